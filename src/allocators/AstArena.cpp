@@ -0,0 +1,77 @@
+/**
+ * @file AstArena.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AstArena.hpp"
+#include <algorithm>
+#include <cstdint>
+
+thread_local AstArena::Ptr AstArena::_current{nullptr};
+
+
+void *AstArena::allocate(size_t size, size_t alignment)
+{
+    auto align = [alignment](std::byte *ptr)
+    {
+        return reinterpret_cast<std::byte *>((reinterpret_cast<uintptr_t>(ptr) + alignment - 1) & ~(alignment - 1));
+    };
+
+    std::byte *ptr = _next ? align(_next) : nullptr;
+
+    if (!ptr || ptr + size > _end)
+    {
+        addChunk(size + alignment);
+        ptr = align(_next);
+    }
+
+    _bytesAllocated += (ptr + size - _next);
+    _next = ptr + size;
+
+    return ptr;
+}
+
+
+bool AstArena::contains(const void *ptr) const
+{
+    auto bytePtr = static_cast<const std::byte *>(ptr);
+
+    /* Search backwards since we are most likely to be asked about recent allocations */
+    return std::any_of(_chunks.rbegin(), _chunks.rend(), [bytePtr](const Chunk &chunk)
+    {
+        return (bytePtr >= chunk.memory.get() && bytePtr < chunk.memory.get() + chunk.size);
+    });
+}
+
+
+void AstArena::addChunk(size_t minimumSize)
+{
+    size_t size = _chunks.empty() ? kMinChunkSize : std::min(2 * _chunks.back().size, kMaxChunkSize);
+
+    size = std::max(size, minimumSize);
+
+    Chunk chunk{std::unique_ptr<std::byte[]>(new std::byte[size]), size}; /* Uninitialized */
+
+    _next = chunk.memory.get();
+    _end = _next + size;
+    _bytesReserved += size;
+
+    _chunks.push_back(std::move(chunk));
+}
+
+
+AstArena::CurrentArena::CurrentArena(AstArena::Ptr arena)
+    : _previous(std::move(_current))
+{
+    _current = std::move(arena);
+}
+
+
+AstArena::CurrentArena::~CurrentArena()
+{
+    _current = std::move(_previous);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file AstArena.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "PoolAllocator.hpp"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+ * Owns all of the nodes for a parsed program in large contiguous chunks. Nodes are bump-allocated in the order that
+ * they are parsed so a node's children are typically stored just before it. Individual deallocations are a no-op; all
+ * chunks are freed together with the arena.
+ *
+ * The parser installs the arena for the duration of the parse (see CurrentArena). Nodes created while no arena is
+ * installed (i.e. at runtime) are allocated from the PoolAllocator.
+ *
+ * Nodes do not refer to their arena. The root of the parsed program owns the arenas (see adopt) so the root must
+ * outlive any node taken from the tree, i.e. scopes containing functions and compiled programs. A pass which replaces
+ * the root must adopt the previous root.
+ */
+class AstArena
+{
+public:
+    using Ptr = std::shared_ptr<AstArena>;
+
+    /* Chunks double in size from the minimum to the maximum. Larger allocations are given a chunk of their own */
+    static constexpr size_t kMinChunkSize{4 * 1024};
+    static constexpr size_t kMaxChunkSize{256 * 1024};
+
+    AstArena() = default;
+    AstArena(const AstArena &) = delete;
+    AstArena &operator=(const AstArena &) = delete;
+
+    /* Returns aligned memory from the current chunk, adding a new chunk if required */
+    void *allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    /* Returns true if the memory was allocated from this arena */
+    [[nodiscard]] bool contains(const void *ptr) const;
+
+    /* Total size of the chunks owned by the arena */
+    [[nodiscard]] size_t bytesReserved() const { return _bytesReserved; }
+
+    /* Total size of the allocations (including alignment padding) */
+    [[nodiscard]] size_t bytesAllocated() const { return _bytesAllocated; }
+
+    /* Installs an arena for the current thread. The previous arena is restored on destruction */
+    class CurrentArena
+    {
+    public:
+        explicit CurrentArena(AstArena::Ptr arena);
+        ~CurrentArena();
+
+        CurrentArena(const CurrentArena &) = delete;
+        CurrentArena &operator=(const CurrentArena &) = delete;
+
+    private:
+        AstArena::Ptr _previous;
+    };
+
+    /* Arena installed for the current thread or nullptr */
+    [[nodiscard]] static AstArena *current() { return _current.get(); }
+
+    /* Allocates a node in the current arena (if any) */
+    template <class TNode, class... Args>
+    static std::shared_ptr<TNode> makeNode(Args &&...args);
+
+    /* Returns a pointer to the root which also owns the arenas (or a previous root). The root is destroyed first */
+    template <class TNode>
+    static std::shared_ptr<TNode> adopt(std::shared_ptr<TNode> root, std::shared_ptr<const void> owner);
+
+    /*
+     * Minimal allocator for std::allocate_shared. Stateless so that it adds nothing to a node's control block: memory
+     * is taken from the current arena (only used by makeNode) and freed with the arena
+     */
+    template <class T>
+    struct Allocator
+    {
+        using value_type = T;
+
+        Allocator() = default;
+
+        template <class U>
+        Allocator(const Allocator<U> &) {}
+
+        T *allocate(size_t n) { return static_cast<T *>(_current->allocate(n * sizeof(T), alignof(T))); }
+
+        void deallocate(T *, size_t) {} /* Freed with the arena */
+
+        template <class U>
+        bool operator==(const Allocator<U> &) const { return true; }
+
+        template <class U>
+        bool operator!=(const Allocator<U> &) const { return false; }
+    };
+
+protected:
+    struct Chunk
+    {
+        std::unique_ptr<std::byte[]> memory;
+        size_t size{0};
+    };
+
+    void addChunk(size_t minimumSize);
+
+private:
+    std::vector<Chunk> _chunks;
+
+    std::byte *_next{nullptr}; /* Next free byte in the last chunk */
+    std::byte *_end{nullptr};  /* End of the last chunk */
+
+    size_t _bytesReserved{0};
+    size_t _bytesAllocated{0};
+
+    static thread_local AstArena::Ptr _current;
+};
+
+
+template <class TNode, class... Args>
+std::shared_ptr<TNode> AstArena::makeNode(Args &&...args)
+{
+    if (!_current)
+    {
+        return std::allocate_shared<TNode>(PoolAllocator::Allocator<TNode>(), std::forward<Args>(args)...);
+    }
+
+    return std::allocate_shared<TNode>(Allocator<TNode>(), std::forward<Args>(args)...);
+}
+
+
+template <class TNode>
+std::shared_ptr<TNode> AstArena::adopt(std::shared_ptr<TNode> root, std::shared_ptr<const void> owner)
+{
+    if (!root)
+    {
+        return nullptr;
+    }
+
+    struct Owner
+    {
+        std::shared_ptr<const void> owner;
+        std::shared_ptr<TNode> root; /* Destroyed first */
+    };
+
+    auto rootOwner = std::make_shared<Owner>(Owner{std::move(owner), std::move(root)});
+
+    return std::shared_ptr<TNode>(rootOwner, rootOwner->root.get());
+}
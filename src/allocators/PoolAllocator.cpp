@@ -8,61 +8,378 @@
  */
 
 #include "PoolAllocator.hpp"
-#include <cstdint>
+#include <atomic>
 #include <cstdlib>
-#include <iostream>
+#include <mutex>
 
-// TODO: - need some way to cleanup and destroy old blocks if memory goes way down.
+thread_local PoolAllocator::ThreadCache *PoolAllocator::tCache{nullptr};
 
-Chunk *PoolAllocator::allocateBlock(size_t chunkSize)
+namespace
 {
-    // static size_t blockCounter = 0;
-    // std::cout << "allocating new block; blockCounter = " << ++blockCounter << std::endl;
+thread_local bool tCacheDestroyed{false};
+}
+
+
+/* Header at the start of each block. Blocks are aligned to kBlockSize so the header can be found from any chunk */
+struct PoolAllocator::Block
+{
+    Block *prev{nullptr}; /* Blocks with free chunks */
+    Block *next{nullptr};
+    bool hasFreeChunks{false};
+
+    size_t sizeClass{0};
+    uint32_t usedChunks{0};
+
+    FreeChunk *freeList{nullptr}; /* Freed chunks */
+    uint8_t *uncarved{nullptr};   /* Chunks which have never been used */
+    uint8_t *end{nullptr};
+
+    static Block *blockFor(void *chunk)
+    {
+        return reinterpret_cast<Block *>(reinterpret_cast<uintptr_t>(chunk) & ~(uintptr_t)(kBlockSize - 1));
+    }
+
+    FreeChunk *pop()
+    {
+        if (freeList)
+        {
+            FreeChunk *chunk = freeList;
+            freeList = chunk->next;
+            return chunk;
+        }
+
+        const size_t size = chunkSize(sizeClass);
+
+        if (uncarved + size <= end)
+        {
+            auto chunk = reinterpret_cast<FreeChunk *>(uncarved);
+            uncarved += size;
+            return chunk;
+        }
+
+        return nullptr;
+    }
+
+    [[nodiscard]] bool isFull() const { return (!freeList && uncarved + chunkSize(sizeClass) > end); }
+};
+
+
+/* Blocks shared by all threads. Protected by a mutex; threads only access it in batches */
+struct PoolAllocator::SharedPool
+{
+    /* Number of empty blocks kept for each size class before empty blocks are released */
+    static constexpr uint32_t kMaxEmptyBlocks{1};
+
+    std::mutex mutex;
+
+    Block *blocksWithFreeChunks[kNumSizeClasses]{};
+    uint32_t emptyBlocks[kNumSizeClasses]{};
+
+    Statistics stats;
+    std::atomic<size_t> largeAllocations{0};
+
+    /* Moves up to count chunks onto the list. Returns the number of chunks moved */
+    uint32_t takeChunks(size_t sizeClass, uint32_t count, FreeChunk *&head);
+
+    void returnChunk(FreeChunk *chunk);
+
+protected:
+    Block *newBlock(size_t sizeClass);
+
+    void releaseBlock(Block *block);
+
+    void link(Block *block);
+
+    void unlink(Block *block);
+};
+
+
+PoolAllocator::SharedPool &PoolAllocator::sharedPool()
+{
+    /* Never destroyed so that objects can be freed during static destruction */
+    static SharedPool *pool = new SharedPool();
+    return *pool;
+}
+
+
+uint32_t PoolAllocator::SharedPool::takeChunks(size_t sizeClass, uint32_t count, FreeChunk *&head)
+{
+    uint32_t taken = 0;
+
+    while (taken < count)
+    {
+        Block *block = blocksWithFreeChunks[sizeClass];
+
+        if (!block)
+        {
+            block = newBlock(sizeClass);
+        }
+
+        if (block->usedChunks == 0)
+        {
+            --emptyBlocks[sizeClass];
+        }
+
+        for (; taken < count; ++taken)
+        {
+            FreeChunk *chunk = block->pop();
+            if (!chunk)
+            {
+                break;
+            }
+
+            chunk->next = head;
+            head = chunk;
+            ++block->usedChunks;
+        }
+
+        if (block->isFull())
+        {
+            unlink(block);
+        }
+    }
+
+    stats.chunksInUse += taken;
+    return taken;
+}
+
+
+void PoolAllocator::SharedPool::returnChunk(FreeChunk *chunk)
+{
+    Block *block = Block::blockFor(chunk);
+
+    chunk->next = block->freeList;
+    block->freeList = chunk;
+    --block->usedChunks;
+    --stats.chunksInUse;
+
+    if (!block->hasFreeChunks)
+    {
+        link(block);
+    }
+
+    if (block->usedChunks == 0)
+    {
+        if (emptyBlocks[block->sizeClass] < kMaxEmptyBlocks)
+            ++emptyBlocks[block->sizeClass];
+        else
+            releaseBlock(block);
+    }
+}
+
+
+PoolAllocator::Block *PoolAllocator::SharedPool::newBlock(size_t sizeClass)
+{
+    void *memory = std::aligned_alloc(kBlockSize, kBlockSize);
+    if (!memory)
+    {
+        throw std::bad_alloc();
+    }
+
+    constexpr size_t kHeaderSize = ((sizeof(Block) + kSizeClassGranularity - 1) / kSizeClassGranularity) * kSizeClassGranularity;
+
+    auto block = new (memory) Block();
+    block->sizeClass = sizeClass;
+    block->uncarved = static_cast<uint8_t *>(memory) + kHeaderSize;
+    block->end = static_cast<uint8_t *>(memory) + kBlockSize;
+
+    link(block);
+
+    ++emptyBlocks[sizeClass];
+    ++stats.blocksInUse;
+    ++stats.blocksAllocated;
+
+    return block;
+}
+
+
+void PoolAllocator::SharedPool::releaseBlock(Block *block)
+{
+    unlink(block);
+
+    block->~Block();
+    std::free(block);
+
+    --stats.blocksInUse;
+    ++stats.blocksReleased;
+}
+
+
+void PoolAllocator::SharedPool::link(Block *block)
+{
+    Block *&head = blocksWithFreeChunks[block->sizeClass];
+
+    block->prev = nullptr;
+    block->next = head;
+
+    if (head)
+    {
+        head->prev = block;
+    }
+
+    head = block;
+    block->hasFreeChunks = true;
+}
+
+
+void PoolAllocator::SharedPool::unlink(Block *block)
+{
+    if (block->prev)
+        block->prev->next = block->next;
+    else
+        blocksWithFreeChunks[block->sizeClass] = block->next;
+
+    if (block->next)
+    {
+        block->next->prev = block->prev;
+    }
+
+    block->prev = block->next = nullptr;
+    block->hasFreeChunks = false;
+}
+
+
+void PoolAllocator::initThreadCache()
+{
+    if (tCacheDestroyed)
+    {
+        return;
+    }
+
+    thread_local ThreadCache cache;
+    tCache = &cache;
+}
+
+
+PoolAllocator::ThreadCache::~ThreadCache()
+{
+    flushThreadCache();
+
+    tCache = nullptr;
+    tCacheDestroyed = true;
+}
 
-    size_t blockSize = (chunkSize * chunksPerBlock);
 
-    Chunk *blockBegin = reinterpret_cast<Chunk *>(malloc(blockSize));
-    Chunk *chunk = blockBegin;
+void *PoolAllocator::allocateSlow(size_t sizeClass)
+{
+    if (!tCache)
+    {
+        initThreadCache();
+    }
+
+    SharedPool &pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    if (!tCache) /* Thread is exiting */
+    {
+        FreeChunk *chunk{nullptr};
+        pool.takeChunks(sizeClass, 1, chunk);
+        ++pool.stats.allocations;
+        return chunk;
+    }
+
+    SizeClassCache &cache = tCache->sizeClasses[sizeClass];
+
+    cache.count += pool.takeChunks(sizeClass, kBatchSize - cache.count, cache.head);
+
+    FreeChunk *chunk = cache.head;
+    cache.head = chunk->next;
+    --cache.count;
+    ++tCache->allocations;
+
+    return chunk;
+}
+
+
+void PoolAllocator::deallocateSlow(void *ptr, size_t sizeClass)
+{
+    if (!tCache)
+    {
+        initThreadCache();
+    }
 
-    for (size_t i = 0; i < (chunksPerBlock - 1); ++i)
+    SharedPool &pool = sharedPool();
+
+    if (!tCache) /* Thread is exiting */
     {
-        chunk->next = reinterpret_cast<Chunk *>((uint8_t *)chunk + chunkSize);
-        chunk = chunk->next;
+        std::lock_guard<std::mutex> lock(pool.mutex);
+        pool.returnChunk(static_cast<FreeChunk *>(ptr));
+        ++pool.stats.deallocations;
+        return;
     }
 
-    chunk->next = nullptr;
+    SizeClassCache &cache = tCache->sizeClasses[sizeClass];
+
+    if (cache.count >= kMaxCachedChunks)
+    {
+        std::lock_guard<std::mutex> lock(pool.mutex);
 
-    return blockBegin;
+        for (uint32_t i = 0; i < kBatchSize; ++i)
+        {
+            FreeChunk *chunk = cache.head;
+            cache.head = chunk->next;
+            pool.returnChunk(chunk);
+        }
+
+        cache.count -= kBatchSize;
+    }
+
+    cache.head = new (ptr) FreeChunk{cache.head};
+    ++cache.count;
+    ++tCache->deallocations;
 }
 
 
-void *PoolAllocator::allocate(size_t chunkSize)
+void *PoolAllocator::allocateLarge(size_t size)
 {
-    // std::cout << "allocating chunk: " << ++numChunksInUse << std::endl;
+    sharedPool().largeAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    return ::operator new(size);
+}
+
 
-    if (!nextAvailChunk) // No blocks allocated or no chunks available.
+void PoolAllocator::flushThreadCache()
+{
+    if (!tCache)
     {
-        nextAvailChunk = allocateBlock(chunkSize);
+        return;
     }
 
-    // TODO: - check chunkSize matches what we expect here.
+    SharedPool &pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+
+    for (SizeClassCache &cache : tCache->sizeClasses)
+    {
+        while (cache.head)
+        {
+            FreeChunk *chunk = cache.head;
+            cache.head = chunk->next;
+            pool.returnChunk(chunk);
+        }
 
-    Chunk *ptr = nextAvailChunk;
+        cache.count = 0;
+    }
 
-    // Advance to next chunk. When no available chunks, it will be set to nullptr;
-    nextAvailChunk = nextAvailChunk->next;
+    pool.stats.allocations += tCache->allocations;
+    pool.stats.deallocations += tCache->deallocations;
 
-    return ptr;
+    tCache->allocations = tCache->deallocations = 0;
 }
 
 
-void PoolAllocator::deallocate(void *chunk)
+PoolAllocator::Statistics PoolAllocator::statistics()
 {
-    // std::cout << "deallocating chunk: " << --numChunksInUse << std::endl;
+    SharedPool &pool = sharedPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
 
-    // Freed pointer's next pointer points to current allocation pointer and
-    // allocation pointer set to returned free chunk.
-    reinterpret_cast<Chunk *>(chunk)->next = nextAvailChunk;
+    Statistics stats = pool.stats;
+    stats.largeAllocations = pool.largeAllocations.load(std::memory_order_relaxed);
 
-    nextAvailChunk = reinterpret_cast<Chunk *>(chunk);
-}
\ No newline at end of file
+    if (tCache)
+    {
+        stats.allocations += tCache->allocations;
+        stats.deallocations += tCache->deallocations;
+    }
+
+    return stats;
+}
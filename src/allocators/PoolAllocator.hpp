@@ -8,40 +8,172 @@
  */
 
 #pragma once
-#include <new>
 #include <cstddef>
-
-struct Chunk
-{
-    Chunk *next{nullptr};
-};
+#include <cstdint>
+#include <new>
 
 /**
- * The allocator class.
+ * Size-class allocator for small objects (AnyObject, Scope storage and nodes created at runtime).
  *
- * - Consider it as consisting of a series of large blocks with smaller chunks.
+ * - Memory is taken from the system in large aligned blocks. Each block is split into chunks of a single size class.
+ * - Each thread has a cache of free chunks for each size class so most allocations do not take a lock. Caches are
+ *   refilled from (and overflow back to) the shared blocks in batches.
+ * - A block is returned to the system once all of its chunks have been freed (one empty block is kept for each size
+ *   class to avoid thrashing).
+ * - Larger allocations use operator new.
  *
  * Ref: http://dmitrysoshnikov.com/compilers/writing-a-pool-allocator/
  */
 class PoolAllocator
 {
 public:
-    PoolAllocator(size_t chunksPerBlock_) : chunksPerBlock(chunksPerBlock_) {}
+    static constexpr size_t kBlockSize{64 * 1024};
+    static constexpr size_t kSizeClassGranularity{16};
+    static constexpr size_t kMaxChunkSize{512};
+    static constexpr size_t kNumSizeClasses{kMaxChunkSize / kSizeClassGranularity};
+
+    struct Statistics
+    {
+        size_t allocations{0};      /* Pooled allocations. Other threads are included once they exit */
+        size_t deallocations{0};    /* Pooled deallocations. Other threads are included once they exit */
+        size_t largeAllocations{0}; /* Allocations larger than kMaxChunkSize */
+        size_t blocksInUse{0};
+        size_t blocksAllocated{0};
+        size_t blocksReleased{0};
+        size_t chunksInUse{0}; /* Includes free chunks held in thread caches */
+
+        [[nodiscard]] size_t bytesReserved() const { return blocksInUse * kBlockSize; }
+    };
+
+    static void *allocate(size_t size);
+
+    /* Size must match the size passed to allocate() */
+    static void deallocate(void *ptr, size_t size);
+
+    static Statistics statistics();
+
+    /* Returns the chunks cached by this thread to the blocks so that empty blocks can be released */
+    static void flushThreadCache();
+
+    /* Stateless allocator for std::allocate_shared and containers */
+    template <class T>
+    struct Allocator
+    {
+        using value_type = T;
+
+        Allocator() = default;
+
+        template <class U>
+        Allocator(const Allocator<U> &) {}
+
+        T *allocate(size_t n) { return static_cast<T *>(PoolAllocator::allocate(n * sizeof(T))); }
+
+        void deallocate(T *ptr, size_t n) { PoolAllocator::deallocate(ptr, n * sizeof(T)); }
+
+        template <class U>
+        bool operator==(const Allocator<U> &) const { return true; }
+
+        template <class U>
+        bool operator!=(const Allocator<U> &) const { return false; }
+    };
+
+protected:
+    static size_t sizeClass(size_t size) { return (size - 1) / kSizeClassGranularity; }
+
+    static size_t chunkSize(size_t sizeClass) { return (sizeClass + 1) * kSizeClassGranularity; }
+
+    /* Refills the thread cache or allocates directly from the blocks if the thread has exited */
+    static void *allocateSlow(size_t sizeClass);
+
+    /* Returns a batch of chunks to the blocks if the thread cache is full */
+    static void deallocateSlow(void *ptr, size_t sizeClass);
 
-    void *allocate(size_t chunkSize);
+    static void *allocateLarge(size_t size);
+
+    /* Chunks moved between a thread cache and the blocks at a time */
+    static constexpr uint32_t kBatchSize{32};
+    static constexpr uint32_t kMaxCachedChunks{2 * kBatchSize};
+
+    struct FreeChunk
+    {
+        FreeChunk *next{nullptr};
+    };
+
+    struct Block;
+    struct SharedPool;
+
+    static SharedPool &sharedPool();
+
+    struct SizeClassCache
+    {
+        FreeChunk *head{nullptr};
+        uint32_t count{0};
+    };
+
+    /* Free chunks for the current thread */
+    struct ThreadCache
+    {
+        SizeClassCache sizeClasses[kNumSizeClasses];
+
+        size_t allocations{0};
+        size_t deallocations{0};
+
+        ~ThreadCache(); /* Returns all chunks */
+    };
+
+    /* Creates the cache for the current thread unless the thread is exiting */
+    static void initThreadCache();
+
+    /* Nullptr before first use and after thread exit */
+    static thread_local ThreadCache *tCache;
+};
+
+
+inline void *PoolAllocator::allocate(size_t size)
+{
+    if (size == 0 || size > kMaxChunkSize)
+    {
+        return allocateLarge(size);
+    }
+
+    const size_t index = sizeClass(size);
+
+    if (tCache && tCache->sizeClasses[index].head)
+    {
+        SizeClassCache &cache = tCache->sizeClasses[index];
+
+        FreeChunk *chunk = cache.head;
+        cache.head = chunk->next;
+        --cache.count;
+        ++tCache->allocations;
+
+        return chunk;
+    }
+
+    return allocateSlow(index);
+}
+
+
+inline void PoolAllocator::deallocate(void *ptr, size_t size)
+{
+    if (size == 0 || size > kMaxChunkSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
 
-    void deallocate(void *ptr);
+    const size_t index = sizeClass(size);
 
-private:
-    Chunk *allocateBlock(size_t chunkSize);
+    if (tCache && tCache->sizeClasses[index].count < kMaxCachedChunks)
+    {
+        SizeClassCache &cache = tCache->sizeClasses[index];
 
-    /**
-     * Number of chunks per block.
-     */
-    size_t chunksPerBlock;
+        FreeChunk *chunk = new (ptr) FreeChunk{cache.head};
+        cache.head = chunk;
+        ++cache.count;
+        ++tCache->deallocations;
+        return;
+    }
 
-    /**
-     * Allocation pointer.
-     */
-    Chunk *nextAvailChunk{nullptr};
-};
\ No newline at end of file
+    deallocateSlow(ptr, index);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file Bytecode.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Bytecode.hpp"
+#include "Exceptions.hpp"
+#include "Stringify.hpp"
+#include <sstream>
+
+
+const char *opCodeName(OpCode opCode)
+{
+    switch (opCode)
+    {
+        case OpCode::LoadConst:
+            return "LoadConst";
+        case OpCode::LoadNone:
+            return "LoadNone";
+        case OpCode::Move:
+            return "Move";
+        case OpCode::LoadGlobal:
+            return "LoadGlobal";
+        case OpCode::StoreGlobal:
+            return "StoreGlobal";
+        case OpCode::CheckType:
+            return "CheckType";
+        case OpCode::CheckArgument:
+            return "CheckArgument";
+        case OpCode::Add:
+            return "Add";
+        case OpCode::Subtract:
+            return "Subtract";
+        case OpCode::Multiply:
+            return "Multiply";
+        case OpCode::Divide:
+            return "Divide";
+        case OpCode::Modulo:
+            return "Modulo";
+        case OpCode::Equal:
+            return "Equal";
+        case OpCode::NotEqual:
+            return "NotEqual";
+        case OpCode::Less:
+            return "Less";
+        case OpCode::LessOrEqual:
+            return "LessOrEqual";
+        case OpCode::Greater:
+            return "Greater";
+        case OpCode::GreaterOrEqual:
+            return "GreaterOrEqual";
+        case OpCode::And:
+            return "And";
+        case OpCode::Or:
+            return "Or";
+        case OpCode::Not:
+            return "Not";
+        case OpCode::Negate:
+            return "Negate";
+        case OpCode::CastInt:
+            return "CastInt";
+        case OpCode::CastFloat:
+            return "CastFloat";
+        case OpCode::Increment:
+            return "Increment";
+        case OpCode::Decrement:
+            return "Decrement";
+        case OpCode::Jump:
+            return "Jump";
+        case OpCode::JumpIfFalse:
+            return "JumpIfFalse";
+        case OpCode::JumpIfTrue:
+            return "JumpIfTrue";
+        case OpCode::Call:
+            return "Call";
+        case OpCode::CallNative:
+            return "CallNative";
+        case OpCode::Return:
+            return "Return";
+        case OpCode::ReturnNone:
+            return "ReturnNone";
+        case OpCode::Halt:
+            return "Halt";
+        default:
+            ThrowException("unknown opcode");
+    }
+}
+
+
+std::string BytecodeFunction::disassemble() const
+{
+    std::ostringstream oss;
+
+    oss << "function " << name << " (" << paramTypes.size() << " params, " << numRegisters << " registers)" << std::endl;
+
+    for (size_t i = 0; i < code.size(); ++i)
+    {
+        const Instruction &instruction = code[i];
+
+        oss << eucleia::stringify("%5zu  %-15s %5u %5u %5u", i, opCodeName(instruction.opCode), instruction.a, instruction.b, instruction.c) << std::endl;
+    }
+
+    return oss.str();
+}
+
+
+std::string BytecodeProgram::disassemble() const
+{
+    std::ostringstream oss;
+
+    for (const auto &function : functions)
+    {
+        oss << function.disassemble() << std::endl;
+    }
+
+    return oss.str();
+}
@@ -0,0 +1,112 @@
+/**
+ * @file Bytecode.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyObject.hpp"
+#include "BaseNode.hpp"
+#include "Value.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/*
+ * Instruction set for the register VM. Operands a, b, c are register indices unless stated otherwise. Registers are
+ * NaN-boxed Values so Int, Float and Bool operations do not allocate.
+ */
+enum class OpCode : uint8_t
+{
+    LoadConst,      /* R[a] = K[b] */
+    LoadNone,       /* R[a] = None */
+    Move,           /* R[a] = R[b] */
+    LoadGlobal,     /* R[a] = G[b] */
+    StoreGlobal,    /* G[a] = R[b] */
+    CheckType,      /* Throws if R[a] is not of type b */
+    CheckArgument,  /* Throws if parameter R[a] is not of type b */
+    Add,            /* R[a] = R[b] + R[c] */
+    Subtract,       /* R[a] = R[b] - R[c] */
+    Multiply,       /* R[a] = R[b] * R[c] */
+    Divide,         /* R[a] = R[b] / R[c] */
+    Modulo,         /* R[a] = R[b] % R[c] */
+    Equal,          /* R[a] = R[b] == R[c] */
+    NotEqual,       /* R[a] = R[b] != R[c] */
+    Less,           /* R[a] = R[b] < R[c] */
+    LessOrEqual,    /* R[a] = R[b] <= R[c] */
+    Greater,        /* R[a] = R[b] > R[c] */
+    GreaterOrEqual, /* R[a] = R[b] >= R[c] */
+    And,            /* R[a] = R[b] && R[c] */
+    Or,             /* R[a] = R[b] || R[c] */
+    Not,            /* R[a] = !R[b] */
+    Negate,         /* R[a] = -R[b] */
+    CastInt,        /* R[a] = int(R[b]) */
+    CastFloat,      /* R[a] = float(R[b]) */
+    Increment,      /* ++R[a] */
+    Decrement,      /* --R[a] */
+    Jump,           /* pc = a */
+    JumpIfFalse,    /* if (!R[a]) pc = b */
+    JumpIfTrue,     /* if (R[a]) pc = b */
+    Call,           /* R[a] = F[b](R[a], ..., R[a + c - 1]) */
+    CallNative,     /* R[a] = N[b](R[a], ..., R[a + c - 1]) */
+    Return,         /* return R[a] */
+    ReturnNone,     /* return */
+    Halt
+};
+
+
+struct Instruction
+{
+    OpCode opCode;
+    uint16_t a{0};
+    uint16_t b{0};
+    uint16_t c{0};
+};
+
+
+struct BytecodeFunction
+{
+    std::string name;
+    std::vector<Instruction> code;
+    std::vector<AnyObject::Type> paramTypes;
+    std::vector<std::string> paramNames;
+    uint16_t numRegisters{0};
+
+    /* Prints instructions for debugging */
+    std::string disassemble() const;
+};
+
+
+struct BytecodeProgram
+{
+    using Ptr = std::shared_ptr<BytecodeProgram>;
+
+    /* Index of the entry-point in functions */
+    static constexpr uint16_t kMainFunction{0};
+
+    std::vector<BytecodeFunction> functions;
+    std::vector<Value> constants;
+
+    /* Names of module functions called with CallNative. Resolved by the VM on first call */
+    std::vector<std::string> nativeNames;
+
+    /* Largest argument count passed to a module function */
+    uint16_t maxNativeArgs{0};
+
+    /* Keeps the nodes below (and the arenas they were allocated in) alive */
+    BaseNode::Ptr ast;
+
+    /* Module import nodes to evaluate before running */
+    BaseNodePtrVector modules;
+
+    std::string disassemble() const;
+};
+
+
+/* Returns the name of an opcode for printing */
+const char *opCodeName(OpCode opCode);
@@ -0,0 +1,1007 @@
+/**
+ * @file BytecodeCompiler.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "BytecodeCompiler.hpp"
+#include "AddVariableNode.hpp"
+#include "BinaryNode.hpp"
+#include "Exceptions.hpp"
+#include "FunctionCallNode.hpp"
+#include "FunctionNode.hpp"
+#include "Logger.hpp"
+#include "LookupVariableNode.hpp"
+#include "NodeTraversal.hpp"
+#include "ObjectFactory.hpp"
+#include <algorithm>
+#include <limits>
+
+
+namespace
+{
+
+/* Thrown internally when the AST contains a node the VM does not support */
+struct UnsupportedNode
+{
+    std::string reason;
+};
+
+constexpr size_t kMaxRegisters = std::numeric_limits<uint16_t>::max();
+
+} // namespace
+
+
+BytecodeProgram::Ptr BytecodeCompiler::compile(const BaseNode::Ptr &ast)
+{
+    try
+    {
+        return BytecodeCompiler().compileProgram(ast);
+    }
+    catch (const UnsupportedNode &error)
+    {
+        log().debug("cannot compile to bytecode: " + error.reason);
+        return nullptr;
+    }
+}
+
+
+BytecodeProgram::Ptr BytecodeCompiler::compileProgram(const BaseNode::Ptr &ast)
+{
+    if (!ast || !ast->isNodeType(NodeType::File))
+    {
+        unsupported("expected file node");
+    }
+
+    _program = std::make_shared<BytecodeProgram>();
+    _program->ast = ast;
+    _program->functions.emplace_back();
+    _program->functions.back().name = "main";
+
+    /* File-level declarations are visible to all functions */
+    collectDeclarations(*ast);
+    collectNames(*ast);
+
+    FunctionState mainState;
+    mainState.functionIndex = BytecodeProgram::kMainFunction;
+    mainState.isMain = true;
+    mainState.scopes.emplace_back();
+    mainState.nextRegister = (uint16_t)_globals.size(); /* Globals occupy the first registers */
+    mainState.liveTop = mainState.nextRegister;
+
+    _state = &mainState;
+    compileStatements(ast->castNode<AnyNode>().children());
+    emit(OpCode::Halt);
+
+    for (size_t i = 0; i < _functionNodes.size(); ++i)
+    {
+        compileFunction(*_functionNodes[i], (uint16_t)(i + 1));
+    }
+
+    _state = nullptr;
+    return _program;
+}
+
+
+void BytecodeCompiler::collectDeclarations(const BaseNode &node)
+{
+    for (const auto &child : node.castNode<AnyNode>().children())
+    {
+        const BaseNode *declaration = child.get();
+
+        if (child->isNodeType(NodeType::Assign))
+        {
+            declaration = child->castNode<AnyNode>().child(0).get();
+        }
+
+        if (declaration->isNodeType(NodeType::File))
+        {
+            collectDeclarations(*declaration); /* Imported file */
+        }
+        else if (declaration->isNodeType(NodeType::Function))
+        {
+            auto &funcNode = declaration->castNode<FunctionNode>();
+
+            if (_functionIndices.count(funcNode._funcName))
+            {
+                unsupported("duplicate function " + funcNode._funcName);
+            }
+
+            if (funcNode.isPure())
+            {
+                unsupported("pure function " + funcNode._funcName);
+            }
+
+            _functionNodes.push_back(&funcNode);
+            _functionIndices[funcNode._funcName] = (uint16_t)_functionNodes.size();
+
+            _program->functions.emplace_back();
+            _program->functions.back().name = funcNode._funcName;
+        }
+        else if (declaration->isNodeType(NodeType::AddVariable))
+        {
+            if (dynamic_cast<const AddReferenceVariableNode *>(declaration))
+            {
+                unsupported("references");
+            }
+
+            auto &variableNode = declaration->castNode<AddVariableNode>();
+
+            if (_globals.count(variableNode.name()))
+            {
+                unsupported(variableNode.name() + " is already defined in current scope");
+            }
+
+            uint16_t reg = (uint16_t)_globals.size();
+            _globals[variableNode.name()] = Variable{reg, variableNode.variableType()};
+            _globalDeclarations.insert(declaration);
+        }
+    }
+
+    for (const auto &[name, _] : _functionIndices)
+    {
+        if (_globals.count(name))
+        {
+            unsupported("function and variable share name " + name);
+        }
+    }
+}
+
+
+void BytecodeCompiler::collectNames(const BaseNode &node)
+{
+    if (node.isNodeType(NodeType::AddVariable) && !_globalDeclarations.count(&node))
+    {
+        _localNames.insert(node.castNode<AddVariableNode>().name());
+    }
+    else if (node.isNodeType(NodeType::FunctionCall))
+    {
+        for (const auto &argNode : node.castNode<FunctionCallNode>()._funcArgs)
+        {
+            if (argNode->isNodeType(NodeType::LookupVariable))
+                _argumentNames.insert(argNode->castNode<LookupVariableNode>().name());
+        }
+    }
+
+    forEachChild(node, [this](const BaseNode::Ptr &child)
+    {
+        if (child)
+            collectNames(*child);
+    });
+}
+
+
+void BytecodeCompiler::compileFunction(const FunctionNode &node, uint16_t functionIndex)
+{
+    FunctionState state;
+    state.functionIndex = functionIndex;
+    state.isMain = false;
+    _state = &state;
+
+    pushScope();
+
+    BytecodeFunction &function = currentFunction();
+
+    for (const auto &argNode : node._funcArgs)
+    {
+        if (!argNode->isNodeType(NodeType::AddVariable) || dynamic_cast<const AddReferenceVariableNode *>(argNode.get()))
+        {
+            unsupported("unexpected function argument");
+        }
+
+        auto &variableNode = argNode->castNode<AddVariableNode>();
+
+        (void)compileAddVariable(variableNode);
+        state.scopes.back()[variableNode.name()].isParameter = true;
+
+        function.paramTypes.push_back(variableNode.variableType());
+        function.paramNames.push_back(variableNode.name());
+    }
+
+    /* Arguments are moved into place by the caller so remove the default initialization */
+    function.code.clear();
+
+    for (uint16_t i = 0; i < function.paramTypes.size(); ++i)
+    {
+        emit(OpCode::CheckArgument, i, (uint16_t)function.paramTypes[i]);
+    }
+
+    compileStatement(*node.funcBody);
+    emit(OpCode::ReturnNone);
+
+    popScope();
+    _state = nullptr;
+}
+
+
+void BytecodeCompiler::compileStatements(const BaseNodePtrVector &nodes)
+{
+    for (const auto &node : nodes)
+    {
+        if (node->isNodeType(NodeType::Module))
+        {
+            if (!_state->isMain || _state->scopes.size() != 1)
+                unsupported("module import inside block");
+
+            _program->modules.push_back(node); /* Evaluated by the VM before running */
+            continue;
+        }
+
+        compileStatement(*node);
+    }
+}
+
+
+void BytecodeCompiler::compileStatement(const BaseNode &node)
+{
+    switch (node.type())
+    {
+        case NodeType::Block:
+            compileBlock(node.castNode<AnyNode>().children());
+            break;
+        case NodeType::File:
+            if (!_state->isMain || _state->scopes.size() != 1)
+                unsupported("import inside block");
+            compileStatements(node.castNode<AnyNode>().children());
+            break;
+        case NodeType::Function:
+            if (!_state->isMain || _state->scopes.size() != 1)
+                unsupported("nested function definition");
+            break; /* Compiled separately */
+        case NodeType::If:
+            compileIf(node.castNode<AnyNode>());
+            break;
+        case NodeType::ForLoop:
+            compileForLoop(node.castNode<AnyNode>());
+            break;
+        case NodeType::While:
+            compileWhileLoop(node.castNode<AnyNode>());
+            break;
+        case NodeType::DoWhile:
+            compileDoWhileLoop(node.castNode<AnyNode>());
+            break;
+        case NodeType::Break:
+            compileBreak();
+            break;
+        case NodeType::Continue:
+            compileContinue();
+            break;
+        case NodeType::Return:
+            compileReturn(node.castNode<AnyNode>());
+            break;
+        case NodeType::Assign:
+            compileAssign(node.castNode<AnyNode>());
+            break;
+        default:
+            (void)compileExpression(node);
+            break;
+    }
+
+    /* Release any temporaries */
+    _state->nextRegister = _state->liveTop;
+}
+
+
+void BytecodeCompiler::compileBlock(const BaseNodePtrVector &nodes)
+{
+    pushScope();
+    compileStatements(nodes);
+    popScope();
+}
+
+
+void BytecodeCompiler::compileIf(const AnyNode &node)
+{
+    const auto &condition = node.child(0);
+    const auto &thenBranch = node.child(1);
+    const auto &elseBranch = node.child(2);
+
+    Operand conditionResult = compileExpression(*condition);
+    size_t jumpToElse = emit(OpCode::JumpIfFalse, conditionResult.reg);
+    _state->nextRegister = _state->liveTop;
+
+    compileStatement(*thenBranch);
+
+    if (elseBranch)
+    {
+        size_t jumpToEnd = emit(OpCode::Jump);
+        patchJump(jumpToElse);
+        compileStatement(*elseBranch);
+        patchJump(jumpToEnd);
+    }
+    else
+    {
+        patchJump(jumpToElse);
+    }
+}
+
+
+void BytecodeCompiler::compileForLoop(const AnyNode &node)
+{
+    pushScope(); /* Loop scope */
+
+    compileStatement(*node.child(0)); /* Initialization */
+
+    size_t loopStart = currentPosition();
+
+    Operand condition = compileExpression(*node.child(1));
+    size_t jumpToEnd = emit(OpCode::JumpIfFalse, condition.reg);
+    _state->nextRegister = _state->liveTop;
+
+    _state->loops.emplace_back();
+    compileStatement(*node.child(3)); /* Body */
+    patchContinueJumps();
+    compileStatement(*node.child(2)); /* Update */
+    emit(OpCode::Jump, (uint16_t)loopStart);
+
+    patchJump(jumpToEnd);
+
+    for (size_t index : _state->loops.back().breakJumps)
+    {
+        patchJump(index);
+    }
+
+    _state->loops.pop_back();
+
+    popScope();
+}
+
+
+void BytecodeCompiler::compileWhileLoop(const AnyNode &node)
+{
+    size_t loopStart = currentPosition();
+
+    Operand condition = compileExpression(*node.child(0)); /* Evaluated in outer scope */
+    size_t jumpToEnd = emit(OpCode::JumpIfFalse, condition.reg);
+    _state->nextRegister = _state->liveTop;
+
+    _state->loops.emplace_back();
+    pushScope(); /* Loop scope */
+    compileStatement(*node.child(1));
+    popScope();
+    patchContinueJumps();
+    emit(OpCode::Jump, (uint16_t)loopStart);
+
+    patchJump(jumpToEnd);
+
+    for (size_t index : _state->loops.back().breakJumps)
+    {
+        patchJump(index);
+    }
+
+    _state->loops.pop_back();
+}
+
+
+void BytecodeCompiler::compileDoWhileLoop(const AnyNode &node)
+{
+    size_t loopStart = currentPosition();
+
+    _state->loops.emplace_back();
+    pushScope(); /* Loop scope */
+    compileStatement(*node.child(1));
+    popScope();
+    patchContinueJumps();
+
+    Operand condition = compileExpression(*node.child(0)); /* Evaluated in outer scope */
+    emit(OpCode::JumpIfTrue, condition.reg, (uint16_t)loopStart);
+
+    for (size_t index : _state->loops.back().breakJumps)
+    {
+        patchJump(index);
+    }
+
+    _state->loops.pop_back();
+}
+
+
+void BytecodeCompiler::compileBreak()
+{
+    if (_state->loops.empty())
+    {
+        unsupported("break outside of loop");
+    }
+
+    _state->loops.back().breakJumps.push_back(emit(OpCode::Jump));
+}
+
+
+void BytecodeCompiler::compileContinue()
+{
+    if (_state->loops.empty())
+    {
+        unsupported("continue outside of loop");
+    }
+
+    _state->loops.back().continueJumps.push_back(emit(OpCode::Jump));
+}
+
+
+void BytecodeCompiler::patchContinueJumps()
+{
+    for (size_t index : _state->loops.back().continueJumps)
+    {
+        patchJump(index);
+    }
+
+    _state->loops.back().continueJumps.clear();
+}
+
+
+void BytecodeCompiler::compileReturn(const AnyNode &node)
+{
+    if (_state->isMain)
+    {
+        unsupported("return outside of function");
+    }
+
+    const auto &returnNode = node.child(0);
+
+    if (returnNode)
+    {
+        Operand result = compileExpression(*returnNode);
+        emit(OpCode::Return, result.reg);
+    }
+    else
+    {
+        emit(OpCode::ReturnNone);
+    }
+}
+
+
+void BytecodeCompiler::compileAssign(const AnyNode &node)
+{
+    const auto &left = node.child(0);
+    const auto &right = node.child(1);
+
+    std::string name;
+
+    if (left->isNodeType(NodeType::AddVariable))
+    {
+        if (dynamic_cast<const AddReferenceVariableNode *>(left.get()))
+        {
+            unsupported("references");
+        }
+
+        (void)compileAddVariable(left->castNode<AddVariableNode>());
+        name = left->castNode<AddVariableNode>().name();
+    }
+    else if (left->isNodeType(NodeType::LookupVariable))
+    {
+        name = left->castNode<LookupVariableNode>().name();
+    }
+    else
+    {
+        unsupported("assignment to array or class member");
+    }
+
+    storeVariable(name, compileExpression(*right));
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileExpression(const BaseNode &node)
+{
+    switch (node.type())
+    {
+        case NodeType::Int:
+        case NodeType::Float:
+        case NodeType::Bool:
+        case NodeType::String:
+            return compileLiteral(node.castNode<AnyNode>());
+        case NodeType::LookupVariable:
+            return compileLookup(node.castNode<LookupVariableNode>());
+        case NodeType::AddVariable:
+            if (dynamic_cast<const AddReferenceVariableNode *>(&node))
+                unsupported("references");
+            return compileAddVariable(node.castNode<AddVariableNode>());
+        case NodeType::Binary:
+            return compileBinary(node.castNode<BinaryNode>());
+        case NodeType::Not:
+        case NodeType::Negation:
+            return compileUnary(node.castNode<AnyNode>());
+        case NodeType::Cast:
+            return compileCast(node.castNode<AnyNode>());
+        case NodeType::PrefixIncrement:
+        case NodeType::PrefixDecrement:
+            return compilePrefix(node.castNode<AnyNode>());
+        case NodeType::FunctionCall:
+            return compileFunctionCall(node.castNode<FunctionCallNode>());
+        case NodeType::Assign:
+        {
+            compileAssign(node.castNode<AnyNode>());
+
+            uint16_t reg = allocateRegister();
+            emit(OpCode::LoadNone, reg);
+            return Operand{reg, AnyObject::NotSet};
+        }
+        default:
+            unsupported("node type " + std::to_string((int)node.type()));
+    }
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileExpressionInto(const BaseNode &node, uint16_t target)
+{
+    Operand result = compileExpression(node);
+
+    if (result.reg != target)
+    {
+        emit(OpCode::Move, target, result.reg);
+    }
+
+    return Operand{target, result.type};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileLiteral(const AnyNode &node)
+{
+    Scope emptyScope;
+
+    Value constant = const_cast<AnyNode &>(node).evaluateValue(emptyScope);
+    const AnyObject::Type type = constant.type();
+
+    uint16_t reg = allocateRegister();
+    emit(OpCode::LoadConst, reg, addConstant(std::move(constant)));
+
+    return Operand{reg, type};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileLookup(const LookupVariableNode &node)
+{
+    if (const Variable *local = lookupLocal(node.name()))
+    {
+        return Operand{local->reg, local->type};
+    }
+
+    if (const Variable *global = lookupGlobal(node.name()))
+    {
+        if (_state->isMain)
+        {
+            return Operand{global->reg, global->type};
+        }
+
+        checkGlobalAccess(node.name(), false);
+
+        uint16_t reg = allocateRegister();
+        emit(OpCode::LoadGlobal, reg, global->reg);
+        return Operand{reg, global->type};
+    }
+
+    unsupported("unresolved variable " + node.name());
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileBinary(const BinaryNode &node)
+{
+    Operand left = compileExpression(*node.left());
+    Operand right = compileExpression(*node.right());
+
+    OpCode opCode;
+    bool isComparison = false;
+
+    switch (node.binaryOperator())
+    {
+        case BinaryOperatorType::Add:
+            opCode = OpCode::Add;
+            break;
+        case BinaryOperatorType::Minus:
+            opCode = OpCode::Subtract;
+            break;
+        case BinaryOperatorType::Multiply:
+            opCode = OpCode::Multiply;
+            break;
+        case BinaryOperatorType::Divide:
+            opCode = OpCode::Divide;
+            break;
+        case BinaryOperatorType::Modulo:
+            opCode = OpCode::Modulo;
+            break;
+        case BinaryOperatorType::Equal:
+            opCode = OpCode::Equal, isComparison = true;
+            break;
+        case BinaryOperatorType::NotEqual:
+            opCode = OpCode::NotEqual, isComparison = true;
+            break;
+        case BinaryOperatorType::Less:
+            opCode = OpCode::Less, isComparison = true;
+            break;
+        case BinaryOperatorType::LessOrEqual:
+            opCode = OpCode::LessOrEqual, isComparison = true;
+            break;
+        case BinaryOperatorType::Greater:
+            opCode = OpCode::Greater, isComparison = true;
+            break;
+        case BinaryOperatorType::GreaterOrEqual:
+            opCode = OpCode::GreaterOrEqual, isComparison = true;
+            break;
+        case BinaryOperatorType::And:
+            opCode = OpCode::And, isComparison = true;
+            break;
+        case BinaryOperatorType::Or:
+            opCode = OpCode::Or, isComparison = true;
+            break;
+        default:
+            unsupported("unknown binary operator");
+    }
+
+    /* Only infer the result type where it is certain. Invalid combinations throw at runtime */
+    AnyObject::Type resultType = AnyObject::NotSet;
+
+    auto isNumeric = [](AnyObject::Type type)
+    {
+        return (type == AnyObject::Int || type == AnyObject::Float);
+    };
+
+    if (isComparison)
+    {
+        resultType = (left.type != AnyObject::NotSet && left.type == right.type) ? AnyObject::Bool : AnyObject::NotSet;
+    }
+    else if (left.type == AnyObject::Int && right.type == AnyObject::Int)
+    {
+        resultType = AnyObject::Int;
+    }
+    else if (isNumeric(left.type) && isNumeric(right.type) && opCode != OpCode::Modulo)
+    {
+        resultType = AnyObject::Float;
+    }
+    else if (left.type == AnyObject::String && right.type == AnyObject::String && opCode == OpCode::Add)
+    {
+        resultType = AnyObject::String;
+    }
+
+    uint16_t reg = allocateRegister();
+    emit(opCode, reg, left.reg, right.reg);
+
+    return Operand{reg, resultType};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileUnary(const AnyNode &node)
+{
+    Operand operand = compileExpression(*node.child(0));
+
+    uint16_t reg = allocateRegister();
+
+    if (node.isNodeType(NodeType::Not))
+    {
+        emit(OpCode::Not, reg, operand.reg);
+        return Operand{reg, AnyObject::Bool};
+    }
+
+    emit(OpCode::Negate, reg, operand.reg);
+
+    bool isNumeric = (operand.type == AnyObject::Int || operand.type == AnyObject::Float);
+    return Operand{reg, isNumeric ? operand.type : AnyObject::NotSet};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileCast(const AnyNode &node)
+{
+    Operand operand = compileExpression(*node.child(0));
+
+    uint16_t reg = allocateRegister();
+    emit(node.valueType() == AnyObject::Int ? OpCode::CastInt : OpCode::CastFloat, reg, operand.reg);
+
+    return Operand{reg, node.valueType()};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compilePrefix(const AnyNode &node)
+{
+    const auto &expression = node.child(0);
+
+    if (!expression->isNodeType(NodeType::LookupVariable))
+    {
+        unsupported("prefix operator on expression");
+    }
+
+    OpCode opCode = node.isNodeType(NodeType::PrefixIncrement) ? OpCode::Increment : OpCode::Decrement;
+
+    const std::string &name = expression->castNode<LookupVariableNode>().name();
+
+    const Variable *variable = lookupLocal(name);
+    if (!variable && _state->isMain)
+    {
+        variable = lookupGlobal(name);
+    }
+
+    if (variable)
+    {
+        if (variable->isParameter)
+        {
+            unsupported("modification of parameter " + name);
+        }
+
+        emit(opCode, variable->reg);
+        return Operand{variable->reg, variable->type};
+    }
+
+    /* Global accessed from inside a function */
+    checkGlobalAccess(name, true);
+
+    Operand global = compileLookup(expression->castNode<LookupVariableNode>());
+    emit(opCode, global.reg);
+    emit(OpCode::StoreGlobal, lookupGlobal(name)->reg, global.reg);
+
+    return global;
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileFunctionCall(const FunctionCallNode &node)
+{
+    if (lookupLocal(node._funcName) || lookupGlobal(node._funcName))
+    {
+        unsupported("call of variable " + node._funcName);
+    }
+
+    const uint16_t argc = (uint16_t)node._funcArgs.size();
+
+    /* Arguments are passed in consecutive registers which become the callee's parameters */
+    const uint16_t base = _state->nextRegister;
+
+    for (uint16_t i = 0; i < argc; ++i)
+    {
+        uint16_t target = allocateRegister();
+
+        (void)compileExpressionInto(*node._funcArgs[i], target);
+
+        _state->nextRegister = target + 1; /* Release argument temporaries */
+    }
+
+    if (argc == 0)
+    {
+        (void)allocateRegister(); /* Result register */
+    }
+
+    auto iter = _functionIndices.find(node._funcName);
+    if (iter != _functionIndices.end())
+    {
+        const FunctionNode &funcNode = *_functionNodes[iter->second - 1];
+
+        if (funcNode._funcArgs.size() != argc)
+        {
+            unsupported("incorrect number of arguments for " + node._funcName);
+        }
+
+        emit(OpCode::Call, base, iter->second, argc);
+    }
+    else
+    {
+        auto nativeIter = _nativeIndices.find(node._funcName);
+        if (nativeIter == _nativeIndices.end())
+        {
+            nativeIter = _nativeIndices.emplace(node._funcName, (uint16_t)_program->nativeNames.size()).first;
+            _program->nativeNames.push_back(node._funcName);
+        }
+
+        _program->maxNativeArgs = std::max(_program->maxNativeArgs, argc);
+
+        emit(OpCode::CallNative, base, nativeIter->second, argc);
+    }
+
+    _state->nextRegister = base + 1;
+    return Operand{base, AnyObject::NotSet};
+}
+
+
+BytecodeCompiler::Operand BytecodeCompiler::compileAddVariable(const AddVariableNode &node)
+{
+    const AnyObject::Type type = node.variableType();
+
+    Value defaultValue;
+
+    switch (type)
+    {
+        case AnyObject::Int:
+        case AnyObject::Float:
+        case AnyObject::Bool:
+        case AnyObject::String:
+            defaultValue = Value(ObjectFactory::allocate(type));
+            break;
+        default:
+            unsupported("variable of type " + AnyObject::typeToString(type));
+    }
+
+    uint16_t reg;
+
+    if (_state->isMain && _state->scopes.size() == 1)
+    {
+        const Variable *global = lookupGlobal(node.name());
+        if (!global)
+        {
+            unsupported("declaration of " + node.name() + " inside expression");
+        }
+
+        reg = global->reg;
+    }
+    else
+    {
+        VariableMap &scope = _state->scopes.back();
+
+        if (scope.count(node.name()))
+        {
+            unsupported(node.name() + " is already defined in current scope");
+        }
+
+        reg = allocateRegister();
+        _state->liveTop = _state->nextRegister;
+
+        scope[node.name()] = Variable{reg, type};
+    }
+
+    emit(OpCode::LoadConst, reg, addConstant(defaultValue));
+
+    return Operand{reg, type};
+}
+
+
+void BytecodeCompiler::storeVariable(const std::string &name, Operand value)
+{
+    const Variable *variable = lookupLocal(name);
+    bool isGlobal = false;
+
+    if (!variable)
+    {
+        variable = lookupGlobal(name);
+        isGlobal = !_state->isMain;
+    }
+
+    if (!variable)
+    {
+        unsupported("unresolved variable " + name);
+    }
+
+    if (variable->isParameter)
+    {
+        unsupported("assignment to parameter " + name);
+    }
+
+    if (isGlobal)
+    {
+        checkGlobalAccess(name, true);
+    }
+
+    if (value.type != variable->type)
+    {
+        emit(OpCode::CheckType, value.reg, (uint16_t)variable->type);
+    }
+
+    if (isGlobal)
+    {
+        emit(OpCode::StoreGlobal, variable->reg, value.reg);
+    }
+    else if (value.reg != variable->reg)
+    {
+        emit(OpCode::Move, variable->reg, value.reg);
+    }
+}
+
+
+const BytecodeCompiler::Variable *BytecodeCompiler::lookupLocal(const std::string &name) const
+{
+    for (auto iter = _state->scopes.rbegin(); iter != _state->scopes.rend(); ++iter)
+    {
+        auto found = iter->find(name);
+        if (found != iter->end())
+        {
+            return &found->second;
+        }
+    }
+
+    return nullptr;
+}
+
+
+const BytecodeCompiler::Variable *BytecodeCompiler::lookupGlobal(const std::string &name) const
+{
+    auto iter = _globals.find(name);
+
+    return (iter != _globals.end()) ? &iter->second : nullptr;
+}
+
+
+void BytecodeCompiler::checkGlobalAccess(const std::string &name, bool isWrite) const
+{
+    if (_localNames.count(name))
+    {
+        unsupported("global " + name + " may be shadowed by a caller");
+    }
+
+    if (isWrite && _argumentNames.count(name))
+    {
+        unsupported("global " + name + " is modified by a function and passed as an argument");
+    }
+}
+
+
+void BytecodeCompiler::pushScope()
+{
+    _state->scopes.emplace_back();
+    _state->scopeTops.push_back(_state->liveTop);
+}
+
+
+void BytecodeCompiler::popScope()
+{
+    _state->scopes.pop_back();
+
+    _state->liveTop = _state->scopeTops.back();
+    _state->scopeTops.pop_back();
+
+    _state->nextRegister = _state->liveTop;
+}
+
+
+uint16_t BytecodeCompiler::allocateRegister()
+{
+    if (_state->nextRegister >= kMaxRegisters)
+    {
+        unsupported("too many registers");
+    }
+
+    uint16_t reg = _state->nextRegister++;
+
+    BytecodeFunction &function = currentFunction();
+    function.numRegisters = std::max(function.numRegisters, _state->nextRegister);
+
+    return reg;
+}
+
+
+uint16_t BytecodeCompiler::addConstant(Value constant)
+{
+    if (_program->constants.size() >= kMaxRegisters)
+    {
+        unsupported("too many constants");
+    }
+
+    _program->constants.push_back(std::move(constant));
+    return (uint16_t)(_program->constants.size() - 1);
+}
+
+
+size_t BytecodeCompiler::emit(OpCode opCode, uint16_t a, uint16_t b, uint16_t c)
+{
+    auto &code = currentFunction().code;
+
+    if (code.size() >= kMaxRegisters)
+    {
+        unsupported("function " + currentFunction().name + " is too large");
+    }
+
+    code.push_back(Instruction{opCode, a, b, c});
+    return code.size() - 1;
+}
+
+
+void BytecodeCompiler::patchJump(size_t index)
+{
+    Instruction &instruction = currentFunction().code[index];
+
+    if (instruction.opCode == OpCode::Jump)
+        instruction.a = (uint16_t)currentPosition();
+    else
+        instruction.b = (uint16_t)currentPosition();
+}
+
+
+size_t BytecodeCompiler::currentPosition() const
+{
+    return _program->functions[_state->functionIndex].code.size();
+}
+
+
+BytecodeFunction &BytecodeCompiler::currentFunction()
+{
+    return _program->functions[_state->functionIndex];
+}
+
+
+void BytecodeCompiler::unsupported(const std::string &reason) const
+{
+    throw UnsupportedNode{reason};
+}
@@ -0,0 +1,170 @@
+/**
+ * @file BytecodeCompiler.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "Bytecode.hpp"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+/*
+ * Lowers the AST built by FileParser into bytecode for the register VM.
+ *
+ * Supported: int/float/bool/string variables, arithmetic, loops, if/else, break, continue, return, casts, functions defined at
+ * file-level and module functions (i.e. print). Functions may access their own locals and file-level globals.
+ *
+ * Unsupported: arrays, classes, references, nested function definitions and pure functions (which the tree-walker
+ * memoizes). For these compile() returns nullptr and the
+ * caller should use the tree-walker instead.
+ *
+ * Function arguments are copied into the callee's registers. The tree-walker passes arguments by reference and finds
+ * names which are not declared in a function in the scopes of its callers. To give the same results, programs are not
+ * compiled if a function assigns a parameter, accesses a global which is also declared in a block or function, or
+ * modifies a global which is passed as an argument.
+ */
+class BytecodeCompiler
+{
+public:
+    /* Returns nullptr if the AST cannot be compiled */
+    static BytecodeProgram::Ptr compile(const BaseNode::Ptr &ast);
+
+protected:
+    /* Prevent direct initialization */
+    BytecodeCompiler() = default;
+
+    struct Variable
+    {
+        uint16_t reg;
+        AnyObject::Type type;
+        bool isParameter{false};
+    };
+
+    /* Result of compiling an expression */
+    struct Operand
+    {
+        uint16_t reg;
+        AnyObject::Type type; /* NotSet if unknown at compile-time */
+    };
+
+    using VariableMap = std::unordered_map<std::string, Variable>;
+
+    struct LoopLabels
+    {
+        std::vector<size_t> breakJumps;
+        std::vector<size_t> continueJumps; /* Patched to the update (for) or condition (while) */
+    };
+
+    struct FunctionState
+    {
+        uint16_t functionIndex{0};
+        bool isMain{false};
+        std::vector<VariableMap> scopes;
+        std::vector<LoopLabels> loops;
+
+        /* First free register */
+        uint16_t nextRegister{0};
+
+        /* Registers below are held by variables. Temporaries above are released after each statement */
+        uint16_t liveTop{0};
+        std::vector<uint16_t> scopeTops;
+    };
+
+    BytecodeProgram::Ptr compileProgram(const BaseNode::Ptr &ast);
+
+    /* File-level declarations: functions and global variables */
+    void collectDeclarations(const BaseNode &node);
+
+    /* Names declared below file-level and names passed as arguments to functions (see checkGlobalAccess) */
+    void collectNames(const BaseNode &node);
+
+    void compileFunction(const class FunctionNode &node, uint16_t functionIndex);
+
+    void compileStatement(const BaseNode &node);
+    void compileStatements(const BaseNodePtrVector &nodes);
+    void compileBlock(const BaseNodePtrVector &nodes);
+    void compileIf(const AnyNode &node);
+    void compileForLoop(const AnyNode &node);
+    void compileWhileLoop(const AnyNode &node);
+    void compileDoWhileLoop(const AnyNode &node);
+    void compileBreak();
+
+    void compileContinue();
+
+    /* Patches continue jumps to the current position */
+    void patchContinueJumps();
+    void compileReturn(const AnyNode &node);
+    void compileAssign(const AnyNode &node);
+
+    Operand compileExpression(const BaseNode &node);
+    Operand compileExpressionInto(const BaseNode &node, uint16_t target);
+    Operand compileLiteral(const AnyNode &node);
+    Operand compileLookup(const class LookupVariableNode &node);
+    Operand compileBinary(const class BinaryNode &node);
+    Operand compileUnary(const AnyNode &node);
+    Operand compileCast(const AnyNode &node);
+    Operand compilePrefix(const AnyNode &node);
+    Operand compileFunctionCall(const class FunctionCallNode &node);
+    Operand compileAddVariable(const class AddVariableNode &node);
+
+    /* Stores a value in a variable with a type-check if the type cannot be determined at compile-time */
+    void storeVariable(const std::string &name, Operand value);
+
+    /* Returns the variable if declared in a function scope or nullptr */
+    const Variable *lookupLocal(const std::string &name) const;
+
+    /* Returns the variable if declared as a file-level global or nullptr */
+    const Variable *lookupGlobal(const std::string &name) const;
+
+    /* Rejects accesses to a global from a function which the tree-walker may resolve to a different object */
+    void checkGlobalAccess(const std::string &name, bool isWrite) const;
+
+    void pushScope();
+    void popScope();
+
+    uint16_t allocateRegister();
+
+    uint16_t addConstant(Value constant);
+
+    size_t emit(OpCode opCode, uint16_t a = 0, uint16_t b = 0, uint16_t c = 0);
+
+    /* Sets the jump target of an emitted jump to the current position */
+    void patchJump(size_t index);
+
+    size_t currentPosition() const;
+
+    BytecodeFunction &currentFunction();
+
+    /* Throws an exception which compile() turns into nullptr */
+    [[noreturn]] void unsupported(const std::string &reason) const;
+
+private:
+    BytecodeProgram::Ptr _program;
+
+    FunctionState *_state{nullptr};
+
+    /* File-level variables. These live in the registers of the main function */
+    VariableMap _globals;
+    std::unordered_set<const BaseNode *> _globalDeclarations;
+
+    /* Names declared in a block or function (which shadow a global in the functions called from there) */
+    std::unordered_set<std::string> _localNames;
+
+    /* Names of variables passed as arguments to a function (which the callee's parameter refers to) */
+    std::unordered_set<std::string> _argumentNames;
+
+    /* File-level function definitions and their index in the program */
+    std::unordered_map<std::string, uint16_t> _functionIndices;
+    std::vector<const class FunctionNode *> _functionNodes;
+
+    std::unordered_map<std::string, uint16_t> _nativeIndices;
+};
@@ -0,0 +1,515 @@
+/**
+ * @file ConstantFolder.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ConstantFolder.hpp"
+#include "AddVariableNode.hpp"
+#include "AstArena.hpp"
+#include "BinaryNode.hpp"
+#include "ClassDefinitionNode.hpp"
+#include "ClassNode.hpp"
+#include "FunctionNode.hpp"
+#include "LookupVariableNode.hpp"
+#include "NodeFactory.hpp"
+#include "NodeTraversal.hpp"
+#include "Scope.hpp"
+#include "SymbolTable.hpp"
+#include <exception>
+#include <utility>
+
+
+size_t ConstantFolder::fold(AnyNode::Ptr &ast)
+{
+    if (!ast)
+    {
+        return 0;
+    }
+
+    ConstantFolder folder;
+    folder.collectNames(*ast);
+
+    auto folded = std::static_pointer_cast<AnyNode>(folder.foldNode(ast));
+
+    if (folded != ast) /* The previous root owns the arenas of the unchanged nodes */
+    {
+        ast = AstArena::adopt(std::move(folded), std::move(ast));
+    }
+
+    return folder._numRemoved;
+}
+
+
+void ConstantFolder::collectNames(const BaseNode &node)
+{
+    auto markModified = [this](const BaseNode::Ptr &target)
+    {
+        if (target && target->isNodeType(NodeType::LookupVariable))
+            _modifiedNames.insert(target->castNode<LookupVariableNode>().name());
+    };
+
+    switch (node.type())
+    {
+        case NodeType::AddVariable:
+        {
+            const auto &variableNode = node.castNode<AddVariableNode>();
+
+            ++_numDeclarations[variableNode.declaredName()];
+
+            if (dynamic_cast<const AddReferenceVariableNode *>(&variableNode)) /* Bound variable can be modified */
+                _modifiedNames.insert(variableNode.name());
+            break;
+        }
+        case NodeType::Assign:
+            markModified(node.castNode<AnyNode>().child(0));
+            break;
+        case NodeType::PrefixIncrement:
+        case NodeType::PrefixDecrement:
+            markModified(node.castNode<AnyNode>().child(0));
+            break;
+        case NodeType::FunctionCall: /* May be passed by reference */
+            for (const auto &argNode : node.castNode<FunctionCallNode>()._funcArgs)
+                markModified(argNode);
+            break;
+        case NodeType::Function:
+            ++_numDeclarations[node.castNode<FunctionNode>()._funcName];
+            break;
+        case NodeType::ClassDefinition:
+            ++_numDeclarations[node.castNode<ClassDefinitionNode>().className()];
+            break;
+        default:
+            if (auto *instanceNode = dynamic_cast<const ClassNode *>(&node))
+                ++_numDeclarations[instanceNode->instanceName()];
+            break;
+    }
+
+    forEachChild(node, [this](const BaseNode::Ptr &child)
+    {
+        if (child)
+            collectNames(*child);
+    });
+}
+
+
+BaseNode::Ptr ConstantFolder::foldNode(const BaseNode::Ptr &node)
+{
+    if (!node)
+    {
+        return nullptr;
+    }
+
+    switch (node->type())
+    {
+        case NodeType::LookupVariable:
+        {
+            auto iter = _constants.find(node->castNode<LookupVariableNode>().name());
+
+            return (iter != _constants.end()) ? makeLiteral(iter->second) : node;
+        }
+        case NodeType::Binary:
+        {
+            const auto &binaryNode = node->castNode<BinaryNode>();
+
+            auto left = foldNode(binaryNode.left());
+            auto right = foldNode(binaryNode.right());
+
+            const auto binaryOperator = binaryNode.binaryOperator();
+
+            /* Leave integer division by zero for the tree-walker */
+            if ((binaryOperator == BinaryOperatorType::Divide || binaryOperator == BinaryOperatorType::Modulo) &&
+                isLiteral(right) && right->isNodeType(NodeType::Int) && isLiteral(left) && left->isNodeType(NodeType::Int))
+            {
+                Scope emptyScope;
+                if (right->evaluateValue(emptyScope).asInt() == 0)
+                    return (left == binaryNode.left() && right == binaryNode.right()) ? node : AstArena::makeNode<BinaryNode>(left, right, binaryOperator);
+            }
+
+            auto folded = (left == binaryNode.left() && right == binaryNode.right()) ? node : AstArena::makeNode<BinaryNode>(left, right, binaryOperator);
+
+            return evaluateIfLiteral(std::move(folded), {left, right});
+        }
+        case NodeType::Not:
+        case NodeType::Negation:
+        case NodeType::Cast:
+        {
+            const auto &anyNode = node->castNode<AnyNode>();
+
+            auto expression = foldNode(anyNode.child(0));
+            if (expression == anyNode.child(0))
+            {
+                return evaluateIfLiteral(node, {expression});
+            }
+
+            BaseNode::Ptr folded;
+
+            if (node->isNodeType(NodeType::Not))
+                folded = NodeFactory::createNotNode(expression);
+            else if (node->isNodeType(NodeType::Negation))
+                folded = NodeFactory::createNegationNode(expression);
+            else
+                folded = NodeFactory::createCastNode(expression, anyNode.valueType());
+
+            return evaluateIfLiteral(std::move(folded), {expression});
+        }
+        case NodeType::If:
+            return foldIf(node);
+        case NodeType::ForLoop:
+        {
+            const auto &children = node->castNode<AnyNode>().children();
+
+            BaseNodePtrVector folded{foldNode(children[0]), foldNode(children[1]), foldNode(children[2]), foldNode(children[3])};
+
+            if (!childrenChanged(children, folded))
+                return node;
+
+            return NodeFactory::createForLoopNode(folded[0], folded[1], folded[2], folded[3]);
+        }
+        case NodeType::While:
+        case NodeType::DoWhile:
+        {
+            const auto &children = node->castNode<AnyNode>().children();
+
+            auto condition = foldNode(children[0]);
+            auto body = foldNode(children[1]);
+
+            if (node->isNodeType(NodeType::While) && isLiteral(condition))
+            {
+                try
+                {
+                    Scope emptyScope;
+
+                    if (!condition->evaluateValue(emptyScope).toBool()) /* Never runs */
+                    {
+                        _numRemoved += 1 + countNodes(condition.get()) + countNodes(body.get());
+                        return NodeFactory::createBlockNode({});
+                    }
+                }
+                catch (const std::exception &)
+                {
+                }
+            }
+
+            if (condition == children[0] && body == children[1])
+                return node;
+
+            return node->isNodeType(NodeType::While) ? NodeFactory::createWhileLoopNode(condition, body) : NodeFactory::createDoWhileLoopNode(condition, body);
+        }
+        case NodeType::Return:
+        {
+            const auto &anyNode = node->castNode<AnyNode>();
+
+            auto expression = foldNode(anyNode.child(0));
+
+            return (expression == anyNode.child(0)) ? node : NodeFactory::createReturnNode(expression);
+        }
+        case NodeType::Block:
+        case NodeType::File:
+        {
+            bool changed{false};
+
+            const bool isFileLevel = node->isNodeType(NodeType::File);
+
+            auto statements = foldStatements(node->castNode<AnyNode>().children(), isFileLevel, changed);
+
+            if (!changed)
+                return node;
+
+            return isFileLevel ? NodeFactory::createFileNode(std::move(statements)) : NodeFactory::createBlockNode(std::move(statements));
+        }
+        case NodeType::Assign:
+        {
+            const auto &anyNode = node->castNode<AnyNode>();
+
+            /* Only array indices are folded on the left-hand side */
+            auto left = anyNode.child(0)->isNodeType(NodeType::ArrayAccess) ? foldNode(anyNode.child(0)) : anyNode.child(0);
+            auto right = foldNode(anyNode.child(1));
+
+            if (left == anyNode.child(0) && right == anyNode.child(1))
+                return node;
+
+            return NodeFactory::createAssignNode(left, right);
+        }
+        case NodeType::Array:
+        {
+            const auto &children = node->castNode<AnyNode>().children();
+
+            BaseNodePtrVector folded;
+            folded.reserve(children.size());
+
+            for (const auto &child : children)
+                folded.push_back(foldNode(child));
+
+            return childrenChanged(children, folded) ? NodeFactory::createArrayNode(std::move(folded)) : node;
+        }
+        case NodeType::ArrayAccess:
+        {
+            const auto &anyNode = node->castNode<AnyNode>();
+
+            auto index = foldNode(anyNode.child(1));
+
+            return (index == anyNode.child(1)) ? node : NodeFactory::createArrayAccessNode(anyNode.child(0), index);
+        }
+        case NodeType::FunctionCall:
+        {
+            const auto &callNode = node->castNode<FunctionCallNode>();
+
+            BaseNodePtrVector args;
+            args.reserve(callNode._funcArgs.size());
+
+            for (const auto &argNode : callNode._funcArgs)
+                args.push_back(foldNode(argNode));
+
+            return childrenChanged(callNode._funcArgs, args) ? AstArena::makeNode<FunctionCallNode>(callNode._funcName, std::move(args)) : node;
+        }
+        case NodeType::Function:
+        {
+            const auto &functionNode = node->castNode<FunctionNode>();
+
+            auto body = foldNode(functionNode.funcBody);
+
+            return (body == functionNode.funcBody) ? node : AstArena::makeNode<FunctionNode>(functionNode._funcName, functionNode._funcArgs, body, functionNode.isPure());
+        }
+        case NodeType::ClassDefinition:
+        {
+            const auto &classNode = node->castNode<ClassDefinitionNode>();
+
+            bool changed{false};
+
+            std::vector<FunctionNode::Ptr> methods;
+            methods.reserve(classNode.methods().size());
+
+            for (const auto &method : classNode.methods())
+            {
+                methods.push_back(std::static_pointer_cast<FunctionNode>(foldNode(method)));
+                changed |= (methods.back() != method);
+            }
+
+            if (!changed)
+                return node;
+
+            return AstArena::makeNode<ClassDefinitionNode>(classNode.className(), classNode.parentClassName(), classNode.variables(), std::move(methods));
+        }
+        case NodeType::ClassMethodCall:
+        {
+            const auto &anyNode = node->castNode<AnyNode>();
+
+            auto methodCall = foldNode(anyNode.child(0));
+
+            if (methodCall == anyNode.child(0))
+                return node;
+
+            return NodeFactory::createClassMethodCallNode(SymbolTable::instance().name(anyNode.symbol(0)), std::static_pointer_cast<FunctionCallNode>(methodCall));
+        }
+        default: /* Literals, declarations, etc. */
+            return node;
+    }
+}
+
+
+BaseNodePtrVector ConstantFolder::foldStatements(const BaseNodePtrVector &nodes, bool isFileLevel, bool &changed)
+{
+    BaseNodePtrVector folded;
+    folded.reserve(nodes.size());
+
+    for (const auto &node : nodes)
+    {
+        auto foldedNode = foldNode(node);
+
+        changed |= (foldedNode != node);
+
+        if (isEmptyBlock(foldedNode)) /* Does nothing */
+        {
+            ++_numRemoved;
+            changed = true;
+            continue;
+        }
+
+        if (isFileLevel)
+        {
+            addConstant(*foldedNode);
+        }
+
+        folded.push_back(std::move(foldedNode));
+    }
+
+    return folded;
+}
+
+
+BaseNode::Ptr ConstantFolder::foldIf(const BaseNode::Ptr &node)
+{
+    const auto &ifNode = node->castNode<AnyNode>();
+
+    auto condition = foldNode(ifNode.child(0));
+    auto thenBranch = foldNode(ifNode.child(1));
+    auto elseBranch = foldNode(ifNode.child(2));
+
+    if (isLiteral(condition))
+    {
+        try
+        {
+            Scope emptyScope;
+
+            const bool isTrue = condition->evaluateValue(emptyScope).toBool();
+
+            auto taken = isTrue ? thenBranch : elseBranch;
+            auto skipped = isTrue ? elseBranch : thenBranch;
+
+            _numRemoved += 1 + countNodes(condition.get()) + countNodes(skipped.get());
+
+            if (!taken)
+            {
+                --_numRemoved; /* Replaced by an empty block */
+                return NodeFactory::createBlockNode({});
+            }
+
+            return taken;
+        }
+        catch (const std::exception &)
+        {
+        }
+    }
+
+    if (condition == ifNode.child(0) && thenBranch == ifNode.child(1) && elseBranch == ifNode.child(2))
+    {
+        return node;
+    }
+
+    return NodeFactory::createIfNode(condition, thenBranch, elseBranch);
+}
+
+
+BaseNode::Ptr ConstantFolder::evaluateIfLiteral(BaseNode::Ptr node, const BaseNodePtrVector &operands)
+{
+    for (const auto &operand : operands)
+    {
+        if (!isLiteral(operand))
+            return node;
+    }
+
+    try
+    {
+        Scope emptyScope;
+
+        auto literal = makeLiteral(node->evaluateValue(emptyScope));
+        if (!literal)
+        {
+            return node;
+        }
+
+        _numRemoved += countNodes(node.get()) - 1;
+        return literal;
+    }
+    catch (const std::exception &) /* Report at runtime */
+    {
+        return node;
+    }
+}
+
+
+void ConstantFolder::addConstant(const BaseNode &statement)
+{
+    if (!statement.isNodeType(NodeType::Assign))
+    {
+        return;
+    }
+
+    const auto &left = statement.castNode<AnyNode>().child(0);
+    const auto &right = statement.castNode<AnyNode>().child(1);
+
+    if (!left->isNodeType(NodeType::AddVariable) || dynamic_cast<const AddReferenceVariableNode *>(left.get()) || !isLiteral(right))
+    {
+        return;
+    }
+
+    const auto &variableNode = left->castNode<AddVariableNode>();
+    const auto valueType = right->castNode<AnyNode>().valueType();
+
+    /* Assignments which convert the value are not propagated. Strings are not immediates */
+    if (valueType != variableNode.variableType() || valueType == AnyObject::String)
+    {
+        return;
+    }
+
+    const std::string &name = variableNode.name();
+
+    if (_numDeclarations[name] != 1 || _modifiedNames.count(name))
+    {
+        return;
+    }
+
+    Scope emptyScope;
+    _constants.emplace(name, right->evaluateValue(emptyScope));
+}
+
+
+bool ConstantFolder::childrenChanged(const BaseNodePtrVector &children, const BaseNodePtrVector &foldedChildren)
+{
+    return (children != foldedChildren);
+}
+
+
+bool ConstantFolder::isLiteral(const BaseNode::Ptr &node)
+{
+    if (!node)
+    {
+        return false;
+    }
+
+    switch (node->type())
+    {
+        case NodeType::Int:
+        case NodeType::Float:
+        case NodeType::Bool:
+        case NodeType::String:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+bool ConstantFolder::isEmptyBlock(const BaseNode::Ptr &node)
+{
+    return (node && node->isNodeType(NodeType::Block) && node->castNode<AnyNode>().children().empty());
+}
+
+
+BaseNode::Ptr ConstantFolder::makeLiteral(const Value &value)
+{
+    switch (value.type())
+    {
+        case AnyObject::Int:
+            return NodeFactory::createIntNode(value.asInt());
+        case AnyObject::Float:
+            return NodeFactory::createFloatNode(value.asFloat());
+        case AnyObject::Bool:
+            return NodeFactory::createBoolNode(value.asBool());
+        case AnyObject::String:
+            return NodeFactory::createStringNode(std::as_const(value.object()).getValue<std::string>());
+        default:
+            return nullptr;
+    }
+}
+
+
+size_t ConstantFolder::countNodes(const BaseNode *node)
+{
+    if (!node)
+    {
+        return 0;
+    }
+
+    size_t count = 1;
+
+    forEachChild(*node, [&count](const BaseNode::Ptr &child)
+    {
+        count += countNodes(child.get());
+    });
+
+    return count;
+}
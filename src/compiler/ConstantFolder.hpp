@@ -0,0 +1,80 @@
+/**
+ * @file ConstantFolder.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "Value.hpp"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+
+/*
+ * Optimization pass run after parsing (before the VariableResolver).
+ *
+ * 1. Folding: Binary, Not, Negation and Cast nodes with literal operands are evaluated once and replaced by a literal.
+ *    If nodes with a literal condition are replaced by the branch taken and while loops which never run are removed.
+ *    Expressions which throw (or divide an int by zero) are left for the tree-walker to report at runtime.
+ *
+ * 2. Propagation: a file-level int, float or bool variable declared with a literal (after folding) is replaced by its
+ *    value in the statements that follow. Since functions are dynamically scoped this is only done for names which are
+ *    declared once in the entire program and are never assigned, incremented, bound to a reference or passed to a
+ *    function (which may take the argument by reference).
+ *
+ * Nodes are immutable (children are captured by the evaluate functions) so any node with a folded child is rebuilt.
+ */
+class ConstantFolder
+{
+public:
+    /* Returns the number of nodes removed */
+    static size_t fold(AnyNode::Ptr &ast);
+
+protected:
+    /* Prevent direct initialization */
+    ConstantFolder() = default;
+
+    /* Counts declarations and modifications of each name */
+    void collectNames(const BaseNode &node);
+
+    /* Returns the folded node (or the same node if nothing changed) */
+    BaseNode::Ptr foldNode(const BaseNode::Ptr &node);
+
+    /* Folds a sequence of statements removing any which do nothing */
+    BaseNodePtrVector foldStatements(const BaseNodePtrVector &nodes, bool isFileLevel, bool &changed);
+
+    BaseNode::Ptr foldIf(const BaseNode::Ptr &node);
+
+    /* Returns a literal if the node has literal operands and can be evaluated, otherwise the node */
+    BaseNode::Ptr evaluateIfLiteral(BaseNode::Ptr node, const BaseNodePtrVector &operands);
+
+    /* Records the value of a file-level variable declared with a literal */
+    void addConstant(const BaseNode &statement);
+
+    /* Returns true if the node's children were folded */
+    static bool childrenChanged(const BaseNodePtrVector &children, const BaseNodePtrVector &foldedChildren);
+
+    static bool isLiteral(const BaseNode::Ptr &node);
+
+    static bool isEmptyBlock(const BaseNode::Ptr &node);
+
+    /* Returns a literal node for an Int, Float, Bool or String value or nullptr */
+    static BaseNode::Ptr makeLiteral(const Value &value);
+
+    static size_t countNodes(const BaseNode *node);
+
+private:
+    std::unordered_map<std::string, int> _numDeclarations;
+    std::unordered_set<std::string> _modifiedNames;
+
+    /* File-level variables declared so far which are never modified */
+    std::unordered_map<std::string, Value> _constants;
+
+    size_t _numRemoved{0};
+};
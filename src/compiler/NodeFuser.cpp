@@ -0,0 +1,398 @@
+/**
+ * @file NodeFuser.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "NodeFuser.hpp"
+#include "Exceptions.hpp"
+#include "Logger.hpp"
+#include "LookupVariableNode.hpp"
+#include "NodeFactory.hpp"
+#include "NodeTraversal.hpp"
+#include "Scope.hpp"
+#include "Stringify.hpp"
+#include "Value.hpp"
+
+namespace
+{
+
+/* Variable or Int literal */
+struct IntOperand
+{
+    const LookupVariableNode *variable{nullptr}; /* Literal if nullptr */
+    long constant{0};
+
+    /* Returns false if the variable is not an Int */
+    bool evaluate(const Scope &scope, long &result) const
+    {
+        if (!variable)
+        {
+            result = constant;
+            return true;
+        }
+
+        const AnyObject &object = *variable->lookupObject(scope);
+        if (!object.isType(AnyObject::Int))
+        {
+            return false;
+        }
+
+        result = object.getValue<long>();
+        return true;
+    }
+};
+
+
+/* Condition comparing Int operands. Other types are evaluated by the condition node */
+struct FusedComparison
+{
+    IntOperand left;
+    IntOperand right;
+    BinaryOperatorType binaryOperator{BinaryOperatorType::Unknown};
+    BaseNode::Ptr condition{nullptr};
+
+    bool operator()(Scope &scope) const
+    {
+        long leftValue, rightValue;
+
+        if (left.evaluate(scope, leftValue) && right.evaluate(scope, rightValue))
+        {
+            switch (binaryOperator)
+            {
+                case BinaryOperatorType::Equal:
+                    return (leftValue == rightValue);
+                case BinaryOperatorType::NotEqual:
+                    return (leftValue != rightValue);
+                case BinaryOperatorType::GreaterOrEqual:
+                    return (leftValue >= rightValue);
+                case BinaryOperatorType::Greater:
+                    return (leftValue > rightValue);
+                case BinaryOperatorType::LessOrEqual:
+                    return (leftValue <= rightValue);
+                case BinaryOperatorType::Less:
+                    return (leftValue < rightValue);
+                default:
+                    break;
+            }
+        }
+
+        return condition->evaluateValue(scope).toBool();
+    }
+};
+
+
+bool isComparison(BinaryOperatorType binaryOperator)
+{
+    switch (binaryOperator)
+    {
+        case BinaryOperatorType::Equal:
+        case BinaryOperatorType::NotEqual:
+        case BinaryOperatorType::GreaterOrEqual:
+        case BinaryOperatorType::Greater:
+        case BinaryOperatorType::LessOrEqual:
+        case BinaryOperatorType::Less:
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+const LookupVariableNode *asVariable(const BaseNode::Ptr &node)
+{
+    return (node && node->isNodeType(NodeType::LookupVariable)) ? &node->castNode<LookupVariableNode>() : nullptr;
+}
+
+
+/* Returns the value of a literal or None */
+Value literalValue(const BaseNode::Ptr &node)
+{
+    if (!node || !(node->isNodeType(NodeType::Int) || node->isNodeType(NodeType::Float)))
+    {
+        return Value();
+    }
+
+    Scope emptyScope;
+    return node->evaluateValue(emptyScope);
+}
+
+
+bool toIntOperand(const BaseNode::Ptr &node, IntOperand &operand)
+{
+    if (auto *variable = asVariable(node))
+    {
+        operand.variable = variable;
+        return true;
+    }
+
+    Value literal = literalValue(node);
+
+    if (literal.isSmallInt())
+    {
+        operand.constant = literal.asInt();
+        return true;
+    }
+
+    return false;
+}
+
+
+/* Returns true if the condition is a comparison of Int operands */
+bool toFusedComparison(const BaseNode::Ptr &condition, FusedComparison &comparison)
+{
+    if (!condition || !condition->isNodeType(NodeType::Binary))
+    {
+        return false;
+    }
+
+    const auto &binaryNode = condition->castNode<BinaryNode>();
+
+    comparison.binaryOperator = binaryNode.binaryOperator();
+    comparison.condition = condition;
+
+    return isComparison(comparison.binaryOperator) &&
+           toIntOperand(binaryNode.left(), comparison.left) &&
+           toIntOperand(binaryNode.right(), comparison.right);
+}
+
+
+template <class TValue>
+void applyInPlace(TValue &value, TValue constant, BinaryOperatorType binaryOperator)
+{
+    switch (binaryOperator)
+    {
+        case BinaryOperatorType::Add:
+            value += constant;
+            break;
+        case BinaryOperatorType::Minus:
+            value -= constant;
+            break;
+        default:
+            value *= constant;
+            break;
+    }
+}
+
+
+template <int Delta>
+auto incrementFunction(const LookupVariableNode *variable, const char *errorMessage)
+{
+    return [variable, errorMessage](Scope &scope)
+    {
+        AnyObject &object = *variable->lookupObject(scope);
+
+        if (object.isType(AnyObject::Int))
+            object.getValue<long>() += Delta;
+        else if (object.isType(AnyObject::Float))
+            object.getValue<double>() += Delta;
+        else
+            ThrowException(errorMessage);
+
+        return AnyObject::Ptr();
+    };
+}
+
+} // namespace
+
+
+size_t NodeFuser::fuse(const BaseNode::Ptr &ast)
+{
+    NodeFuser fuser;
+    fuser.visit(ast, true);
+
+    log().debug(eucleia::stringify("fused %zu nodes", fuser._numFused));
+    return fuser._numFused;
+}
+
+
+void NodeFuser::visit(const BaseNode::Ptr &node, bool isStatement)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    switch (node->type())
+    {
+        case NodeType::Binary:
+            fuseBinary(node->castNode<BinaryNode>());
+            break;
+        case NodeType::If:
+        case NodeType::ForLoop:
+        case NodeType::While:
+        case NodeType::DoWhile:
+            fuseBranch(node->castNode<AnyNode>());
+            break;
+        case NodeType::Assign:
+            fuseAssign(node->castNode<AnyNode>());
+            break;
+        case NodeType::PrefixIncrement:
+        case NodeType::PrefixDecrement:
+            if (isStatement)
+                fuseIncrement(node->castNode<AnyNode>());
+            break;
+        default:
+            break;
+    }
+
+    switch (node->type())
+    {
+        case NodeType::Block:
+        case NodeType::File:
+            for (const auto &child : node->castNode<AnyNode>().children())
+                visit(child, true);
+            break;
+        case NodeType::ForLoop: /* init, condition, update, body */
+        {
+            const auto &children = node->castNode<AnyNode>().children();
+
+            visit(children[0], true);
+            visit(children[1], false);
+            visit(children[2], true);
+            visit(children[3], true);
+            break;
+        }
+        case NodeType::While:
+        case NodeType::DoWhile:
+            visit(node->castNode<AnyNode>().child(0), false);
+            visit(node->castNode<AnyNode>().child(1), true);
+            break;
+        default:
+            forEachChild(*node, [this](const BaseNode::Ptr &child)
+            {
+                visit(child, false);
+            });
+            break;
+    }
+}
+
+
+void NodeFuser::fuseBinary(BinaryNode &node)
+{
+    const LookupVariableNode *variable = asVariable(node.left());
+    Value literal = literalValue(node.right());
+
+    if (!variable || !literal.isSmallInt() || node.isFused())
+    {
+        return;
+    }
+
+    node.fuseVariableWithConstant(variable, literal.asInt());
+    ++_numFused;
+}
+
+
+void NodeFuser::fuseBranch(AnyNode &node)
+{
+    const auto &children = node.children();
+
+    FusedComparison condition;
+
+    switch (node.type())
+    {
+        case NodeType::If:
+            if (!toFusedComparison(children[0], condition))
+                return;
+
+            node.specialize(NodeFactory::ifFunction(std::move(condition), children[1], children[2]));
+            break;
+        case NodeType::ForLoop:
+            if (!toFusedComparison(children[1], condition))
+                return;
+
+            node.specialize(NodeFactory::forLoopFunction(children[0], std::move(condition), children[2], children[3], node.scopeLayout()));
+            break;
+        case NodeType::While:
+            if (!toFusedComparison(children[0], condition))
+                return;
+
+            node.specialize(NodeFactory::whileLoopFunction(std::move(condition), children[1], node.scopeLayout()));
+            break;
+        case NodeType::DoWhile:
+            if (!toFusedComparison(children[0], condition))
+                return;
+
+            node.specialize(NodeFactory::doWhileLoopFunction(std::move(condition), children[1], node.scopeLayout()));
+            break;
+        default:
+            return;
+    }
+
+    ++_numFused;
+}
+
+
+void NodeFuser::fuseAssign(AnyNode &node)
+{
+    const LookupVariableNode *variable = asVariable(node.child(0));
+
+    const BaseNode::Ptr &right = node.child(1);
+
+    if (!variable || !right->isNodeType(NodeType::Binary))
+    {
+        return;
+    }
+
+    const auto &binaryNode = right->castNode<BinaryNode>();
+
+    const BinaryOperatorType binaryOperator = binaryNode.binaryOperator();
+
+    if (binaryOperator != BinaryOperatorType::Add &&
+        binaryOperator != BinaryOperatorType::Minus &&
+        binaryOperator != BinaryOperatorType::Multiply)
+    {
+        return;
+    }
+
+    /* Lookups of the same name in a statement resolve to the same variable */
+    const LookupVariableNode *operand = asVariable(binaryNode.left());
+    if (!operand || operand->name() != variable->name())
+    {
+        return;
+    }
+
+    Value constant = literalValue(binaryNode.right());
+
+    if (!constant.isSmallInt() && !constant.isFloat())
+    {
+        return;
+    }
+
+    node.specialize([variable, right, binaryOperator, constant = std::move(constant)](Scope &scope)
+    {
+        AnyObject &object = *variable->lookupObject(scope);
+
+        if (object.isType(AnyObject::Int) && constant.isSmallInt())
+            applyInPlace(object.getValue<long>(), constant.asInt(), binaryOperator);
+        else if (object.isType(AnyObject::Float) && constant.isFloat())
+            applyInPlace(object.getValue<double>(), constant.asFloat(), binaryOperator);
+        else
+            object.assign(right->evaluateValue(scope)); /* i.e. implicit casts */
+
+        return AnyObject::Ptr();
+    });
+
+    ++_numFused;
+}
+
+
+void NodeFuser::fuseIncrement(AnyNode &node)
+{
+    const LookupVariableNode *variable = asVariable(node.child(0));
+
+    if (!variable)
+    {
+        return;
+    }
+
+    if (node.isNodeType(NodeType::PrefixIncrement))
+        node.specialize(incrementFunction<1>(variable, "cannot use prefix operator on object of type"));
+    else
+        node.specialize(incrementFunction<-1>(variable, "cannot use prefix operator on object of type."));
+
+    ++_numFused;
+}
@@ -0,0 +1,51 @@
+/**
+ * @file NodeFuser.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "BinaryNode.hpp"
+
+
+/*
+ * Superinstructions for the tree-walker. Run after the VariableResolver. The most common shapes are specialized in
+ * place so that they are evaluated without calling their operand nodes or creating intermediate values:
+ *
+ * 1. variable <op> Int literal (i.e. n - 1, i < n) is evaluated directly by the BinaryNode.
+ * 2. If and loop conditions comparing Int variables and literals (i.e. i < n, a == b) are inlined in the branch.
+ * 3. x = x + k, x = x - k and x = x * k for an Int or Float literal k update the variable in place.
+ * 4. ++i and --i statements update the variable without returning it.
+ *
+ * Nodes keep their type and children so the AST is unchanged for the BytecodeCompiler. Fused nodes fall back to the
+ * original evaluation if the variables do not have the expected types.
+ */
+class NodeFuser
+{
+public:
+    /* Returns the number of nodes fused */
+    static size_t fuse(const BaseNode::Ptr &ast);
+
+protected:
+    /* Prevent direct initialization */
+    NodeFuser() = default;
+
+    /* Statements are nodes whose result is discarded */
+    void visit(const BaseNode::Ptr &node, bool isStatement);
+
+    void fuseBinary(BinaryNode &node);
+
+    void fuseBranch(AnyNode &node);
+
+    void fuseAssign(AnyNode &node);
+
+    void fuseIncrement(AnyNode &node);
+
+private:
+    size_t _numFused{0};
+};
@@ -0,0 +1,54 @@
+/**
+ * @file NodeTraversal.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "BinaryNode.hpp"
+#include "ClassDefinitionNode.hpp"
+#include "FunctionCallNode.hpp"
+#include "FunctionNode.hpp"
+
+
+/* Calls func for each child of a node (optional children may be nullptr) */
+template <class TFunc>
+inline void forEachChild(const BaseNode &node, TFunc &&func)
+{
+    switch (node.type())
+    {
+        case NodeType::Binary:
+            func(node.castNode<BinaryNode>().left());
+            func(node.castNode<BinaryNode>().right());
+            break;
+        case NodeType::FunctionCall:
+            for (const auto &argNode : node.castNode<FunctionCallNode>()._funcArgs)
+                func(argNode);
+            break;
+        case NodeType::Function:
+            for (const auto &argNode : node.castNode<FunctionNode>()._funcArgs)
+                func(argNode);
+
+            func(node.castNode<FunctionNode>().funcBody);
+            break;
+        case NodeType::ClassDefinition:
+            for (const auto &variable : node.castNode<ClassDefinitionNode>().variables())
+                func(variable);
+
+            for (const auto &method : node.castNode<ClassDefinitionNode>().methods())
+                func(method);
+            break;
+        default:
+            if (auto *anyNode = dynamic_cast<const AnyNode *>(&node))
+            {
+                for (const auto &child : anyNode->children())
+                    func(child);
+            }
+            break;
+    }
+}
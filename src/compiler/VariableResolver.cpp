@@ -0,0 +1,484 @@
+/**
+ * @file VariableResolver.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "VariableResolver.hpp"
+#include "BinaryNode.hpp"
+#include "ClassDefinitionNode.hpp"
+#include "ClassNode.hpp"
+#include "Exceptions.hpp"
+#include "ModuleNodeFactory.hpp"
+#include "NodeTraversal.hpp"
+#include <cassert>
+
+
+void VariableResolver::resolve(const BaseNode::Ptr &ast)
+{
+    if (!ast)
+    {
+        return;
+    }
+
+    VariableResolver resolver;
+    resolver.collectNames(*ast);
+
+    /* The entry-point file's layout is adopted by the global scope */
+    auto *fileNode = ast->isNodeType(NodeType::File) ? static_cast<AnyNode *>(ast.get()) : nullptr;
+
+    resolver.pushScope(fileNode ? fileNode->scopeLayout() : nullptr);
+
+    if (fileNode)
+        resolver.visitChildren(*fileNode);
+    else
+        resolver.visit(ast);
+
+    resolver.popScope();
+}
+
+
+void VariableResolver::collectNames(const BaseNode &node)
+{
+    if (node.isNodeType(NodeType::FunctionCall))
+    {
+        _calledNames.insert(node.castNode<FunctionCallNode>()._funcName);
+    }
+    else if (node.isNodeType(NodeType::Function))
+    {
+        auto &functionNode = node.castNode<FunctionNode>();
+        auto &definitions = _functionDefinitions[functionNode._funcName];
+
+        ++definitions.count;
+
+        if (functionNode.isPure())
+            ++definitions.numPure;
+    }
+
+    forEachChild(node, [this](const BaseNode::Ptr &child)
+    {
+        if (child)
+            collectNames(*child);
+    });
+}
+
+
+void VariableResolver::visit(const BaseNode::Ptr &node)
+{
+    if (!node)
+    {
+        return;
+    }
+
+    switch (node->type())
+    {
+        case NodeType::LookupVariable:
+            resolveLookup(node->castNode<LookupVariableNode>());
+            break;
+        case NodeType::AddVariable:
+        {
+            auto &variableNode = node->castNode<AddVariableNode>();
+
+            if (dynamic_cast<AddReferenceVariableNode *>(&variableNode)) /* Lookup the bound variable first */
+            {
+                accessModified(variableNode.name());
+                resolveLookup(variableNode);
+            }
+
+            declareVariable(variableNode);
+            break;
+        }
+        case NodeType::Binary:
+        {
+            auto &binaryNode = node->castNode<BinaryNode>();
+            visit(binaryNode.left());
+            visit(binaryNode.right());
+            break;
+        }
+        case NodeType::FunctionCall: /* Arguments are evaluated in the caller's scope */
+        {
+            auto &callNode = node->castNode<FunctionCallNode>();
+
+            if (!_functions.empty())
+            {
+                _functions.back().calledNames.push_back(callNode._funcName);
+            }
+
+            for (const auto &argNode : callNode._funcArgs)
+            {
+                visit(argNode);
+            }
+            break;
+        }
+        case NodeType::Function:
+        {
+            auto &functionNode = node->castNode<FunctionNode>();
+            declareNamed(functionNode._funcName);
+            visitFunction(functionNode);
+            break;
+        }
+        case NodeType::ClassDefinition:
+        {
+            /* Variables are evaluated in the instance scope so are not resolved */
+            auto &classNode = node->castNode<ClassDefinitionNode>();
+            declareNamed(classNode.className());
+
+            for (const auto &methodNode : classNode.methods())
+            {
+                visitFunction(*methodNode);
+            }
+            break;
+        }
+        case NodeType::Return:
+        {
+            auto &returnNode = node->castNode<AnyNode>();
+            auto &returnedNode = returnNode.child(0);
+
+            if (returnedNode && returnedNode->isNodeType(NodeType::FunctionCall) && !_functions.empty())
+            {
+                _functions.back().returnedCalls.push_back(&returnedNode->castNode<FunctionCallNode>());
+            }
+
+            visitChildren(returnNode);
+            break;
+        }
+        case NodeType::ClassMethodCall: /* Instance lookup and arguments are evaluated in the caller's scope */
+        {
+            auto &methodCallNode = node->castNode<AnyNode>();
+
+            if (!_functions.empty())
+            {
+                _functions.back().callsMethod = true;
+            }
+
+            visit(methodCallNode.child(1));
+
+            for (const auto &argNode : methodCallNode.child(0)->castNode<FunctionCallNode>()._funcArgs)
+            {
+                visit(argNode);
+            }
+            break;
+        }
+        case NodeType::Assign:
+        case NodeType::PrefixIncrement:
+        case NodeType::PrefixDecrement:
+        {
+            auto &modifyNode = node->castNode<AnyNode>();
+            auto &targetNode = modifyNode.child(0);
+
+            if (targetNode->isNodeType(NodeType::LookupVariable))
+            {
+                accessModified(targetNode->castNode<LookupVariableNode>().name());
+            }
+
+            visitChildren(modifyNode);
+            break;
+        }
+        case NodeType::StructAccess: /* Instance lookup */
+            visitChildren(node->castNode<AnyNode>());
+            break;
+        case NodeType::Block:
+        {
+            auto &blockNode = node->castNode<AnyNode>();
+
+            pushScope(blockNode.scopeLayout());
+            visitChildren(blockNode);
+            popScope();
+            break;
+        }
+        case NodeType::ForLoop:
+        case NodeType::While:
+        case NodeType::DoWhile:
+            visitLoop(node->castNode<AnyNode>());
+            break;
+        case NodeType::Unknown:
+            if (auto *classNode = dynamic_cast<ClassNode *>(node.get()))
+            {
+                declareInstance(*classNode);
+                break;
+            }
+            [[fallthrough]];
+        case NodeType::Module: /* Function names are not known */
+        case NodeType::Program:
+            _scopes.back().opaque = true;
+            break;
+        default: /* Imported files are evaluated in the same scope */
+        {
+            auto *anyNode = dynamic_cast<AnyNode *>(node.get());
+
+            if (anyNode)
+                visitChildren(*anyNode);
+            else
+                _scopes.back().opaque = true;
+            break;
+        }
+    }
+}
+
+
+void VariableResolver::visitChildren(const AnyNode &node)
+{
+    for (const auto &childNode : node.children())
+    {
+        visit(childNode);
+    }
+}
+
+
+void VariableResolver::visitInNewScope(const BaseNode::Ptr &node, ScopeLayout *layout)
+{
+    pushScope(layout);
+    visit(node);
+    popScope();
+}
+
+
+void VariableResolver::visitLoop(const AnyNode &node)
+{
+    switch (node.type())
+    {
+        case NodeType::ForLoop: /* init, condition, update and body share the loop scope */
+            pushScope(node.scopeLayout());
+            visitChildren(node);
+            popScope();
+            break;
+        case NodeType::While: /* Condition is evaluated in the outer scope */
+            visit(node.child(0));
+            visitInNewScope(node.child(1), node.scopeLayout());
+            break;
+        case NodeType::DoWhile:
+            visitInNewScope(node.child(1), node.scopeLayout());
+            visit(node.child(0));
+            break;
+        default:
+            assert(false);
+            break;
+    }
+}
+
+
+void VariableResolver::visitFunction(FunctionNode &node)
+{
+    _functions.emplace_back();
+    pushScope(node.funcScopeLayout.get(), true);
+
+    for (const auto &argNode : node._funcArgs)
+    {
+        assert(argNode->isNodeType(NodeType::AddVariable));
+        declareVariable(argNode->castNode<AddVariableNode>());
+    }
+
+    visit(node.funcBody);
+    popScope();
+
+    if (node.isPure())
+    {
+        checkPure(node, _functions.back());
+    }
+
+    markTailCalls(node, _functions.back());
+    _functions.pop_back();
+}
+
+
+void VariableResolver::checkPure(const FunctionNode &node, const StaticFunction &function) const
+{
+    auto fail = [&node](const std::string &reason)
+    {
+        ThrowException("pure function '" + node._funcName + "' " + reason);
+    };
+
+    if (function.opaque)
+    {
+        fail("imports a module");
+    }
+
+    if (!function.outerName.empty())
+    {
+        fail("accesses variable '" + function.outerName + "' outside of its scope");
+    }
+
+    if (!function.modifiedParameter.empty())
+    {
+        fail("modifies argument '" + function.modifiedParameter + "'");
+    }
+
+    if (function.callsMethod)
+    {
+        fail("calls a class method");
+    }
+
+    /* Functions are found by name at runtime so a name must refer to a single pure function */
+    for (const auto &calledName : function.calledNames)
+    {
+        auto iter = _functionDefinitions.find(calledName);
+
+        bool isPure = (iter != _functionDefinitions.end()) ? (iter->second.count == 1 && iter->second.numPure == 1)
+                                                           : NodeFactory::isPureModuleFunction(calledName);
+        if (!isPure)
+        {
+            fail("calls function '" + calledName + "' which is not pure");
+        }
+    }
+}
+
+
+void VariableResolver::markTailCalls(FunctionNode &node, const StaticFunction &function)
+{
+    if (function.numDeclarations > node._funcArgs.size() || function.opaque)
+    {
+        return;
+    }
+
+    for (auto *callNode : function.returnedCalls)
+    {
+        if (callNode->_funcName == node._funcName) /* Checked at runtime */
+        {
+            callNode->setTailCallOf(&node);
+        }
+    }
+}
+
+
+void VariableResolver::resolveLookup(LookupVariableNode &node)
+{
+    uint32_t depth = 0;
+
+    const int *declaration = findDeclaration(node.name(), depth);
+
+    if (!declaration)
+    {
+        accessNamed(node.name());
+    }
+    else if (*declaration != kNamedDeclaration)
+    {
+        node.resolve(depth, (uint32_t)(*declaration));
+    }
+}
+
+
+const int *VariableResolver::findDeclaration(const std::string &name, uint32_t &depth) const
+{
+    depth = 0;
+
+    for (auto iter = _scopes.rbegin(); iter != _scopes.rend(); ++iter, ++depth)
+    {
+        auto declaration = iter->declarations.find(name);
+        if (declaration != iter->declarations.end())
+        {
+            return &(declaration->second);
+        }
+
+        if (iter->opaque || iter->isFunction)
+        {
+            break;
+        }
+    }
+
+    return nullptr;
+}
+
+
+void VariableResolver::accessNamed(const std::string &name)
+{
+    uint32_t depth;
+
+    if (!_functions.empty() && _functions.back().outerName.empty() && !findDeclaration(name, depth))
+    {
+        _functions.back().outerName = name;
+    }
+}
+
+
+void VariableResolver::accessModified(const std::string &name)
+{
+    if (_functions.empty() || !_functions.back().modifiedParameter.empty())
+    {
+        return;
+    }
+
+    uint32_t depth;
+
+    if (findDeclaration(name, depth) && _scopes[_scopes.size() - 1 - depth].isFunction)
+    {
+        _functions.back().modifiedParameter = name;
+    }
+}
+
+
+void VariableResolver::declareVariable(AddVariableNode &node)
+{
+    auto &scope = _scopes.back();
+
+    if (!scope.layout)
+    {
+        declareNamed(node.declaredName());
+        return;
+    }
+
+    uint32_t slot = scope.layout->addSlot(node.declaredName());
+
+    node.resolveDeclaration(slot);
+
+    if (!_functions.empty())
+        ++_functions.back().numDeclarations;
+
+    if (_calledNames.count(node.declaredName()))
+        node.setShadowsCall();
+    scope.declarations[node.declaredName()] = (int)slot;
+}
+
+
+void VariableResolver::declareInstance(ClassNode &node)
+{
+    auto &scope = _scopes.back();
+
+    /* Instances shadowing a called function are found by name so that cached functions are invalidated */
+    if (!scope.layout || _calledNames.count(node.instanceName()))
+    {
+        declareNamed(node.instanceName());
+        return;
+    }
+
+    uint32_t slot = scope.layout->addSlot(node.instanceName());
+
+    node.resolveDeclaration(slot);
+
+    if (!_functions.empty())
+        ++_functions.back().numDeclarations;
+
+    scope.declarations[node.instanceName()] = (int)slot;
+}
+
+
+void VariableResolver::declareNamed(const std::string &name)
+{
+    _scopes.back().declarations.emplace(name, kNamedDeclaration);
+
+    if (!_functions.empty())
+        ++_functions.back().numDeclarations;
+}
+
+
+void VariableResolver::pushScope(ScopeLayout *layout, bool isFunction)
+{
+    StaticScope scope;
+    scope.layout = layout;
+    scope.isFunction = isFunction;
+
+    _scopes.push_back(std::move(scope));
+}
+
+
+void VariableResolver::popScope()
+{
+    assert(!_scopes.empty());
+
+    if (_scopes.back().opaque && !_functions.empty())
+        _functions.back().opaque = true;
+
+    _scopes.pop_back();
+}
@@ -0,0 +1,145 @@
+/**
+ * @file VariableResolver.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AddVariableNode.hpp"
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "FunctionNode.hpp"
+#include "LookupVariableNode.hpp"
+#include "ScopeLayout.hpp"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+/*
+ * Resolves variables to slots in the scopes created by the tree-walker after parsing. Each Block, loop and function
+ * call has a ScopeLayout; declarations are assigned a slot and lookups which refer to a declaration made earlier in an
+ * enclosing scope are resolved to (depth, slot) so that evaluating them does not require hashing the variable name.
+ *
+ * Functions are dynamically scoped (a function can access variables in the caller's scope) so lookups are not resolved
+ * beyond the function's own scope. Lookups also stop at scopes which contain declarations with names we cannot know
+ * until runtime (i.e. module imports). Unresolved lookups use the name as before.
+ *
+ * Slot declarations with the same name as a called function are marked so that defining them invalidates the functions
+ * cached by FunctionCallNodes.
+ *
+ * Calls in tail position (return f(...)) of the function they call are marked so that the frame is reused. This is only
+ * done if the function declares nothing other than its arguments: the callee declares the same arguments so no lookup
+ * made by the callee (or a function it calls) can see the caller's frame.
+ *
+ * Functions declared pure are checked: they cannot access variables outside their scope, modify their arguments (which
+ * refer to the caller's variables), import modules, call methods or call functions which are not pure (i.e. print).
+ */
+class VariableResolver
+{
+public:
+    static void resolve(const BaseNode::Ptr &ast);
+
+protected:
+    /* Prevent direct initialization */
+    VariableResolver() = default;
+
+    static constexpr int kNamedDeclaration{-1};
+
+    struct StaticScope
+    {
+        ScopeLayout *layout{nullptr};
+
+        /* Declarations seen so far. Slot or kNamedDeclaration for functions, classes, etc. */
+        std::unordered_map<std::string, int> declarations;
+
+        /* Contains declarations with unknown names. Lookups cannot see past this scope */
+        bool opaque{false};
+
+        /* Lookups cannot see past a function's scope (dynamic scoping) */
+        bool isFunction{false};
+    };
+
+    /* Records the names of all called and defined functions */
+    void collectNames(const BaseNode &node);
+
+    /* Function being visited */
+    struct StaticFunction
+    {
+        /* Declarations including the arguments and those in nested scopes */
+        size_t numDeclarations{0};
+
+        /* Contains a scope with declarations with unknown names */
+        bool opaque{false};
+
+        /* Return statements which return the result of a call */
+        std::vector<FunctionCallNode *> returnedCalls;
+
+        /* Names of called functions and the first variable accessed outside the function's scope */
+        std::vector<std::string> calledNames;
+        std::string outerName;
+
+        /* First parameter which is assigned, incremented or bound to a reference */
+        std::string modifiedParameter;
+
+        bool callsMethod{false};
+    };
+
+    /* Number of definitions of a function name and how many of them are pure */
+    struct FunctionDefinitions
+    {
+        int count{0};
+        int numPure{0};
+    };
+
+    void visit(const BaseNode::Ptr &node);
+
+    void visitChildren(const AnyNode &node);
+
+    void visitInNewScope(const BaseNode::Ptr &node, ScopeLayout *layout);
+
+    void visitFunction(FunctionNode &node);
+
+    void visitLoop(const AnyNode &node);
+
+    /* Marks returned calls to the function as tail calls */
+    static void markTailCalls(FunctionNode &node, const StaticFunction &function);
+
+    /* Throws if a function declared pure is not */
+    void checkPure(const FunctionNode &node, const StaticFunction &function) const;
+
+    void resolveLookup(LookupVariableNode &node);
+
+    /* Returns the slot (or kNamedDeclaration) for a name declared in the function's scopes or nullptr. Sets depth */
+    const int *findDeclaration(const std::string &name, uint32_t &depth) const;
+
+    /* Records a variable accessed by name */
+    void accessNamed(const std::string &name);
+
+    /* Records a variable which is modified. Parameters are declared in the function's scope */
+    void accessModified(const std::string &name);
+
+    void declareVariable(AddVariableNode &node);
+
+    /* Class instances are declared in a slot like variables */
+    void declareInstance(class ClassNode &node);
+
+    /* Declaration linked by name at runtime */
+    void declareNamed(const std::string &name);
+
+    void pushScope(ScopeLayout *layout, bool isFunction = false);
+
+    void popScope();
+
+private:
+    std::vector<StaticScope> _scopes;
+
+    std::unordered_set<std::string> _calledNames;
+    std::unordered_map<std::string, FunctionDefinitions> _functionDefinitions;
+
+    std::vector<StaticFunction> _functions;
+};
@@ -0,0 +1,721 @@
+/**
+ * @file VirtualMachine.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "VirtualMachine.hpp"
+#include "AnyNode.hpp"
+#include "Exceptions.hpp"
+#include "ModuleFunctor.hpp"
+#include "ObjectFactory.hpp"
+#include <cassert>
+#include <utility>
+
+/* Use computed-goto for dispatch where available (GCC, Clang) */
+#if defined(__GNUC__) || defined(__clang__)
+#define VM_COMPUTED_GOTO 1
+#else
+#define VM_COMPUTED_GOTO 0
+#endif
+
+#if VM_COMPUTED_GOTO
+#define VM_DISPATCH() goto *kDispatchTable[static_cast<size_t>(pc->opCode)]
+#define VM_CASE(name) Label##name:
+#else
+#define VM_DISPATCH() continue
+#define VM_CASE(name) case OpCode::name:
+#endif
+
+#define VM_NEXT() \
+    ++pc;         \
+    VM_DISPATCH()
+
+/* Arithmetic and comparisons with fast-paths for Int and Float operands */
+#define VM_BINARY(name, op)                                                               \
+    VM_CASE(name)                                                                         \
+    {                                                                                     \
+        const Value &left = R[pc->b];                                                     \
+        const Value &right = R[pc->c];                                                    \
+        Value &result = R[pc->a];                                                         \
+                                                                                          \
+        if (left.isSmallInt() && right.isSmallInt())                                      \
+        {                                                                                 \
+            result = Value(left.asInt() op right.asInt());                                \
+        }                                                                                 \
+        else if (left.isFloat() && right.isFloat())                                       \
+        {                                                                                 \
+            result = Value(left.asFloat() op right.asFloat());                            \
+        }                                                                                 \
+        else                                                                              \
+        {                                                                                 \
+            binaryOperation(OpCode::name, result, left, right);                           \
+        }                                                                                 \
+        VM_NEXT();                                                                        \
+    }
+
+
+namespace
+{
+
+constexpr size_t kInitialStackSize = 1024;
+
+template <typename T>
+bool applyComparison(OpCode opCode, T left, T right, bool &result)
+{
+    switch (opCode)
+    {
+        case OpCode::Equal:
+            result = (left == right);
+            return true;
+        case OpCode::NotEqual:
+            result = (left != right);
+            return true;
+        case OpCode::Less:
+            result = (left < right);
+            return true;
+        case OpCode::LessOrEqual:
+            result = (left <= right);
+            return true;
+        case OpCode::Greater:
+            result = (left > right);
+            return true;
+        case OpCode::GreaterOrEqual:
+            result = (left >= right);
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+template <typename T>
+bool applyArithmetic(OpCode opCode, T left, T right, T &result)
+{
+    switch (opCode)
+    {
+        case OpCode::Add:
+            result = left + right;
+            return true;
+        case OpCode::Subtract:
+            result = left - right;
+            return true;
+        case OpCode::Multiply:
+            result = left * right;
+            return true;
+        case OpCode::Divide:
+            result = left / right;
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace
+
+
+VirtualMachine::VirtualMachine(BytecodeProgram::Ptr program)
+    : _program(std::move(program)),
+      _natives(_program->nativeNames.size(), nullptr),
+      _nativeArguments(_program->maxNativeArgs, nullptr)
+{
+    _stack.resize(kInitialStackSize);
+
+    /* Build argument nodes for each argument count */
+    BaseNodePtrVector argumentNodes;
+
+    _nativeArgumentNodes.emplace_back();
+
+    for (size_t i = 0; i < _program->maxNativeArgs; ++i)
+    {
+        argumentNodes.push_back(std::make_shared<AnyNode>(NodeType::Unknown, [this, i](Scope &)
+        {
+            return _nativeArguments[i];
+        }));
+
+        _nativeArgumentNodes.push_back(argumentNodes);
+    }
+}
+
+
+void VirtualMachine::run()
+{
+    for (const auto &moduleNode : _program->modules)
+    {
+        (void)moduleNode->evaluate(_nativeScope);
+    }
+
+    _frames.clear();
+    execute();
+}
+
+
+bool VirtualMachine::reserveRegisters(size_t count)
+{
+    if (count <= _stack.size())
+    {
+        return false;
+    }
+
+    _stack.resize(std::max(count, 2 * _stack.size()));
+    return true;
+}
+
+
+AnyObject &VirtualMachine::resolveNative(uint16_t index)
+{
+    AnyObject::Ptr &native = _natives[index];
+
+    if (!native)
+    {
+        native = _nativeScope.getNamedObject(_program->nativeNames[index]);
+
+        if (!native->isType(AnyObject::_ModuleFunction))
+        {
+            ThrowException(_program->nativeNames[index] + " is not a module function");
+        }
+    }
+
+    return *native;
+}
+
+
+#if VM_COMPUTED_GOTO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+void VirtualMachine::execute()
+{
+#if VM_COMPUTED_GOTO
+    /* NB: must match order of OpCode */
+    static const void *kDispatchTable[] = {
+        &&LabelLoadConst,
+        &&LabelLoadNone,
+        &&LabelMove,
+        &&LabelLoadGlobal,
+        &&LabelStoreGlobal,
+        &&LabelCheckType,
+        &&LabelCheckArgument,
+        &&LabelAdd,
+        &&LabelSubtract,
+        &&LabelMultiply,
+        &&LabelDivide,
+        &&LabelModulo,
+        &&LabelEqual,
+        &&LabelNotEqual,
+        &&LabelLess,
+        &&LabelLessOrEqual,
+        &&LabelGreater,
+        &&LabelGreaterOrEqual,
+        &&LabelAnd,
+        &&LabelOr,
+        &&LabelNot,
+        &&LabelNegate,
+        &&LabelCastInt,
+        &&LabelCastFloat,
+        &&LabelIncrement,
+        &&LabelDecrement,
+        &&LabelJump,
+        &&LabelJumpIfFalse,
+        &&LabelJumpIfTrue,
+        &&LabelCall,
+        &&LabelCallNative,
+        &&LabelReturn,
+        &&LabelReturnNone,
+        &&LabelHalt};
+
+    static_assert(sizeof(kDispatchTable) / sizeof(kDispatchTable[0]) == static_cast<size_t>(OpCode::Halt) + 1,
+                  "dispatch table does not match OpCode");
+#endif
+
+    const BytecodeFunction *function = &_program->functions[BytecodeProgram::kMainFunction];
+    size_t base = 0;
+
+    (void)reserveRegisters(function->numRegisters);
+
+    Value *R = _stack.data();         /* Registers for current frame */
+    Value *G = _stack.data();         /* Globals (main frame registers) */
+    const Value *K = _program->constants.data();
+    const Instruction *pc = function->code.data();
+
+#if VM_COMPUTED_GOTO
+    VM_DISPATCH();
+#else
+    for (;;)
+    {
+        switch (pc->opCode)
+        {
+#endif
+
+    VM_CASE(LoadConst)
+    {
+        R[pc->a] = K[pc->b];
+        VM_NEXT();
+    }
+
+    VM_CASE(LoadNone)
+    {
+        R[pc->a] = Value();
+        VM_NEXT();
+    }
+
+    VM_CASE(Move)
+    {
+        R[pc->a] = R[pc->b];
+        VM_NEXT();
+    }
+
+    VM_CASE(LoadGlobal)
+    {
+        R[pc->a] = G[pc->b];
+        VM_NEXT();
+    }
+
+    VM_CASE(StoreGlobal)
+    {
+        G[pc->a] = R[pc->b];
+        VM_NEXT();
+    }
+
+    VM_CASE(CheckType)
+    {
+        const Value &value = R[pc->a];
+        const auto expectedType = static_cast<AnyObject::Type>(pc->b);
+
+        if (value.type() != expectedType)
+        {
+            ThrowException("Invalid assignment. Types do not match [LHS = " + AnyObject::typeToString(expectedType) +
+                           ", RHS = " + typeName(value) + "]");
+        }
+
+        VM_NEXT();
+    }
+
+    VM_CASE(CheckArgument)
+    {
+        const Value &value = R[pc->a];
+
+        if (value.type() != static_cast<AnyObject::Type>(pc->b))
+        {
+            throwArgumentError(*function, pc->a);
+        }
+
+        VM_NEXT();
+    }
+
+    VM_BINARY(Add, +)
+    VM_BINARY(Subtract, -)
+    VM_BINARY(Multiply, *)
+
+    VM_CASE(Divide)
+    {
+        const Value &left = R[pc->b];
+        const Value &right = R[pc->c];
+
+        if (left.isInt() && right.isInt() && right.asInt() == 0)
+        {
+            ThrowException("integer division by zero");
+        }
+
+        binaryOperation(OpCode::Divide, R[pc->a], left, right);
+        VM_NEXT();
+    }
+
+    VM_CASE(Modulo)
+    {
+        const Value &left = R[pc->b];
+        const Value &right = R[pc->c];
+        Value &result = R[pc->a];
+
+        if (left.isSmallInt() && right.isSmallInt() && right.asInt() != 0)
+        {
+            result = Value(left.asInt() % right.asInt());
+        }
+        else if (left.isInt() && right.isInt() && right.asInt() == 0)
+        {
+            ThrowException("integer modulo by zero");
+        }
+        else
+        {
+            binaryOperation(OpCode::Modulo, result, left, right);
+        }
+
+        VM_NEXT();
+    }
+
+    VM_BINARY(Equal, ==)
+    VM_BINARY(NotEqual, !=)
+    VM_BINARY(Less, <)
+    VM_BINARY(LessOrEqual, <=)
+    VM_BINARY(Greater, >)
+    VM_BINARY(GreaterOrEqual, >=)
+
+    VM_CASE(And)
+    {
+        binaryOperation(OpCode::And, R[pc->a], R[pc->b], R[pc->c]);
+        VM_NEXT();
+    }
+
+    VM_CASE(Or)
+    {
+        binaryOperation(OpCode::Or, R[pc->a], R[pc->b], R[pc->c]);
+        VM_NEXT();
+    }
+
+    VM_CASE(Not)
+    {
+        const Value &operand = R[pc->b];
+        if (!operand.isBool())
+        {
+            throwTypeError("!", operand);
+        }
+
+        R[pc->a] = Value(!operand.asBool());
+        VM_NEXT();
+    }
+
+    VM_CASE(Negate)
+    {
+        const Value &operand = R[pc->b];
+        Value &result = R[pc->a];
+
+        if (operand.isInt())
+        {
+            result = Value(-operand.asInt());
+        }
+        else if (operand.isFloat())
+        {
+            result = Value(-operand.asFloat());
+        }
+        else
+        {
+            throwTypeError("-", operand);
+        }
+
+        VM_NEXT();
+    }
+
+    VM_CASE(CastInt)
+    {
+        const Value &operand = R[pc->b];
+        Value &result = R[pc->a];
+
+        if (operand.isFloat())
+        {
+            result = Value((long)operand.asFloat());
+        }
+        else if (operand.isInt())
+        {
+            result = Value(operand.asInt());
+        }
+        else
+        {
+            throwTypeError("int()", operand);
+        }
+
+        VM_NEXT();
+    }
+
+    VM_CASE(CastFloat)
+    {
+        const Value &operand = R[pc->b];
+        Value &result = R[pc->a];
+
+        if (operand.isInt())
+        {
+            result = Value((double)operand.asInt());
+        }
+        else if (operand.isFloat())
+        {
+            result = Value(operand.asFloat());
+        }
+        else
+        {
+            throwTypeError("float()", operand);
+        }
+
+        VM_NEXT();
+    }
+
+    VM_CASE(Increment)
+    {
+        Value &operand = R[pc->a];
+
+        if (operand.isInt())
+            operand = Value(operand.asInt() + 1);
+        else if (operand.isFloat())
+            operand = Value(operand.asFloat() + 1.0);
+        else
+            throwTypeError("++", operand);
+
+        VM_NEXT();
+    }
+
+    VM_CASE(Decrement)
+    {
+        Value &operand = R[pc->a];
+
+        if (operand.isInt())
+            operand = Value(operand.asInt() - 1);
+        else if (operand.isFloat())
+            operand = Value(operand.asFloat() - 1.0);
+        else
+            throwTypeError("--", operand);
+
+        VM_NEXT();
+    }
+
+    VM_CASE(Jump)
+    {
+        pc = function->code.data() + pc->a;
+        VM_DISPATCH();
+    }
+
+    VM_CASE(JumpIfFalse)
+    {
+        const Value &condition = R[pc->a];
+        if (!condition.isBool())
+        {
+            throwTypeError("condition", condition);
+        }
+
+        pc = condition.asBool() ? (pc + 1) : (function->code.data() + pc->b);
+        VM_DISPATCH();
+    }
+
+    VM_CASE(JumpIfTrue)
+    {
+        const Value &condition = R[pc->a];
+        if (!condition.isBool())
+        {
+            throwTypeError("condition", condition);
+        }
+
+        pc = condition.asBool() ? (function->code.data() + pc->b) : (pc + 1);
+        VM_DISPATCH();
+    }
+
+    VM_CASE(Call)
+    {
+        const BytecodeFunction *callee = &_program->functions[pc->b];
+
+        _frames.push_back(Frame{function, pc + 1, base});
+
+        base += pc->a;
+
+        if (reserveRegisters(base + callee->numRegisters))
+        {
+            G = _stack.data();
+        }
+
+        R = _stack.data() + base;
+        function = callee;
+        pc = callee->code.data();
+        VM_DISPATCH();
+    }
+
+    VM_CASE(CallNative)
+    {
+        AnyObject &native = resolveNative(pc->b);
+
+        const uint16_t argc = pc->c;
+
+        for (uint16_t i = 0; i < argc; ++i)
+        {
+            _nativeArguments[i] = ObjectFactory::box(R[pc->a + i]);
+        }
+
+        AnyObject::Ptr result = native.getValue<ModuleFunctor>()(_nativeArgumentNodes[argc], _nativeScope);
+
+        std::fill(_nativeArguments.begin(), _nativeArguments.begin() + argc, nullptr);
+
+        R[pc->a] = Value(result);
+        VM_NEXT();
+    }
+
+    VM_CASE(Return)
+    {
+        Value result = R[pc->a];
+
+        Frame &caller = _frames.back();
+
+        _stack[base] = std::move(result); /* Callee's first register is the caller's result register */
+
+        function = caller.function;
+        pc = caller.returnAddress;
+        base = caller.base;
+        R = _stack.data() + base;
+
+        _frames.pop_back();
+        VM_DISPATCH();
+    }
+
+    VM_CASE(ReturnNone)
+    {
+        Frame &caller = _frames.back();
+
+        _stack[base] = Value();
+
+        function = caller.function;
+        pc = caller.returnAddress;
+        base = caller.base;
+        R = _stack.data() + base;
+
+        _frames.pop_back();
+        VM_DISPATCH();
+    }
+
+    VM_CASE(Halt)
+    {
+        return;
+    }
+
+#if !VM_COMPUTED_GOTO
+            default:
+                ThrowException("unknown opcode");
+        }
+    }
+#endif
+}
+
+#if VM_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+
+void VirtualMachine::binaryOperation(OpCode opCode, Value &result, const Value &left, const Value &right)
+{
+    bool boolResult;
+
+    if (left.isBool() && right.isBool())
+    {
+        switch (opCode)
+        {
+            case OpCode::Equal:
+                boolResult = (left.asBool() == right.asBool());
+                break;
+            case OpCode::NotEqual:
+                boolResult = (left.asBool() != right.asBool());
+                break;
+            case OpCode::And:
+                boolResult = (left.asBool() && right.asBool());
+                break;
+            case OpCode::Or:
+                boolResult = (left.asBool() || right.asBool());
+                break;
+            default:
+                ThrowException("cannot apply operator to types Bool, Bool");
+        }
+
+        result = Value(boolResult);
+        return;
+    }
+
+    if (left.isInt() && right.isInt())
+    {
+        const long leftValue = left.asInt();
+        const long rightValue = right.asInt();
+        long intResult;
+
+        if (applyComparison(opCode, leftValue, rightValue, boolResult))
+        {
+            result = Value(boolResult);
+        }
+        else if (applyArithmetic(opCode, leftValue, rightValue, intResult))
+        {
+            result = Value(intResult);
+        }
+        else if (opCode == OpCode::Modulo)
+        {
+            result = Value(leftValue % rightValue);
+        }
+        else if (opCode == OpCode::And || opCode == OpCode::Or)
+        {
+            result = Value((opCode == OpCode::And) ? (leftValue && rightValue) : (leftValue || rightValue));
+        }
+        else
+        {
+            ThrowException("cannot apply operator to types Int, Int");
+        }
+
+        return;
+    }
+
+    auto isNumeric = [](const Value &value)
+    {
+        return (value.isInt() || value.isFloat());
+    };
+
+    if (isNumeric(left) && isNumeric(right)) /* Implicit casts */
+    {
+        double leftValue = left.isFloat() ? left.asFloat() : (double)left.asInt();
+        double rightValue = right.isFloat() ? right.asFloat() : (double)right.asInt();
+        double floatResult;
+
+        if (applyComparison(opCode, leftValue, rightValue, boolResult))
+        {
+            result = Value(boolResult);
+        }
+        else if (applyArithmetic(opCode, leftValue, rightValue, floatResult))
+        {
+            result = Value(floatResult);
+        }
+        else
+        {
+            ThrowException("cannot apply operator to types Float, Float");
+        }
+
+        return;
+    }
+
+    if (left.type() == AnyObject::String && right.type() == AnyObject::String)
+    {
+        const auto &leftValue = std::as_const(left.object()).getValue<std::string>();
+        const auto &rightValue = std::as_const(right.object()).getValue<std::string>();
+
+        switch (opCode)
+        {
+            case OpCode::Add:
+                result = Value(ObjectFactory::allocate(leftValue + rightValue));
+                return;
+            case OpCode::Equal:
+                boolResult = (leftValue == rightValue);
+                break;
+            case OpCode::NotEqual:
+                boolResult = (leftValue != rightValue);
+                break;
+            default:
+                ThrowException("cannot apply operator to types String, String");
+        }
+
+        result = Value(boolResult);
+        return;
+    }
+
+    ThrowException("cannot apply operator [" + std::string(opCodeName(opCode)) + "] to registers of type [" +
+                   typeName(left) + "] and [" + typeName(right) + "]");
+}
+
+
+void VirtualMachine::throwArgumentError(const BytecodeFunction &function, uint16_t index)
+{
+    /* NB: same message as FunctionCallNode */
+    ThrowException("incorrect type for argument '" + function.paramNames[index] + "' of function '" + function.name +
+                   "'. Expected type '" + AnyObject::typeToString(function.paramTypes[index]) + "'.");
+}
+
+
+void VirtualMachine::throwTypeError(const char *operation, const Value &value)
+{
+    ThrowException(std::string("cannot apply ") + operation + " to register of type [" + typeName(value) + "]");
+}
+
+
+std::string VirtualMachine::typeName(const Value &value)
+{
+    return value.isNone() ? "None" : AnyObject::typeToString(value.type());
+}
@@ -0,0 +1,69 @@
+/**
+ * @file VirtualMachine.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "Bytecode.hpp"
+#include "Scope.hpp"
+#include <memory>
+#include <vector>
+
+
+/*
+ * Register-based VM for programs lowered by BytecodeCompiler. Each call frame is a window onto a single register stack
+ * so arguments evaluated by the caller become the callee's parameters without copying. Dispatch uses computed-goto
+ * where supported by the compiler and falls back to a switch.
+ */
+class VirtualMachine
+{
+public:
+    explicit VirtualMachine(BytecodeProgram::Ptr program);
+
+    /* Evaluates module imports and executes the program */
+    void run();
+
+protected:
+    struct Frame
+    {
+        const BytecodeFunction *function;
+        const Instruction *returnAddress;
+        size_t base;
+    };
+
+    void execute();
+
+    /* Grows the register stack if required. Returns true if the stack was reallocated */
+    bool reserveRegisters(size_t count);
+
+    /* Returns the module function for a CallNative instruction */
+    AnyObject &resolveNative(uint16_t index);
+
+    /* Slow-path for binary operations on mixed or non-numeric types */
+    static void binaryOperation(OpCode opCode, Value &result, const Value &left, const Value &right);
+
+    [[noreturn]] static void throwTypeError(const char *operation, const Value &value);
+
+    [[noreturn]] static void throwArgumentError(const BytecodeFunction &function, uint16_t index);
+
+    /* Returns the type name of a register for error messages */
+    static std::string typeName(const Value &value);
+
+private:
+    BytecodeProgram::Ptr _program;
+
+    std::vector<Value> _stack;
+    std::vector<Frame> _frames;
+
+    /* Module functions imported by the program */
+    Scope _nativeScope;
+    std::vector<AnyObject::Ptr> _natives;
+
+    /* Module functions evaluate their arguments as nodes. These nodes return the boxed registers */
+    AnyObject::Vector _nativeArguments;
+    std::vector<BaseNodePtrVector> _nativeArgumentNodes;
+};
@@ -0,0 +1,163 @@
+/**
+ * @file InterpreterContext.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "InterpreterContext.hpp"
+#include "AnyObject.hpp"
+#include "Exceptions.hpp"
+#include <atomic>
+#include <mutex>
+
+thread_local InterpreterContext *InterpreterContext::_current{nullptr};
+
+namespace
+{
+
+/* Indices of destroyed slots are reused */
+struct CacheSlotIndices
+{
+    std::mutex mutex;
+    std::vector<uint32_t> freeIndices;
+    uint32_t nextIndex{0};
+};
+
+CacheSlotIndices &cacheSlotIndices()
+{
+    /* Never destroyed so that nodes can be destroyed during static destruction */
+    static CacheSlotIndices *indices = new CacheSlotIndices();
+    return *indices;
+}
+
+std::atomic<uint64_t> gNextCacheSlotKey{1};
+
+uint32_t acquireCacheSlotIndex()
+{
+    auto &indices = cacheSlotIndices();
+    std::lock_guard<std::mutex> guard(indices.mutex);
+
+    if (indices.freeIndices.empty())
+    {
+        return indices.nextIndex++;
+    }
+
+    uint32_t index = indices.freeIndices.back();
+    indices.freeIndices.pop_back();
+    return index;
+}
+
+} // namespace
+
+
+CacheSlot::CacheSlot()
+    : _index(acquireCacheSlotIndex()),
+      _key(gNextCacheSlotKey.fetch_add(1, std::memory_order_relaxed))
+{
+}
+
+
+CacheSlot::CacheSlot(const CacheSlot &) : CacheSlot()
+{
+}
+
+
+CacheSlot::~CacheSlot()
+{
+    auto &indices = cacheSlotIndices();
+    std::lock_guard<std::mutex> guard(indices.mutex);
+
+    indices.freeIndices.push_back(_index);
+}
+
+
+InterpreterContext::CurrentContext::CurrentContext(InterpreterContext &context)
+    : _previous(_current)
+{
+    _current = &context;
+}
+
+
+InterpreterContext::CurrentContext::~CurrentContext()
+{
+    _current = _previous;
+}
+
+
+InterpreterContext &InterpreterContext::threadContext()
+{
+    thread_local InterpreterContext context;
+
+    _current = &context;
+    return context;
+}
+
+
+FunctionMemo &InterpreterContext::memo(const CacheSlot &slot)
+{
+    if (slot.index() >= _memos.size())
+    {
+        _memos.resize(slot.index() + 1);
+    }
+
+    auto &[key, memo] = _memos[slot.index()];
+
+    if (key != slot.key() || !memo)
+    {
+        key = slot.key();
+        memo = std::make_unique<FunctionMemo>();
+    }
+
+    return *memo;
+}
+
+
+std::shared_ptr<AnyObject> InterpreterContext::takeReturnValue()
+{
+    switch (completion)
+    {
+        case Completion::Normal:
+            return nullptr;
+        case Completion::Return:
+            completion = Completion::Normal;
+            return std::move(returnValue);
+        default:
+            checkNotInterrupted(); /* Throws */
+            return nullptr;
+    }
+}
+
+
+void InterpreterContext::reset()
+{
+    completion = Completion::Normal;
+    returnValue = nullptr;
+    tailCallArguments.clear();
+}
+
+
+void InterpreterContext::checkNotInterrupted()
+{
+    if (!isInterrupted())
+    {
+        return;
+    }
+
+    Completion unhandled = completion;
+
+    reset();
+
+    switch (unhandled)
+    {
+        case Completion::Return:
+        case Completion::TailCall:
+            ThrowException("return statement outside of function");
+        case Completion::Break:
+            ThrowException("break statement outside of loop");
+        default:
+            ThrowException("continue statement outside of loop");
+    }
+}
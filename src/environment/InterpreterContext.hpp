@@ -0,0 +1,274 @@
+/**
+ * @file InterpreterContext.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "CycleCollector.hpp"
+#include "FunctionMemo.hpp"
+#include "SymbolTable.hpp"
+#include "Value.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * How the last statement completed. Break, continue and return set this instead of jumping so that the statements in
+ * the enclosing blocks are skipped and their scopes are destroyed normally. The enclosing loop (break/continue) or
+ * function call (return) resets it to Normal.
+ */
+enum class Completion : uint8_t
+{
+    Normal,
+    Break,
+    Continue,
+    Return,
+    TailCall /* Return by calling the same function again. The arguments are in tailCallArguments */
+};
+
+
+/*
+ * Identifies a node for the caches held by each context (see InterpreterContext). Indices are reused once the node is
+ * destroyed so that the caches stay small. The key is never reused so a stale entry for a previous owner of the index
+ * is detected. Copies are given a new slot.
+ */
+class CacheSlot
+{
+public:
+    CacheSlot();
+    CacheSlot(const CacheSlot &);
+    ~CacheSlot();
+
+    CacheSlot &operator=(const CacheSlot &) { return (*this); } /* Keeps its own slot */
+
+    [[nodiscard]] uint32_t index() const { return _index; }
+
+    [[nodiscard]] uint64_t key() const { return _key; }
+
+private:
+    uint32_t _index;
+    uint64_t _key;
+};
+
+
+/*
+ * Owns the runtime state for evaluating a program: the completion of the last statement, the binding generation used
+ * to validate call-site caches, the caches themselves and the collector for the objects allocated by the program. The
+ * AST is not modified during evaluation so the same AST may be evaluated by several contexts at once (one per thread).
+ *
+ * Nodes use the context installed for the current thread (see CurrentContext). Each thread has a default context which
+ * is used if none is installed.
+ */
+class InterpreterContext
+{
+public:
+    InterpreterContext() = default;
+
+    InterpreterContext(const InterpreterContext &) = delete;
+    InterpreterContext &operator=(const InterpreterContext &) = delete;
+
+    /* Installs a context for the current thread. The previous context is restored on destruction */
+    class CurrentContext
+    {
+    public:
+        explicit CurrentContext(InterpreterContext &context);
+        ~CurrentContext();
+
+        CurrentContext(const CurrentContext &) = delete;
+        CurrentContext &operator=(const CurrentContext &) = delete;
+
+    private:
+        InterpreterContext *_previous;
+    };
+
+    /* Context installed for the current thread */
+    [[nodiscard]] static inline InterpreterContext &current();
+
+    /* Function resolved by a previous call. Valid while the binding generation is unchanged */
+    struct CallSiteCache
+    {
+        uint64_t key{0}; /* Key of the slot which owns the entry */
+        uint64_t generation{0};
+        class FunctionNode *function{nullptr}; /* NB: raw pointers are owned by the scope */
+        class ModuleFunctor *moduleFunction{nullptr};
+    };
+
+    /* Returns the cache for a call site. Stale entries are reset */
+    [[nodiscard]] inline CallSiteCache &callSiteCache(const CacheSlot &slot);
+
+    /* Methods found by a method call site for the classes of previous receivers (a polymorphic inline cache). Class
+     * ids are never reused and class layouts do not change so entries are never invalidated */
+    struct MethodCache
+    {
+        static constexpr size_t kNumEntries{4};
+
+        uint64_t key{0};
+        uint64_t classIds[kNumEntries]{}; /* Zero for an empty entry */
+        uint32_t slots[kNumEntries]{};
+        uint32_t numInserted{0};
+
+        /* Returns the slot of the method in the class layout or -1 */
+        [[nodiscard]] inline int find(uint64_t classId) const;
+
+        /* Replaces the oldest entry once the cache is full (i.e. a megamorphic call site) */
+        inline void insert(uint64_t classId, uint32_t slot);
+    };
+
+    /* Returns the method cache for a method call site. Stale entries are reset */
+    [[nodiscard]] inline MethodCache &methodCache(const CacheSlot &slot);
+
+    /* Returns the results of previous calls to a pure function */
+    [[nodiscard]] FunctionMemo &memo(const CacheSlot &slot);
+
+    /* Frees cycles between the arrays and class instances allocated while the context is installed */
+    [[nodiscard]] CycleCollector &collector() { return _collector; }
+
+    /* Incremented whenever a name lookup could return a different object (i.e. a name is linked or shadowed). Results
+     * of lookups made in the same generation can be reused (see FunctionCallNode) */
+    [[nodiscard]] uint64_t bindingGeneration() const { return _bindingGeneration; }
+
+    void invalidateBindings()
+    {
+        ++_bindingGeneration;
+        _cachedNames = 0;
+    }
+
+    /* Called when a call site caches a function. Records the name so that a method call can tell whether the members
+     * of its receiver could shadow the function (see shadowNames) */
+    void noteCachedName(SymbolID symbol) { _cachedNames |= nameMask(symbol); }
+
+    /* Called before a method call adds the members of the receiver to the names visible to its callees. Invalidates
+     * the bindings only if a member may have the name of a cached function */
+    void shadowNames(uint64_t mask)
+    {
+        if (VALUE_UNLIKELY(_cachedNames & mask))
+            invalidateBindings();
+    }
+
+    /* Bit for a name in the masks used by noteCachedName and shadowNames */
+    [[nodiscard]] static uint64_t nameMask(SymbolID symbol) { return (uint64_t{1} << (symbol % 64)); }
+
+    /* True if a break, continue or return has not been handled yet */
+    [[nodiscard]] bool isInterrupted() const { return VALUE_UNLIKELY(completion != Completion::Normal); }
+
+    /* Called by loops after evaluating the body. Handles break and continue. Returns true to exit the loop */
+    inline bool exitLoop();
+
+    /* Called after evaluating a function body. Returns the value of any return statement */
+    std::shared_ptr<class AnyObject> takeReturnValue();
+
+    /* Called at file-level. Throws if a break, continue or return was not handled */
+    void checkNotInterrupted();
+
+    /* Discards any completion left by an evaluation which threw */
+    void reset();
+
+    Completion completion{Completion::Normal};
+
+    std::shared_ptr<class AnyObject> returnValue{nullptr};
+
+    /* Evaluated arguments of pending tail calls. The function call reusing its frame takes the last N arguments */
+    std::vector<std::shared_ptr<class AnyObject>> tailCallArguments;
+
+private:
+    /* Default context for the current thread. Installed on first use */
+    static InterpreterContext &threadContext();
+
+    /* Returns the entry for a slot in a vector of caches. Stale entries are reset */
+    template <typename Cache>
+    static inline Cache &cacheEntry(std::vector<Cache> &caches, const CacheSlot &slot);
+
+    uint64_t _bindingGeneration{1};
+    uint64_t _cachedNames{0}; /* Names of functions cached in this generation (see nameMask) */
+
+    std::vector<CallSiteCache> _callSites;  /* Indexed by slot */
+    std::vector<MethodCache> _methodSites; /* Indexed by slot */
+    std::vector<std::pair<uint64_t, std::unique_ptr<FunctionMemo>>> _memos; /* Key and memo indexed by slot */
+
+    CycleCollector _collector;
+
+    static thread_local InterpreterContext *_current;
+};
+
+
+InterpreterContext &InterpreterContext::current()
+{
+    return VALUE_LIKELY(_current != nullptr) ? *_current : threadContext();
+}
+
+
+template <typename Cache>
+Cache &InterpreterContext::cacheEntry(std::vector<Cache> &caches, const CacheSlot &slot)
+{
+    if (VALUE_UNLIKELY(slot.index() >= caches.size()))
+    {
+        caches.resize(slot.index() + 1);
+    }
+
+    Cache &cache = caches[slot.index()];
+
+    if (VALUE_UNLIKELY(cache.key != slot.key()))
+    {
+        cache = Cache{slot.key()};
+    }
+
+    return cache;
+}
+
+
+InterpreterContext::CallSiteCache &InterpreterContext::callSiteCache(const CacheSlot &slot)
+{
+    return cacheEntry(_callSites, slot);
+}
+
+
+InterpreterContext::MethodCache &InterpreterContext::methodCache(const CacheSlot &slot)
+{
+    return cacheEntry(_methodSites, slot);
+}
+
+
+int InterpreterContext::MethodCache::find(uint64_t classId) const
+{
+    for (size_t i = 0; i < kNumEntries; ++i)
+    {
+        if (classIds[i] == classId)
+            return (int)slots[i];
+    }
+
+    return -1;
+}
+
+
+void InterpreterContext::MethodCache::insert(uint64_t classId, uint32_t slot)
+{
+    size_t i = (numInserted++ % kNumEntries);
+
+    classIds[i] = classId;
+    slots[i] = slot;
+}
+
+
+bool InterpreterContext::exitLoop()
+{
+    if (!isInterrupted())
+    {
+        return false;
+    }
+
+    switch (completion)
+    {
+        case Completion::Continue:
+            completion = Completion::Normal;
+            return false;
+        case Completion::Break:
+            completion = Completion::Normal;
+            return true;
+        default: /* Return or TailCall: propagate to function call */
+            return true;
+    }
+}
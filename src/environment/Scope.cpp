@@ -10,8 +10,15 @@
 #include "Scope.hpp"
 #include "AnyObject.hpp"
 #include "Exceptions.hpp"
+#include "InterpreterContext.hpp"
 #include <cassert>
 
+void Scope::invalidateBindings()
+{
+    InterpreterContext::current().invalidateBindings();
+}
+
+
 Scope::Scope(const Scope &_parent)
     : Scope(&_parent)
 {
@@ -22,39 +29,177 @@ Scope::Scope(const Scope *_parent)
 {
 }
 
+Scope::Scope(const Scope &_parent, const ScopeLayout *layout_)
+    : parent(const_cast<Scope *>(&_parent))
+{
+    if (layout_ && !layout_->empty()) /* Name lookups skip scopes without slots */
+    {
+        layout = layout_;
+        slots.resize(layout->size());
+    }
+}
+
+
+Scope::Scope(const Scope &_parent, const Scope &members_, const AnyObject::Ptr &receiver_)
+    : members(&members_),
+      receiver(&receiver_),
+      parent(const_cast<Scope *>(&_parent))
+{
+}
+
 
-AnyObject::Ptr Scope::getNamedObject(const std::string &name) const
+Scope &Scope::operator=(const Scope &other)
 {
-    // Try in our scope (to handle variable shadowing).
-    auto iter = linkedObjectForName.find(name);
-    if (iter != linkedObjectForName.end())
+    if (this == &other)
     {
-        return (iter->second);
+        return (*this);
     }
 
-    // Otherwise check if it is defined in our parent's scope? Keep working outwards.
-    if (parent)
+    linkedObjectForName = other.linkedObjectForName ? std::make_unique<ObjectForName>(*other.linkedObjectForName) : nullptr;
+    layout = other.layout;
+    slots = other.slots;
+    members = other.members;
+    receiver = other.receiver;
+    parent = other.parent;
+
+    invalidateBindings();
+
+    return (*this);
+}
+
+
+const AnyObject::Ptr &Scope::getNamedObject(const std::string &name) const
+{
+    bool isGlobal;
+    return getNamedObject(name, isGlobal);
+}
+
+
+const AnyObject::Ptr &Scope::getNamedObject(const std::string &name, bool &isGlobal) const
+{
+    const Scope *owner{nullptr};
+
+    if (auto object = findNamedObject(name, owner))
     {
-        return parent->getNamedObject(name);
+        isGlobal = (owner->parent == nullptr);
+        return (*object);
     }
 
     ThrowException("No variable defined with name [" + name + "]");
 }
 
 
+const AnyObject::Ptr *Scope::findNamedObject(const std::string &name, const Scope *&owner) const
+{
+    // Try in our scope first (to handle variable shadowing). Otherwise check if it is
+    // defined in our parent's scope? Keep working outwards.
+    for (const Scope *current = this; current; current = current->parent)
+    {
+        owner = current;
+
+        if (auto slotObject = current->findSlotObject(name))
+        {
+            return slotObject;
+        }
+
+        if (current->linkedObjectForName)
+        {
+            auto iter = current->linkedObjectForName->find(name);
+            if (iter != current->linkedObjectForName->end())
+            {
+                return &(iter->second);
+            }
+        }
+
+        if (current->members)
+        {
+            if (auto memberObject = current->members->findSlotObject(name))
+            {
+                return memberObject;
+            }
+            else if (name == "this")
+            {
+                return current->receiver;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+
 void Scope::linkObject(const std::string &name, AnyObject::Ptr object)
 {
     assert(object != nullptr);
 
     // 1. Check for name clashes. This is where we have two variables with
     // the same name defined in the SAME scope.
-    auto iter = linkedObjectForName.find(name);
-    if (iter != linkedObjectForName.end())
+    if (!linkedObjectForName)
+    {
+        linkedObjectForName = std::make_unique<ObjectForName>();
+    }
+    else if (linkedObjectForName->count(name))
+    {
+        ThrowException(name + " is already defined in current scope");
+    }
+
+    if (findSlotObject(name))
     {
         ThrowException(name + " is already defined in current scope");
     }
 
     // 2. Add to map. This will ensure that we now ignore any outer-scope variables
     // with this name (variable shadowing).
-    linkedObjectForName[name] = object;
+    (*linkedObjectForName)[name] = object;
+
+    invalidateBindings();
+}
+
+
+void Scope::defineSlot(uint32_t slot, AnyObject::Ptr object)
+{
+    assert(object != nullptr);
+    assert(layout && slot < slots.size());
+
+    const std::string &name = layout->slotName(slot);
+
+    if (slots[slot] || (linkedObjectForName && linkedObjectForName->count(name)))
+    {
+        ThrowException(name + " is already defined in current scope");
+    }
+
+    slots[slot] = std::move(object);
+}
+
+
+void Scope::adoptLayout(const ScopeLayout *layout_)
+{
+    if (!layout_ || layout_->empty() || layout == layout_)
+    {
+        return;
+    }
+    else if (layout)
+    {
+        ThrowException("cannot evaluate file in a scope created for another file");
+    }
+
+    layout = layout_;
+    slots.resize(layout->size());
+}
+
+
+const AnyObject::Ptr *Scope::findSlotObject(const std::string &name) const
+{
+    if (!layout)
+    {
+        return nullptr;
+    }
+
+    int slot = layout->findSlot(name);
+    if (slot == ScopeLayout::kNotFound || !slots[slot])
+    {
+        return nullptr;
+    }
+
+    return &slots[slot];
 }
@@ -8,6 +8,10 @@
  */
 
 #pragma once
+#include "PoolAllocator.hpp"
+#include "ScopeLayout.hpp"
+#include <cassert>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -18,26 +22,131 @@ class Scope
 public:
     Scope(const Scope &_parent);
     Scope(const Scope *_parent = nullptr);
-    ~Scope() = default;
+
+    /// Create a scope with slots for variables resolved by VariableResolver.
+    Scope(const Scope &_parent, const ScopeLayout *layout);
+
+    /// Create a scope for a method call. Name lookups find the members in the receiver's instance scope (shared, not
+    /// copied) and 'this' is bound to the receiver. The receiver must outlive the scope.
+    Scope(const Scope &_parent, const Scope &members_, const std::shared_ptr<class AnyObject> &receiver_);
+
+    ~Scope()
+    {
+        if (!parent && !isInstanceScope) /* Global scope: bindings found in it are gone */
+            invalidateBindings();
+    }
+
+    /// Copies the variables (used for assigning class instances).
+    Scope &operator=(const Scope &other);
 
     /// Get a named object ("variable") in our scope or an outer scope. We work outwards from our scope to handle
     /// variable shadowing correctly
-    std::shared_ptr<class AnyObject> getNamedObject(const std::string &name) const;
+    const std::shared_ptr<class AnyObject> &getNamedObject(const std::string &name) const;
+
+    /// As above. Sets isGlobal if the object was found in the outermost scope.
+    const std::shared_ptr<class AnyObject> &getNamedObject(const std::string &name, bool &isGlobal) const;
+
+    /// Get a resolved variable. Depth is the number of scopes to move outwards. Falls back to a name-based lookup
+    /// from the parent of the target scope if the slot is empty (i.e. a conditional declaration was skipped).
+    inline const std::shared_ptr<class AnyObject> &getSlotObject(uint32_t depth, uint32_t slot, const std::string &name) const;
 
     /// Returns non-const reference to parent scope.
     inline Scope *parentScope() { return parent; }
 
-    /// Set a new parent scope. Use with care!
-    void setParentScope(Scope *parent_) { parent = parent_; }
-
     /// Create a link between a variable name and an object in this scope.
     void linkObject(const std::string &name, std::shared_ptr<class AnyObject> object);
 
+    /// Define a resolved variable in this scope.
+    void defineSlot(uint32_t slot, std::shared_ptr<class AnyObject> object);
+
+    /// Adopts a layout if the scope does not have one. Used by the entry-point file node for the global scope.
+    void adoptLayout(const ScopeLayout *layout);
+
+    [[nodiscard]] bool hasLayout() const { return (layout != nullptr); }
+
+    /// Calls the function with each object defined in this scope (not its parents). Used by the CycleCollector.
+    template <class TFunction>
+    void forEachObject(TFunction &&function) const;
+
+    /// Marks the scope of a class instance. Its members are only found through method call scopes (lookups which are
+    /// never cached) so destroying it does not invalidate the bindings.
+    void setIsInstanceScope() { isInstanceScope = true; }
+
+    /// Called whenever a name lookup could return a different object (i.e. a name is linked or shadowed). Increments
+    /// the binding generation of the current InterpreterContext so that cached lookups are discarded.
+    static void invalidateBindings();
+
 private:
+    /// Returns the object for a name and the scope it was found in or nullptr.
+    const std::shared_ptr<class AnyObject> *findNamedObject(const std::string &name, const Scope *&owner) const;
+
+    /// Returns the object in a slot for a name in this scope or nullptr.
+    const std::shared_ptr<class AnyObject> *findSlotObject(const std::string &name) const;
+
+    using ObjectForName = std::unordered_map<std::string,
+                                             std::shared_ptr<class AnyObject>,
+                                             std::hash<std::string>,
+                                             std::equal_to<std::string>,
+                                             PoolAllocator::Allocator<std::pair<const std::string, std::shared_ptr<class AnyObject>>>>;
+
+    using ObjectSlots = std::vector<std::shared_ptr<class AnyObject>, PoolAllocator::Allocator<std::shared_ptr<class AnyObject>>>;
+
     /// Stores a mapping from the variable name to a pointer to the object. These
     /// are only linked objects defined in this scope. This enables variable
-    /// shadowing.
-    std::unordered_map<std::string, std::shared_ptr<class AnyObject>> linkedObjectForName;
+    /// shadowing. Allocated on the first call to linkObject() as most scopes only
+    /// contain resolved variables.
+    std::unique_ptr<ObjectForName> linkedObjectForName;
+
+    /// Objects for resolved variables. Indexed by the slots in layout.
+    const ScopeLayout *layout{nullptr};
+    ObjectSlots slots;
+
+    /// Instance scope and object of the receiver for a method call scope.
+    const Scope *members{nullptr};
+    const std::shared_ptr<class AnyObject> *receiver{nullptr};
 
     Scope *parent{nullptr};
+
+    bool isInstanceScope{false};
 };
+
+
+const std::shared_ptr<class AnyObject> &Scope::getSlotObject(uint32_t depth, uint32_t slot, const std::string &name) const
+{
+    const Scope *target = this;
+
+    for (; depth > 0; --depth)
+    {
+        target = target->parent;
+    }
+
+    assert(slot < target->slots.size());
+
+    const auto &object = target->slots[slot];
+    if (object)
+    {
+        return object;
+    }
+
+    return target->parent ? target->parent->getNamedObject(name) : getNamedObject(name); /* Throws */
+}
+
+
+template <class TFunction>
+void Scope::forEachObject(TFunction &&function) const
+{
+    for (const auto &object : slots)
+    {
+        if (object)
+            function(object);
+    }
+
+    if (linkedObjectForName)
+    {
+        for (const auto &[name, object] : *linkedObjectForName)
+        {
+            if (object)
+                function(object);
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/**
+ * @file ScopeLayout.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ScopeLayout.hpp"
+
+
+uint32_t ScopeLayout::addSlot(const std::string &name)
+{
+    auto iter = _slotForName.find(name);
+    if (iter != _slotForName.end())
+    {
+        return iter->second; /* Redefinition. Caught at runtime */
+    }
+
+    uint32_t slot = (uint32_t)_names.size();
+
+    _names.push_back(name);
+    _slotForName[name] = slot;
+
+    return slot;
+}
+
+
+int ScopeLayout::findSlotForName(const std::string &name) const
+{
+    auto iter = _slotForName.find(name);
+
+    return (iter != _slotForName.end()) ? (int)iter->second : kNotFound;
+}
+
+
+void ScopeLayout::clear()
+{
+    _names.clear();
+    _slotForName.clear();
+}
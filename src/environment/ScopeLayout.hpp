@@ -0,0 +1,68 @@
+/**
+ * @file ScopeLayout.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Slot assignments for variables declared in a scope. Built by VariableResolver after parsing and shared by every Scope
+ * created for the same block, loop or function. Resolved variables are accessed by index; the name map is only used
+ * for name-based lookups (i.e. from a called function or for debugging).
+ */
+class ScopeLayout
+{
+public:
+    using Ptr = std::shared_ptr<ScopeLayout>;
+
+    static constexpr int kNotFound{-1};
+
+    /* Returns the slot for a name. Adds a new slot if not found */
+    uint32_t addSlot(const std::string &name);
+
+    /* Returns the slot for a name or kNotFound */
+    [[nodiscard]] inline int findSlot(const std::string &name) const;
+
+    [[nodiscard]] const std::string &slotName(uint32_t slot) const { return _names.at(slot); }
+
+    [[nodiscard]] size_t size() const { return _names.size(); }
+
+    [[nodiscard]] bool empty() const { return _names.empty(); }
+
+    void clear();
+
+protected:
+    [[nodiscard]] int findSlotForName(const std::string &name) const;
+
+private:
+    static constexpr size_t kMaxLinearSearch{8};
+
+    std::vector<std::string> _names;
+    std::unordered_map<std::string, uint32_t> _slotForName;
+};
+
+
+int ScopeLayout::findSlot(const std::string &name) const
+{
+    if (_names.size() > kMaxLinearSearch)
+    {
+        return findSlotForName(name);
+    }
+
+    for (size_t slot = 0; slot < _names.size(); ++slot) /* Faster than hashing the name for small scopes */
+    {
+        if (_names[slot] == name)
+            return (int)slot;
+    }
+
+    return kNotFound;
+}
@@ -20,6 +20,8 @@ int main(int argc, const char *argv[])
 
         parser.addFlagArg("--help", "display available options");
         parser.addFlagArg("--trace", "logs everything!"); /* TODO: - enable user to set different log levels or disable */
+        parser.addFlagArg("--bytecode", "compile to bytecode and run on the VM");
+        parser.addFlagArg("--cache", "reuse the parsed program from a .ekc file if the sources are unchanged");
 
         parser.addPositionalArg("fileName");
         parser.parseArgs(argc, argv);
@@ -35,7 +37,9 @@ int main(int argc, const char *argv[])
         else
             log().setThreshold(LogLevel::Debug);
 
-        Interpreter::evaluateFile(parser["fileName"]);
+        auto engine = parser.isSet("--bytecode") ? Interpreter::Engine::Bytecode : Interpreter::Engine::TreeWalker;
+
+        Interpreter::evaluateFile(parser["fileName"], engine, parser.isSet("--cache"));
     }
     catch (std::exception &exception)
     {
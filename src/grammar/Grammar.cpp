@@ -10,11 +10,60 @@
 #include "Grammar.hpp"
 
 GrammarImpl::GrammarImpl()
-    : punctuation{',', ';', '(', ')', '{', '}', '[', ']', '.', ':'},
-      operators{'+', '-', '*', '/', '%', '&', '|', '<', '>', '=', '!'},
-      keywords{"if", "else", "true", "false", "func", "while", "do", "for", "int",
-               "float", "bool", "array", "string", "break", "return", "import",
-               "class"},
-      dataTypes{"int", "float", "bool", "array", "string"}
+    : keywords{"if", "else", "true", "false", "func", "while", "do", "for", "int",
+               "float", "bool", "array", "string", "break", "continue", "return",
+               "import", "class", "pure"},
+      kindNames{"if", "else", "true", "false", "func", "while", "do", "for", "int",
+                "float", "bool", "array", "string", "break", "continue", "return",
+                "import", "class", "pure",
+                "+", "-", "*", "/", "%", "=", "!", "<", ">", "&", "==", "!=", "<=", ">=", "&&", "||", "++", "--",
+                ",", ";", "(", ")", "{", "}", "[", "]", ".", ":",
+                "identifier", "int literal", "float literal", "string literal", "end of file", "unknown"}
 {
 }
+
+
+TokenKind GrammarImpl::operatorKind(std::string_view text)
+{
+    if (text.size() == 1)
+    {
+        return kCharKinds[(unsigned char)text[0]];
+    }
+    else if (text.size() == 2)
+    {
+        if (text[1] == '=')
+        {
+            switch (text[0])
+            {
+                case '=':
+                    return TokenKind::Equal;
+                case '!':
+                    return TokenKind::NotEqual;
+                case '<':
+                    return TokenKind::LessEqual;
+                case '>':
+                    return TokenKind::GreaterEqual;
+                default:
+                    return TokenKind::Unknown;
+            }
+        }
+        else if (text[0] == text[1])
+        {
+            switch (text[0])
+            {
+                case '&':
+                    return TokenKind::And;
+                case '|':
+                    return TokenKind::Or;
+                case '+':
+                    return TokenKind::Increment;
+                case '-':
+                    return TokenKind::Decrement;
+                default:
+                    return TokenKind::Unknown;
+            }
+        }
+    }
+
+    return TokenKind::Unknown;
+}
@@ -9,30 +9,249 @@
 
 #pragma once
 #include "SingletonT.hpp"
+#include <array>
+#include <cstdint>
 #include <string>
-#include <unordered_set>
+#include <string_view>
+
+/* Keywords are interned first by the SymbolTable so the symbol for a keyword is its KeywordID */
+enum class KeywordID : uint32_t
+{
+    If,
+    Else,
+    True,
+    False,
+    Func,
+    While,
+    Do,
+    For,
+    Int, /* Data types */
+    Float,
+    Bool,
+    Array,
+    String,
+    Break,
+    Continue,
+    Return,
+    Import,
+    Class,
+    Pure,
+    Count
+};
+
+
+/*
+ * One kind for each keyword, operator and punctuation character so the parser can dispatch on a single integer.
+ * Keywords come first and have the same values as KeywordID.
+ */
+enum class TokenKind : uint8_t
+{
+    /* Keywords */
+    If,
+    Else,
+    True,
+    False,
+    Func,
+    While,
+    Do,
+    For,
+    Int,
+    Float,
+    Bool,
+    Array,
+    String,
+    Break,
+    Continue,
+    Return,
+    Import,
+    Class,
+    Pure,
+
+    /* Operators */
+    Plus,         /* + */
+    Minus,        /* - */
+    Star,         /* * */
+    Slash,        /* / */
+    Percent,      /* % */
+    Assign,       /* = */
+    Not,          /* ! */
+    Less,         /* < */
+    Greater,      /* > */
+    Ampersand,    /* & */
+    Equal,        /* == */
+    NotEqual,     /* != */
+    LessEqual,    /* <= */
+    GreaterEqual, /* >= */
+    And,          /* && */
+    Or,           /* || */
+    Increment,    /* ++ */
+    Decrement,    /* -- */
+
+    /* Punctuation */
+    Comma,
+    Semicolon,
+    LeftParen,
+    RightParen,
+    LeftBrace,
+    RightBrace,
+    LeftBracket,
+    RightBracket,
+    Dot,
+    Colon,
+
+    /* Other */
+    Identifier,
+    IntLiteral,
+    FloatLiteral,
+    StringLiteral,
+    EndOfFile,
+    Unknown,
+    Count
+};
+
+static_assert((uint32_t)TokenKind::Pure == (uint32_t)KeywordID::Pure, "keyword kinds must match KeywordID");
+
+
+/* Lexer character classes. Each character belongs to exactly one class */
+enum class CharClass : uint8_t
+{
+    Invalid,
+    End, /* '\0' */
+    WhiteSpace,
+    Digit,
+    ID, /* Letters and '_' */
+    Quote,
+    Operator,
+    Punctuation,
+    Hash /* Start of shebang */
+};
+
+
+/* Lookup table for all 256 characters */
+using CharClassTable = std::array<CharClass, 256>;
+
+constexpr CharClassTable makeCharClassTable()
+{
+    CharClassTable table{};
+
+    table['\0'] = CharClass::End;
+
+    for (unsigned char c : {' ', '\t', '\n', '\v', '\f', '\r'})
+        table[c] = CharClass::WhiteSpace;
+
+    for (unsigned char c = '0'; c <= '9'; ++c)
+        table[c] = CharClass::Digit;
+
+    for (unsigned char c = 'a'; c <= 'z'; ++c)
+        table[c] = table[c - 'a' + 'A'] = CharClass::ID;
+
+    table['_'] = CharClass::ID;
+    table['"'] = CharClass::Quote;
+    table['#'] = CharClass::Hash;
+
+    for (unsigned char c : {'+', '-', '*', '/', '%', '&', '|', '<', '>', '=', '!'})
+        table[c] = CharClass::Operator;
+
+    for (unsigned char c : {',', ';', '(', ')', '{', '}', '[', ']', '.', ':'})
+        table[c] = CharClass::Punctuation;
+
+    return table;
+}
+
+
+/* Kinds of single character operators and punctuation */
+constexpr std::array<TokenKind, 256> makeCharKindTable()
+{
+    std::array<TokenKind, 256> table{};
+
+    for (auto &kind : table)
+        kind = TokenKind::Unknown;
+
+    table['+'] = TokenKind::Plus;
+    table['-'] = TokenKind::Minus;
+    table['*'] = TokenKind::Star;
+    table['/'] = TokenKind::Slash;
+    table['%'] = TokenKind::Percent;
+    table['='] = TokenKind::Assign;
+    table['!'] = TokenKind::Not;
+    table['<'] = TokenKind::Less;
+    table['>'] = TokenKind::Greater;
+    table['&'] = TokenKind::Ampersand;
+
+    table[','] = TokenKind::Comma;
+    table[';'] = TokenKind::Semicolon;
+    table['('] = TokenKind::LeftParen;
+    table[')'] = TokenKind::RightParen;
+    table['{'] = TokenKind::LeftBrace;
+    table['}'] = TokenKind::RightBrace;
+    table['['] = TokenKind::LeftBracket;
+    table[']'] = TokenKind::RightBracket;
+    table['.'] = TokenKind::Dot;
+    table[':'] = TokenKind::Colon;
+
+    return table;
+}
+
+
+/* Higher binds tighter */
+constexpr std::array<uint8_t, (size_t)TokenKind::Count> makePrecedenceTable()
+{
+    std::array<uint8_t, (size_t)TokenKind::Count> table{};
+
+    table[(size_t)TokenKind::Assign] = 1;
+    table[(size_t)TokenKind::Or] = 2;
+    table[(size_t)TokenKind::And] = 3;
+
+    for (TokenKind kind : {TokenKind::Less, TokenKind::Greater, TokenKind::LessEqual, TokenKind::GreaterEqual,
+                           TokenKind::Equal, TokenKind::NotEqual})
+        table[(size_t)kind] = 7;
+
+    table[(size_t)TokenKind::Plus] = table[(size_t)TokenKind::Minus] = 10;
+    table[(size_t)TokenKind::Star] = table[(size_t)TokenKind::Slash] = table[(size_t)TokenKind::Percent] = 20;
+
+    return table;
+}
+
 
 class GrammarImpl
 {
 public:
-    bool isDataType(const std::string &value) { return dataTypes.count(value); }
-    bool isKeyword(const std::string &value) { return keywords.count(value); }
-    bool isOperator(char c) { return operators.count(c); }
-    bool isPunctuation(char c) { return punctuation.count(c); }
+    using KeywordNames = std::array<const char *, (size_t)KeywordID::Count>;
+    using KindNames = std::array<const char *, (size_t)TokenKind::Count>;
+    using PrecedenceTable = std::array<uint8_t, (size_t)TokenKind::Count>;
+
+    bool isDataType(uint32_t symbol) const { return (symbol >= (uint32_t)KeywordID::Int && symbol <= (uint32_t)KeywordID::String); }
+    bool isKeyword(uint32_t symbol) const { return (symbol < (uint32_t)KeywordID::Count); }
+    bool isOperator(char c) const { return (charClass(c) == CharClass::Operator); }
+    bool isPunctuation(char c) const { return (charClass(c) == CharClass::Punctuation); }
+
+    static CharClass charClass(char c) { return kCharClasses[(unsigned char)c]; }
+
+    /* Returns the kind for an operator or punctuation token (Unknown if not recognized) */
+    static TokenKind operatorKind(std::string_view text);
+    static TokenKind punctuationKind(char c) { return kCharKinds[(unsigned char)c]; }
+
+    /* Binary operator precedence. Zero if the kind is not a binary operator */
+    static int precedence(TokenKind kind) { return kPrecedence[(size_t)kind]; }
+
+    /* Text for a kind (i.e. "while", "==", "{") */
+    const char *kindName(TokenKind kind) const { return kindNames[(size_t)kind]; }
+
+    /* Names ordered by KeywordID */
+    const KeywordNames &keywordNames() const { return keywords; }
 
 protected:
     friend class SingletonT<GrammarImpl>; /* Can use constructor */
     GrammarImpl();                        /* Prevent initialization except in Singleton */
 
 private:
-    using StringSet = std::unordered_set<std::string>;
-    using CharSet = std::unordered_set<char>;
+    static constexpr CharClassTable kCharClasses{makeCharClassTable()};
 
-    const CharSet punctuation;
-    const CharSet operators;
+    static constexpr std::array<TokenKind, 256> kCharKinds{makeCharKindTable()};
+    static constexpr PrecedenceTable kPrecedence{makePrecedenceTable()};
 
-    const StringSet keywords;
-    const StringSet dataTypes;
+    const KeywordNames keywords;
+    const KindNames kindNames;
 };
 
 using Grammar = SingletonT<GrammarImpl>;
@@ -7,19 +7,58 @@
 
 #include "EucleiaInterpreter.hpp"
 
+#include "BytecodeCompiler.hpp"
 #include "FileParser.hpp"
+#include "InterpreterContext.hpp"
+#include "Logger.hpp"
 #include "Scope.hpp"
+#include "Stringify.hpp"
+#include "VirtualMachine.hpp"
 #include <iostream>
 
 // TODO: - Parser() should have empty constructor. Should call parseFile method with string to run parser.
-void Interpreter::evaluateFile(const std::string &fpath)
+void Interpreter::evaluateFile(const std::string &fpath, Engine engine, bool useCache)
 {
     // 1. Generate abstract symbol tree.
-    BaseNode::Ptr ast = FileParser::parseMainFile(fpath);
+    FileParser::Statistics parseStatistics;
+
+    BaseNode::Ptr ast = FileParser::parseMainFile(fpath, useCache, &parseStatistics);
+
+    log().debug(eucleia::stringify("constant folding removed %zu nodes", parseStatistics.numFolded));
+
+    if (engine == Engine::Bytecode)
+    {
+        BytecodeProgram::Ptr program = BytecodeCompiler::compile(ast);
+
+        if (program)
+        {
+            VirtualMachine(std::move(program)).run();
+            return;
+        }
+
+        log().debug("falling back to tree-walker for " + fpath);
+    }
+
+    // 2. Create runtime state and global scope.
+    InterpreterContext context;
+    InterpreterContext::CurrentContext currentContext(context);
 
-    // 2. Create global scope.
     Scope globalScope;
 
     // 3. Evaluate AST.
     (void)ast->evaluate(globalScope);
+
+    const auto &statistics = context.collector().statistics();
+
+    log().debug(eucleia::stringify("cycle collector: %llu collections, %llu objects freed, %.3fms paused (max %.3fms)",
+                                   (unsigned long long)statistics.collections,
+                                   (unsigned long long)statistics.objectsFreed,
+                                   1e-6 * (double)statistics.totalPause.count(),
+                                   1e-6 * (double)statistics.maxPause.count()));
+}
+
+
+PreparedScript Interpreter::compile(const std::string &fpath, bool useCache)
+{
+    return PreparedScript(FileParser::parseMainFile(fpath, useCache));
 }
@@ -8,6 +8,7 @@
 #ifndef EucleiaInterpreter_hpp
 #define EucleiaInterpreter_hpp
 
+#include "PreparedScript.hpp"
 #include <sstream>
 #include <string>
 #include <vector>
@@ -15,8 +16,17 @@
 class Interpreter // TODO: - just make a static class.
 {
 public:
-    /// Prints output to std::out.
-    static void evaluateFile(const std::string &fpath);
+    enum class Engine
+    {
+        TreeWalker, /* Evaluate AST nodes directly */
+        Bytecode    /* Compile to bytecode and run on the VM. Falls back to TreeWalker if unsupported */
+    };
+
+    /// Prints output to std::out. If useCache is set, the parsed program is reused from a .ekc file if the sources are unchanged.
+    static void evaluateFile(const std::string &fpath, Engine engine = Engine::TreeWalker, bool useCache = false);
+
+    /// Parses a program and evaluates its imports so that it can be run many times (i.e. by an embedding host).
+    static PreparedScript compile(const std::string &fpath, bool useCache = false);
 };
 
 #endif /* EucleiaInterpreter_hpp */
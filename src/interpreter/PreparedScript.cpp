@@ -0,0 +1,152 @@
+/**
+ * @file PreparedScript.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "PreparedScript.hpp"
+#include "AnyObject.hpp"
+#include "Exceptions.hpp"
+#include "FunctionCallNode.hpp"
+#include "FunctionNode.hpp"
+#include "InterpreterContext.hpp"
+#include "Scope.hpp"
+
+
+PreparedScript::PreparedScript(AnyNode::Ptr ast)
+    : _ast(std::move(ast)),
+      _context(std::make_unique<InterpreterContext>()),
+      _imports(std::make_unique<Scope>())
+{
+    if (!_ast || !_ast->isNodeType(NodeType::File))
+    {
+        ThrowException("expected the AST for a file");
+    }
+
+    InterpreterContext::CurrentContext currentContext(*_context);
+    evaluateImports();
+}
+
+
+PreparedScript::~PreparedScript()
+{
+    if (!_context) /* Moved */
+    {
+        return;
+    }
+
+    InterpreterContext::CurrentContext currentContext(*_context);
+
+    _globals.reset();
+    _imports.reset();
+
+    (void)_context->collector().collect(); /* Cycles created by the script */
+}
+
+
+PreparedScript::PreparedScript(PreparedScript &&) noexcept = default;
+
+
+PreparedScript &PreparedScript::operator=(PreparedScript &&other) noexcept
+{
+    if (this != &other)
+    {
+        PreparedScript previous(std::move(*this)); /* Destroys the scopes before the AST which owns their functions */
+
+        _ast = std::move(other._ast);
+        _context = std::move(other._context);
+        _imports = std::move(other._imports);
+        _globals = std::move(other._globals);
+    }
+
+    return *this;
+}
+
+
+void PreparedScript::evaluateImports()
+{
+    /* The global scope uses the entry-point file's layout. Imported variables are stored in its slots */
+    _imports->adoptLayout(_ast->scopeLayout());
+
+    for (const auto &node : _ast->children())
+    {
+        if (isImport(*node))
+        {
+            (void)node->evaluate(*_imports);
+
+            _context->checkNotInterrupted();
+        }
+    }
+}
+
+
+bool PreparedScript::isImport(const BaseNode &node)
+{
+    return (node.isNodeType(NodeType::File) || node.isNodeType(NodeType::Module));
+}
+
+
+void PreparedScript::run(const Bindings &bindings)
+{
+    InterpreterContext::CurrentContext currentContext(*_context);
+    _context->reset();
+
+    _globals.reset(); /* Destroyed in this context so that cached bindings are discarded */
+
+    auto globals = std::make_unique<Scope>();
+    *globals = *_imports;
+
+    for (const auto &[name, object] : bindings)
+    {
+        globals->linkObject(name, object);
+    }
+
+    for (const auto &node : _ast->children())
+    {
+        if (!isImport(*node))
+        {
+            (void)node->evaluate(*globals);
+
+            _context->checkNotInterrupted();
+        }
+    }
+
+    _globals = std::move(globals);
+}
+
+
+AnyObject::Ptr PreparedScript::call(const std::string &name, std::vector<AnyObject::Ptr> arguments)
+{
+    if (!_globals)
+    {
+        run();
+    }
+
+    InterpreterContext::CurrentContext currentContext(*_context);
+    _context->reset();
+
+    auto &object = _globals->getNamedObject(name);
+
+    if (!object->isType(AnyObject::_UserFunction))
+    {
+        ThrowException("'" + name + "' is not a function defined by the script");
+    }
+
+    auto &funcNode = object->getValue<BaseNode::Ptr>()->castNode<FunctionNode>();
+
+    return FunctionCallNode::call(funcNode, std::move(arguments), *_globals);
+}
+
+
+const Scope &PreparedScript::globals() const
+{
+    if (!_globals)
+    {
+        ThrowException("script has not been run");
+    }
+
+    return *_globals;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file PreparedScript.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AnyObject;
+class InterpreterContext;
+class Scope;
+
+/*
+ * A parsed program which can be run many times (see Interpreter::compile). Embedding hosts use it to avoid parsing the
+ * script for each request.
+ *
+ * - Imports are evaluated once when the script is prepared. Each run starts with a new global scope containing the
+ *   imported names (variables declared by imported files are shared between runs).
+ * - Bindings are linked into the global scope before the script is run. Use them for inputs which the script reads
+ *   but does not declare.
+ * - Functions defined by the last run can be called directly without running the script again.
+ *
+ * A script has its own InterpreterContext so separate scripts may run on separate threads. A single script must not be
+ * used by more than one thread at a time. An object may be bound to scripts running on several threads if none of them
+ * modify it.
+ */
+class PreparedScript
+{
+public:
+    using Bindings = std::unordered_map<std::string, std::shared_ptr<AnyObject>>;
+
+    explicit PreparedScript(AnyNode::Ptr ast);
+    ~PreparedScript();
+
+    PreparedScript(PreparedScript &&) noexcept;
+    PreparedScript &operator=(PreparedScript &&) noexcept;
+
+    /* Evaluates the script in a new global scope. Bound objects are shared with the script (not copied) */
+    void run(const Bindings &bindings = {});
+
+    /* Calls a function defined by the script. The script is run (without bindings) if it has not been run yet */
+    std::shared_ptr<AnyObject> call(const std::string &name, std::vector<std::shared_ptr<AnyObject>> arguments = {});
+
+    /* Global scope of the last run (i.e. for reading results). Throws if the script has not been run */
+    [[nodiscard]] const Scope &globals() const;
+
+protected:
+    /* Evaluates the imports of the entry-point file */
+    void evaluateImports();
+
+    /* Imported files and modules are evaluated once */
+    static bool isImport(const BaseNode &node);
+
+private:
+    AnyNode::Ptr _ast; /* Owns the functions in the scopes below so it is destroyed last */
+
+    std::unique_ptr<InterpreterContext> _context;
+
+    std::unique_ptr<Scope> _imports; /* Copied to create the global scope for each run */
+    std::unique_ptr<Scope> _globals; /* Last run */
+};
@@ -8,170 +8,99 @@
  */
 
 #include "CharStream.hpp"
-#include "Exceptions.hpp"
-#include "FileUtils.hpp"
-#include "Grammar.hpp"
 #include "Stringify.hpp"
 #include <algorithm>
 #include <cstring>
-#include <filesystem>
-#include <stdio.h>
-#include <stdlib.h>
 
-CharStream::CharStream(const std::string &path_) : path(path_)
-{
-    base = ptr = eucleia::loadFileContents(path.c_str());
-    line = col = 1;
-}
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-
-CharStream::~CharStream()
+CharStream::CharStream(const std::string &path_)
+    : path(path_),
+      file(eucleia::MappedFile::open(path_))
 {
-    if (base != nullptr)
-    {
-        free(base);
-    }
+    base = ptr = file->data();
+    end = base + file->size();
 }
 
 
-char CharStream::current() const
+void CharStream::skipWhiteSpace()
 {
-    if (!ptr)
-        ThrowException(location() + ": char pointer is NULL");
+    /* Most runs are a single space */
+    if (!isWhiteSpace())
+        return;
 
-    return (*ptr);
-}
+    ++ptr;
 
+#if defined(__SSE2__)
+    /*
+     * Check 16 characters at a time for indentation. The file is padded with '\0' characters so we can read past the
+     * end. Whitespace is ' ' or '\t'...'\r' (9-13).
+     */
+    const __m128i spaces = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i controlRange = _mm_set1_epi8('\r' - '\t');
 
-char CharStream::increment()
-{
-    if (isLast())
-        ThrowException(location() + ": cannot increment char pointer");
-
-    if (isNewLine()) // Before increment, current == '\n'
-    {
-        lineColCount[line++] = col; // NB: postfix not prefix operator!
-        col = 1;
-    }
-    else
+    while (true)
     {
-        ++col;
-    }
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
 
-    return *(++ptr);
-}
+        const __m128i isSpace = _mm_cmpeq_epi8(chars, spaces);
 
+        const __m128i offset = _mm_sub_epi8(chars, tab); /* Unsigned compare: (c - '\t') <= ('\r' - '\t') */
+        const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(offset, controlRange), offset);
 
-char CharStream::decrement()
-{
-    if (!ptr || ptr == base)
-        ThrowException(location() + ": cannot decrement char pointer");
+        const unsigned int mask = _mm_movemask_epi8(_mm_or_si128(isSpace, isControl));
 
-    (void)(--ptr);
+        if (mask != 0xFFFF)
+        {
+            ptr += __builtin_ctz(~mask);
+            return;
+        }
 
-    if (isNewLine())
-    {
-        --line;
-        col = endCol(line); // Get end column number.
-    }
-    else
-    {
-        --col;
+        ptr += 16; /* '\0' is not whitespace so we cannot pass the end */
     }
-
-    return current();
-}
-
-
-bool CharStream::isLast() const
-{
-    return (current() == '\0');
-}
-
-
-bool CharStream::isNewLine() const
-{
-    return (current() == '\n');
+#else
+    while (isWhiteSpace())
+        ++ptr;
+#endif
 }
 
 
-bool CharStream::isQuote() const
+void CharStream::skipLine()
 {
-    return (current() == '"');
+    skipUntil('\n');
 }
 
 
-bool CharStream::isComment()
+void CharStream::skipUntil(char c)
 {
-    if (isLast() || current() != '/')
-        return false;
+    /* memchr is vectorized */
+    auto found = static_cast<const char *>(std::memchr(ptr, c, end - ptr));
 
-    /* Find the next '/' for comment begin */
-    char next = increment();
-    decrement(); // Reset the pointer.
-
-    return (next == '/');
+    ptr = (found ? found : end);
 }
 
 
-bool CharStream::isShebang()
+unsigned int CharStream::currentLine() const
 {
-    /* Special UNIX char sequence '#!' */
-
-    if (isLast() || current() != '#')
-        return false;
-
-    /* Find the next '!' for shebang */
-    char next = increment();
-    decrement(); // Reset the pointer.
-
-    return (next == '!');
+    return 1 + std::count(base, ptr, '\n');
 }
 
 
-bool CharStream::isOperator() const
+unsigned int CharStream::currentCol() const
 {
-    return Grammar::instance().isOperator(current());
-}
+    const char *lineStart = ptr;
 
+    while (lineStart != base && lineStart[-1] != '\n')
+        --lineStart;
 
-bool CharStream::isPunctuation() const
-{
-    return Grammar::instance().isPunctuation(current());
-}
-
-
-bool CharStream::isDigit() const
-{
-    return isdigit(current());
-}
-
-
-bool CharStream::isWhiteSpace() const
-{
-    return (isspace(current()));
-}
-
-
-bool CharStream::isID() const
-{
-    char c = current();
-
-    return (c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'));
-}
-
-
-unsigned int CharStream::endCol(unsigned int lineNum) const
-{
-    auto iter = lineColCount.find(lineNum);
-    if (iter == lineColCount.end())
-        ThrowException(location() + eucleia::stringify(": no column count for line %u", lineNum));
-
-    return iter->second;
+    return 1 + (ptr - lineStart);
 }
 
 
 std::string CharStream::location() const
 {
-    return eucleia::stringify("(%s:%d:%d)", path.filename().c_str(), line, col);
-}
\ No newline at end of file
+    return eucleia::stringify("(%s:%d:%d)", path.filename().c_str(), currentLine(), currentCol());
+}
@@ -8,66 +8,108 @@
  */
 
 #pragma once
+#include "Exceptions.hpp"
+#include "FileUtils.hpp"
+#include "Grammar.hpp"
 #include <filesystem>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 
+/*
+ * Reads characters from a memory-mapped file. The stream only tracks a pointer into the file; the line and column are
+ * calculated from the offset when a location is required (i.e. for errors).
+ */
 class CharStream
 {
 public:
     CharStream() = delete;
     CharStream(const std::string &path);
 
-    ~CharStream();
+    ~CharStream() = default;
+
+    /* Mapped file. Views returned by view() are valid for the lifetime of the file */
+    [[nodiscard]] const eucleia::MappedFile::Ptr &source() const { return file; }
+
+    /* Current position in the file */
+    [[nodiscard]] const char *position() const { return ptr; }
+
+    /* Returns the characters from begin up to the current position */
+    [[nodiscard]] std::string_view view(const char *begin) const { return std::string_view(begin, ptr - begin); }
 
     // Returns the current character in the stream.
-    char current() const;
+    char current() const { return (*ptr); }
 
-    // Increments the pointer and returns the new current char.
-    char increment();
+    // Returns the next character without moving the stream ('\0' at the end).
+    char peek() const { return (isLast() ? '\0' : ptr[1]); }
 
-    // Decrements the pointer and returns the new current char.
-    char decrement();
+    // Returns the class of the current character.
+    CharClass currentClass() const { return GrammarImpl::charClass(*ptr); }
+
+    // Increments the pointer and returns the new current char.
+    inline char increment();
 
     // Returns true if there are no more characters to read.
-    bool isLast() const;
+    bool isLast() const { return (ptr == end); }
+
+    bool isNewLine() const { return (current() == '\n'); }
+
+    bool isQuote() const { return (currentClass() == CharClass::Quote); }
+
+    bool isComment() const { return (current() == '/' && peek() == '/'); }
 
-    bool isNewLine() const;
+    bool isShebang() const { return (current() == '#' && peek() == '!'); }
 
-    bool isQuote() const;
+    bool isPunctuation() const { return (currentClass() == CharClass::Punctuation); }
 
-    bool isComment();
+    bool isWhiteSpace() const { return (currentClass() == CharClass::WhiteSpace); }
 
-    bool isShebang();
+    bool isDigit() const { return (currentClass() == CharClass::Digit); }
 
-    bool isPunctuation() const;
+    bool isOperator() const { return (currentClass() == CharClass::Operator); }
 
-    bool isWhiteSpace() const;
+    bool isID() const { return (currentClass() == CharClass::ID); }
 
-    bool isDigit() const;
+    /* Skips characters of the class (or either class). The end of the file is never skipped */
+    inline void skipWhile(CharClass charClass, CharClass orClass);
 
-    bool isOperator() const;
+    /* Skips to the next non-whitespace character */
+    void skipWhiteSpace();
 
-    bool isID() const;
+    /* Skips to the end of the line (the '\n' character) */
+    void skipLine();
 
-    inline unsigned int currentLine() const { return line; }
+    /* Skips to the next occurrence of c or the end of the file */
+    void skipUntil(char c);
 
-    inline unsigned int currentCol() const { return col; }
+    unsigned int currentLine() const;
+
+    unsigned int currentCol() const;
 
     // Prints stream's location.
     std::string location() const;
 
 private:
-    unsigned int endCol(unsigned int lineNum) const;
-
     const std::filesystem::path path;
 
-    char *base{nullptr};
-    char *ptr{nullptr};
-
-    unsigned int line;
-    unsigned int col;
+    eucleia::MappedFile::Ptr file{nullptr};
 
-    // Required to handle user repeatedly decrementing.
-    std::unordered_map<unsigned int, unsigned int> lineColCount;
+    const char *base{nullptr};
+    const char *end{nullptr}; /* '\0' after the contents */
+    const char *ptr{nullptr};
 };
+
+
+char CharStream::increment()
+{
+    if (isLast())
+        ThrowException(location() + ": cannot increment char pointer");
+
+    return *(++ptr);
+}
+
+
+void CharStream::skipWhile(CharClass charClass, CharClass orClass)
+{
+    for (CharClass c = currentClass(); c == charClass || c == orClass; c = currentClass())
+        ++ptr;
+}
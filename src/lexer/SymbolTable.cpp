@@ -0,0 +1,56 @@
+/**
+ * @file SymbolTable.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "SymbolTable.hpp"
+#include "Exceptions.hpp"
+#include "Grammar.hpp"
+#include <cassert>
+
+
+SymbolTableImpl::SymbolTableImpl()
+{
+    for (const char *keyword : Grammar::instance().keywordNames())
+    {
+        (void)intern(keyword);
+    }
+
+    assert(_names.size() == (size_t)KeywordID::Count);
+}
+
+
+SymbolID SymbolTableImpl::intern(std::string_view name)
+{
+    LockGuard lock(_mutex);
+
+    auto iter = _symbolForName.find(name);
+    if (iter != _symbolForName.end())
+    {
+        return iter->second;
+    }
+
+    SymbolID symbol = (SymbolID)_names.size();
+
+    const std::string &stored = _names.emplace_back(name);
+    _symbolForName.emplace(stored, symbol);
+
+    return symbol;
+}
+
+
+const std::string &SymbolTableImpl::name(SymbolID symbol) const
+{
+    LockGuard lock(_mutex);
+
+    if (symbol >= _names.size())
+    {
+        ThrowException("invalid symbol " + std::to_string(symbol));
+    }
+
+    return _names[symbol];
+}
@@ -0,0 +1,53 @@
+/**
+ * @file SymbolTable.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "SingletonT.hpp"
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+using SymbolID = uint32_t;
+
+/*
+ * Interns identifiers and keywords so that the parser can compare them by ID. IDs are stable for the lifetime of the
+ * process and shared by all files. Keywords are interned on construction so their IDs match KeywordID.
+ */
+class SymbolTableImpl
+{
+public:
+    static constexpr SymbolID kNoSymbol{std::numeric_limits<SymbolID>::max()};
+
+    /* Returns the ID for a name, adding it if required (thread-safe) */
+    SymbolID intern(std::string_view name);
+
+    /* Returns the name for an ID (thread-safe) */
+    const std::string &name(SymbolID symbol) const;
+
+protected:
+    friend class SingletonT<SymbolTableImpl>;
+
+    /* Prevent direct initialization */
+    SymbolTableImpl();
+
+private:
+    /* Deque so that views of the names remain valid as names are added */
+    std::deque<std::string> _names;
+    std::unordered_map<std::string_view, SymbolID> _symbolForName;
+
+    using LockGuard = std::lock_guard<std::mutex>;
+
+    mutable std::mutex _mutex;
+};
+
+using SymbolTable = SingletonT<SymbolTableImpl>;
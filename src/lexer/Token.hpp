@@ -9,16 +9,21 @@
 
 #pragma once
 #include "Exceptions.hpp"
+#include "FileUtils.hpp"
+#include "Grammar.hpp"
+#include "SymbolTable.hpp"
 #include <cassert>
+#include <charconv>
 #include <queue>
 #include <string>
+#include <string_view>
 
 
-/* Stores a token */
-class Token : public std::string
+/* Stores a token. The text is a view into the source file which is kept alive by Tokens */
+class Token
 {
 public:
-    enum Type
+    enum Type : int8_t
     {
         NotSet = (-1),
         EndOfFile,
@@ -34,52 +39,123 @@ public:
     std::string typeToString() const;
 
     /* Constructors */
-    Token(Type type) : _type(type) {}
-    Token(std::string &value, Type type = NotSet) : std::string(value), _type(type) {}
-    Token(std::string &&value = "", Type type = NotSet) : std::string(value), _type(type) {}
+    Token(Type type = NotSet) : _type(type), _kind(type == EndOfFile ? TokenKind::EndOfFile : TokenKind::Unknown) {}
+    Token(std::string_view text, Type type, TokenKind kind, SymbolID symbol = SymbolTableImpl::kNoSymbol)
+        : _text(text), _type(type), _kind(kind), _symbol(symbol) {}
 
-    /* Reference to type */
-    [[nodiscard]] inline Type &type()
+    [[nodiscard]] inline Type type() const
     {
         return _type;
     }
 
-    [[nodiscard]] inline Type type() const
+    [[nodiscard]] inline TokenKind kind() const
     {
-        return _type;
+        return _kind;
+    }
+
+    [[nodiscard]] inline bool is(TokenKind kind) const
+    {
+        return (_kind == kind);
     }
 
-    /* Validates the type of a token */
-    [[nodiscard]] inline Token &validated(Type type)
+    /* Interned ID for Keyword, Variable and String tokens */
+    [[nodiscard]] inline SymbolID symbol() const
     {
-        assert(_type == type);
-        return (*this);
+        return _symbol;
     }
 
-    /* Cast to float */
+    [[nodiscard]] inline std::string_view view() const
+    {
+        return _text;
+    }
+
+    /* Copy of the text */
+    [[nodiscard]] inline std::string str() const
+    {
+        return std::string(_text);
+    }
+
+    [[nodiscard]] inline bool operator==(std::string_view text) const
+    {
+        return (_text == text);
+    }
+
+    [[nodiscard]] inline bool operator!=(std::string_view text) const
+    {
+        return (_text != text);
+    }
+
+    /* Cast to float. Throws if malformed or out of range */
     [[nodiscard]] inline double toFloat() const
     {
         assert(_type == Token::Float);
-        return strtof(data(), nullptr);
+
+        double value{0.0};
+        checkNumber(parseNumber(value));
+        return value;
     }
 
-    /* Cast to int */
+    /* Cast to int. Throws if malformed or out of range */
     [[nodiscard]] inline long toInt() const
     {
         assert(_type == Token::Int);
-        return strtold(data(), nullptr);
+
+        long value{0};
+        checkNumber(parseNumber(value));
+        return value;
+    }
+
+    /* Returns std::errc() if an Int or Float token can be converted. Otherwise the error (i.e. result_out_of_range) */
+    [[nodiscard]] inline std::errc numberError() const
+    {
+        if (_type == Token::Float)
+        {
+            double value;
+            return parseNumber(value);
+        }
+
+        long value;
+        return parseNumber(value);
     }
 
     /* Cast to bool */
     [[nodiscard]] inline bool toBool() const
     {
         assert(_type == Token::Keyword);
-        return (*this == "true");
+        return (_kind == TokenKind::True);
     }
 
 private:
+    /* The whole text must be converted */
+    template <typename TValue>
+    [[nodiscard]] std::errc parseNumber(TValue &value) const
+    {
+        const char *end = _text.data() + _text.size();
+
+        auto [last, error] = std::from_chars(_text.data(), end, value);
+
+        if (error == std::errc() && last != end)
+            return std::errc::invalid_argument;
+
+        return error;
+    }
+
+    void checkNumber(std::errc error) const
+    {
+        if (error == std::errc::result_out_of_range)
+            ThrowException("number '" + str() + "' is out of range");
+        else if (error != std::errc())
+            ThrowException("invalid number '" + str() + "'");
+    }
+
+    std::string_view _text;
+
     /* Type of the token */
     Type _type{Type::NotSet};
+
+    TokenKind _kind{TokenKind::Unknown};
+
+    SymbolID _symbol{SymbolTableImpl::kNoSymbol};
 };
 
 
@@ -99,10 +175,20 @@ public:
     /* empty() */
     using std::queue<Token>::empty;
 
+    /* Iterate over the remaining tokens without consuming them */
+    [[nodiscard]] auto begin() const { return c.begin(); }
+    [[nodiscard]] auto end() const { return c.end(); }
+
+    /* Source file viewed by the tokens */
+    [[nodiscard]] const eucleia::MappedFile::Ptr &source() const { return _source; }
+
 protected:
     friend class Tokenizer;
 
     using std::queue<Token>::push;
+
+    /* Source file viewed by the tokens */
+    eucleia::MappedFile::Ptr _source{nullptr};
 };
 
 
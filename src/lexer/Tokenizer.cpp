@@ -20,67 +20,58 @@ Tokens Tokenizer::buildTokens(const std::string &path)
     CharStream stream(path);
 
     Tokens tokens;
+    tokens._source = stream.source(); /* Keep file alive for token views */
 
-    while (!stream.isLast())
-    {
-        Token token = buildNextToken(stream);
-        log().debug("Parsed '" + token + "' => " + token.typeToString() + " " + stream.location());
+    size_t count = 0;
 
-        if (token.type() != Token::EndOfFile)
-            tokens.push(std::move(token));
+    for (Token token = buildNextToken(stream); token.type() != Token::EndOfFile; token = buildNextToken(stream))
+    {
+        tokens.push(std::move(token));
+        ++count;
     }
 
+    log().debug(eucleia::stringify("Parsed %zu tokens from %s", count, path.c_str()));
+
     return tokens;
 }
 
 
 Token Tokenizer::buildNextToken(CharStream &stream)
 {
-    if (stream.isLast())
-    {
-        return Token(Token::EndOfFile);
-    }
-    else if (stream.isComment() || stream.isShebang())
-    {
-        skipLine(stream);
-        return buildNextToken(stream);
-    }
-    else if (stream.isQuote())
-    {
-        return buildStringToken(stream);
-    }
-    else if (stream.isDigit())
-    {
-        return buildNumberToken(stream);
-    }
-    else if (stream.isWhiteSpace())
-    {
-        (void)stream.increment();
-        return buildNextToken(stream);
-    }
-    else if (stream.isPunctuation())
-    {
-        return buildPunctuationToken(stream);
-    }
-    else if (stream.isOperator())
-    {
-        return buildOperatorToken(stream);
-    }
-    else if (stream.isID())
+    while (true)
     {
-        return buildIDToken(stream);
+        switch (stream.currentClass())
+        {
+            case CharClass::End:
+                return Token(Token::EndOfFile);
+            case CharClass::WhiteSpace:
+                stream.skipWhiteSpace();
+                break;
+            case CharClass::Quote:
+                return buildStringToken(stream);
+            case CharClass::Digit:
+                return buildNumberToken(stream);
+            case CharClass::ID:
+                return buildIDToken(stream);
+            case CharClass::Punctuation:
+                return buildPunctuationToken(stream);
+            case CharClass::Operator:
+                if (!stream.isComment())
+                    return buildOperatorToken(stream);
+
+                stream.skipLine();
+                break;
+            case CharClass::Hash:
+                if (stream.isShebang())
+                {
+                    stream.skipLine();
+                    break;
+                }
+                [[fallthrough]];
+            default:
+                ThrowException(stream.location() + eucleia::stringify(": failed to process character: %c", stream.current()));
+        }
     }
-
-    ThrowException(stream.location() + eucleia::stringify(": failed to process character: %c", stream.current()));
-}
-
-
-void Tokenizer::skipLine(CharStream &stream)
-{
-    do
-    {
-        (void)stream.increment();
-    } while (!stream.isLast() && !stream.isNewLine());
 }
 
 
@@ -91,67 +82,23 @@ Token Tokenizer::buildStringToken(CharStream &stream)
         ThrowException(stream.location() + ": missing opening quote for string");
     }
 
-    // Allocate:
-    size_t capacity = 100;
-    size_t count = 0;
-
-    char *value = (char *)malloc(sizeof(char) * capacity);
-    if (!value)
-    {
-        ThrowException(stream.location() + ": failed to malloc array");
-    }
-
-    while (!stream.isLast())
-    {
-        (void)stream.increment();
-
-        if (stream.isQuote())
-        {
-            break;
-        }
-
-        value[count++] = stream.current();
+    (void)stream.increment(); // Skip opening quote.
 
-        if (count >= capacity)
-        {
-            capacity <<= 2; // Double capacity.
-
-            void *tempPtr = realloc(value, sizeof(char) * capacity);
-            if (!tempPtr) // Failed to resize array.
-            {
-                free(value); // Free old block.
-                ThrowException(stream.location() + ": failed to resize array");
-            }
+    const char *begin = stream.position();
 
-            value = (char *)tempPtr; // Resized array.
-        }
-    }
+    stream.skipUntil('"');
 
     if (!stream.isQuote()) // Should be the endquote.
     {
-        free(value); // Cleanup memory.
         ThrowException(stream.location() + ": missing end quote");
     }
 
+    std::string_view value = stream.view(begin);
+
     // Skip end-quote.
     (void)stream.increment();
 
-    // Terminate string:
-    value[count++] = '\0';
-
-    // Resize to fit:
-    if (count < capacity)
-    {
-        value = (char *)realloc(value, sizeof(char) * count);
-    }
-
-    // Create string token:
-    Token token = Token(std::string(value), Token::String);
-
-    // Handle memory:
-    free(value);
-
-    return token;
+    return Token(value, Token::String, TokenKind::StringLiteral, intern(value));
 }
 
 
@@ -164,8 +111,7 @@ Token Tokenizer::buildNumberToken(CharStream &stream)
 
     bool readDecimal = false;
 
-    int count = 0;
-    char value[100];
+    const char *begin = stream.position();
 
     while (stream.isDigit() || (stream.current() == '.'))
     {
@@ -179,14 +125,24 @@ Token Tokenizer::buildNumberToken(CharStream &stream)
             readDecimal = true;
         }
 
-        value[count++] = stream.current();
-
         (void)stream.increment();
     }
 
-    value[count] = '\0'; // Terminate.
+    Token token = readDecimal ? Token(stream.view(begin), Token::Float, TokenKind::FloatLiteral)
+                              : Token(stream.view(begin), Token::Int, TokenKind::IntLiteral);
 
-    return Token(std::string(value), readDecimal ? Token::Float : Token::Int);
+    std::errc error = token.numberError();
+
+    if (error == std::errc::result_out_of_range)
+    {
+        ThrowException(stream.location() + ": number out of range: " + token.str());
+    }
+    else if (error != std::errc())
+    {
+        ThrowException(stream.location() + ": invalid number: " + token.str());
+    }
+
+    return token;
 }
 
 
@@ -197,19 +153,17 @@ Token Tokenizer::buildIDToken(CharStream &stream)
         ThrowException(stream.location() + " : unexpected ID character");
     }
 
-    std::vector<char> buffer;
+    const char *begin = stream.position();
 
-    while (stream.isID() || stream.isDigit()) // Enable digits after first 'id' character so 'abc123' is allowed
-    {
-        buffer.push_back(stream.current());
-        (void)stream.increment();
-    }
+    stream.skipWhile(CharClass::ID, CharClass::Digit); // Enable digits after first 'id' character so 'abc123' is allowed
 
-    buffer.push_back('\0');
+    std::string_view name = stream.view(begin);
+    SymbolID symbol = intern(name);
 
-    std::string stringID(buffer.data());
+    if (Grammar::instance().isKeyword(symbol)) /* Keyword symbols are their kind */
+        return Token(name, Token::Keyword, static_cast<TokenKind>(symbol), symbol);
 
-    return Token(std::move(stringID), Grammar::instance().isKeyword(stringID) ? Token::Keyword : Token::Variable);
+    return Token(name, Token::Variable, TokenKind::Identifier, symbol);
 }
 
 
@@ -220,10 +174,10 @@ Token Tokenizer::buildPunctuationToken(CharStream &stream)
         ThrowException(stream.location() + ": expected punctuation");
     }
 
-    char buffer[2] = {stream.current(), '\0'};
+    const char *begin = stream.position();
     (void)stream.increment();
 
-    return Token(std::string(buffer), Token::Punctuation);
+    return Token(stream.view(begin), Token::Punctuation, GrammarImpl::punctuationKind(*begin));
 }
 
 
@@ -234,15 +188,32 @@ Token Tokenizer::buildOperatorToken(CharStream &stream)
         ThrowException(stream.location() + ": expected operator");
     }
 
-    std::vector<char> buffer; // Will allow other operators in future (ie +=).
+    const char *begin = stream.position(); // Will allow other operators in future (ie +=).
+
+    stream.skipWhile(CharClass::Operator, CharClass::Operator);
+
+    std::string_view text = stream.view(begin);
+
+    TokenKind kind = GrammarImpl::operatorKind(text);
+    if (kind == TokenKind::Unknown)
+    {
+        ThrowException(stream.location() + ": unknown operator '" + std::string(text) + "'");
+    }
+
+    return Token(text, Token::Operator, kind);
+}
+
 
-    while (stream.isOperator())
+SymbolID Tokenizer::intern(std::string_view name)
+{
+    auto iter = _symbolCache.find(name);
+    if (iter != _symbolCache.end())
     {
-        buffer.push_back(stream.current());
-        (void)stream.increment();
+        return iter->second;
     }
 
-    buffer.push_back('\0');
+    SymbolID symbol = SymbolTable::instance().intern(name);
+    _symbolCache.emplace(name, symbol);
 
-    return Token(std::string(buffer.data()), Token::Operator);
+    return symbol;
 }
@@ -9,8 +9,11 @@
 
 #pragma once
 #include "CharStream.hpp"
+#include "SymbolTable.hpp"
 #include "Token.hpp"
 #include <string>
+#include <string_view>
+#include <unordered_map>
 
 
 /* Builder class for Tokens */
@@ -29,8 +32,7 @@ protected:
     /* Construct tokens from a file */
     Tokens buildTokens(const std::string &path);
 
-    void skipLine(CharStream &stream);
-
+    /* Returns the next token (EndOfFile at the end). Skips whitespace and comments */
     Token buildNextToken(CharStream &stream);
 
     Token buildStringToken(CharStream &stream);
@@ -38,4 +40,11 @@ protected:
     Token buildIDToken(CharStream &stream);
     Token buildOperatorToken(CharStream &stream);
     Token buildPunctuationToken(CharStream &stream);
+
+    /* Interns an identifier or string literal. Cached to avoid locking the SymbolTable for repeated identifiers */
+    SymbolID intern(std::string_view name);
+
+private:
+    /* Views into the source file */
+    std::unordered_map<std::string_view, SymbolID> _symbolCache;
 };
@@ -11,33 +11,58 @@
 #include "Exceptions.hpp"
 #include "ObjectFactory.hpp"
 
-AddVariableNode::AddVariableNode(std::string name, AnyObject::Type type)
+AddVariableNode::AddVariableNode(std::string name, AnyObject::Type type, AnyObject::Type elementType)
     : LookupVariableNode(std::move(name)),
-      _variableType(type)
+      _variableType(type),
+      _elementType(elementType)
 {
     setType(NodeType::AddVariable);
 }
 
 AnyObject::Ptr AddVariableNode::evaluate(Scope &scope)
 {
-    /* TODO: - add support for functions (to enable passing to other functions, etc) */
-    auto objectPtr = ObjectFactory::allocate(_variableType);
-    scope.linkObject(name(), objectPtr);
+    auto objectPtr = allocate();
+    declare(scope, objectPtr);
 
     return objectPtr;
 }
 
 
+AnyObject::Ptr AddVariableNode::allocate() const
+{
+    /* TODO: - add support for functions (to enable passing to other functions, etc) */
+    return (_elementType != AnyObject::NotSet) ? ObjectFactory::allocateArray(_elementType) : ObjectFactory::allocate(_variableType);
+}
+
+
+void AddVariableNode::declare(Scope &scope, AnyObject::Ptr object) const
+{
+    if (_declaredSlot >= 0)
+    {
+        scope.defineSlot((uint32_t)_declaredSlot, std::move(object));
+
+        if (_shadowsCall)
+            Scope::invalidateBindings();
+    }
+    else
+        scope.linkObject(declaredName(), std::move(object));
+}
+
+
 /// Type checking.
 bool AddVariableNode::passesAssignmentTypeCheck(const AnyObject &assignObject) const
 {
-    return assignObject.isType(_variableType);
+    if (!assignObject.isType(_variableType))
+        return false;
+
+    /* Packed array declarations accept empty arrays and arrays packed with the same type */
+    return (_elementType == AnyObject::NotSet || assignObject.elementType() == _elementType || assignObject.arraySize() == 0);
 }
 
 
 std::string AddVariableNode::description() const
 {
-    return AnyObject::typeToString(_variableType);
+    return (_elementType != AnyObject::NotSet) ? AnyObject::typeToString(_elementType) + "[]" : AnyObject::typeToString(_variableType);
 }
 
 
@@ -55,7 +80,7 @@ AnyObject::Ptr AddReferenceVariableNode::evaluate(Scope &scope)
     // 1. Lookup the object associated with the variable name defined in this
     // scope or a parent scope (no issue with lifetimes such as to be bound
     // object going out of scope before our reference.
-    AnyObject::Ptr boundObject = scope.getNamedObject(name());
+    AnyObject::Ptr boundObject = lookupObject(scope);
 
     // TODO: - this will not work for classes/structs since they could point to different types.
     // 2. Type checking. The type of the reference must match that of the bound object.
@@ -66,7 +91,7 @@ AnyObject::Ptr AddReferenceVariableNode::evaluate(Scope &scope)
 
     // 3. Instead of creating a new object, we add the reference name and link
     // to this existing object in the scope.
-    scope.linkObject(referenceName, boundObject);
+    declare(scope, boundObject);
 
     return boundObject;
 }
\ No newline at end of file
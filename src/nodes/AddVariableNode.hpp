@@ -18,18 +18,43 @@ class AddVariableNode : public LookupVariableNode
 public:
     using Ptr = std::shared_ptr<AddVariableNode>;
 
-    AddVariableNode(std::string name, AnyObject::Type type);
+    /* Element type is set for packed array declarations (i.e. int[] a) */
+    AddVariableNode(std::string name, AnyObject::Type type, AnyObject::Type elementType = AnyObject::NotSet);
 
     // Creates a new empty variable of a given type to the scope (i.e. int a;).
     std::shared_ptr<AnyObject> evaluate(Scope &scope) override;
 
+    // Returns a new empty object of the declared type without adding it to a scope (i.e. for class fields).
+    [[nodiscard]] std::shared_ptr<AnyObject> allocate() const;
+
     std::string description() const;
 
+    [[nodiscard]] AnyObject::Type variableType() const { return _variableType; }
+
+    [[nodiscard]] AnyObject::Type elementType() const { return _elementType; }
+
     //  Type checking for variable assignment.
     bool passesAssignmentTypeCheck(const AnyObject &assignObject) const;
 
+    // Name of the variable added to the scope.
+    virtual const std::string &declaredName() const { return name(); }
+
+    // Set by VariableResolver. The variable is defined in a slot of the current scope instead of by name.
+    void resolveDeclaration(uint32_t slot) { _declaredSlot = (int)slot; }
+
+    // Set by VariableResolver. The declared name is also the name of a called function (see FunctionCallNode).
+    void setShadowsCall() { _shadowsCall = true; }
+
+    // Adds the object to the scope using the slot if resolved.
+    void declare(Scope &scope, std::shared_ptr<AnyObject> object) const;
+
 protected:
     const AnyObject::Type _variableType;
+    const AnyObject::Type _elementType;
+
+    int _declaredSlot{-1};
+
+    bool _shadowsCall{false};
 };
 
 
@@ -54,6 +79,8 @@ public:
      */
     std::shared_ptr<AnyObject> evaluate(Scope &scope) override;
 
+    const std::string &declaredName() const override { return referenceName; }
+
 protected:
     const std::string referenceName;
 };
\ No newline at end of file
@@ -14,4 +14,10 @@
 std::shared_ptr<AnyObject> AnyNode::evaluate(Scope &scope)
 {
     return _evaluateFunc(scope);
+}
+
+
+Value AnyNode::evaluateValue(Scope &scope)
+{
+    return _evaluateValueFunc ? _evaluateValueFunc(scope) : Value(_evaluateFunc(scope));
 }
\ No newline at end of file
@@ -8,10 +8,15 @@
  */
 
 #pragma once
+#include "AnyObject.hpp"
 #include "BaseNode.hpp"
+#include "NodeFunction.hpp"
 #include "PropertyInterface.hpp"
 #include "Scope.hpp"
-#include <functional>
+#include "ScopeLayout.hpp"
+#include "SymbolTable.hpp"
+#include "Value.hpp"
+#include <array>
 #include <memory>
 
 /* Generic node */
@@ -20,15 +25,52 @@ class AnyNode : public BaseNode
 public:
     using Ptr = std::shared_ptr<AnyNode>;
 
-    using EvaluateFunction = std::function<std::shared_ptr<class AnyObject>(Scope &)>;
+    using EvaluateFunction = NodeFunction<std::shared_ptr<class AnyObject>(Scope &)>;
+    using EvaluateValueFunction = NodeFunction<Value(Scope &)>;
 
-    explicit AnyNode(NodeType type, EvaluateFunction &&evaluateFunc)
-        : BaseNode(type), _evaluateFunc(std::move(evaluateFunc)) {}
+    /* NB: functions are constructed in-place so that they are stored in the same arena as the node */
+    template <class TEvaluate>
+    explicit AnyNode(NodeType type, TEvaluate &&evaluateFunc, BaseNodePtrVector children = {}, AnyObject::Type valueType = AnyObject::NotSet)
+        : BaseNode(type), _evaluateFunc(std::forward<TEvaluate>(evaluateFunc)), _children(std::move(children)), _valueType(valueType) {}
+
+    /* Nodes with an allocation-free path for immediate results */
+    template <class TEvaluate, class TEvaluateValue>
+    explicit AnyNode(NodeType type, TEvaluate &&evaluateFunc, TEvaluateValue &&evaluateValueFunc, BaseNodePtrVector children, AnyObject::Type valueType = AnyObject::NotSet)
+        : BaseNode(type), _evaluateFunc(std::forward<TEvaluate>(evaluateFunc)), _evaluateValueFunc(std::forward<TEvaluateValue>(evaluateValueFunc)), _children(std::move(children)), _valueType(valueType) {}
 
     std::shared_ptr<class AnyObject> evaluate(Scope &scope) final;
 
+    Value evaluateValue(Scope &scope) final;
+
+    /* Child nodes captured by the evaluate function (optional children are stored as nullptr) */
+    [[nodiscard]] const BaseNodePtrVector &children() const { return _children; }
+
+    [[nodiscard]] const BaseNode::Ptr &child(size_t index) const { return _children.at(index); }
+
+    /* Type produced by literal and cast nodes. NotSet for all other nodes */
+    [[nodiscard]] AnyObject::Type valueType() const { return _valueType; }
+
+    /* Layout of the scope created by Block, loop and File nodes. Filled-in by VariableResolver */
+    void setScopeLayout(ScopeLayout::Ptr layout) { _scopeLayout = std::move(layout); }
+
+    [[nodiscard]] ScopeLayout *scopeLayout() const { return _scopeLayout.get(); }
+
+    /* Replaces the evaluate function with a specialized version which behaves identically (see NodeFuser) */
+    template <class TEvaluate>
+    void specialize(TEvaluate &&evaluateFunc) { _evaluateFunc.reset(std::forward<TEvaluate>(evaluateFunc)); }
+
+    /* Names captured by Module, StructAccess and ClassMethodCall nodes. Required to serialize the AST */
+    void setSymbols(SymbolID first, SymbolID second = SymbolTableImpl::kNoSymbol) { _symbols = {first, second}; }
+
+    [[nodiscard]] SymbolID symbol(size_t index) const { return _symbols.at(index); }
+
 private:
     EvaluateFunction _evaluateFunc;
+    EvaluateValueFunction _evaluateValueFunc; /* Optional */
+    BaseNodePtrVector _children;
+    AnyObject::Type _valueType{AnyObject::NotSet};
+    ScopeLayout::Ptr _scopeLayout{nullptr}; /* Optional */
+    std::array<SymbolID, 2> _symbols{SymbolTableImpl::kNoSymbol, SymbolTableImpl::kNoSymbol};
 };
 
 
@@ -37,15 +79,26 @@ class AnyPropertyNode : public AnyNode, public PropertyInterface
 public:
     using Ptr = std::shared_ptr<AnyPropertyNode>;
 
-    explicit AnyPropertyNode(NodeType type, EvaluateFunction &&evaluateFunc, EvaluateFunction &&evaluateNoCloneFunc)
-        : AnyNode(type, std::move(evaluateFunc)),
-          _evaluateNoCloneFunc(std::move(evaluateNoCloneFunc)) {}
+    using SetFunction = NodeFunction<void(Scope &, const Value &)>;
+
+    /* NB: evaluateValue borrows the property (read-only) whereas evaluate returns a copy */
+    template <class TEvaluate, class TEvaluateValue, class TEvaluateNoClone, class TSet>
+    explicit AnyPropertyNode(NodeType type, TEvaluate &&evaluateFunc, TEvaluateValue &&evaluateValueFunc, TEvaluateNoClone &&evaluateNoCloneFunc, TSet &&setFunc, BaseNodePtrVector children = {})
+        : AnyNode(type, std::forward<TEvaluate>(evaluateFunc), std::forward<TEvaluateValue>(evaluateValueFunc), std::move(children)),
+          _evaluateNoCloneFunc(std::forward<TEvaluateNoClone>(evaluateNoCloneFunc)),
+          _setFunc(std::forward<TSet>(setFunc)) {}
 
     std::shared_ptr<class AnyObject> evaluateNoClone(Scope &scope) final
     {
         return _evaluateNoCloneFunc(scope);
     }
 
+    void setProperty(Scope &scope, const Value &value) final
+    {
+        _setFunc(scope, value);
+    }
+
 private:
     EvaluateFunction _evaluateNoCloneFunc;
+    SetFunction _setFunc;
 };
\ No newline at end of file
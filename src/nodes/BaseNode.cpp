@@ -0,0 +1,18 @@
+/**
+ * @file BaseNode.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "BaseNode.hpp"
+#include "Scope.hpp"
+#include "Value.hpp"
+
+
+Value BaseNode::evaluateValue(Scope &scope)
+{
+    return Value(evaluate(scope));
+}
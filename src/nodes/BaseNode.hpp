@@ -22,6 +22,7 @@ enum class NodeType
     If,
     ForLoop,
     Break,
+    Continue,
     Return,
     Not,
     While,
@@ -58,7 +59,7 @@ public:
     template <class TNode>
     const TNode &castNode() const
     {
-        return static_cast<TNode &>(*this);
+        return static_cast<const TNode &>(*this);
     }
 
 
@@ -82,6 +83,9 @@ public:
 
     virtual std::shared_ptr<class AnyObject> evaluate(class Scope &scope) = 0; // TODO: - can this be const-cast?
 
+    /* Evaluates to a NaN-boxed value. Override to avoid allocating objects for Int, Float and Bool results */
+    virtual class Value evaluateValue(class Scope &scope);
+
     void setType(NodeType type)
     {
         _type = type;
@@ -10,81 +10,118 @@
 #include "BinaryNode.hpp"
 #include "Exceptions.hpp"
 #include "ObjectFactory.hpp"
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 
-BinaryOperatorType BinaryNode::toBinaryOperator(const std::string &operatorString)
+BinaryOperatorType BinaryNode::toBinaryOperator(TokenKind kind)
 {
-    if (operatorString == "+")
-        return BinaryOperatorType::Add;
-    else if (operatorString == "-")
-        return BinaryOperatorType::Minus;
-    else if (operatorString == "*")
-        return BinaryOperatorType::Multiply;
-    else if (operatorString == "/")
-        return BinaryOperatorType::Divide;
-    else if (operatorString == "==")
-        return BinaryOperatorType::Equal;
-    else if (operatorString == "!=")
-        return BinaryOperatorType::NotEqual;
-    else if (operatorString == ">=")
-        return BinaryOperatorType::GreaterOrEqual;
-    else if (operatorString == ">")
-        return BinaryOperatorType::Greater;
-    else if (operatorString == "<=")
-        return BinaryOperatorType::LessOrEqual;
-    else if (operatorString == "<")
-        return BinaryOperatorType::Less;
-    else if (operatorString == "%")
-        return BinaryOperatorType::Modulo;
-    else if (operatorString == "&&")
-        return BinaryOperatorType::And;
-    else if (operatorString == "||")
-        return BinaryOperatorType::Or;
-
-    return BinaryOperatorType::Unknown;
+    switch (kind)
+    {
+        case TokenKind::Plus:
+            return BinaryOperatorType::Add;
+        case TokenKind::Minus:
+            return BinaryOperatorType::Minus;
+        case TokenKind::Star:
+            return BinaryOperatorType::Multiply;
+        case TokenKind::Slash:
+            return BinaryOperatorType::Divide;
+        case TokenKind::Equal:
+            return BinaryOperatorType::Equal;
+        case TokenKind::NotEqual:
+            return BinaryOperatorType::NotEqual;
+        case TokenKind::GreaterEqual:
+            return BinaryOperatorType::GreaterOrEqual;
+        case TokenKind::Greater:
+            return BinaryOperatorType::Greater;
+        case TokenKind::LessEqual:
+            return BinaryOperatorType::LessOrEqual;
+        case TokenKind::Less:
+            return BinaryOperatorType::Less;
+        case TokenKind::Percent:
+            return BinaryOperatorType::Modulo;
+        case TokenKind::And:
+            return BinaryOperatorType::And;
+        case TokenKind::Or:
+            return BinaryOperatorType::Or;
+        default:
+            return BinaryOperatorType::Unknown;
+    }
 }
 
 
 AnyObject::Ptr BinaryNode::evaluate(Scope &scope)
 {
-    auto leftEvaluated = _left->evaluate(scope);
-    auto rightEvaluated = _right->evaluate(scope);
-
     // Persist result by storing in outer scope.
-    return applyOperator(*leftEvaluated, *rightEvaluated);
+    return ObjectFactory::box(evaluateValue(scope));
+}
+
+
+Value BinaryNode::evaluateValue(Scope &scope)
+{
+    if (_fusedVariable)
+    {
+        const AnyObject &object = *_fusedVariable->lookupObject(scope);
+
+        if (object.isType(AnyObject::Int)) /* Otherwise evaluate normally (i.e. implicit casts) */
+            return applyOperator(object.getValue<long>(), _fusedConstant);
+    }
+
+    Value leftEvaluated = _left->evaluateValue(scope);
+    Value rightEvaluated = _right->evaluateValue(scope);
+
+    return applyOperator(leftEvaluated, rightEvaluated);
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(const AnyObject &left, const AnyObject &right) const
+Value BinaryNode::applyOperator(const Value &left, const Value &right) const
 {
-    if (left.isType(AnyObject::Bool) && right.isType(AnyObject::Bool))
+    if (left.isSmallInt() && right.isSmallInt()) /* Most common case */
     {
-        return applyOperator(left.getValue<bool>(), right.getValue<bool>());
+        return applyOperator(left.asInt(), right.asInt());
     }
-    if (left.isType(AnyObject::Int) && right.isType(AnyObject::Int))
+    else if (left.isBool() && right.isBool())
     {
-        return applyOperator(left.getValue<long>(), right.getValue<long>());
+        return applyOperator(left.asBool(), right.asBool());
     }
-    else if (left.isType(AnyObject::Float) && right.isType(AnyObject::Float)) /* Implicit casts */
+    else if (left.isFloat() && right.isFloat())
     {
-        return applyOperator(left.getValue<double>(), right.getValue<double>());
+        return applyOperator(left.asFloat(), right.asFloat());
     }
-    else if (left.isType(AnyObject::Int) && right.isType(AnyObject::Float))
+    else if (left.isInt() && right.isInt())
     {
-        return applyOperator((double)left.getValue<long>(), right.getValue<double>());
+        return applyOperator(left.asInt(), right.asInt());
     }
-    else if (left.isType(AnyObject::Float) && right.isType(AnyObject::Int))
+    else if (left.isInt() && right.isFloat()) /* Implicit casts */
     {
-        return applyOperator(left.getValue<double>(), (double)right.getValue<long>());
+        return applyOperator((double)left.asInt(), right.asFloat());
     }
-    else if (left.isType(AnyObject::String) && right.isType(AnyObject::String))
+    else if (left.isFloat() && right.isInt())
     {
-        return applyOperator(left.getValue<std::string>(), right.getValue<std::string>());
+        return applyOperator(left.asFloat(), (double)right.asInt());
     }
-    else if (left.isType(AnyObject::Array) && right.isType(AnyObject::Array))
+    else if (left.isHeap() && right.isHeap())
     {
-        return applyOperator(left.getValue<AnyObject::Vector>(), right.getValue<AnyObject::Vector>());
+        const AnyObject &leftObject = left.object();
+        const AnyObject &rightObject = right.object();
+
+        if (leftObject.isType(AnyObject::String) && rightObject.isType(AnyObject::String))
+        {
+            if (&leftObject == &rightObject || leftObject.sharesBuffer(rightObject)) /* Same object or copy (i.e. interned literals) */
+            {
+                if (_binaryOperator == BinaryOperatorType::Equal)
+                    return Value(true);
+                else if (_binaryOperator == BinaryOperatorType::NotEqual)
+                    return Value(false);
+            }
+
+            return applyOperator(leftObject.getValue<std::string>(), rightObject.getValue<std::string>());
+        }
+        else if (leftObject.isType(AnyObject::Array) && rightObject.isType(AnyObject::Array))
+        {
+            return applyOperator(leftObject, rightObject);
+        }
     }
 
     std::stringstream oss;
@@ -94,20 +131,33 @@ AnyObject::Ptr BinaryNode::applyOperator(const AnyObject &left, const AnyObject
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(const AnyObject::Vector &left, const AnyObject::Vector &right) const
+Value BinaryNode::applyOperator(const AnyObject &left, const AnyObject &right) const
 {
     switch (_binaryOperator)
     {
         case BinaryOperatorType::Add:
         {
-            // TODO: - this will probably require us to copy the vector otherwise we're doing shallow copying
-            AnyObject::Vector result;
+            if (left.elementType() != AnyObject::NotSet && left.elementType() == right.elementType())
+            {
+                std::vector<Value> elements; /* Result is packed */
+
+                elements.reserve(left.arraySize() + right.arraySize());
+
+                for (size_t i = 0; i < left.arraySize(); ++i)
+                    elements.push_back(left.arrayElement(i));
+
+                for (size_t i = 0; i < right.arraySize(); ++i)
+                    elements.push_back(right.arrayElement(i));
+
+                return Value(ObjectFactory::allocateArray(elements));
+            }
+
+            AnyObject::Vector result = left.arrayElements(); /* Elements are copied since they are modified in-place by indexed assignment */
+            AnyObject::Vector rightElements = right.arrayElements();
 
-            result.reserve(left.size() + right.size());
-            result.insert(result.end(), left.begin(), left.end());
-            result.insert(result.end(), right.begin(), right.end());
+            result.insert(result.end(), std::make_move_iterator(rightElements.begin()), std::make_move_iterator(rightElements.end()));
 
-            return ObjectFactory::allocate(std::move(result));
+            return Value(ObjectFactory::allocate(std::move(result)));
         }
         default:
             ThrowException("cannot apply operator to types Array, Array");
@@ -115,100 +165,100 @@ AnyObject::Ptr BinaryNode::applyOperator(const AnyObject::Vector &left, const An
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(bool left, bool right) const
+Value BinaryNode::applyOperator(bool left, bool right) const
 {
     switch (_binaryOperator)
     {
         case BinaryOperatorType::Equal:
-            return ObjectFactory::allocate(left == right);
+            return Value(left == right);
         case BinaryOperatorType::NotEqual:
-            return ObjectFactory::allocate(left != right);
+            return Value(left != right);
         case BinaryOperatorType::And:
-            return ObjectFactory::allocate(left && right);
+            return Value(left && right);
         case BinaryOperatorType::Or:
-            return ObjectFactory::allocate(left || right);
+            return Value(left || right);
         default:
             ThrowException("cannot apply operator to types Bool, Bool");
     }
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(long left, long right) const
+Value BinaryNode::applyOperator(long left, long right) const
 {
     switch (_binaryOperator)
     {
         case BinaryOperatorType::Add:
-            return ObjectFactory::allocate(left + right);
+            return Value(left + right);
         case BinaryOperatorType::Minus:
-            return ObjectFactory::allocate(left - right);
+            return Value(left - right);
         case BinaryOperatorType::Multiply:
-            return ObjectFactory::allocate(left * right);
+            return Value(left * right);
         case BinaryOperatorType::Divide:
-            return ObjectFactory::allocate(left / right);
+            return Value(left / right);
         case BinaryOperatorType::Equal:
-            return ObjectFactory::allocate(left == right);
+            return Value(left == right);
         case BinaryOperatorType::NotEqual:
-            return ObjectFactory::allocate(left != right);
+            return Value(left != right);
         case BinaryOperatorType::GreaterOrEqual:
-            return ObjectFactory::allocate(left >= right);
+            return Value(left >= right);
         case BinaryOperatorType::Greater:
-            return ObjectFactory::allocate(left > right);
+            return Value(left > right);
         case BinaryOperatorType::LessOrEqual:
-            return ObjectFactory::allocate(left <= right);
+            return Value(left <= right);
         case BinaryOperatorType::Less:
-            return ObjectFactory::allocate(left < right);
+            return Value(left < right);
         case BinaryOperatorType::Modulo:
-            return ObjectFactory::allocate(left % right);
+            return Value(left % right);
         case BinaryOperatorType::And:
-            return ObjectFactory::allocate(left && right);
+            return Value(left && right);
         case BinaryOperatorType::Or:
-            return ObjectFactory::allocate(left || right);
+            return Value(left || right);
         default:
             ThrowException("cannot apply operator to types Int, Int");
     }
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(double left, double right) const
+Value BinaryNode::applyOperator(double left, double right) const
 {
     switch (_binaryOperator)
     {
         case BinaryOperatorType::Add:
-            return ObjectFactory::allocate(left + right);
+            return Value(left + right);
         case BinaryOperatorType::Minus:
-            return ObjectFactory::allocate(left - right);
+            return Value(left - right);
         case BinaryOperatorType::Multiply:
-            return ObjectFactory::allocate(left * right);
+            return Value(left * right);
         case BinaryOperatorType::Divide:
-            return ObjectFactory::allocate(left / right);
+            return Value(left / right);
         case BinaryOperatorType::Equal:
-            return ObjectFactory::allocate(left == right);
+            return Value(left == right);
         case BinaryOperatorType::NotEqual:
-            return ObjectFactory::allocate(left != right);
+            return Value(left != right);
         case BinaryOperatorType::GreaterOrEqual:
-            return ObjectFactory::allocate(left >= right);
+            return Value(left >= right);
         case BinaryOperatorType::Greater:
-            return ObjectFactory::allocate(left > right);
+            return Value(left > right);
         case BinaryOperatorType::LessOrEqual:
-            return ObjectFactory::allocate(left <= right);
+            return Value(left <= right);
         case BinaryOperatorType::Less:
-            return ObjectFactory::allocate(left < right);
+            return Value(left < right);
         default:
             ThrowException("cannot apply operator to types Float, Float");
     }
 }
 
 
-AnyObject::Ptr BinaryNode::applyOperator(const std::string &left, const std::string &right) const
+Value BinaryNode::applyOperator(const std::string &left, const std::string &right) const
 {
     switch (_binaryOperator)
     {
         case BinaryOperatorType::Add:
-            return ObjectFactory::allocate(left + right);
+            return Value(ObjectFactory::allocate(left + right));
         case BinaryOperatorType::Equal:
-            return ObjectFactory::allocate(left == right);
+            return Value(left == right);
         case BinaryOperatorType::NotEqual:
-            return ObjectFactory::allocate(left != right);
+            return Value(left != right);
         default:
             ThrowException("cannot apply operator to types String, String");
     }
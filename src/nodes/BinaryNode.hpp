@@ -10,7 +10,10 @@
 #pragma once
 #include "AnyObject.hpp"
 #include "BaseNode.hpp"
+#include "Grammar.hpp"
+#include "LookupVariableNode.hpp"
 #include "Scope.hpp"
+#include "Value.hpp"
 #include <string>
 
 enum class BinaryOperatorType : int
@@ -35,30 +38,53 @@ enum class BinaryOperatorType : int
 class BinaryNode : public BaseNode
 {
 public:
-    BinaryNode(BaseNode::Ptr left, BaseNode::Ptr right, const std::string &binaryOperator)
+    BinaryNode(BaseNode::Ptr left, BaseNode::Ptr right, BinaryOperatorType binaryOperator)
         : _left(left),
           _right(right),
-          _binaryOperator(toBinaryOperator(binaryOperator))
+          _binaryOperator(binaryOperator)
     {
         setType(NodeType::Binary);
     }
 
+    /* Converts an operator token kind to the enum. Returns Unknown if not a binary operator */
+    static BinaryOperatorType toBinaryOperator(TokenKind kind);
+
     AnyObject::Ptr evaluate(Scope &scope) override;
 
-protected:
-    AnyObject::Ptr applyOperator(const AnyObject &left, const AnyObject &right) const;
+    /* Int, Float and Bool results are returned inline without allocating */
+    Value evaluateValue(Scope &scope) override;
+
+    [[nodiscard]] const BaseNode::Ptr &left() const { return _left; }
 
-    AnyObject::Ptr applyOperator(bool left, bool right) const;
-    AnyObject::Ptr applyOperator(long left, long right) const;
-    AnyObject::Ptr applyOperator(double left, double right) const;
-    AnyObject::Ptr applyOperator(const std::string &left, const std::string &right) const;
-    AnyObject::Ptr applyOperator(const AnyObject::Vector &left, const AnyObject::Vector &right) const;
+    [[nodiscard]] const BaseNode::Ptr &right() const { return _right; }
 
-    /* Convert string to enum (faster if doing lost of comparisons) */
-    static BinaryOperatorType toBinaryOperator(const std::string &operatorString);
+    [[nodiscard]] BinaryOperatorType binaryOperator() const { return _binaryOperator; }
+
+    /* Set by NodeFuser if the left operand is a variable and the right operand is an Int literal (i.e. n - 1). Int
+     * variables are then evaluated without calling the operand nodes */
+    void fuseVariableWithConstant(const LookupVariableNode *variable, long constant)
+    {
+        _fusedVariable = variable;
+        _fusedConstant = constant;
+    }
+
+    [[nodiscard]] bool isFused() const { return (_fusedVariable != nullptr); }
+
+protected:
+    Value applyOperator(const Value &left, const Value &right) const;
+
+    Value applyOperator(bool left, bool right) const;
+    Value applyOperator(long left, long right) const;
+    Value applyOperator(double left, double right) const;
+    Value applyOperator(const std::string &left, const std::string &right) const;
+    /* Arrays */
+    Value applyOperator(const AnyObject &left, const AnyObject &right) const;
 
 private:
     BaseNode::Ptr _left{nullptr};
     BaseNode::Ptr _right{nullptr};
     BinaryOperatorType _binaryOperator{BinaryOperatorType::Unknown};
+
+    const LookupVariableNode *_fusedVariable{nullptr}; /* Owned by _left */
+    long _fusedConstant{0};
 };
\ No newline at end of file
@@ -10,7 +10,18 @@
 #include "ClassDefinitionNode.hpp"
 #include "AnyObject.hpp"
 #include "Exceptions.hpp"
+#include "InterpreterContext.hpp"
 #include "ObjectFactory.hpp"
+#include <algorithm>
+#include <atomic>
+
+
+namespace
+{
+
+std::atomic<uint64_t> gNextClassId{1};
+
+} // namespace
 
 
 ClassDefinitionNode::ClassDefinitionNode(std::string typeName_,
@@ -41,103 +52,114 @@ std::shared_ptr<ClassDefinitionNode> ClassDefinitionNode::lookupParent(const Sco
 
 AnyObject::Ptr ClassDefinitionNode::evaluate(Scope &scope)
 {
-    if (active)
-    {
-        ThrowException(typeName + " is already defined");
-    }
-
-    active = true;
+    /* The parent is resolved in the scope so each evaluation activates a copy. The AST node is not modified */
+    auto definition = std::make_shared<ClassDefinitionNode>(*this);
+    definition->active = true;
+    definition->_classId = gNextClassId.fetch_add(1, std::memory_order_relaxed);
 
-    buildVariableDefHashMap(scope);
-    buildMethodDefsHashMap(scope);
+    definition->buildLayout(scope);
 
-    /* NB: wrap-up in an object shared pointer */
-    auto objectWrapper = ObjectFactory::allocate(shared_from_this(), AnyObject::_ClassDefinition);
+    /* NB: wrap-up in an object shared pointer. Throws if the class is already defined in the scope */
+    auto objectWrapper = ObjectFactory::allocate(std::static_pointer_cast<BaseNode>(definition), AnyObject::_ClassDefinition);
 
     scope.linkObject(typeName, objectWrapper);
     return objectWrapper;
 }
 
 
-void ClassDefinitionNode::installVariablesInScope(Scope &scope) const
+void ClassDefinitionNode::initializeInstance(Scope &instanceScope) const
 {
     if (!active)
     {
-        ThrowException("the struct definition is inactive!");
+        ThrowException("the class definition is inactive!");
     }
 
-    for (auto iter = allVariableDefsMap.begin(); iter != allVariableDefsMap.end(); ++iter)
-    {
-        (void)iter->second->evaluate(scope);
-    }
-}
+    instanceScope.adoptLayout(_instanceLayout.get());
+    instanceScope.setIsInstanceScope();
 
+    uint32_t slot = 0;
 
-void ClassDefinitionNode::installMethodsInScope(Scope &scope) const
-{
-    if (!active)
+    for (const auto &field : _fields)
     {
-        ThrowException("The class definition is inactive!");
+        instanceScope.defineSlot(slot++, field->allocate());
     }
 
-    for (auto &[name, funcNode] : allMethodDefsMap)
+    for (const auto &methodObject : _methodObjects)
     {
-        (void)funcNode->evaluate(scope);
+        instanceScope.defineSlot(slot++, methodObject);
     }
 }
 
 
-void ClassDefinitionNode::buildVariableDefHashMap(const Scope &scope)
+void ClassDefinitionNode::buildLayout(const Scope &scope)
 {
-    if (!allVariableDefsMap.empty())
+    auto parent = lookupParent(scope);
+    if (parent)
     {
-        return; // Already built.
+        _fields = parent->_fields;
+        _methods = parent->_methods;
+        _methodObjects = parent->_methodObjects; /* Shared until overridden */
     }
 
-    auto parent = lookupParent(scope);
-    if (parent)
+    for (const auto &variableDef : variableDefs)
     {
-        parent->buildVariableDefHashMap(scope); // TODO: - unnecessary
+        for (const auto &field : _fields)
+        {
+            if (field->name() == variableDef->name())
+                ThrowException("duplicate class variable " + field->name());
+        }
 
-        // Copy parent definitions.
-        allVariableDefsMap = parent->allVariableDefsMap;
+        _fields.push_back(variableDef);
     }
 
-    // Now we add our own variable definitions and check for any clashes.
-    for (AddVariableNode::Ptr &variableDef : variableDefs)
+    // We are not going to be too smart initially. We just replace methods with
+    // the same name even with different numbers and types of arguments.
+    for (const auto &methodDef : methodDefs)
     {
-        auto iter = allVariableDefsMap.find(variableDef->name());
-        if (iter != allVariableDefsMap.end())
+        auto methodObject = ObjectFactory::allocate(std::static_pointer_cast<BaseNode>(methodDef), AnyObject::_UserFunction);
+
+        auto iter = std::find_if(_methods.begin(), _methods.end(), [&methodDef](const FunctionNode::Ptr &method)
+        { return (method->_funcName == methodDef->_funcName); });
+
+        if (iter != _methods.end())
         {
-            ThrowException("duplicate class variable " + iter->first);
+            _methodObjects[iter - _methods.begin()] = std::move(methodObject);
+            *iter = methodDef;
+        }
+        else
+        {
+            _methods.push_back(methodDef);
+            _methodObjects.push_back(std::move(methodObject));
         }
-
-        allVariableDefsMap[variableDef->name()] = variableDef;
     }
-}
 
+    /* Fields followed by methods */
+    _instanceLayout = std::make_shared<ScopeLayout>();
 
-void ClassDefinitionNode::buildMethodDefsHashMap(const Scope &scope)
-{
-    if (!allMethodDefsMap.empty())
+    auto addSlot = [this](const std::string &name)
     {
-        return;
-    }
+        if (_instanceLayout->findSlot(name) != ScopeLayout::kNotFound)
+            ThrowException("duplicate class member " + name);
 
-    auto parent = std::static_pointer_cast<ClassDefinitionNode>(lookupParent(scope));
-    if (parent)
+        _instanceLayout->addSlot(name);
+        _slotSymbols.push_back(SymbolTable::instance().intern(name));
+
+        _memberMask |= InterpreterContext::nameMask(_slotSymbols.back());
+    };
+
+    for (const auto &field : _fields)
     {
-        parent->buildMethodDefsHashMap(scope); // Unnecessary since to be installed, this will already have happened.
+        addSlot(field->name());
+    }
 
-        // Copy parent methods.
-        allMethodDefsMap = parent->allMethodDefsMap;
+    for (const auto &method : _methods)
+    {
+        addSlot(method->_funcName);
     }
 
-    // Now we add our own methods and replace any existing methods with same name
-    // We are not going to be too smart initially. We just replace methods with
-    // the same name even with different numbers and types of arguments.
-    for (FunctionNode::Ptr funcDef : methodDefs)
+    /* Bound to the receiver of a method call (see ClassNode::callMethod) */
+    if (_instanceLayout->findSlot("this") != ScopeLayout::kNotFound)
     {
-        allMethodDefsMap[funcDef->_funcName] = funcDef;
+        ThrowException("'this' cannot be the name of a class member");
     }
-}
\ No newline at end of file
+}
@@ -11,9 +11,10 @@
 #include "AddVariableNode.hpp"
 #include "FunctionNode.hpp"
 #include "Scope.hpp"
+#include "ScopeLayout.hpp"
+#include "SymbolTable.hpp"
 #include <memory>
 #include <string>
-#include <unordered_set>
 #include <vector>
 
 
@@ -48,25 +49,51 @@ public:
     std::shared_ptr<class AnyObject> evaluate(Scope &scope) override;
 
     /**
-     * Calls evaluate method on all method nodes. Installs them in argument scope.
+     * Adopts the instance layout for the scope of a new instance. Fields are set to new objects and methods to the
+     * objects shared by all instances.
      */
-    void installMethodsInScope(Scope &scope) const;
+    void initializeInstance(Scope &instanceScope) const;
 
     /**
-     * Calls evaluate method on all variables in this struct and parents. Installs them in argument scope.
+     * Returns the slot of a field or method in the instance layout or ScopeLayout::kNotFound.
      */
-    void installVariablesInScope(Scope &scope) const;
+    [[nodiscard]] inline int findSlot(SymbolID symbol) const;
 
-protected:
     /**
-     * Builds the method map from parent classes.
+     * Returns the slot of a method in the instance layout or ScopeLayout::kNotFound (also for fields).
      */
-    void buildMethodDefsHashMap(const Scope &scope);
+    [[nodiscard]] inline int findMethod(SymbolID symbol) const;
+
+    /* Method in a slot returned by findMethod */
+    [[nodiscard]] FunctionNode &method(uint32_t slot) const { return *_methods[slot - _fields.size()]; }
+
+    /* Unique for each active definition. Identifies the class in method caches */
+    [[nodiscard]] uint64_t classId() const { return _classId; }
+
+    /* Names of the fields and methods (see InterpreterContext::shadowNames) */
+    [[nodiscard]] uint64_t memberMask() const { return _memberMask; }
+
+    /* Slots for the fields and methods of this class and its parents */
+    [[nodiscard]] const ScopeLayout &instanceLayout() const { return *_instanceLayout; }
+
+    /* Name of the class added to the scope */
+    [[nodiscard]] const std::string &className() const { return typeName; }
 
+    /* Name of the parent class or empty */
+    [[nodiscard]] const std::string &parentClassName() const { return parentTypeName; }
+
+    /* Variables defined by this class (excluding any inherited variables) */
+    [[nodiscard]] const std::vector<std::shared_ptr<AddVariableNode>> &variables() const { return variableDefs; }
+
+    /* Methods defined by this class (excluding any inherited methods) */
+    [[nodiscard]] const std::vector<FunctionNode::Ptr> &methods() const { return methodDefs; }
+
+protected:
     /**
-     * Builds the variableDefsMap from any parent classes and checks for clashing variables.
+     * Flattens the fields and methods of this class and its parents into the instance layout. Fields come first
+     * followed by the methods. Methods with the same name as a parent method replace it.
      */
-    void buildVariableDefHashMap(const Scope &scope);
+    void buildLayout(const Scope &scope);
 
     /**
      * Returns a pointer to the parent struct or nullptr if not found.
@@ -91,10 +118,9 @@ protected:
     std::vector<std::shared_ptr<class AddVariableNode>> variableDefs;
 
     /**
-     * We activate the definition once evaluate is called. This is when we can
-     * try to locate the definition of the parent if there is one and install
-     * it in the scope. We also refuse to allow more than one definition in the
-     * scope as you would expect so evaluate() cannot be called more than once!
+     * Set for the copy made by evaluate(). This is when we can locate the
+     * definition of the parent if there is one and install it in the scope.
+     * The definition in the AST is never active so it can be evaluated again.
      */
     bool active{false};
 
@@ -105,15 +131,44 @@ protected:
     std::vector<FunctionNode::Ptr> methodDefs;
 
     /**
-     * Stores our owned variables and those of any parent variables we inherit.
-     * To construct the object, we will call evaluate() method on each node.
+     * Set for active copies by buildLayout(). Fields of this class and its parents in slot order.
      */
-    std::unordered_map<std::string, std::shared_ptr<class AddVariableNode>> allVariableDefsMap;
+    std::vector<std::shared_ptr<class AddVariableNode>> _fields;
 
     /**
-     * Stores our owned methods and those of any parent methods we inherit. If
-     * we have a method with the same name as one in a parent class, we will
-     * "override" it by using our own.
+     * Methods of this class and its parents following the fields. Each method has a single object shared by all
+     * instances of the class (and of derived classes which do not override it).
      */
-    std::unordered_map<std::string, FunctionNode::Ptr> allMethodDefsMap;
-};
\ No newline at end of file
+    std::vector<FunctionNode::Ptr> _methods;
+    std::vector<std::shared_ptr<class AnyObject>> _methodObjects;
+
+    /**
+     * Slot names and symbols for the fields and methods. Members are found by comparing symbols (see findSlot).
+     */
+    ScopeLayout::Ptr _instanceLayout{nullptr};
+    std::vector<SymbolID> _slotSymbols;
+
+    uint64_t _memberMask{0};
+
+    uint64_t _classId{0};
+};
+
+
+int ClassDefinitionNode::findSlot(SymbolID symbol) const
+{
+    for (size_t slot = 0; slot < _slotSymbols.size(); ++slot) /* Classes have few members */
+    {
+        if (_slotSymbols[slot] == symbol)
+            return (int)slot;
+    }
+
+    return ScopeLayout::kNotFound;
+}
+
+
+int ClassDefinitionNode::findMethod(SymbolID symbol) const
+{
+    int slot = findSlot(symbol);
+
+    return (slot >= (int)_fields.size()) ? slot : ScopeLayout::kNotFound;
+}
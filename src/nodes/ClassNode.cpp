@@ -9,8 +9,11 @@
 
 #include "ClassNode.hpp"
 #include "AnyObject.hpp"
+#include "FunctionCallNode.hpp"
 #include "FunctionNode.hpp"
+#include "InterpreterContext.hpp"
 #include "ObjectFactory.hpp"
+#include "PoolAllocator.hpp"
 #include <cassert>
 
 
@@ -21,28 +24,47 @@ ClassNode::ClassNode(std::string typeName_, std::string name_)
 
 AnyObject::Ptr ClassNode::evaluate(Scope &scope)
 {
-    if (classDefinition)
-    {
-        ThrowException("Class [" + name + "] is already initialized!");
-    }
+    /* Each evaluation creates a new instance. The AST node is not modified */
+    auto instance = std::allocate_shared<ClassNode>(PoolAllocator::Allocator<ClassNode>(), typeName, name);
 
     // Initialize our instance from the struct definition defined in the scope.
     auto theObject = scope.getNamedObject(typeName);
 
-    classDefinition = std::static_pointer_cast<ClassDefinitionNode>(theObject->getValue<BaseNode::Ptr>());
+    instance->classDefinition = std::static_pointer_cast<ClassDefinitionNode>(theObject->getValue<BaseNode::Ptr>());
+    instance->classDefinition->initializeInstance(instance->_instanceScope);
 
-    classDefinition->installVariablesInScope(_instanceScope);
-    classDefinition->installMethodsInScope(_instanceScope);
+    // Add the instance to the scope.
+    auto wrappedClass = ObjectFactory::allocate(std::static_pointer_cast<BaseNode>(instance), AnyObject::Class);
 
-    // Add the active struct instance to the scope. TODO: - transfer ownership
-    // to the scope. Will have to remove this class from AST to do this correctly.
-    auto wrappedClass = ObjectFactory::allocate(shared_from_this(), AnyObject::Class);
+    if (_declaredSlot >= 0)
+        scope.defineSlot((uint32_t)_declaredSlot, wrappedClass);
+    else
+        scope.linkObject(name, wrappedClass);
 
-    scope.linkObject(name, wrappedClass);
     return wrappedClass;
 }
 
 
+AnyObject::Ptr ClassNode::callMethod(const AnyObject::Ptr &instanceObject, uint32_t methodSlot, FunctionCallNode &methodCallNode, Scope &scope)
+{
+    const auto &instance = static_cast<const ClassNode &>(*instanceObject->getValue<BaseNode::Ptr>());
+    const auto &definition = instance.definition();
+
+    /* Members of the receiver may shadow functions cached by call sites in its methods and their callees */
+    InterpreterContext::current().shadowNames(definition.memberMask());
+
+    Scope receiverScope(scope, instance._instanceScope, instanceObject);
+
+    return methodCallNode.callWith(definition.method(methodSlot), scope, receiverScope); /* Arguments in caller's scope */
+}
+
+
+void ClassNode::throwNoMember(SymbolID symbol) const
+{
+    ThrowException("class " + typeName + " has no member named " + SymbolTable::instance().name(symbol));
+}
+
+
 ClassNode &ClassNode::operator=(const ClassNode &other)
 {
     if (this == &other)
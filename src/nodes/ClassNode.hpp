@@ -38,11 +38,42 @@ public:
 
     [[nodiscard]] Scope &instanceScope() { return _instanceScope; }
 
+    /* Name of the class */
+    [[nodiscard]] const std::string &className() const { return typeName; }
+
+    /* Name of the variable added to the scope */
+    [[nodiscard]] const std::string &instanceName() const { return name; }
+
+    /* Set by VariableResolver. The instance is defined in a slot of the current scope instead of by name */
+    void resolveDeclaration(uint32_t slot) { _declaredSlot = (int)slot; }
+
+    /* Returns a field (or method) of an instance. Throws if the class has no member with the name */
+    [[nodiscard]] inline const std::shared_ptr<class AnyObject> &member(SymbolID symbol) const;
+
+    /* Definition of the class of the instance */
+    [[nodiscard]] const ClassDefinitionNode &definition() const { return *classDefinition; }
+
+    /**
+     * Calls a method of an instance. The method is evaluated in a scope which binds the instance to 'this' and can see
+     * its members. Its parent is the caller's scope so the method has access to variables defined outside the class.
+     * @param instanceObject The instance (i.e. the object for a ClassNode).
+     * @param methodSlot Slot of the method in the class layout (see ClassDefinitionNode::findMethod).
+     * @param methodCallNode The call. Its arguments are evaluated in the caller's scope.
+     */
+    static std::shared_ptr<class AnyObject> callMethod(const std::shared_ptr<class AnyObject> &instanceObject,
+                                                       uint32_t methodSlot,
+                                                       class FunctionCallNode &methodCallNode,
+                                                       Scope &scope);
+
 protected:
+    [[noreturn]] void throwNoMember(SymbolID symbol) const;
+
     /**
      * The struct has its own scope for storing its own variables. It does not
      * inherit from any parent scopes. Literally just used for storing stuff.
      * When this instance goes out of scope, all variables will be deleted.
+     * The scope uses the layout of the class definition so fields and methods
+     * are stored in slots (see ClassDefinitionNode::initializeInstance).
      */
     Scope _instanceScope;
 
@@ -53,7 +84,22 @@ protected:
     std::string name;
 
     /**
-     * Store the struct definition once active.
+     * Store the struct definition. Only set for the instances created by evaluate().
      */
     std::shared_ptr<ClassDefinitionNode> classDefinition{nullptr};
-};
\ No newline at end of file
+
+    int _declaredSlot{-1};
+};
+
+
+const std::shared_ptr<class AnyObject> &ClassNode::member(SymbolID symbol) const
+{
+    int slot = classDefinition->findSlot(symbol);
+
+    if (slot == ScopeLayout::kNotFound)
+    {
+        throwNoMember(symbol);
+    }
+
+    return _instanceScope.getSlotObject(0, (uint32_t)slot, classDefinition->instanceLayout().slotName(slot));
+}
\ No newline at end of file
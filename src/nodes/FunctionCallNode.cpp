@@ -12,93 +12,277 @@
 #include "AnyObject.hpp"
 #include "Exceptions.hpp"
 #include "FunctionNode.hpp"
-#include "JumpPoints.hpp"
 #include "ModuleFunctor.hpp"
 #include "Scope.hpp"
+#include <cassert>
+
+/* Inlined into evaluate() so that plain function calls are not slowed down by the method call path */
+__attribute__((always_inline)) inline AnyObject::Ptr FunctionCallNode::invoke(FunctionNode &funcNode, Scope &argumentScope, Scope &scope, InterpreterContext &context)
+{
+    {
+        // 3. Extend current scope (outside function) with names and values of function
+        // arguments.
+        Scope funcScope(scope, funcNode.funcScopeLayout.get());
+
+        // TODO: - evaluate all of the function's parameters in function scope to create uninitialized variables.
+        // THen call setObject with all of the arguments to update the values and our type-checker will ensure
+        // that the object types are compatible.
+
+        int iarg = 0;
+        for (const auto &argNode : _funcArgs)
+        {
+            // Evaluate all function arguments in external scope (outside function).
+            auto evaluatedArg = argNode->evaluate(argumentScope);
+
+            // Check that the evaluatedArg type (RHS) is compatible with the corresponding
+            // (LHS) variable.
+            auto &argVariable = funcNode._funcArgs[iarg++]->castNode<AddVariableNode>();
+            checkArgumentType(funcNode, argVariable, *evaluatedArg);
+
+            // Define variable in the function's scope.
+            argVariable.declare(funcScope, evaluatedArg);
+        }
+
+        // Evaluate the function body in our function scope now that we've added the
+        // call arguments.
+        (void)funcNode.funcBody->evaluate(funcScope);
+    }
+
+    return completeCall(funcNode, scope, context);
+}
+
 
 AnyObject::Ptr FunctionCallNode::evaluate(Scope &scope)
 {
+    auto &context = InterpreterContext::current();
+    auto &cache = context.callSiteCache(_cacheSlot); /* NB: invalidated by other calls */
+
+    if (cache.generation != context.bindingGeneration())
+    {
+        resolveFunction(scope, cache);
+    }
+
     // 0. Any library functions that we wish to evaluate.
-    auto someNode = scope.getNamedObject(_funcName);
-    if (someNode->isType(AnyObject::_ModuleFunction))
+    if (cache.moduleFunction)
     {
-        return someNode->getValue<ModuleFunctor>()(_funcArgs, scope);
+        return (*cache.moduleFunction)(_funcArgs, scope);
     }
 
-    // TODO: - finish implementing here. Should not be a shared pointer.
-    // 1. Get a pointer to the function node stored in this scope.
-    auto funcNode = std::static_pointer_cast<FunctionNode>(someNode->getValue<BaseNode::Ptr>());
+    auto *funcNode = cache.function;
 
-    // 2. Verify that the number of arguments matches those required for the
-    // function we are calling.
-    if (_funcArgs.size() != funcNode->_funcArgs.size())
+    if (funcNode == _tailCallOf)
+    {
+        prepareTailCall(*funcNode, scope, context);
+        return nullptr;
+    }
+
+    if (funcNode->isPure())
+    {
+        return evaluateMemoized(*funcNode, scope, scope);
+    }
+
+    return invoke(*funcNode, scope, scope, context);
+}
+
+
+AnyObject::Ptr FunctionCallNode::callWith(FunctionNode &funcNode, Scope &argumentScope, Scope &scope)
+{
+    if (_funcArgs.size() != funcNode._funcArgs.size())
     {
         char buffer[150];
         snprintf(buffer, 150, "expected %ld arguments but got %ld arguments for function '%s'.",
-                 funcNode->_funcArgs.size(),
+                 funcNode._funcArgs.size(),
                  _funcArgs.size(),
-                 _funcName.c_str());
+                 funcNode._funcName.c_str());
 
         ThrowException(buffer);
     }
 
-    // 3. Extend current scope (outside function) with names and values of function
-    // arguments.
-    auto funcScope(scope);
+    if (funcNode.isPure())
+    {
+        return evaluateMemoized(funcNode, argumentScope, scope);
+    }
+
+    return invoke(funcNode, argumentScope, scope, InterpreterContext::current());
+}
+
+
+AnyObject::Ptr FunctionCallNode::completeCall(FunctionNode &funcNode, Scope &scope, InterpreterContext &context)
+{
+    // 4. Tail calls reuse this frame. The previous function scope is destroyed before the next is created.
+    while (VALUE_UNLIKELY(context.completion == Completion::TailCall))
+    {
+        context.completion = Completion::Normal;
+
+        Scope funcScope(scope, funcNode.funcScopeLayout.get());
+        takeTailCallArguments(funcNode, funcScope, context);
 
-    // TODO: - evaluate all of the function's parameters in function scope to create uninitialized variables.
-    // THen call setObject with all of the arguments to update the values and our type-checker will ensure
-    // that the object types are compatible.
+        (void)funcNode.funcBody->evaluate(funcScope);
+    }
+
+    // Only return non-NULL if return seen.
+    return context.takeReturnValue();
+}
+
+
+AnyObject::Ptr FunctionCallNode::evaluateMemoized(FunctionNode &funcNode, Scope &argumentScope, Scope &scope)
+{
+    std::vector<AnyObject::Ptr> arguments;
+    arguments.reserve(_funcArgs.size());
 
-    int iarg = 0;
     for (const auto &argNode : _funcArgs)
     {
-        // Evaluate all function arguments in external scope (outside function).
-        auto evaluatedArg = argNode->evaluate(scope);
+        arguments.push_back(argNode->evaluate(argumentScope));
+    }
 
-        // Check that the evaluatedArg type (RHS) is compatible with the corresponding
-        // (LHS) variable.
-        auto &argVariable = funcNode->_funcArgs[iarg++]->castNode<AddVariableNode>();
+    return call(funcNode, std::move(arguments), scope);
+}
 
-        if (!argVariable.passesAssignmentTypeCheck(*evaluatedArg))
-        {
-            char buffer[150];
-            snprintf(buffer, 150, "incorrect type for argument '%s' of function '%s'. Expected type '%s'.",
-                     argVariable.name().c_str(),
-                     _funcName.c_str(),
-                     argVariable.description().c_str());
 
-            ThrowException(buffer);
+AnyObject::Ptr FunctionCallNode::call(FunctionNode &funcNode, std::vector<AnyObject::Ptr> arguments, Scope &scope)
+{
+    if (arguments.size() != funcNode._funcArgs.size())
+    {
+        char buffer[150];
+        snprintf(buffer, 150, "expected %ld arguments but got %ld arguments for function '%s'.",
+                 funcNode._funcArgs.size(),
+                 arguments.size(),
+                 funcNode._funcName.c_str());
+
+        ThrowException(buffer);
+    }
+
+    auto &context = InterpreterContext::current();
+
+    std::string key;
+    bool isStorable = funcNode.isPure();
+
+    for (size_t iarg = 0; iarg < arguments.size(); ++iarg)
+    {
+        checkArgumentType(funcNode, funcNode._funcArgs[iarg]->castNode<AddVariableNode>(), *arguments[iarg]);
+
+        isStorable = isStorable && FunctionMemo::appendKey(key, *arguments[iarg]);
+    }
+
+    AnyObject::Ptr result;
+
+    if (isStorable && context.memo(funcNode.cacheSlot()).find(key, result))
+    {
+        return result;
+    }
+
+    {
+        Scope funcScope(scope, funcNode.funcScopeLayout.get());
+
+        for (size_t iarg = 0; iarg < arguments.size(); ++iarg)
+        {
+            funcNode._funcArgs[iarg]->castNode<AddVariableNode>().declare(funcScope, std::move(arguments[iarg]));
         }
 
-        // Define variable in the function's scope.
-        funcScope.linkObject(argVariable.name(), evaluatedArg);
+        (void)funcNode.funcBody->evaluate(funcScope);
     }
 
-    // Evaluate the function body in our function scope now that we've added the
-    // call arguments.
-    return evaluateFunctionBody(*funcNode->funcBody, funcScope);
+    result = completeCall(funcNode, scope, context);
+
+    if (isStorable)
+    {
+        context.memo(funcNode.cacheSlot()).insert(std::move(key), result);
+    }
+
+    return result;
 }
 
 
-AnyObject::Ptr FunctionCallNode::evaluateFunctionBody(BaseNode &funcBody, Scope &funcScope)
+void FunctionCallNode::prepareTailCall(FunctionNode &funcNode, Scope &scope, InterpreterContext &context)
 {
-    // Reset return value.
-    gEnvironmentContext.returnValue = nullptr;
+    auto &arguments = context.tailCallArguments;
+
+    // Evaluating an argument may make (and complete) other tail calls so the arguments are used as a stack.
+    for (size_t iarg = 0; iarg < _funcArgs.size(); ++iarg)
+    {
+        auto evaluatedArg = _funcArgs[iarg]->evaluate(scope);
+
+        checkArgumentType(funcNode, funcNode._funcArgs[iarg]->castNode<AddVariableNode>(), *evaluatedArg);
+
+        arguments.push_back(std::move(evaluatedArg));
+    }
+
+    context.completion = Completion::TailCall; /* Handled by the function call */
+}
+
 
-    jmp_buf *original = gEnvironmentContext.returnJumpPoint;
+void FunctionCallNode::takeTailCallArguments(FunctionNode &funcNode, Scope &funcScope, InterpreterContext &context)
+{
+    auto &arguments = context.tailCallArguments;
+    assert(arguments.size() >= funcNode._funcArgs.size());
 
-    jmp_buf local;
-    gEnvironmentContext.returnJumpPoint = &local;
+    size_t first = arguments.size() - funcNode._funcArgs.size();
 
-    // Evaluate each node and return last result.
-    if (setjmp(local) != 1)
+    for (size_t iarg = 0; iarg < funcNode._funcArgs.size(); ++iarg)
     {
-        (void)funcBody.evaluate(funcScope);
+        auto &argVariable = funcNode._funcArgs[iarg]->castNode<AddVariableNode>();
+        argVariable.declare(funcScope, std::move(arguments[first + iarg]));
     }
 
-    gEnvironmentContext.returnJumpPoint = original;
+    arguments.resize(first);
+}
 
-    // Only return non-NULL if return seen.
-    return gEnvironmentContext.returnValue;
-}
\ No newline at end of file
+
+void FunctionCallNode::checkArgumentType(const FunctionNode &funcNode, const AddVariableNode &argVariable, const AnyObject &evaluatedArg)
+{
+    if (!argVariable.passesAssignmentTypeCheck(evaluatedArg))
+    {
+        char buffer[150];
+        snprintf(buffer, 150, "incorrect type for argument '%s' of function '%s'. Expected type '%s'.",
+                 argVariable.name().c_str(),
+                 funcNode._funcName.c_str(),
+                 argVariable.description().c_str());
+
+        ThrowException(buffer);
+    }
+}
+
+
+void FunctionCallNode::resolveFunction(Scope &scope, InterpreterContext::CallSiteCache &cache) const
+{
+    bool isGlobal{false};
+
+    auto &someNode = scope.getNamedObject(_funcName, isGlobal);
+
+    cache = InterpreterContext::CallSiteCache{cache.key};
+
+    if (someNode->isType(AnyObject::_ModuleFunction))
+    {
+        cache.moduleFunction = &someNode->getValue<ModuleFunctor>();
+    }
+    else
+    {
+        // 1. Get a pointer to the function node stored in this scope.
+        auto *funcNode = static_cast<FunctionNode *>(someNode->getValue<BaseNode::Ptr>().get());
+
+        // 2. Verify that the number of arguments matches those required for the
+        // function we are calling.
+        if (_funcArgs.size() != funcNode->_funcArgs.size())
+        {
+            char buffer[150];
+            snprintf(buffer, 150, "expected %ld arguments but got %ld arguments for function '%s'.",
+                     funcNode->_funcArgs.size(),
+                     _funcArgs.size(),
+                     _funcName.c_str());
+
+            ThrowException(buffer);
+        }
+
+        cache.function = funcNode;
+    }
+
+    // Only reuse functions defined in the global scope. Leaving an inner scope does not change the generation so its
+    // functions may no longer be visible on the next call.
+    if (isGlobal)
+    {
+        auto &context = InterpreterContext::current();
+
+        cache.generation = context.bindingGeneration();
+        context.noteCachedName(_funcSymbol); /* May be shadowed by a method call */
+    }
+}
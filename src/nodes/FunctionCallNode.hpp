@@ -9,7 +9,10 @@
 
 #pragma once
 #include "BaseNode.hpp"
+#include "InterpreterContext.hpp"
+#include "SymbolTable.hpp"
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
@@ -22,7 +25,8 @@ public:
 
     FunctionCallNode(std::string funcName_, BaseNodePtrVector funcArgs_)
         : _funcName(std::move(funcName_)),
-          _funcArgs(std::move(funcArgs_))
+          _funcArgs(std::move(funcArgs_)),
+          _funcSymbol(SymbolTable::instance().intern(_funcName))
     {
         setType(NodeType::FunctionCall);
     }
@@ -30,11 +34,49 @@ public:
     ~FunctionCallNode() override = default;
 
     // TODO: - don't forget to do performance profiling for Fib sequence and see memory requirements for old and new version
-    // TODO: - create a new PR after this for parser to store all nodes in AST in flat array using pointers with method to delete by walking along array.
     std::shared_ptr<class AnyObject> evaluate(class Scope &scope) override;
 
-    std::shared_ptr<class AnyObject> evaluateFunctionBody(BaseNode &funcBody, class Scope &funcScope);
+    /* Set by VariableResolver for a call in tail position of the function which it calls (i.e. return f(n - 1)). The
+     * arguments are evaluated and the enclosing call of the function reuses its frame instead of recursing */
+    void setTailCallOf(const class FunctionNode *function) { _tailCallOf = function; }
+
+    /* Calls a function with evaluated arguments (i.e. from the host, see PreparedScript). Pure functions are memoized */
+    static std::shared_ptr<class AnyObject> call(class FunctionNode &funcNode,
+                                                 std::vector<std::shared_ptr<class AnyObject>> arguments,
+                                                 class Scope &scope);
+
+    /* Calls a function found by the caller (i.e. a method) with the arguments of this call. The arguments are evaluated
+     * in argumentScope and the function in a new scope whose parent is scope */
+    std::shared_ptr<class AnyObject> callWith(class FunctionNode &funcNode, class Scope &argumentScope, class Scope &scope);
 
     std::string _funcName;
     BaseNodePtrVector _funcArgs{nullptr};
+
+protected:
+    /* Looks up the function and checks the number of arguments. Caches functions defined in the global scope */
+    void resolveFunction(class Scope &scope, InterpreterContext::CallSiteCache &cache) const;
+
+    /* Evaluates any tail calls made by the function and returns the result */
+    static std::shared_ptr<class AnyObject> completeCall(class FunctionNode &funcNode, class Scope &scope, InterpreterContext &context);
+
+    /* Evaluates the arguments and the function body. The number of arguments has been checked */
+    std::shared_ptr<class AnyObject> invoke(class FunctionNode &funcNode, class Scope &argumentScope, class Scope &scope, InterpreterContext &context);
+
+    /* Calls a pure function. Results for the same argument values are reused */
+    std::shared_ptr<class AnyObject> evaluateMemoized(class FunctionNode &funcNode, class Scope &argumentScope, class Scope &scope);
+
+    /* Evaluates the arguments of a tail call in the current function scope */
+    void prepareTailCall(class FunctionNode &funcNode, class Scope &scope, InterpreterContext &context);
+
+    /* Declares the arguments of the last tail call in the new function scope */
+    static void takeTailCallArguments(class FunctionNode &funcNode, class Scope &funcScope, InterpreterContext &context);
+
+    static void checkArgumentType(const class FunctionNode &funcNode, const class AddVariableNode &argVariable, const class AnyObject &evaluatedArg);
+
+    /* Caches for this call site are held by each InterpreterContext so the node is not modified by calls */
+    CacheSlot _cacheSlot;
+
+    SymbolID _funcSymbol;
+
+    const class FunctionNode *_tailCallOf{nullptr};
 };
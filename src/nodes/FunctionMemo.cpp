@@ -0,0 +1,110 @@
+/**
+ * @file FunctionMemo.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FunctionMemo.hpp"
+#include "AnyObject.hpp"
+
+
+bool FunctionMemo::appendKey(std::string &key, const AnyObject &argument)
+{
+    auto appendBytes = [&key](const void *bytes, size_t numBytes)
+    {
+        key.append(static_cast<const char *>(bytes), numBytes);
+    };
+
+    key.push_back((char)argument.getType());
+
+    switch (argument.getType())
+    {
+        case AnyObject::Int:
+        {
+            long value = argument.getValue<long>();
+            appendBytes(&value, sizeof(value));
+            return true;
+        }
+        case AnyObject::Float:
+        {
+            double value = argument.getValue<double>();
+            appendBytes(&value, sizeof(value));
+            return true;
+        }
+        case AnyObject::Bool:
+            key.push_back(argument.getValue<bool>() ? 1 : 0);
+            return true;
+        case AnyObject::String:
+        {
+            const auto &value = argument.getValue<std::string>();
+
+            size_t length = value.size(); /* Prevents collisions between adjacent strings */
+            appendBytes(&length, sizeof(length));
+            key.append(value);
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+
+bool FunctionMemo::find(const std::string &key, AnyObject::Ptr &result)
+{
+    auto iter = _results.find(key);
+    if (iter == _results.end())
+    {
+        ++_statistics.misses;
+        return false;
+    }
+
+    ++_statistics.hits;
+
+    _entries.splice(_entries.begin(), _entries, iter->second);
+
+    const auto &stored = iter->second->second;
+
+    result = stored ? stored->clone() : nullptr;
+    return true;
+}
+
+
+void FunctionMemo::insert(std::string key, const AnyObject::Ptr &result)
+{
+    if (_capacity == 0)
+    {
+        return;
+    }
+
+    if (result && !(result->isType(AnyObject::Int) || result->isType(AnyObject::Float) ||
+                    result->isType(AnyObject::Bool) || result->isType(AnyObject::String)))
+    {
+        return;
+    }
+
+    if (_results.count(key))
+    {
+        return;
+    }
+
+    if (_entries.size() >= _capacity)
+    {
+        _results.erase(_entries.back().first);
+        _entries.pop_back();
+        ++_statistics.evictions;
+    }
+
+    _entries.emplace_front(std::move(key), result ? result->clone() : nullptr);
+    _results.emplace(_entries.front().first, _entries.begin());
+}
+
+
+void FunctionMemo::clear()
+{
+    _results.clear();
+    _entries.clear();
+    _statistics = Statistics();
+}
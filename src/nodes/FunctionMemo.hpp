@@ -0,0 +1,67 @@
+/**
+ * @file FunctionMemo.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+
+/*
+ * Results of calls to a pure function keyed on the values of the arguments. Only calls with Int, Float, Bool and
+ * String arguments and results are stored. The cache is bounded: the least recently used entry is evicted when it is
+ * full.
+ */
+class FunctionMemo
+{
+public:
+    static constexpr size_t kDefaultCapacity{4096};
+
+    struct Statistics
+    {
+        uint64_t hits{0};
+        uint64_t misses{0};
+        uint64_t evictions{0};
+    };
+
+    explicit FunctionMemo(size_t capacity = kDefaultCapacity) : _capacity(capacity) {}
+
+    /* Appends an argument to the key. Returns false if the argument cannot be stored */
+    static bool appendKey(std::string &key, const class AnyObject &argument);
+
+    /* Returns a copy of the stored result or nullptr. Results are copied since the caller may modify them. The entry
+     * becomes the most recently used */
+    bool find(const std::string &key, std::shared_ptr<class AnyObject> &result);
+
+    /* Stores a copy of the result. Ignored if the result cannot be stored */
+    void insert(std::string key, const std::shared_ptr<class AnyObject> &result);
+
+    void clear();
+
+    [[nodiscard]] const Statistics &statistics() const { return _statistics; }
+
+    [[nodiscard]] size_t size() const { return _entries.size(); }
+
+    [[nodiscard]] size_t capacity() const { return _capacity; }
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<class AnyObject>>; /* NB: nullptr if nothing returned */
+
+    std::list<Entry> _entries; /* Most recently used first */
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> _results; /* Keys refer to the entries */
+
+    size_t _capacity;
+
+    Statistics _statistics;
+};
@@ -15,7 +15,7 @@
 /// Create a new FunctionObject from a FunctionNode and register in current scope.
 AnyObject::Ptr FunctionNode::evaluate(Scope &scope)
 {
-    // TODO: - I think this creates a strong-reference cycle! Need to break the chain here
+    /* NB: not a reference cycle. The object refers to the node but the node never refers to the objects */
     auto functionObject = ObjectFactory::allocate(shared_from_this(), AnyObject::_UserFunction);
 
     scope.linkObject(_funcName, functionObject);
@@ -10,6 +10,7 @@
 #pragma once
 #include "BaseNode.hpp"
 #include "FunctionCallNode.hpp"
+#include "ScopeLayout.hpp"
 #include <memory>
 #include <string>
 
@@ -19,9 +20,10 @@ class FunctionNode : public FunctionCallNode, public std::enable_shared_from_thi
 public:
     using Ptr = std::shared_ptr<FunctionNode>;
 
-    FunctionNode(std::string funcName_, BaseNodePtrVector funcArgs_, BaseNode::Ptr funcBody_)
+    FunctionNode(std::string funcName_, BaseNodePtrVector funcArgs_, BaseNode::Ptr funcBody_, bool isPure_ = false)
         : FunctionCallNode(std::move(funcName_), std::move(funcArgs_)),
-          funcBody(funcBody_)
+          funcBody(funcBody_),
+          _isPure(isPure_)
     {
         setType(NodeType::Function);
     }
@@ -31,4 +33,16 @@ public:
     std::shared_ptr<class AnyObject> evaluate(class Scope &scope) override;
 
     BaseNode::Ptr funcBody{nullptr};
+
+    /* Slots for the function arguments in the scope created for each call. Set by VariableResolver */
+    ScopeLayout::Ptr funcScopeLayout{std::make_shared<ScopeLayout>()};
+
+    /* Declared pure (no side-effects and the result depends only on the arguments) */
+    [[nodiscard]] bool isPure() const { return _isPure; }
+
+    /* Identifies the results of previous calls for pure functions (see InterpreterContext::memo) */
+    [[nodiscard]] const CacheSlot &cacheSlot() const { return _cacheSlot; }
+
+protected:
+    bool _isPure{false};
 };
@@ -9,8 +9,15 @@
 
 #include "LookupVariableNode.hpp"
 #include "AnyObject.hpp"
+#include "Value.hpp"
 
 AnyObject::Ptr LookupVariableNode::evaluate(Scope &scope)
 {
-    return scope.getNamedObject(_name);
+    return lookupObject(scope);
+}
+
+
+Value LookupVariableNode::evaluateValue(Scope &scope)
+{
+    return Value(*lookupObject(scope));
 }
\ No newline at end of file
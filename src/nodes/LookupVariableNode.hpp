@@ -25,8 +25,26 @@ public:
     /* Returns the object in the scope associated with a variable name */
     std::shared_ptr<class AnyObject> evaluate(Scope &scope) override;
 
+    /* Returns the value of the object without copying the pointer */
+    class Value evaluateValue(Scope &scope) override;
+
+    /* Set by VariableResolver. Depth is the number of scopes outwards from the scope in which we are evaluated */
+    void resolve(uint32_t depth, uint32_t slot)
+    {
+        _depth = (int)depth;
+        _slot = slot;
+    }
+
+    [[nodiscard]] bool isResolved() const { return (_depth >= 0); }
+
+    /* Slot lookup if resolved, otherwise by name */
+    inline const std::shared_ptr<class AnyObject> &lookupObject(const Scope &scope) const;
+
 private:
     std::string _name;
+
+    int _depth{-1};
+    uint32_t _slot{0};
 };
 
 
@@ -34,3 +52,9 @@ const std::string &LookupVariableNode::name() const
 {
     return _name;
 }
+
+
+const std::shared_ptr<class AnyObject> &LookupVariableNode::lookupObject(const Scope &scope) const
+{
+    return isResolved() ? scope.getSlotObject(_depth, _slot, _name) : scope.getNamedObject(_name);
+}
@@ -6,15 +6,19 @@
 //
 
 #include "ModuleNodeFactory.hpp"
+#include "ArrayKernels.hpp"
 #include "BaseNode.hpp"
 #include "Exceptions.hpp"
 #include "Logger.hpp"
 #include "NodeFactory.hpp"
 #include "ObjectFactory.hpp"
 #include "Stringify.hpp"
+#include "Value.hpp"
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <unordered_set>
+#include <utility>
 
 
 namespace NodeFactory
@@ -41,9 +45,8 @@ AnyNode::Ptr createIOModuleNode()
     {
         for (const auto &callArg : callArgs)
         {
-            auto evaluatedNode = callArg->evaluate(scope);
-
-            std::cout << *evaluatedNode;
+            /* NB: values are printed without allocating (string literals refer to the interned object) */
+            std::cout << callArg->evaluateValue(scope);
 
             if (callArg != callArgs.back())
             {
@@ -84,16 +87,162 @@ AnyNode::Ptr createMathModuleNode()
 }
 
 
+/* Careful if using a reference! Need to not hold reference to garbage! */
+static AnyObject::Ptr evaluateArray(const BaseNode::Ptr &node, Scope &scope)
+{
+    auto theObject = node->evaluate(scope);
+
+    if (!theObject || !theObject->isType(AnyObject::Array))
+    {
+        ThrowException("expected an array");
+    }
+
+    return theObject;
+}
+
+static double toFloat(const Value &value)
+{
+    if (value.isInt())
+        return (double)value.asInt();
+    else if (value.isFloat())
+        return value.asFloat();
+
+    ThrowException("expected an int or float");
+}
+
+
+/* Int or Float. A generic array is a Float array if any element is a Float. Throws for other elements */
+static AnyObject::Type numericType(const AnyObject &array)
+{
+    const AnyObject::Type elementType = array.elementType();
+
+    if (elementType == AnyObject::Int || elementType == AnyObject::Float)
+    {
+        return elementType;
+    }
+
+    bool hasFloat = false;
+
+    for (size_t i = 0; i < array.arraySize(); ++i)
+    {
+        Value element = array.arrayElement(i);
+
+        if (element.isFloat())
+            hasFloat = true;
+        else if (!element.isInt())
+            ThrowException("expected an array of ints or floats");
+    }
+
+    return hasFloat ? AnyObject::Float : AnyObject::Int;
+}
+
+
+/* Elements of an int[]. The elements of a generic array of ints are copied into storage */
+static const AnyObject::IntVector &intElements(const AnyObject &array, AnyObject::IntVector &storage)
+{
+    if (array.elementType() == AnyObject::Int)
+    {
+        return array.getValue<AnyObject::IntVector>();
+    }
+
+    storage.resize(array.arraySize());
+
+    for (size_t i = 0; i < storage.size(); ++i)
+    {
+        storage[i] = array.arrayElement(i).asInt(); /* Checked by numericType */
+    }
+
+    return storage;
+}
+
+
+/* Elements of a float[]. The elements of an int[] or a generic array are converted into storage */
+static const AnyObject::FloatVector &floatElements(const AnyObject &array, AnyObject::FloatVector &storage)
+{
+    if (array.elementType() == AnyObject::Float)
+    {
+        return array.getValue<AnyObject::FloatVector>();
+    }
+
+    storage.resize(array.arraySize());
+
+    for (size_t i = 0; i < storage.size(); ++i)
+    {
+        storage[i] = toFloat(array.arrayElement(i));
+    }
+
+    return storage;
+}
+
+
+/* Returns kernel(values, size) for an array of ints or floats */
+template <class TKernel>
+static AnyObject::Ptr reduceArray(const AnyObject &array, TKernel &&kernel)
+{
+    if (numericType(array) == AnyObject::Float)
+    {
+        AnyObject::FloatVector storage;
+
+        const auto &elements = floatElements(array, storage);
+        return ObjectFactory::allocate(kernel(elements.data(), elements.size()));
+    }
+
+    AnyObject::IntVector storage;
+
+    const auto &elements = intElements(array, storage);
+    return ObjectFactory::allocate(kernel(elements.data(), elements.size()));
+}
+
+
+/* Returns kernel(left, right, size) for arrays of equal length. Ints are promoted if the other array has a Float */
+template <class TKernel>
+static AnyObject::Ptr combineArrays(const AnyObject &left, const AnyObject &right, TKernel &&kernel)
+{
+    if (left.arraySize() != right.arraySize())
+    {
+        ThrowException("expected arrays of equal length");
+    }
+
+    if (numericType(left) == AnyObject::Float || numericType(right) == AnyObject::Float)
+    {
+        AnyObject::FloatVector leftStorage, rightStorage;
+
+        const auto &leftElements = floatElements(left, leftStorage);
+        const auto &rightElements = floatElements(right, rightStorage);
+
+        return kernel(leftElements.data(), rightElements.data(), leftElements.size());
+    }
+
+    AnyObject::IntVector leftStorage, rightStorage;
+
+    const auto &leftElements = intElements(left, leftStorage);
+    const auto &rightElements = intElements(right, rightStorage);
+
+    return kernel(leftElements.data(), rightElements.data(), leftElements.size());
+}
+
+
+/* Returns a new array filled by kernel(left, right, result, size) */
+template <class TKernel>
+static AnyObject::Ptr transformArrays(const AnyObject &left, const AnyObject &right, TKernel &&kernel)
+{
+    return combineArrays(left, right, [&kernel](auto left, auto right, size_t size)
+    {
+        std::vector<std::remove_const_t<std::remove_pointer_t<decltype(left)>>> result(size);
+
+        kernel(left, right, result.data(), size);
+        return ObjectFactory::allocate(std::move(result));
+    });
+}
+
+
 AnyNode::Ptr createArrayModuleNode()
 {
     auto doClear = std::pair("clear", [](BaseNodePtrVector &callArgs, Scope &scope)
     {
         assert(callArgs.size() == 1);
 
-        auto theObject = callArgs.front()->evaluate(scope); /* Careful if using a reference! Need to not hold reference to garbage! */
-
-        auto &arrayObject = theObject->getValue<AnyObject::Vector>();
-        arrayObject.clear();
+        evaluateArray(callArgs.front(), scope)->clearArray();
         return nullptr;
     });
 
@@ -101,27 +250,175 @@ AnyNode::Ptr createArrayModuleNode()
     {
         assert(callArgs.size() == 1);
 
-        auto theObject = callArgs.front()->evaluate(scope);
-
-        auto &arrayObject = theObject->getValue<AnyObject::Vector>();
+        auto theObject = evaluateArray(callArgs.front(), scope);
 
-        return ObjectFactory::allocate((double)arrayObject.size());
+        return ObjectFactory::allocate((double)theObject->arraySize());
     });
 
     auto doAppend = std::pair("append", [](BaseNodePtrVector &callArgs, Scope &scope)
     {
         assert(callArgs.size() == 2);
 
-        auto theObject = callArgs.front()->evaluate(scope);
-
-        auto &arrayObject = theObject->getValue<AnyObject::Vector>();
-        auto someObject = callArgs.back()->evaluate(scope);
+        auto theObject = evaluateArray(callArgs.front(), scope);
 
-        arrayObject.push_back(someObject->clone()); // NB: must clone!
+        theObject->appendArrayElement(callArgs.back()->evaluateValue(scope)); /* Copied */
         return nullptr;
     });
 
-    return NodeFactory::createModuleNode("array", {doClear, doLength, doAppend});
+    /* Numeric functions for int[] and float[] arrays (see ArrayKernels). Generic arrays of ints and floats are copied */
+    auto doSum = std::pair("sum", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 1);
+
+        return reduceArray(*evaluateArray(callArgs.front(), scope), [](auto values, size_t size)
+        { return ArrayKernels::sum(values, size); });
+    });
+
+    auto doDot = std::pair("dot", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 2);
+
+        auto left = evaluateArray(callArgs.front(), scope);
+        auto right = evaluateArray(callArgs.back(), scope);
+
+        return combineArrays(*left, *right, [](auto left, auto right, size_t size)
+        { return ObjectFactory::allocate(ArrayKernels::dot(left, right, size)); });
+    });
+
+    auto doMin = std::pair("min", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 1);
+
+        auto theObject = evaluateArray(callArgs.front(), scope);
+
+        if (theObject->arraySize() == 0)
+        {
+            ThrowException("min of an empty array");
+        }
+
+        return reduceArray(*theObject, [](auto values, size_t size)
+        { return ArrayKernels::min(values, size); });
+    });
+
+    auto doMax = std::pair("max", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 1);
+
+        auto theObject = evaluateArray(callArgs.front(), scope);
+
+        if (theObject->arraySize() == 0)
+        {
+            ThrowException("max of an empty array");
+        }
+
+        return reduceArray(*theObject, [](auto values, size_t size)
+        { return ArrayKernels::max(values, size); });
+    });
+
+    auto doScale = std::pair("scale", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 2);
+
+        auto theObject = evaluateArray(callArgs.front(), scope);
+        Value factor = callArgs.back()->evaluateValue(scope);
+
+        if (factor.isInt() && numericType(*theObject) == AnyObject::Int)
+        {
+            AnyObject::IntVector storage;
+            const auto &elements = intElements(*theObject, storage);
+
+            AnyObject::IntVector result(elements.size());
+            ArrayKernels::scale(elements.data(), factor.asInt(), result.data(), result.size());
+            return ObjectFactory::allocate(std::move(result));
+        }
+
+        AnyObject::FloatVector storage;
+        const auto &elements = floatElements(*theObject, storage);
+
+        AnyObject::FloatVector result(elements.size());
+        ArrayKernels::scale(elements.data(), toFloat(factor), result.data(), result.size());
+        return ObjectFactory::allocate(std::move(result));
+    });
+
+    auto doAdd = std::pair("add", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 2);
+
+        auto left = evaluateArray(callArgs.front(), scope);
+        auto right = evaluateArray(callArgs.back(), scope);
+
+        return transformArrays(*left, *right, [](auto left, auto right, auto result, size_t size)
+        { ArrayKernels::add(left, right, result, size); });
+    });
+
+    auto doMul = std::pair("mul", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 2);
+
+        auto left = evaluateArray(callArgs.front(), scope);
+        auto right = evaluateArray(callArgs.back(), scope);
+
+        return transformArrays(*left, *right, [](auto left, auto right, auto result, size_t size)
+        { ArrayKernels::mul(left, right, result, size); });
+    });
+
+    auto doFill = std::pair("fill", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 2);
+
+        auto theObject = evaluateArray(callArgs.front(), scope);
+        Value value = callArgs.back()->evaluateValue(scope);
+
+        if (theObject->arraySize() == 0)
+        {
+            return AnyObject::Ptr(); /* Nothing to fill */
+        }
+        else if (value.type() != theObject->elementType())
+        {
+            ThrowException("cannot fill array of type " + AnyObject::typeToString(theObject->elementType()) +
+                           " with " + AnyObject::typeToString(value.type()));
+        }
+
+        switch (value.type())
+        {
+            case AnyObject::Int:
+            {
+                auto &elements = theObject->getValue<AnyObject::IntVector>(); /* Detaches */
+                ArrayKernels::fill(elements.data(), value.asInt(), elements.size());
+                break;
+            }
+            case AnyObject::Float:
+            {
+                auto &elements = theObject->getValue<AnyObject::FloatVector>();
+                ArrayKernels::fill(elements.data(), value.asFloat(), elements.size());
+                break;
+            }
+            default:
+            {
+                auto &elements = theObject->getValue<AnyObject::BoolVector>();
+                std::fill(elements.begin(), elements.end(), value.asBool());
+                break;
+            }
+        }
+
+        return AnyObject::Ptr();
+    });
+
+    /* range(end) or range(start, end) */
+    auto doRange = std::pair("range", [](BaseNodePtrVector &callArgs, Scope &scope)
+    {
+        assert(callArgs.size() == 1 || callArgs.size() == 2);
+
+        long start = (callArgs.size() == 2) ? callArgs.front()->evaluateValue(scope).toInt() : 0;
+        long end = callArgs.back()->evaluateValue(scope).toInt();
+
+        AnyObject::IntVector result(std::max(0L, end - start));
+        ArrayKernels::range(result.data(), start, result.size());
+        return ObjectFactory::allocate(std::move(result));
+    });
+
+    return NodeFactory::createModuleNode("stdarray", {doClear, doLength, doAppend, doSum, doDot, doMin, doMax, doScale,
+                                                      doAdd, doMul, doFill, doRange});
 }
 
 
@@ -138,7 +435,7 @@ AnyNode::Ptr createTestModuleNode()
         assert(callArgs.size() == 2);
 
         bool result = callArgs.front()->evaluate(scope)->getValue<bool>();
-        std::string description = callArgs.back()->evaluate(scope)->getValue<std::string>(); /* Be very careful -> copy otherwise referencing garbage! */
+        std::string description = std::as_const(*callArgs.back()->evaluate(scope)).getValue<std::string>(); /* Be very careful -> copy otherwise referencing garbage! */
 
         // Print pass or fail depending on the test case.
         const char *statusString = result ? "PASSED" : "FAILED";
@@ -152,4 +449,13 @@ AnyNode::Ptr createTestModuleNode()
 }
 
 
+bool isPureModuleFunction(const std::string &functionName)
+{
+    static const std::unordered_set<std::string> kPureFunctions{
+        "sqrt", "pow", "length", "sum", "dot", "min", "max", "scale", "add", "mul", "range"};
+
+    return (kPureFunctions.count(functionName) > 0);
+}
+
+
 } // namespace NodeFactory
\ No newline at end of file
@@ -23,4 +23,7 @@ AnyNode::Ptr createArrayModuleNode();
 
 AnyNode::Ptr createTestModuleNode();
 
+/* Module functions without side-effects which may be called by pure functions (i.e. not print) */
+bool isPureModuleFunction(const std::string &functionName);
+
 } // namespace NodeFactory
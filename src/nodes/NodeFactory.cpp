@@ -9,15 +9,18 @@
 
 #include "NodeFactory.hpp"
 #include "AddVariableNode.hpp"
+#include "AstArena.hpp"
 #include "ClassNode.hpp"
+#include "InterpreterContext.hpp"
 #include "FunctionCallNode.hpp"
-#include "JumpPoints.hpp"
 #include "LookupVariableNode.hpp"
 #include "ObjectFactory.hpp"
 #include "Scope.hpp"
+#include "StringPool.hpp"
 #include <cassert>
 #include <iostream>
 #include <memory>
+#include <utility>
 
 namespace NodeFactory
 {
@@ -34,225 +37,221 @@ AnyNode::Ptr createCastNode(BaseNode::Ptr expression, AnyObject::Type castToType
         ThrowException("Cannot create cast node. Unsupported cast type!");
     }
 
-    return std::make_shared<AnyNode>(NodeType::Cast, [isCastable, expression, castToType](Scope &scope)
+    auto evaluateValue = [isCastable, expression, castToType](Scope &scope)
     {
-        auto evaluatedObject = expression->evaluate(scope);
-        if (!isCastable(evaluatedObject->getType()))
+        Value evaluatedValue = expression->evaluateValue(scope);
+        if (!isCastable(evaluatedValue.type()))
         {
             ThrowException("Unsupported cast type!");
         }
 
-        if (evaluatedObject->getType() == castToType) /* Nothing to do */
+        if (evaluatedValue.type() == castToType) /* Nothing to do */
         {
-            return evaluatedObject;
+            return evaluatedValue;
         }
 
         if (castToType == AnyObject::Int)
-        {
-            long value = (long)expression->evaluate(scope)->getValue<double>();
-            return ObjectFactory::allocate(value);
-        }
+            return Value((long)evaluatedValue.asFloat());
         else
-        {
-            double value = (double)expression->evaluate(scope)->getValue<long>();
-            return ObjectFactory::allocate(value);
-        }
-    });
+            return Value((double)evaluatedValue.asInt());
+    };
+
+    auto evaluate = [evaluateValue](Scope &scope)
+    {
+        return ObjectFactory::box(evaluateValue(scope));
+    };
+
+    return AstArena::makeNode<AnyNode>(NodeType::Cast, std::move(evaluate), std::move(evaluateValue), BaseNodePtrVector{expression}, castToType);
 }
 
 AnyNode::Ptr createBoolNode(bool state)
 {
-    return std::make_shared<AnyNode>(NodeType::Bool, [state](Scope &)
+    return AstArena::makeNode<AnyNode>(NodeType::Bool, [state](Scope &)
     {
         return ObjectFactory::allocate(state);
-    });
+    }, [state](Scope &)
+    {
+        return Value(state);
+    }, BaseNodePtrVector(), AnyObject::Bool);
 }
 
 AnyNode::Ptr createIntNode(long value)
 {
-    return std::make_shared<AnyNode>(NodeType::Int, [value](Scope &)
+    return AstArena::makeNode<AnyNode>(NodeType::Int, [value](Scope &)
     {
         return ObjectFactory::allocate(value);
-    });
+    }, [value](Scope &)
+    {
+        return Value(value);
+    }, BaseNodePtrVector(), AnyObject::Int);
+}
+
+AnyNode::Ptr createStringNode(std::string_view value)
+{
+    return createStringNode(SymbolTable::instance().intern(value));
 }
 
-AnyNode::Ptr createStringNode(std::string value)
+
+AnyNode::Ptr createStringNode(SymbolID symbol)
 {
-    return std::make_shared<AnyNode>(NodeType::String, [value = std::move(value)](Scope &)
+    /* Owned by the pool */
+    AnyObject *object = StringPool::instance().object(symbol).get();
+
+    auto node = AstArena::makeNode<AnyNode>(NodeType::String, [object](Scope &)
     {
-        return ObjectFactory::allocate(value);
-    });
+        return object->clone(); /* Copy since the result may be modified (shares the buffer until it is) */
+    }, [object](Scope &)
+    {
+        return Value(*object); /* Interned object (no allocation) */
+    }, BaseNodePtrVector(), AnyObject::String);
+
+    node->setSymbols(symbol);
+    return node;
 }
 
 AnyNode::Ptr createFloatNode(double value)
 {
-    return std::make_shared<AnyNode>(NodeType::Float, [value](Scope &)
+    return AstArena::makeNode<AnyNode>(NodeType::Float, [value](Scope &)
     {
         return ObjectFactory::allocate(value);
-    });
+    }, [value](Scope &)
+    {
+        return Value(value);
+    }, BaseNodePtrVector(), AnyObject::Float);
 }
 
 AnyNode::Ptr createIfNode(BaseNode::Ptr condition, BaseNode::Ptr thenBranch, BaseNode::Ptr elseBranch)
 {
-    return std::make_shared<AnyNode>(NodeType::If, [condition, thenBranch, elseBranch](Scope &scope) /* Use shared pointer to manage ownership */
-    {
-        if (condition->evaluate(scope)->getValue<bool>())
-            return thenBranch->evaluate(scope);
-        else if (elseBranch)
-            return elseBranch->evaluate(scope);
-        else
-            return AnyObject::Ptr();
-    });
+    return AstArena::makeNode<AnyNode>(NodeType::If, ifFunction(nodeCondition(condition), thenBranch, elseBranch), BaseNodePtrVector{condition, thenBranch, elseBranch});
 }
 
 AnyNode::Ptr createForLoopNode(BaseNode::Ptr init, BaseNode::Ptr condition, BaseNode::Ptr update, BaseNode::Ptr body)
 {
-    return std::make_shared<AnyNode>(NodeType::ForLoop, [init, condition, update, body](Scope &scope)
-    {
-        // Initialization.
-        Scope loopScope(scope); // Extend scope.
-
-        (void)init->evaluate(loopScope);
+    auto layout = std::make_shared<ScopeLayout>();
 
-        jmp_buf local;
-        pushBreakJumpPoint(&local);
-
-        // Add evaluation to forScope:
-        if (setjmp(local) != 1)
-        {
-            for (;
-                 condition->evaluate(loopScope)->getValue<bool>();
-                 update->evaluate(loopScope))
-            {
-                (void)body->evaluate(loopScope);
-            }
-        }
+    auto node = AstArena::makeNode<AnyNode>(NodeType::ForLoop, forLoopFunction(init, nodeCondition(condition), update, body, layout.get()), BaseNodePtrVector{init, condition, update, body});
 
-        popBreakJumpPoint();
-        return nullptr;
-    });
+    node->setScopeLayout(std::move(layout));
+    return node;
 }
 
 
 AnyNode::Ptr createWhileLoopNode(BaseNode::Ptr condition, BaseNode::Ptr body)
 {
-    return std::make_shared<AnyNode>(NodeType::While, [condition, body](Scope &scope)
-    {
-        // Set jump point for break statements.
-        jmp_buf local;
-        pushBreakJumpPoint(&local);
-
-        if (setjmp(local) != 1)
-        {
-            Scope loopScope(scope); // Extend scope.
+    auto layout = std::make_shared<ScopeLayout>();
 
-            while (condition->evaluate(scope)->getValue<bool>())
-            {
-                (void)body->evaluate(loopScope);
-            }
-        }
-
-        // Restore original context.
-        popBreakJumpPoint();
+    auto node = AstArena::makeNode<AnyNode>(NodeType::While, whileLoopFunction(nodeCondition(condition), body, layout.get()), BaseNodePtrVector{condition, body});
 
-        return nullptr;
-    });
+    node->setScopeLayout(std::move(layout));
+    return node;
 }
 
 
 AnyNode::Ptr createDoWhileLoopNode(BaseNode::Ptr condition, BaseNode::Ptr body)
 {
-    return std::make_shared<AnyNode>(NodeType::DoWhile, [condition, body](Scope &scope)
-    {
-        jmp_buf local;
-        pushBreakJumpPoint(&local);
-
-        if (setjmp(local) != 1)
-        {
-            Scope loopScope(scope); // Extend scope.
-
-            do
-            {
-                (void)body->evaluate(loopScope);
-            } while (condition->evaluate(scope)->getValue<bool>()); /* NB: evaluate in outerscope (no access to loop scope) */
-        }
+    auto layout = std::make_shared<ScopeLayout>();
 
-        // Restore original context.
-        popBreakJumpPoint();
+    auto node = AstArena::makeNode<AnyNode>(NodeType::DoWhile, doWhileLoopFunction(nodeCondition(condition), body, layout.get()), BaseNodePtrVector{condition, body});
 
-        return nullptr; // Return nothing.
-    });
+    node->setScopeLayout(std::move(layout));
+    return node;
 }
 
 
 AnyNode::Ptr createBreakNode()
 {
-    return std::make_shared<AnyNode>(NodeType::Break, [](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::Break, [](Scope &)
     {
-        (void)scope;
-        jumpToBreakJumpPoint(); /* Jump to last set point */
+        InterpreterContext::current().completion = Completion::Break; /* Handled by the enclosing loop */
+        return nullptr;
+    });
+}
 
+AnyNode::Ptr createContinueNode()
+{
+    return AstArena::makeNode<AnyNode>(NodeType::Continue, [](Scope &)
+    {
+        InterpreterContext::current().completion = Completion::Continue; /* Handled by the enclosing loop */
         return nullptr;
     });
 }
 
 AnyNode::Ptr createReturnNode(BaseNode::Ptr returnNode)
 {
-    return std::make_shared<AnyNode>(NodeType::Return, [returnNode](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::Return, [returnNode](Scope &scope)
     {
-        gEnvironmentContext.returnValue = nullptr;
+        // i.e. return true;
+        auto returnValue = returnNode ? returnNode->evaluate(scope) : nullptr;
 
-        if (returnNode != nullptr) // i.e. return true;
-        {
-            gEnvironmentContext.returnValue = returnNode->evaluate(scope);
-        }
+        auto &context = InterpreterContext::current();
+        context.returnValue = std::move(returnValue);
 
-        longjmp(*gEnvironmentContext.returnJumpPoint, 1);
+        if (!context.isInterrupted()) /* A tail call completes with TailCall */
+            context.completion = Completion::Return; /* Handled by the function call */
         return nullptr;
-    });
+    }, BaseNodePtrVector{returnNode});
 }
 
 
 AnyNode::Ptr createNotNode(BaseNode::Ptr expression)
 {
-    return std::make_shared<AnyNode>(NodeType::Not, [expression](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::Not, [expression](Scope &scope)
     {
-        AnyObject::Ptr result = expression->evaluate(scope);
-
-        return ObjectFactory::allocate(!result->getValue<bool>());
-    });
+        return ObjectFactory::allocate(!expression->evaluateValue(scope).toBool());
+    }, [expression](Scope &scope)
+    {
+        return Value(!expression->evaluateValue(scope).toBool());
+    }, BaseNodePtrVector{expression});
 }
 
 AnyNode::Ptr createBlockNode(BaseNodePtrVector nodes)
 {
-    return std::make_shared<AnyNode>(NodeType::Block, [nodes = std::move(nodes)](Scope &scope)
+    BaseNodePtrVector children = nodes;
+
+    auto layout = std::make_shared<ScopeLayout>();
+
+    auto blockNode = AstArena::makeNode<AnyNode>(NodeType::Block, [nodes = std::move(nodes), layout = layout.get()](Scope &scope)
     {
         /*
          * Create inner program scope for each block of statements. Good example is for a loop where the body of the
          * loop redeclares a variable. This should be okay
          */
-        Scope blockScope(scope);
+        Scope blockScope(scope, layout);
+
+        auto &context = InterpreterContext::current();
 
         for (const auto &node : nodes)
         {
             (void)node->evaluate(blockScope);
+
+            if (context.isInterrupted()) /* Skip remaining statements after break, continue or return */
+                break;
         }
 
         /* Any memory allocations cleared-up when we exit */
         return nullptr;
-    });
+    }, std::move(children));
+
+    blockNode->setScopeLayout(std::move(layout));
+    return blockNode;
 }
 
 AnyNode::Ptr createAssignNode(BaseNode::Ptr left, BaseNode::Ptr right)
 {
-    return std::make_shared<AnyNode>(NodeType::Assign, [left, right](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::Assign, [left, right](Scope &scope)
     {
         // Setting array or struct values.
         if (left->isNodeType(NodeType::ArrayAccess) || left->isNodeType(NodeType::StructAccess))
         {
             auto &accessor = left->castNode<AnyPropertyNode>();
 
-            *(accessor.evaluateNoClone(scope)) = *(right->evaluate(scope));
+            /* Evaluate RHS first so that it cannot share the array buffer once detached (i.e. a[0] = a) */
+            Value valueRHS = right->evaluateValue(scope);
+
+            if (valueRHS.type() == AnyObject::Array)
+                valueRHS = Value(valueRHS.object().clone());
+
+            accessor.setProperty(scope, valueRHS);
             return nullptr;
         }
 
@@ -262,52 +261,68 @@ AnyNode::Ptr createAssignNode(BaseNode::Ptr left, BaseNode::Ptr right)
         // Case 2: LookupVariableNode -> we object defined in scope (not cloned!) - TODO: - think about whether we should clone it.
         AnyObject::Ptr objectLHS = left->evaluate(scope);
 
-        // Object we want to assign to LHS.
-        AnyObject::Ptr objectRHS = right->evaluate(scope);
+        // Value we want to assign to LHS (Int, Float and Bool values are not allocated).
+        Value valueRHS = right->evaluateValue(scope);
 
         // Update directly. TODO: - We will need to implement this for some object types still.
-        *objectLHS = *objectRHS;
+        objectLHS->assign(valueRHS);
         return nullptr;
-    });
+    }, BaseNodePtrVector{left, right});
 }
 
 
 AnyNode::Ptr createArrayNode(BaseNodePtrVector nodes)
 {
+    BaseNodePtrVector children = nodes;
+
     // TODO: - could treat as references in array?
-    return std::make_shared<AnyNode>(NodeType::Array, [nodes = std::move(nodes)](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::Array, [nodes = std::move(nodes)](Scope &scope)
     {
-        AnyObject::Vector evaluatedObjects;
+        std::vector<Value> evaluatedValues;
 
-        evaluatedObjects.reserve(nodes.size());
+        evaluatedValues.reserve(nodes.size());
 
         for (auto &node : nodes)
         {
-            evaluatedObjects.push_back(node->evaluate(scope));
+            evaluatedValues.push_back(node->evaluateValue(scope));
         }
 
-        return ObjectFactory::allocate(std::move(evaluatedObjects));
-    });
+        return ObjectFactory::allocateArray(evaluatedValues); /* Packed if possible */
+    }, std::move(children));
 }
 
 
 AnyNode::Ptr createFileNode(BaseNodePtrVector nodes)
 {
-    return std::make_shared<AnyNode>(NodeType::File, [nodes](Scope &scope)
+    BaseNodePtrVector children = nodes;
+
+    auto layout = std::make_shared<ScopeLayout>();
+
+    auto fileNode = AstArena::makeNode<AnyNode>(NodeType::File, [nodes, layout = layout.get()](Scope &scope)
     {
+        /* Only the entry-point file has a layout. Imported files are evaluated in the same scope */
+        scope.adoptLayout(layout);
+
+        auto &context = InterpreterContext::current();
+
         for (const auto &node : nodes)
         {
             (void)node->evaluate(scope);
+
+            context.checkNotInterrupted();
         }
 
         return nullptr;
-    });
+    }, std::move(children));
+
+    fileNode->setScopeLayout(std::move(layout));
+    return fileNode;
 }
 
 
 AnyNode::Ptr createPrefixIncrementNode(BaseNode::Ptr expression)
 {
-    return std::make_shared<AnyNode>(NodeType::PrefixIncrement, [expression](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::PrefixIncrement, [expression](Scope &scope)
     {
         // 1. Body should be an already-declared variable.
         assert(expression->isNodeType(NodeType::LookupVariable));
@@ -326,13 +341,13 @@ AnyNode::Ptr createPrefixIncrementNode(BaseNode::Ptr expression)
         }
 
         ThrowException("cannot use prefix operator on object of type");
-    });
+    }, BaseNodePtrVector{expression});
 }
 
 
 AnyNode::Ptr createPrefixDecrementNode(BaseNode::Ptr expression)
 {
-    return std::make_shared<AnyNode>(NodeType::PrefixDecrement, [expression](Scope &scope)
+    return AstArena::makeNode<AnyNode>(NodeType::PrefixDecrement, [expression](Scope &scope)
     {
         // 1. Body should be an already-declared variable.
         assert(expression->isNodeType(NodeType::LookupVariable));
@@ -351,39 +366,47 @@ AnyNode::Ptr createPrefixDecrementNode(BaseNode::Ptr expression)
         }
 
         ThrowException("cannot use prefix operator on object of type.");
-    });
+    }, BaseNodePtrVector{expression});
 }
 
 
 AnyNode::Ptr createNegationNode(BaseNode::Ptr expression)
 {
-    return std::make_shared<AnyNode>(NodeType::Negation, [expression](Scope &scope)
+    auto evaluateValue = [expression](Scope &scope)
     {
-        auto bodyEvaluated = expression->evaluate(scope);
+        Value bodyEvaluated = expression->evaluateValue(scope);
 
-        AnyObject::Ptr result{nullptr};
+        if (bodyEvaluated.isInt())
+            return Value(-bodyEvaluated.asInt());
+        else if (bodyEvaluated.isFloat())
+            return Value(-bodyEvaluated.asFloat());
 
-        if (bodyEvaluated->isType(AnyObject::Int))
-            result = ObjectFactory::allocate(-bodyEvaluated->getValue<long>());
-        else if (bodyEvaluated->isType(AnyObject::Float))
-            result = ObjectFactory::allocate(-bodyEvaluated->getValue<double>());
-        else
-            ThrowException("invalid object type");
+        ThrowException("invalid object type");
+    };
 
-        return result;
-    });
+    auto evaluate = [evaluateValue](Scope &scope)
+    {
+        return ObjectFactory::box(evaluateValue(scope));
+    };
+
+    return AstArena::makeNode<AnyNode>(NodeType::Negation, std::move(evaluate), std::move(evaluateValue), BaseNodePtrVector{expression});
 }
 
 
 AnyPropertyNode::Ptr createStructAccessNode(std::string structVarName, std::string memberVarName)
 {
-    auto evaluateNoClone = [structVarName, memberVarName](Scope &scope)
+    /* The instance lookup is resolved to a slot by VariableResolver if possible */
+    auto instanceNode = AstArena::makeNode<LookupVariableNode>(structVarName);
+
+    const SymbolID memberSymbol = SymbolTable::instance().intern(memberVarName);
+
+    auto evaluateNoClone = [instanceNode, memberSymbol](Scope &scope)
     {
-        auto theObject = scope.getNamedObject(structVarName);
+        const auto &theObject = instanceNode->lookupObject(scope);
 
-        auto theStructObject = std::static_pointer_cast<ClassNode>(theObject->getValue<BaseNode::Ptr>());
+        const auto &theStructObject = static_cast<const ClassNode &>(*theObject->getValue<BaseNode::Ptr>());
 
-        return theStructObject->instanceScope().getNamedObject(memberVarName);
+        return theStructObject.member(memberSymbol); /* Slot in the class layout */
     };
 
     auto evaluate = [evaluateNoClone](Scope &scope)
@@ -392,7 +415,20 @@ AnyPropertyNode::Ptr createStructAccessNode(std::string structVarName, std::stri
         return currentObject->clone();
     };
 
-    return std::make_shared<AnyPropertyNode>(NodeType::StructAccess, std::move(evaluate), std::move(evaluateNoClone));
+    auto evaluateValue = [evaluateNoClone](Scope &scope)
+    {
+        return Value(evaluateNoClone(scope)); /* Borrowed */
+    };
+
+    auto setProperty = [evaluateNoClone](Scope &scope, const Value &value)
+    {
+        evaluateNoClone(scope)->assign(value);
+    };
+
+    auto node = AstArena::makeNode<AnyPropertyNode>(NodeType::StructAccess, std::move(evaluate), std::move(evaluateValue), std::move(evaluateNoClone), std::move(setProperty), BaseNodePtrVector{instanceNode});
+
+    node->setSymbols(SymbolTable::instance().intern(structVarName), memberSymbol);
+    return node;
 }
 
 
@@ -400,33 +436,56 @@ AnyPropertyNode::Ptr createArrayAccessNode(BaseNode::Ptr arrayLookupNode, BaseNo
 {
     assert(arrayLookupNode->isNodeType(NodeType::LookupVariable));
 
-    auto evaluateNoClone = [arrayLookupNode, arrayIndexNode](Scope &scope)
+    /* Returns the array and the checked index */
+    auto lookupArray = [arrayLookupNode, arrayIndexNode](Scope &scope)
     {
         // Lookup in array.
         auto theArrayObject = arrayLookupNode->evaluate(scope); /* Careful with references! */
 
-        auto &arrayObj = theArrayObject->getValue<AnyObject::Vector>();
-        auto index = arrayIndexNode->evaluate(scope)->getValue<long>();
+        auto index = arrayIndexNode->evaluateValue(scope).toInt();
 
-        if (index < 0 || index >= (long)arrayObj.size())
+        if (index < 0 || index >= (long)theArrayObject->arraySize())
             ThrowException("Array index [" + std::to_string(index) + "] is out of bounds!");
 
-        return arrayObj[index];
+        return std::pair(std::move(theArrayObject), (size_t)index);
     };
 
-    auto evaluate = [evaluateNoClone](Scope &scope)
+    /* Reads borrow the element (or return an immediate for packed arrays). Only writes detach a shared array */
+    auto evaluateValue = [lookupArray](Scope &scope)
     {
-        AnyObject::Ptr currentObject = evaluateNoClone(scope);
-        return currentObject->clone();
+        auto [theArrayObject, index] = lookupArray(scope);
+        return theArrayObject->arrayElement(index);
+    };
+
+    auto evaluate = [evaluateValue](Scope &scope)
+    {
+        return ObjectFactory::copy(evaluateValue(scope));
+    };
+
+    auto evaluateNoClone = [lookupArray](Scope &scope)
+    {
+        auto [theArrayObject, index] = lookupArray(scope);
+
+        theArrayObject->unpackArray(); /* Elements of a packed array are not objects */
+        return theArrayObject->getValue<AnyObject::Vector>()[index];
+    };
+
+    auto setProperty = [lookupArray](Scope &scope, const Value &value)
+    {
+        auto [theArrayObject, index] = lookupArray(scope);
+        theArrayObject->setArrayElement(index, value);
     };
 
-    return std::make_shared<AnyPropertyNode>(NodeType::ArrayAccess, std::move(evaluate), std::move(evaluateNoClone));
+    return AstArena::makeNode<AnyPropertyNode>(NodeType::ArrayAccess, std::move(evaluate), std::move(evaluateValue), std::move(evaluateNoClone), std::move(setProperty), BaseNodePtrVector{arrayLookupNode, arrayIndexNode});
 }
 
 
 AnyNode::Ptr createModuleNode(std::string moduleName, ModuleFunctor::Definitions moduleFunctions)
 {
-    return std::make_shared<AnyNode>(NodeType::Module, [moduleName = std::move(moduleName), moduleFunctions = std::move(moduleFunctions)](Scope &scope)
+    /* Empty module nodes (duplicate imports) have no symbol */
+    const SymbolID moduleSymbol = moduleName.empty() ? SymbolTableImpl::kNoSymbol : SymbolTable::instance().intern(moduleName);
+
+    auto node = AstArena::makeNode<AnyNode>(NodeType::Module, [moduleName = std::move(moduleName), moduleFunctions = std::move(moduleFunctions)](Scope &scope)
     {
         for (auto &it : moduleFunctions) /* Add to scope */
         {
@@ -436,30 +495,52 @@ AnyNode::Ptr createModuleNode(std::string moduleName, ModuleFunctor::Definitions
 
         return nullptr;
     });
+
+    node->setSymbols(moduleSymbol);
+    return node;
 }
 
 AnyNode::Ptr createClassMethodCallNode(std::string instanceName, FunctionCallNode::Ptr methodCallNode)
 {
-    return std::make_shared<AnyNode>(NodeType::ClassMethodCall, [instanceName = std::move(instanceName),
-                                                                 methodCallNode](Scope &scope)
+    /* The instance lookup is resolved to a slot by VariableResolver if possible */
+    auto instanceNode = AstArena::makeNode<LookupVariableNode>(instanceName);
+
+    const SymbolID methodSymbol = SymbolTable::instance().intern(methodCallNode->_funcName);
+
+    /* NB: shared so that copies of the functor use the same caches */
+    auto cacheSlot = std::make_shared<const CacheSlot>();
+
+    auto node = AstArena::makeNode<AnyNode>(NodeType::ClassMethodCall, [instanceNode, methodCallNode, methodSymbol, cacheSlot](Scope &scope)
     {
-        auto anyObject = scope.getNamedObject(instanceName);
+        AnyObject::Ptr instanceObject = instanceNode->lookupObject(scope);
+
+        if (!instanceObject->isType(AnyObject::Class))
+        {
+            ThrowException(instanceNode->name() + " is not a class instance");
+        }
 
-        auto thisObject = std::static_pointer_cast<ClassNode>(anyObject->getValue<BaseNode::Ptr>());
+        const auto &definition = static_cast<const ClassNode &>(*instanceObject->getValue<BaseNode::Ptr>()).definition();
 
-        // Important: to correctly evaluate the method, we need to add a parent scope
-        // for the class instance temporarily each time we evaluate so function has
-        // access to stuff created outside class.
-        thisObject->instanceScope().setParentScope(&scope);
+        /* Methods are found by class so overridden methods are dispatched without a name lookup */
+        auto &cache = InterpreterContext::current().methodCache(*cacheSlot);
+
+        int methodSlot = cache.find(definition.classId());
+        if (methodSlot < 0)
+        {
+            methodSlot = definition.findMethod(methodSymbol);
+            if (methodSlot == ScopeLayout::kNotFound)
+            {
+                ThrowException("class " + definition.className() + " has no method named " + methodCallNode->_funcName);
+            }
 
-        /* But evaluate in class' instance scope */
-        AnyObject::Ptr result = methodCallNode->evaluate(thisObject->instanceScope());
+            cache.insert(definition.classId(), (uint32_t)methodSlot);
+        }
 
-        // Set back to avoid problems if we forget to reset it in future.
-        thisObject->instanceScope().setParentScope(nullptr);
+        return ClassNode::callMethod(instanceObject, (uint32_t)methodSlot, *methodCallNode, scope);
+    }, BaseNodePtrVector{methodCallNode, instanceNode});
 
-        return result;
-    });
+    node->setSymbols(SymbolTable::instance().intern(instanceName), methodSymbol);
+    return node;
 }
 
 
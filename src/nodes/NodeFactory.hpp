@@ -11,9 +11,13 @@
 #include "AnyNode.hpp"
 #include "AnyObject.hpp"
 #include "BaseNode.hpp"
+#include "InterpreterContext.hpp"
 #include "FunctionCallNode.hpp"
 #include "ModuleFunctor.hpp"
+#include "Scope.hpp"
+#include "ScopeLayout.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 
 
@@ -26,7 +30,10 @@ AnyNode::Ptr createBoolNode(bool state);
 
 AnyNode::Ptr createIntNode(long value);
 
-AnyNode::Ptr createStringNode(std::string value);
+/* String literals refer to an interned object which is shared by all literals with the same value */
+AnyNode::Ptr createStringNode(std::string_view value);
+
+AnyNode::Ptr createStringNode(SymbolID symbol);
 
 AnyNode::Ptr createFloatNode(double value);
 
@@ -40,6 +47,8 @@ AnyNode::Ptr createDoWhileLoopNode(BaseNode::Ptr condition, BaseNode::Ptr body);
 
 AnyNode::Ptr createBreakNode();
 
+AnyNode::Ptr createContinueNode();
+
 AnyNode::Ptr createReturnNode(BaseNode::Ptr returnNode = nullptr);
 
 AnyNode::Ptr createNotNode(BaseNode::Ptr expression);
@@ -72,6 +81,105 @@ AnyNode::Ptr createModuleNode(std::string moduleName = "", ModuleFunctor::Defini
 
 AnyNode::Ptr createClassMethodCallNode(std::string instanceName, FunctionCallNode::Ptr methodCallNode);
 
+/*
+ * Evaluate functions for branch and loop nodes. The condition is called with the scope and returns a bool so that the
+ * fused conditions installed by the NodeFuser are inlined.
+ */
+inline auto nodeCondition(BaseNode::Ptr condition)
+{
+    return [condition = std::move(condition)](Scope &scope)
+    {
+        return condition->evaluateValue(scope).toBool();
+    };
+}
+
+
+template <class TCondition>
+auto ifFunction(TCondition condition, BaseNode::Ptr thenBranch, BaseNode::Ptr elseBranch)
+{
+    return [condition = std::move(condition), thenBranch = std::move(thenBranch), elseBranch = std::move(elseBranch)](Scope &scope) /* Use shared pointer to manage ownership */
+    {
+        if (condition(scope))
+            return thenBranch->evaluate(scope);
+        else if (elseBranch)
+            return elseBranch->evaluate(scope);
+        else
+            return AnyObject::Ptr();
+    };
+}
+
+
+template <class TCondition>
+auto forLoopFunction(BaseNode::Ptr init, TCondition condition, BaseNode::Ptr update, BaseNode::Ptr body, const ScopeLayout *layout)
+{
+    return [init = std::move(init), condition = std::move(condition), update = std::move(update), body = std::move(body), layout](Scope &scope)
+    {
+        // Initialization.
+        auto &context = InterpreterContext::current();
+
+        Scope loopScope(scope, layout); // Extend scope.
+
+        (void)init->evaluate(loopScope);
+
+        // Add evaluation to forScope:
+        for (;
+             condition(loopScope);
+             update->evaluate(loopScope))
+        {
+            (void)body->evaluate(loopScope);
+
+            if (context.exitLoop())
+                break;
+        }
+
+        return AnyObject::Ptr();
+    };
+}
+
+
+template <class TCondition>
+auto whileLoopFunction(TCondition condition, BaseNode::Ptr body, const ScopeLayout *layout)
+{
+    return [condition = std::move(condition), body = std::move(body), layout](Scope &scope)
+    {
+        auto &context = InterpreterContext::current();
+
+        Scope loopScope(scope, layout); // Extend scope.
+
+        while (condition(scope))
+        {
+            (void)body->evaluate(loopScope);
+
+            if (context.exitLoop())
+                break;
+        }
+
+        return AnyObject::Ptr();
+    };
+}
+
+
+template <class TCondition>
+auto doWhileLoopFunction(TCondition condition, BaseNode::Ptr body, const ScopeLayout *layout)
+{
+    return [condition = std::move(condition), body = std::move(body), layout](Scope &scope)
+    {
+        auto &context = InterpreterContext::current();
+
+        Scope loopScope(scope, layout); // Extend scope.
+
+        do
+        {
+            (void)body->evaluate(loopScope);
+
+            if (context.exitLoop())
+                break;
+        } while (condition(scope)); /* NB: evaluate in outerscope (no access to loop scope) */
+
+        return AnyObject::Ptr(); // Return nothing.
+    };
+}
+
 } // namespace NodeFactory
 
 
@@ -79,9 +187,7 @@ AnyNode::Ptr createClassMethodCallNode(std::string instanceName, FunctionCallNod
 TODO: - interesting performance enhancements
 
 1. Try to have as few Node types as possible (as I'm currently doing)
-2. Then overload new/delete operators
-3. Store Node types in a flat array
-4. Can use a ThreadPool to build nodes (don't need to wait for FileNode to create --> since it's not referenced. Just
+2. Can use a ThreadPool to build nodes (don't need to wait for FileNode to create --> since it's not referenced. Just
    know where we're putting the Node in the flat array and any of its children)
 
 **************************** */
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * @file NodeFunction.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AstArena.hpp"
+#include <new>
+#include <type_traits>
+#include <utility>
+
+template <class Signature>
+class NodeFunction;
+
+/*
+ * Move-only replacement for std::function used by AnyNode. If the node holding the function was allocated in the
+ * current AstArena then the functor is stored alongside it in the arena, otherwise it is allocated on the heap.
+ */
+template <class Result, class... Args>
+class NodeFunction<Result(Args...)>
+{
+public:
+    NodeFunction() = default;
+
+    template <class TFunc, class = std::enable_if_t<!std::is_same_v<std::decay_t<TFunc>, NodeFunction>>>
+    NodeFunction(TFunc &&func)
+    {
+        using Functor = std::decay_t<TFunc>;
+
+        AstArena *arena = AstArena::current();
+
+        if (arena && arena->contains(this))
+        {
+            _functor = new (arena->allocate(sizeof(Functor), alignof(Functor))) Functor(std::forward<TFunc>(func));
+            _destroy = [](void *functor)
+            { static_cast<Functor *>(functor)->~Functor(); };
+        }
+        else
+        {
+            _functor = new Functor(std::forward<TFunc>(func));
+            _destroy = [](void *functor)
+            { delete static_cast<Functor *>(functor); };
+        }
+
+        _invoke = [](void *functor, Args... args) -> Result
+        {
+            return (*static_cast<Functor *>(functor))(std::forward<Args>(args)...);
+        };
+    }
+
+    NodeFunction(NodeFunction &&other) noexcept
+        : _functor(std::exchange(other._functor, nullptr)),
+          _invoke(std::exchange(other._invoke, nullptr)),
+          _destroy(std::exchange(other._destroy, nullptr))
+    {
+    }
+
+    NodeFunction(const NodeFunction &) = delete;
+    NodeFunction &operator=(const NodeFunction &) = delete;
+    NodeFunction &operator=(NodeFunction &&) = delete;
+
+    ~NodeFunction()
+    {
+        if (_functor)
+        {
+            _destroy(_functor);
+        }
+    }
+
+    /* Replaces the functor. It is stored in the arena if the node was allocated in the current arena */
+    template <class TFunc>
+    void reset(TFunc &&func)
+    {
+        this->~NodeFunction();
+        new (this) NodeFunction(std::forward<TFunc>(func));
+    }
+
+    Result operator()(Args... args) const
+    {
+        return _invoke(_functor, std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return (_functor != nullptr); }
+
+private:
+    void *_functor{nullptr};
+    Result (*_invoke)(void *, Args...){nullptr};
+    void (*_destroy)(void *){nullptr};
+};
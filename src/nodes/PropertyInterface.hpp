@@ -28,5 +28,8 @@ struct PropertyInterface
     /* Return object directly for modifying value (setter) */
     virtual std::shared_ptr<class AnyObject> evaluateNoClone(Scope &scope) = 0;
 
+    /* Set value with RHS. Types must match */
+    virtual void setProperty(Scope &scope, const class Value &value) = 0;
+
     virtual ~PropertyInterface() = default;
 };
\ No newline at end of file
@@ -10,6 +10,8 @@
 #include "AnyObject.hpp"
 #include "ClassNode.hpp"
 #include "Exceptions.hpp"
+#include "ObjectFactory.hpp"
+#include "Value.hpp"
 
 
 AnyObject::Type AnyObject::stringToType(const std::string &name)
@@ -60,14 +62,70 @@ std::string AnyObject::typeToString() const
 }
 
 
-AnyObject &AnyObject::operator=(const AnyObject &other)
+void AnyObject::throwAssignTypeMismatch(Type otherType) const
+{
+    throwAssignTypeMismatch(_type, otherType);
+}
+
+
+void AnyObject::throwAssignTypeMismatch(Type type, Type otherType)
+{
+    ThrowException("Invalid assignment. Types do not match [LHS = " + typeToString(type) + ", RHS = " + typeToString(otherType) + "]");
+}
+
+
+namespace
+{
+
+/* Pins rarely contend so the lock spins rather than adding a mutex to every object */
+class PinLock
+{
+public:
+    explicit PinLock(std::atomic_flag &flag) : _flag(flag)
+    {
+        while (_flag.test_and_set(std::memory_order_acquire))
+        {
+        }
+    }
+
+    ~PinLock() { _flag.clear(std::memory_order_release); }
+
+private:
+    std::atomic_flag &_flag;
+};
+
+} // namespace
+
+
+void AnyObject::holdSelf()
 {
-    /* TODO: - implement if required */
-    AnyObject::Vector cloneVector(const AnyObject::Vector &);
+    PinLock lock(_pinLock);
+
+    if (_pins.load(std::memory_order_relaxed) > 0 && !_pinnedSelf)
+        _pinnedSelf = shared_from_this();
+}
 
+
+void AnyObject::releaseSelf()
+{
+    AnyObject::Ptr self;
+
+    {
+        PinLock lock(_pinLock);
+
+        if (_pins.load(std::memory_order_relaxed) == 0)
+            self = std::move(_pinnedSelf);
+    }
+
+    /* May destroy this once the lock is released */
+}
+
+
+AnyObject &AnyObject::operator=(const AnyObject &other)
+{
     if (getType() != other.getType())
     {
-        ThrowException("Invalid assignment. Types do not match [LHS = " + typeToString() + ", RHS = " + other.typeToString() + "]");
+        throwAssignTypeMismatch(other.getType());
     }
 
     switch (getType())
@@ -76,14 +134,17 @@ AnyObject &AnyObject::operator=(const AnyObject &other)
         case Bool:
         case Float:
         case String:
-            _value = other._value; /* Standard copy assignment */
+            _value = other._value; /* Standard copy assignment. Strings and arrays share the buffer */
+            break;
+        case Array:
+            if (_declaredElementType == NotSet || other.elementType() == _declaredElementType)
+                _value = other._value;
+            else if (!packArray(other, _declaredElementType, _value))
+                throwAssignTypeMismatch(_declaredElementType, other.elementType());
             break;
         case Class:
             *std::static_pointer_cast<ClassNode>(getValue<BaseNode::Ptr>()) = *std::static_pointer_cast<ClassNode>(other.getValue<BaseNode::Ptr>());
             break;
-        case Array: /* Array is a vector of shared pointers --> need to clone for deep-copy */
-            getValue<Vector>() = cloneVector(other.getValue<Vector>());
-            break;
         default:
             ThrowException("Copy assignment not implemented for object type [" + typeToString() + "]");
     }
@@ -94,26 +155,217 @@ AnyObject &AnyObject::operator=(const AnyObject &other)
 
 AnyObject::Ptr AnyObject::clone() const
 {
-    AnyObject::Vector cloneVector(const AnyObject::Vector &);
-
     switch (getType())
     {
         case Bool:
-            return std::make_shared<AnyObject>(getValue<bool>());
+            return ObjectFactory::allocate(getValue<bool>());
         case Int:
-            return std::make_shared<AnyObject>(getValue<long>());
+            return ObjectFactory::allocate(getValue<long>());
         case Float:
-            return std::make_shared<AnyObject>(getValue<double>());
+            return ObjectFactory::allocate(getValue<double>());
         case String:
-            return std::make_shared<AnyObject>(getValue<std::string>());
+            return ObjectFactory::allocate(std::get<StringBuffer>(_value));
         case Array:
-            return std::make_shared<AnyObject>(cloneVector(getValue<Vector>()));
+            return visitArray([](const auto &buffer)
+            {
+                return ObjectFactory::allocate(buffer);
+            });
         default:
             ThrowException("clone() is not implemented for object type [" + typeToString() + "]");
     }
 }
 
-AnyObject::Vector cloneVector(const AnyObject::Vector &vector)
+
+bool AnyObject::sharesBuffer(const AnyObject &other) const
+{
+    if (getType() != other.getType())
+    {
+        return false;
+    }
+
+    switch (getType())
+    {
+        case String:
+            return std::get<StringBuffer>(_value).sharesWith(std::get<StringBuffer>(other._value));
+        case Array:
+            return visitArray([&other](const auto &buffer)
+            {
+                using TBuffer = std::decay_t<decltype(buffer)>;
+                return std::holds_alternative<TBuffer>(other._value) && buffer.sharesWith(std::get<TBuffer>(other._value));
+            });
+        default:
+            return false;
+    }
+}
+
+
+size_t AnyObject::arraySize() const
+{
+    return visitArray([](const auto &buffer)
+    {
+        return buffer.get().size();
+    });
+}
+
+
+void AnyObject::appendArrayElement(const Value &value)
+{
+    const Type type = elementType();
+
+    if (type != NotSet && value.type() == type)
+    {
+        switch (type)
+        {
+            case Int:
+                getValue<IntVector>().push_back(value.asInt());
+                return;
+            case Float:
+                getValue<FloatVector>().push_back(value.asFloat());
+                return;
+            default:
+                getValue<BoolVector>().push_back(value.asBool());
+                return;
+        }
+    }
+    else if (_declaredElementType != NotSet && value.type() != _declaredElementType)
+    {
+        throwAssignTypeMismatch(_declaredElementType, value.type());
+    }
+    else if (type == NotSet && arraySize() == 0)
+    {
+        /* An empty array is packed by its first element */
+        switch (value.type())
+        {
+            case Int:
+                _value = IntArrayBuffer(IntVector{value.asInt()});
+                return;
+            case Float:
+                _value = FloatArrayBuffer(FloatVector{value.asFloat()});
+                return;
+            case Bool:
+                _value = BoolArrayBuffer(BoolVector{value.asBool()});
+                return;
+            default:
+                break;
+        }
+    }
+
+    auto element = ObjectFactory::copy(value); /* NB: before unpacking or detaching (i.e. append(a, a)) */
+
+    unpackArray();
+    getValue<Vector>().push_back(std::move(element));
+}
+
+
+void AnyObject::clearArray()
+{
+    switch (_declaredElementType)
+    {
+        case Int:
+            _value = IntArrayBuffer(IntVector()); /* Replace the buffer rather than detaching a shared one */
+            break;
+        case Float:
+            _value = FloatArrayBuffer(FloatVector());
+            break;
+        case Bool:
+            _value = BoolArrayBuffer(BoolVector());
+            break;
+        default:
+            _value = ArrayBuffer(Vector());
+            break;
+    }
+}
+
+
+AnyObject::Vector AnyObject::arrayElements() const
+{
+    if (elementType() == NotSet)
+    {
+        return SharedBuffer<Vector>::copy(getValue<Vector>());
+    }
+
+    Vector elements;
+
+    elements.reserve(arraySize());
+
+    for (size_t i = 0; i < arraySize(); ++i)
+    {
+        elements.push_back(ObjectFactory::box(arrayElement(i)));
+    }
+
+    return elements;
+}
+
+
+void AnyObject::declareElementType(Type elementType)
+{
+    if (elementType != Int && elementType != Float && elementType != Bool)
+    {
+        ThrowException("Invalid array element type [" + typeToString(elementType) + "]. Expected Int, Float or Bool");
+    }
+
+    _declaredElementType = elementType;
+    clearArray();
+}
+
+
+void AnyObject::unpackArray()
+{
+    if (elementType() != NotSet)
+    {
+        _value = ArrayBuffer(arrayElements());
+    }
+}
+
+
+bool AnyObject::packArray(const AnyObject &array, Type elementType, ValueVariant &packed)
+{
+    const size_t size = array.arraySize();
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (array.arrayElement(i).type() != elementType)
+            return false;
+    }
+
+    auto pack = [&array, size](auto vector)
+    {
+        vector.reserve(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            Value element = array.arrayElement(i);
+
+            if constexpr (std::is_same_v<decltype(vector), IntVector>)
+                vector.push_back(element.asInt());
+            else if constexpr (std::is_same_v<decltype(vector), FloatVector>)
+                vector.push_back(element.asFloat());
+            else
+                vector.push_back(element.asBool());
+        }
+
+        return SharedBuffer<decltype(vector)>(std::move(vector));
+    };
+
+    switch (elementType)
+    {
+        case Int:
+            packed = pack(IntVector());
+            return true;
+        case Float:
+            packed = pack(FloatVector());
+            return true;
+        case Bool:
+            packed = pack(BoolVector());
+            return true;
+        default:
+            return false;
+    }
+}
+
+
+template <>
+AnyObject::Vector SharedBuffer<AnyObject::Vector>::copy(const AnyObject::Vector &vector)
 {
     AnyObject::Vector clone;
 
@@ -121,12 +373,13 @@ AnyObject::Vector cloneVector(const AnyObject::Vector &vector)
 
     for (const auto &object : vector)
     {
-        clone.push_back(object->clone()); /* Deep-copy */
+        clone.push_back(object->clone()); /* Elements are modified in-place by indexed assignment */
     }
 
     return clone;
 }
 
+
 std::ostream &operator<<(std::ostream &out, const AnyObject::Vector &array);
 
 
@@ -145,6 +398,18 @@ std::ostream &operator<<(std::ostream &out, const AnyObject &object)
         case AnyObject::String:
             return (out << object.getValue<std::string>());
         case AnyObject::Array:
+            if (object.elementType() != AnyObject::NotSet)
+            {
+                out << "[";
+
+                for (size_t i = 0; i < object.arraySize(); ++i)
+                {
+                    out << object.arrayElement(i) << ", ";
+                }
+
+                return (out << "]");
+            }
+
             return (out << object.getValue<AnyObject::Vector>());
         default:
             return out; /* Don't print anything --> not supported */
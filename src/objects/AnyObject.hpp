@@ -10,24 +10,35 @@
 #pragma once
 #include "BaseNode.hpp"
 #include "ModuleFunctor.hpp"
-#include "PoolAllocator.hpp"
+#include "SharedBuffer.hpp"
+#include <atomic>
 #include <cassert>
 #include <memory>
 #include <new>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
-// TODO: - profile and investigate using PoolAllocator
-// static PoolAllocator allocator{10};
-
-class AnyObject
+class AnyObject : public std::enable_shared_from_this<AnyObject>
 {
 public:
     using Ptr = std::shared_ptr<AnyObject>;
     using Vector = std::vector<AnyObject::Ptr>;
 
+    /* Packed arrays. Used when all elements have the same primitive type */
+    using IntVector = std::vector<long>;
+    using FloatVector = std::vector<double>;
+    using BoolVector = std::vector<bool>; /* Bit-packed */
+
+    /* Strings and arrays share their buffer with copies until modified */
+    using StringBuffer = SharedBuffer<std::string>;
+    using ArrayBuffer = SharedBuffer<Vector>;
+    using IntArrayBuffer = SharedBuffer<IntVector>;
+    using FloatArrayBuffer = SharedBuffer<FloatVector>;
+    using BoolArrayBuffer = SharedBuffer<BoolVector>;
+
     virtual ~AnyObject() = default; /* In case we subclass */
 
     enum Type
@@ -45,17 +56,6 @@ public:
         _ClassDefinition,
     };
 
-    // void *operator new(size_t size)
-    // {
-    //     return allocator.allocate(size);
-    // }
-
-    // void operator delete(void *ptr)
-    // {
-    //     allocator.deallocate(ptr);
-    // }
-
-
     /* Converts user types like "int" --> AnyType::Int or returns None if not found */
     static AnyObject::Type stringToType(const std::string &name);
 
@@ -67,8 +67,16 @@ public:
     explicit AnyObject(bool value) : _value(value), _type(Bool) {}
     explicit AnyObject(long value) : _value(value), _type(Int) {} /* NB: require explicit to avoid implicit casting */
     explicit AnyObject(double value) : _value(value), _type(Float) {}
-    explicit AnyObject(std::string value) : _value(std::move(value)), _type(String) {}
-    explicit AnyObject(AnyObject::Vector value) : _value(std::move(value)), _type(Array) {}
+    explicit AnyObject(std::string value) : _value(StringBuffer(std::move(value))), _type(String) {}
+    explicit AnyObject(AnyObject::Vector value) : _value(ArrayBuffer(std::move(value))), _type(Array) {}
+    explicit AnyObject(IntVector value) : _value(IntArrayBuffer(std::move(value))), _type(Array) {}
+    explicit AnyObject(FloatVector value) : _value(FloatArrayBuffer(std::move(value))), _type(Array) {}
+    explicit AnyObject(BoolVector value) : _value(BoolArrayBuffer(std::move(value))), _type(Array) {}
+    explicit AnyObject(StringBuffer value) : _value(std::move(value)), _type(String) {}
+    explicit AnyObject(ArrayBuffer value) : _value(std::move(value)), _type(Array) {}
+    explicit AnyObject(IntArrayBuffer value) : _value(std::move(value)), _type(Array) {}
+    explicit AnyObject(FloatArrayBuffer value) : _value(std::move(value)), _type(Array) {}
+    explicit AnyObject(BoolArrayBuffer value) : _value(std::move(value)), _type(Array) {}
     explicit AnyObject(ModuleFunctor value) : _value(std::move(value)), _type(_ModuleFunction) {}
 
     /* _userFuntion, _StructDefinition, Struct, ...*/
@@ -76,6 +84,13 @@ public:
 
     AnyObject &operator=(const AnyObject &other);
 
+    /* Assigns an immediate or heap value. Types must match. Defined in Value.hpp */
+    inline void assign(const class Value &value);
+
+    /*
+     * NB: the non-const version detaches a shared string or array. Use the const version for read-only access. Arrays
+     * are stored as a Vector or a packed vector (see elementType())
+     */
     template <typename TValue>
     [[nodiscard]] inline TValue &getValue();
 
@@ -86,13 +101,80 @@ public:
 
     [[nodiscard]] inline bool isType(Type expectedType) const;
 
+    /* Strings and arrays share the buffer with the clone */
     [[nodiscard]] AnyObject::Ptr clone() const;
 
+    /* True if both are strings or arrays with the same buffer (and therefore equal) */
+    [[nodiscard]] bool sharesBuffer(const AnyObject &other) const;
+
+    /* Array element type if the array is packed (Int, Float or Bool). NotSet for a generic array */
+    [[nodiscard]] inline Type elementType() const;
+
+    [[nodiscard]] size_t arraySize() const;
+
+    /* Elements of a packed array are returned as immediates. Elements of a generic array are borrowed. Unchecked */
+    [[nodiscard]] inline class Value arrayElement(size_t index) const;
+
+    /* Types must match. Unchecked index. Defined in Value.hpp */
+    inline void setArrayElement(size_t index, const class Value &value);
+
+    /* Appends a copy. A packed array becomes generic if the type does not match (unless declared) */
+    void appendArrayElement(const class Value &value);
+
+    void clearArray();
+
+    /* Copy of the elements as a generic array */
+    [[nodiscard]] Vector arrayElements() const;
+
+    /* Restricts the elements of an array to a primitive type (i.e. int[] a). The array is emptied and packed */
+    void declareElementType(Type elementType);
+
+    /* Converts a packed array to a generic array so that its elements can be modified in-place */
+    void unpackArray();
+
+    /* Values referring to the object no longer pin it so they never modify it. The owner must keep the object alive
+     * until exit (see StringPool) */
+    void makeImmortal() { _isImmortal = true; }
+
     friend std::ostream &operator<<(std::ostream &out, const AnyObject &object);
 
 protected:
     AnyObject() = default; /* Prevent direct initialization */
 
+    friend class Value;
+    friend class CycleCollector;
+
+    /*
+     * Values hold raw pointers to heap objects. The first pin keeps the object alive until the last unpin. The count is
+     * atomic because an object bound to scripts on several threads is pinned by each of them (see PreparedScript)
+     */
+    void pin()
+    {
+        if (_isImmortal)
+            return;
+
+        if (_pins.fetch_add(1, std::memory_order_relaxed) == 0)
+            holdSelf();
+    }
+
+    void unpin()
+    {
+        if (_isImmortal)
+            return;
+
+        if (_pins.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            releaseSelf();
+    }
+
+    /* 0 -> 1 and 1 -> 0 transitions. The count is checked again under the lock since another thread may have pinned
+     * or unpinned the object in between */
+    void holdSelf();
+    void releaseSelf();
+
+    [[noreturn]] void throwAssignTypeMismatch(Type otherType) const;
+
+    [[noreturn]] static void throwAssignTypeMismatch(Type type, Type otherType);
+
 private:
     using TypeToStringHashMap = std::unordered_map<Type, std::string>;
     using StringToTypeHashMap = std::unordered_map<std::string, Type>;
@@ -100,26 +182,62 @@ private:
     using ValueVariant = std::variant<long,
                                       bool,
                                       double,
-                                      std::string,
-                                      Vector,
+                                      StringBuffer,
+                                      ArrayBuffer,
+                                      IntArrayBuffer,
+                                      FloatArrayBuffer,
+                                      BoolArrayBuffer,
                                       ModuleFunctor,
                                       BaseNode::Ptr>;
+
+    /* Types stored in a SharedBuffer */
+    template <typename TValue>
+    static constexpr bool kIsBuffered = (std::is_same_v<TValue, std::string> ||
+                                         std::is_same_v<TValue, Vector> ||
+                                         std::is_same_v<TValue, IntVector> ||
+                                         std::is_same_v<TValue, FloatVector> ||
+                                         std::is_same_v<TValue, BoolVector>);
+
+    /* Calls the function with the buffer of an array */
+    template <class TFunction>
+    decltype(auto) visitArray(TFunction &&function) const;
+
+    /* Converts the elements of an array to the (primitive) type. Returns false if an element has a different type */
+    static bool packArray(const AnyObject &array, Type elementType, ValueVariant &packed);
+
     ValueVariant _value{};
     Type _type{Type::NotSet};
+    Type _declaredElementType{Type::NotSet}; /* Arrays declared as int[], float[] or bool[] */
+
+    std::atomic<uint32_t> _pins{0};
+    std::atomic_flag _pinLock = ATOMIC_FLAG_INIT; /* Guards _pinnedSelf */
+    AnyObject::Ptr _pinnedSelf{nullptr};
+
+    bool _isImmortal{false}; /* Pin and unpin do nothing so the object may be shared by threads */
 };
 
 
+template <>
+AnyObject::Vector SharedBuffer<AnyObject::Vector>::copy(const AnyObject::Vector &vector);
+
+
 template <typename TValue> // No type checking!!
 TValue &AnyObject::getValue()
 {
-    return std::get<TValue>(_value);
+    if constexpr (kIsBuffered<TValue>)
+        return std::get<SharedBuffer<TValue>>(_value).mutate();
+    else
+        return std::get<TValue>(_value);
 }
 
 
 template <typename TValue>
 const TValue &AnyObject::getValue() const
 {
-    return std::get<TValue>(_value);
+    if constexpr (kIsBuffered<TValue>)
+        return std::get<SharedBuffer<TValue>>(_value).get();
+    else
+        return std::get<TValue>(_value);
 }
 
 
@@ -135,4 +253,34 @@ bool AnyObject::isType(Type expectedType) const
 }
 
 
+AnyObject::Type AnyObject::elementType() const
+{
+    if (std::holds_alternative<IntArrayBuffer>(_value))
+        return Int;
+    else if (std::holds_alternative<FloatArrayBuffer>(_value))
+        return Float;
+    else if (std::holds_alternative<BoolArrayBuffer>(_value))
+        return Bool;
+    else
+        return NotSet;
+}
+
+
+template <class TFunction>
+decltype(auto) AnyObject::visitArray(TFunction &&function) const
+{
+    switch (elementType())
+    {
+        case Int:
+            return function(std::get<IntArrayBuffer>(_value));
+        case Float:
+            return function(std::get<FloatArrayBuffer>(_value));
+        case Bool:
+            return function(std::get<BoolArrayBuffer>(_value));
+        default:
+            return function(std::get<ArrayBuffer>(_value));
+    }
+}
+
+
 std::ostream &operator<<(std::ostream &out, const AnyObject &object);
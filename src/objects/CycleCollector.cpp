@@ -0,0 +1,247 @@
+/**
+ * @file CycleCollector.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "CycleCollector.hpp"
+#include "AnyObject.hpp"
+#include "ClassNode.hpp"
+#include "Exceptions.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+
+/* Something with a reference count which can refer to tracked objects */
+enum class VertexKind : uint8_t
+{
+    Object,      /* A tracked object */
+    ArrayBuffer, /* Elements of a generic array. Shared by the arrays until one is modified */
+    Instance     /* A ClassNode. Its instance scope holds the fields */
+};
+
+struct Vertex
+{
+    const void *address;
+    VertexKind kind;
+    long references; /* References from outside once the references from other vertices are subtracted */
+    bool isReachable{false};
+};
+
+} // namespace
+
+
+CycleCollector::CycleCollector(const Options &options)
+{
+    setOptions(options);
+}
+
+
+void CycleCollector::setOptions(const Options &options)
+{
+    if (options.growthFactor < 1.0)
+    {
+        ThrowException("cycle collector growth factor must be at least 1");
+    }
+
+    _options = options;
+    _threshold = std::max(_options.minThreshold, (size_t)((double)numTracked() * _options.growthFactor));
+}
+
+
+size_t CycleCollector::numTracked() const
+{
+    return (size_t)std::count_if(_tracked.begin(), _tracked.end(), [](const std::weak_ptr<AnyObject> &object)
+    {
+        return !object.expired();
+    });
+}
+
+
+size_t CycleCollector::collect()
+{
+    if (_isCollecting) /* Objects allocated while freeing garbage */
+    {
+        return 0;
+    }
+
+    _isCollecting = true;
+
+    auto start = std::chrono::steady_clock::now();
+
+    auto garbage = findGarbage();
+
+    /* Garbage objects are kept alive until all of the cycles are broken */
+    for (auto &object : garbage)
+    {
+        releaseReferences(*object);
+    }
+
+    const size_t numFreed = garbage.size();
+    garbage.clear();
+
+    _threshold = std::max(_options.minThreshold, (size_t)((double)_tracked.size() * _options.growthFactor));
+
+    auto pause = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+    ++_statistics.collections;
+    _statistics.objectsFreed += numFreed;
+    _statistics.lastPause = pause;
+    _statistics.maxPause = std::max(_statistics.maxPause, pause);
+    _statistics.totalPause += pause;
+
+    _isCollecting = false;
+    return numFreed;
+}
+
+
+std::vector<std::shared_ptr<AnyObject>> CycleCollector::findGarbage()
+{
+    /* Strong references to the tracked objects (the first vertices). They cannot be destroyed by other threads */
+    std::vector<std::shared_ptr<AnyObject>> objects;
+    objects.reserve(_tracked.size());
+
+    for (const auto &tracked : _tracked)
+    {
+        if (auto object = tracked.lock())
+            objects.push_back(std::move(object));
+    }
+
+    std::vector<Vertex> vertices;
+    std::unordered_map<const void *, size_t> indexForAddress;
+
+    vertices.reserve(objects.size());
+    indexForAddress.reserve(2 * objects.size());
+
+    for (const auto &object : objects)
+    {
+        indexForAddress.emplace(object.get(), vertices.size());
+        vertices.push_back(Vertex{object.get(), VertexKind::Object, object.use_count() - 1});
+    }
+
+    /* Calls the function with the index of each vertex referred to by a vertex. Untracked objects are ignored */
+    auto forEachReference = [&vertices, &indexForAddress](size_t index, auto &&function)
+    {
+        const Vertex vertex = vertices[index]; /* NB: copy since vertices may be added */
+
+        auto visitObject = [&indexForAddress, &function](const std::shared_ptr<AnyObject> &object)
+        {
+            auto iter = indexForAddress.find(object.get());
+
+            if (iter != indexForAddress.end())
+                function(iter->second);
+        };
+
+        auto visitShared = [&vertices, &indexForAddress, &function](const void *address, VertexKind kind, long useCount)
+        {
+            auto [iter, isNew] = indexForAddress.try_emplace(address, vertices.size());
+
+            if (isNew)
+                vertices.push_back(Vertex{address, kind, useCount});
+
+            function(iter->second);
+        };
+
+        switch (vertex.kind)
+        {
+            case VertexKind::Object:
+            {
+                const auto &object = *static_cast<const AnyObject *>(vertex.address);
+
+                if (const auto *buffer = std::get_if<AnyObject::ArrayBuffer>(&object._value))
+                {
+                    visitShared(&buffer->get(), VertexKind::ArrayBuffer, buffer->useCount());
+                }
+                else if (object.isType(AnyObject::Class))
+                {
+                    const auto &instance = std::get<BaseNode::Ptr>(object._value);
+
+                    if (instance)
+                        visitShared(instance.get(), VertexKind::Instance, instance.use_count());
+                }
+                break;
+            }
+            case VertexKind::ArrayBuffer:
+                for (const auto &element : *static_cast<const AnyObject::Vector *>(vertex.address))
+                {
+                    visitObject(element);
+                }
+                break;
+            case VertexKind::Instance:
+            {
+                const auto *instance = static_cast<const ClassNode *>(static_cast<const BaseNode *>(vertex.address));
+                instance->instanceScope().forEachObject(visitObject);
+                break;
+            }
+        }
+    };
+
+    /* 1. Subtract the references between vertices (including those found during the loop) */
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        forEachReference(i, [&vertices](size_t reference)
+        {
+            --vertices[reference].references;
+        });
+    }
+
+    /* 2. Mark everything reachable from the roots */
+    std::vector<size_t> pending;
+
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        if (vertices[i].references > 0)
+        {
+            vertices[i].isReachable = true;
+            pending.push_back(i);
+        }
+    }
+
+    while (!pending.empty())
+    {
+        size_t index = pending.back();
+        pending.pop_back();
+
+        forEachReference(index, [&vertices, &pending](size_t reference)
+        {
+            if (!vertices[reference].isReachable)
+            {
+                vertices[reference].isReachable = true;
+                pending.push_back(reference);
+            }
+        });
+    }
+
+    /* 3. Unreachable objects are garbage. The others are still tracked */
+    std::vector<std::shared_ptr<AnyObject>> garbage;
+
+    _tracked.clear();
+
+    for (size_t i = 0; i < objects.size(); ++i)
+    {
+        if (vertices[i].isReachable)
+            _tracked.emplace_back(objects[i]);
+        else
+            garbage.push_back(std::move(objects[i]));
+    }
+
+    return garbage;
+}
+
+
+void CycleCollector::releaseReferences(AnyObject &object)
+{
+    if (std::holds_alternative<AnyObject::ArrayBuffer>(object._value))
+    {
+        object._value = AnyObject::ArrayBuffer(AnyObject::Vector());
+    }
+    else if (object.isType(AnyObject::Class))
+    {
+        std::get<BaseNode::Ptr>(object._value).reset();
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * @file CycleCollector.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class AnyObject;
+
+/**
+ * Frees reference cycles between objects. Objects are reference-counted so most are freed as soon as they become
+ * unreachable but a cycle is never freed (i.e. a class instance with a field sharing the buffer of an array which
+ * contains the instance).
+ *
+ * Only arrays and class instances can refer to other objects. They are tracked by the collector of the context which
+ * allocated them (see ObjectFactory). A collection uses trial deletion over all of the tracked objects:
+ * 1. Each tracked object, array buffer and instance starts with its reference count.
+ * 2. The references between them are subtracted. Anything left with a reference is referred to from outside (a scope,
+ *    the C++ stack or another context) and is a root.
+ * 3. Everything reachable from a root is alive. The remaining objects are garbage. Their references are released which
+ *    breaks the cycles.
+ *
+ * A collection runs when the number of tracked objects reaches the threshold. The threshold is then set to a multiple
+ * of the surviving objects so that the time spent collecting is proportional to the allocations and the number of
+ * tracked objects (the heap) stays within a constant factor of the live objects.
+ *
+ * The collector holds weak references so tracking an object does not take a lock and the object may be destroyed on
+ * any thread. The chunk of a destroyed object is released by the next collection. Only the thread using the context
+ * may call the collector.
+ *
+ * Ref: Bacon & Rajan, "Concurrent Cycle Collection in Reference Counted Systems", ECOOP 2001 (synchronous collector).
+ */
+class CycleCollector
+{
+public:
+    struct Options
+    {
+        size_t minThreshold{10000}; /* Tracked objects before the first collection */
+        double growthFactor{2.0};   /* Threshold after a collection as a multiple of the surviving objects */
+        bool isAutomatic{true};     /* Collect when the threshold is reached. Otherwise only collect() frees cycles */
+    };
+
+    struct Statistics
+    {
+        uint64_t collections{0};
+        uint64_t objectsFreed{0}; /* Objects in cycles. Other objects are freed when their reference count is zero */
+        std::chrono::nanoseconds lastPause{0};
+        std::chrono::nanoseconds maxPause{0};
+        std::chrono::nanoseconds totalPause{0};
+    };
+
+    CycleCollector() = default;
+    explicit CycleCollector(const Options &options);
+
+    CycleCollector(const CycleCollector &) = delete;
+    CycleCollector &operator=(const CycleCollector &) = delete;
+
+    /* Called for a new array or class instance. Runs a collection if the threshold is reached */
+    inline void track(const std::shared_ptr<AnyObject> &object);
+
+    /* Frees all unreachable cycles. Returns the number of objects freed */
+    size_t collect();
+
+    void setOptions(const Options &options);
+
+    [[nodiscard]] const Options &options() const { return _options; }
+
+    [[nodiscard]] const Statistics &statistics() const { return _statistics; }
+
+    /* Number of tracked objects which have not been destroyed */
+    [[nodiscard]] size_t numTracked() const;
+
+    /* Number of tracked objects (including destroyed objects) which triggers the next collection */
+    [[nodiscard]] size_t threshold() const { return _threshold; }
+
+protected:
+    /* Returns strong references to the objects which are only reachable from other tracked objects. Destroyed and
+     * garbage objects are no longer tracked */
+    std::vector<std::shared_ptr<AnyObject>> findGarbage();
+
+    /* Releases the references of a garbage object. An array is left empty and an instance without its ClassNode */
+    static void releaseReferences(AnyObject &object);
+
+private:
+    Options _options;
+    Statistics _statistics;
+
+    std::vector<std::weak_ptr<AnyObject>> _tracked;
+
+    size_t _threshold{_options.minThreshold};
+
+    bool _isCollecting{false};
+};
+
+
+void CycleCollector::track(const std::shared_ptr<AnyObject> &object)
+{
+    _tracked.emplace_back(object);
+
+    if (_tracked.size() >= _threshold && _options.isAutomatic)
+    {
+        (void)collect();
+    }
+}
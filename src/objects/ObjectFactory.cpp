@@ -9,28 +9,129 @@
 
 #include "ObjectFactory.hpp"
 #include "Exceptions.hpp"
+#include "InterpreterContext.hpp"
+#include "Value.hpp"
 #include <string>
 
 namespace ObjectFactory
 {
 
+void track(const AnyObject::Ptr &object)
+{
+    InterpreterContext::current().collector().track(object);
+}
+
+
 AnyObject::Ptr allocate(AnyObject::Type objectType)
 {
     switch (objectType)
     {
         case AnyObject::Int:
-            return std::make_shared<AnyObject>(0L);
+            return allocate(0L);
         case AnyObject::Bool:
-            return std::make_shared<AnyObject>(false);
+            return allocate(false);
         case AnyObject::Float:
-            return std::make_shared<AnyObject>((double)0.0);
+            return allocate((double)0.0);
         case AnyObject::String:
-            return std::make_shared<AnyObject>(std::string());
+            return allocate(std::string());
         case AnyObject::Array:
-            return std::make_shared<AnyObject>(AnyObject::Vector());
+            return allocate(AnyObject::Vector());
         default:
             ThrowException("cannot allocate for object type!");
     }
 }
 
+
+AnyObject::Ptr box(const Value &value)
+{
+    switch (value.type())
+    {
+        case AnyObject::NotSet:
+            return nullptr;
+        case AnyObject::Int:
+            return value.isSmallInt() ? allocate(value.asInt()) : value.object().shared_from_this();
+        case AnyObject::Bool:
+            return allocate(value.asBool());
+        case AnyObject::Float:
+            return allocate(value.asFloat());
+        default:
+            return value.object().shared_from_this();
+    }
+}
+
+
+AnyObject::Ptr copy(const Value &value)
+{
+    bool isCopied = value.isHeap() && (value.type() == AnyObject::Int || value.type() == AnyObject::String || value.type() == AnyObject::Array);
+
+    return isCopied ? value.object().clone() : box(value);
+}
+
+
+AnyObject::Ptr allocateArray(const std::vector<Value> &elements)
+{
+    AnyObject::Type elementType = elements.empty() ? AnyObject::NotSet : elements.front().type();
+
+    for (const auto &element : elements)
+    {
+        if (element.type() != elementType)
+        {
+            elementType = AnyObject::NotSet;
+            break;
+        }
+    }
+
+    switch (elementType)
+    {
+        case AnyObject::Int:
+        {
+            AnyObject::IntVector packed;
+            packed.reserve(elements.size());
+
+            for (const auto &element : elements)
+                packed.push_back(element.asInt());
+
+            return allocate(std::move(packed));
+        }
+        case AnyObject::Float:
+        {
+            AnyObject::FloatVector packed;
+            packed.reserve(elements.size());
+
+            for (const auto &element : elements)
+                packed.push_back(element.asFloat());
+
+            return allocate(std::move(packed));
+        }
+        case AnyObject::Bool:
+        {
+            AnyObject::BoolVector packed;
+            packed.reserve(elements.size());
+
+            for (const auto &element : elements)
+                packed.push_back(element.asBool());
+
+            return allocate(std::move(packed));
+        }
+        default:
+        {
+            AnyObject::Vector objects; /* NB: copy since a lookup returns the variable itself */
+            objects.reserve(elements.size());
+
+            for (const auto &element : elements)
+                objects.push_back(copy(element));
+
+            return allocate(std::move(objects));
+        }
+    }
+}
+
+
+AnyObject::Ptr allocateArray(AnyObject::Type elementType)
+{
+    auto array = allocate(AnyObject::Array);
+    array->declareElementType(elementType);
+    return array;
+}
+
 } // namespace ObjectFactory
\ No newline at end of file
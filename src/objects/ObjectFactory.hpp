@@ -10,18 +10,43 @@
 #pragma once
 
 #include "AnyObject.hpp"
+#include "PoolAllocator.hpp"
 #include <memory>
 #include <new>
+#include <vector>
 
 namespace ObjectFactory
 {
 
+/* Registers an array or class instance with the CycleCollector of the current context */
+void track(const AnyObject::Ptr &object);
+
+/* Object and control block share a single pooled chunk. Objects which can refer to other objects are tracked */
 template <class... Args>
 [[nodiscard]] inline AnyObject::Ptr allocate(Args &&...args)
 {
-    return std::make_shared<AnyObject>(std::forward<Args>(args)...);
+    auto object = std::allocate_shared<AnyObject>(PoolAllocator::Allocator<AnyObject>(), std::forward<Args>(args)...);
+
+    if (object->isType(AnyObject::Array) || object->isType(AnyObject::Class))
+    {
+        track(object);
+    }
+
+    return object;
 }
 
 AnyObject::Ptr allocate(AnyObject::Type objectType);
 
+/* Returns a heap object for the value. Immediates are allocated; heap values return the object they refer to */
+AnyObject::Ptr box(const class Value &value);
+
+/* Returns a new object with a copy of the value. Class instances and functions are returned as-is */
+AnyObject::Ptr copy(const class Value &value);
+
+/* Arrays whose elements all have the same primitive type are packed. Other elements are copied */
+AnyObject::Ptr allocateArray(const std::vector<class Value> &elements);
+
+/* Empty array restricted to a primitive element type (i.e. int[] a) */
+AnyObject::Ptr allocateArray(AnyObject::Type elementType);
+
 } // namespace ObjectFactory
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file SharedBuffer.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "PoolAllocator.hpp"
+#include <memory>
+
+/*
+ * Reference-counted buffer for string and array objects. Copies share the buffer until one of them is modified at
+ * which point it is detached (copy-on-write). Read-only access never copies.
+ */
+template <class T>
+class SharedBuffer
+{
+public:
+    explicit SharedBuffer(T value) : _buffer(allocate(std::move(value))) {}
+
+    [[nodiscard]] const T &get() const { return *_buffer; }
+
+    /* Detaches from any other objects sharing the buffer before returning it */
+    [[nodiscard]] T &mutate()
+    {
+        if (isShared())
+        {
+            _buffer = allocate(copy(*_buffer));
+        }
+
+        return *_buffer;
+    }
+
+    [[nodiscard]] bool isShared() const { return (_buffer.use_count() > 1); }
+
+    /* Number of objects sharing the buffer */
+    [[nodiscard]] long useCount() const { return _buffer.use_count(); }
+
+    [[nodiscard]] bool sharesWith(const SharedBuffer &other) const { return (_buffer == other._buffer); }
+
+    /* Copies the contents when detaching. Specialized for arrays since their elements are mutable objects */
+    static T copy(const T &value) { return value; }
+
+protected:
+    static std::shared_ptr<T> allocate(T value)
+    {
+        return std::allocate_shared<T>(PoolAllocator::Allocator<T>(), std::move(value));
+    }
+
+private:
+    std::shared_ptr<T> _buffer;
+};
@@ -0,0 +1,50 @@
+/**
+ * @file StringPool.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "StringPool.hpp"
+#include <memory>
+#include <string>
+
+
+AnyObject::Ptr StringPoolImpl::intern(std::string_view value)
+{
+    return object(SymbolTable::instance().intern(value));
+}
+
+
+AnyObject::Ptr StringPoolImpl::object(SymbolID symbol)
+{
+    const std::string &value = SymbolTable::instance().name(symbol); /* Throws if invalid */
+
+    LockGuard lock(_mutex);
+
+    if (symbol >= _objects.size())
+    {
+        _objects.resize(symbol + 1);
+    }
+
+    AnyObject::Ptr &entry = _objects[symbol];
+
+    if (!entry)
+    {
+        /* NB: not pooled since the objects live until exit */
+        entry = std::make_shared<AnyObject>(value);
+        entry->makeImmortal();
+        ++_size;
+    }
+
+    return entry;
+}
+
+
+size_t StringPoolImpl::size() const
+{
+    LockGuard lock(_mutex);
+    return _size;
+}
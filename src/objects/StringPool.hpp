@@ -0,0 +1,56 @@
+/**
+ * @file StringPool.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyObject.hpp"
+#include "SingletonT.hpp"
+#include "SymbolTable.hpp"
+#include "Value.hpp"
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/*
+ * Immutable string objects for string literals. Strings are interned by the SymbolTable (which the lexer uses for
+ * identifiers and string literals) so equal strings share a single object and can be compared by address.
+ *
+ * Each object is created once and owned by the pool until exit. Objects are immortal so that Values referring to them
+ * never touch the reference count or pin count. This allows them to be shared by threads evaluating the same AST.
+ * Interned objects must never be modified: string nodes only return them from evaluateValue (values are copied on
+ * assignment) and return a copy from evaluate since the result may be bound to a variable or stored in an array.
+ */
+class StringPoolImpl
+{
+public:
+    /* Returns the object for a string, creating it if required (thread-safe) */
+    [[nodiscard]] AnyObject::Ptr intern(std::string_view value);
+
+    /* Returns the object for an interned symbol (thread-safe) */
+    [[nodiscard]] AnyObject::Ptr object(SymbolID symbol);
+
+    /* Number of objects created */
+    [[nodiscard]] size_t size() const;
+
+protected:
+    friend class SingletonT<StringPoolImpl>;
+
+    /* Prevent direct initialization */
+    StringPoolImpl() = default;
+
+private:
+    /* Indexed by symbol. Null for symbols without an object (i.e. identifiers) */
+    std::vector<AnyObject::Ptr> _objects;
+    size_t _size{0};
+
+    using LockGuard = std::lock_guard<std::mutex>;
+
+    mutable std::mutex _mutex;
+};
+
+using StringPool = SingletonT<StringPoolImpl>;
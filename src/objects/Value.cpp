@@ -0,0 +1,78 @@
+/**
+ * @file Value.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Value.hpp"
+#include "Exceptions.hpp"
+
+
+void Value::setHeap(AnyObject &object)
+{
+    object.pin();
+    _bits = kHeapTag | (reinterpret_cast<uint64_t>(&object) & kPayloadMask);
+}
+
+
+void Value::pin() const
+{
+    heap()->pin();
+}
+
+
+void Value::unpin() const
+{
+    heap()->unpin();
+}
+
+
+void Value::setLargeInt(long value)
+{
+    setHeap(*ObjectFactory::allocate(value));
+}
+
+
+bool Value::toBool() const
+{
+    if (!isBool())
+    {
+        ThrowException("expected a value of type [Bool] but got [" + AnyObject::typeToString(type()) + "]");
+    }
+
+    return asBool();
+}
+
+
+long Value::toInt() const
+{
+    if (!isInt())
+    {
+        ThrowException("expected a value of type [Int] but got [" + AnyObject::typeToString(type()) + "]");
+    }
+
+    return asInt();
+}
+
+
+std::ostream &operator<<(std::ostream &out, const Value &value)
+{
+    std::string printBoolean(const bool &value);
+
+    switch (value.type())
+    {
+        case AnyObject::NotSet:
+            return out;
+        case AnyObject::Bool:
+            return (out << printBoolean(value.asBool()));
+        case AnyObject::Int:
+            return (out << value.asInt());
+        case AnyObject::Float:
+            return (out << value.asFloat());
+        default:
+            return (out << value.object());
+    }
+}
@@ -0,0 +1,294 @@
+/**
+ * @file Value.hpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyObject.hpp"
+#include "ObjectFactory.hpp"
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VALUE_LIKELY(x) __builtin_expect(!!(x), 1)
+#define VALUE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define VALUE_LIKELY(x) (x)
+#define VALUE_UNLIKELY(x) (x)
+#endif
+
+/*
+ * A 64-bit NaN-boxed value. Floats are stored as-is; Int (48-bit), Bool and None are stored inline in the payload of a
+ * quiet NaN so arithmetic on them never touches the heap. All other types (and ints which do not fit in 48 bits) refer
+ * to a heap AnyObject which is kept alive while a Value points at it.
+ *
+ * Layout (upper 16 bits):
+ *   < 0xFFF9   double (NaNs are canonicalized)
+ *   0xFFF9     None
+ *   0xFFFA     Bool
+ *   0xFFFB     Int (sign-extended from 48 bits)
+ *   0xFFFC     AnyObject * (48-bit pointer)
+ */
+class Value
+{
+public:
+    Value() = default; /* None */
+
+    explicit Value(bool value) : _bits(kBoolTag | (uint64_t)value) {}
+    explicit Value(long value);
+    explicit Value(double value);
+
+    /* Ints, floats and bools are copied inline; other types refer to the object */
+    explicit Value(AnyObject &object);
+    explicit Value(const AnyObject::Ptr &object); /* nullptr --> None */
+
+    Value(const Value &other) : _bits(other._bits)
+    {
+        if (isHeap())
+            pin();
+    }
+
+    Value(Value &&other) noexcept : _bits(other._bits)
+    {
+        other._bits = kNoneTag;
+    }
+
+    Value &operator=(const Value &other)
+    {
+        if (!isHeap() && !other.isHeap()) /* Immediates */
+        {
+            _bits = other._bits;
+            return (*this);
+        }
+
+        Value copy(other);
+        std::swap(_bits, copy._bits);
+        return (*this);
+    }
+
+    Value &operator=(Value &&other) noexcept
+    {
+        std::swap(_bits, other._bits);
+        return (*this);
+    }
+
+    ~Value()
+    {
+        if (VALUE_UNLIKELY(isHeap()))
+            unpin();
+    }
+
+    [[nodiscard]] AnyObject::Type type() const;
+
+    [[nodiscard]] bool isNone() const { return (_bits == kNoneTag); }
+    [[nodiscard]] bool isBool() const { return ((_bits & kTagMask) == kBoolTag); }
+    [[nodiscard]] bool isFloat() const { return (_bits < kNoneTag); }
+    [[nodiscard]] bool isInt() const { return isSmallInt() || (isHeap() && heap()->isType(AnyObject::Int)); }
+
+    /* True for ints stored inline */
+    [[nodiscard]] bool isSmallInt() const { return ((_bits & kTagMask) == kIntTag); }
+
+    /* True if the value refers to a heap object */
+    [[nodiscard]] bool isHeap() const { return ((_bits & kTagMask) == kHeapTag); }
+
+    /* Unchecked accessors */
+    [[nodiscard]] bool asBool() const { return (_bits & 1); }
+    [[nodiscard]] long asInt() const { return isSmallInt() ? ((int64_t)(_bits << 16) >> 16) : heap()->getValue<long>(); }
+
+    [[nodiscard]] double asFloat() const
+    {
+        double value;
+        std::memcpy(&value, &_bits, sizeof(double));
+        return value;
+    }
+
+    [[nodiscard]] AnyObject &object() const { return *heap(); }
+
+    /* Checked accessors. Throw if the type does not match */
+    [[nodiscard]] bool toBool() const;
+    [[nodiscard]] long toInt() const;
+
+    /* Returns the bits for identity comparisons */
+    [[nodiscard]] uint64_t bits() const { return _bits; }
+
+    friend std::ostream &operator<<(std::ostream &out, const Value &value);
+
+protected:
+    static constexpr uint64_t kTagMask{0xFFFF000000000000};
+    static constexpr uint64_t kPayloadMask{0x0000FFFFFFFFFFFF};
+
+    static constexpr uint64_t kNoneTag{0xFFF9000000000000};
+    static constexpr uint64_t kBoolTag{0xFFFA000000000000};
+    static constexpr uint64_t kIntTag{0xFFFB000000000000};
+    static constexpr uint64_t kHeapTag{0xFFFC000000000000};
+
+    static constexpr uint64_t kCanonicalNaN{0x7FF8000000000000};
+
+    static constexpr long kMaxSmallInt{(1L << 47) - 1};
+    static constexpr long kMinSmallInt{-(1L << 47)};
+
+    [[nodiscard]] AnyObject *heap() const { return reinterpret_cast<AnyObject *>(_bits & kPayloadMask); }
+
+    /* Sets to heap object and pins it */
+    void setHeap(AnyObject &object);
+
+    /* Out-of-line to keep immediate paths small */
+    void pin() const;
+    void unpin() const;
+
+    /* Boxes ints which do not fit in 48 bits */
+    void setLargeInt(long value);
+
+private:
+    uint64_t _bits{kNoneTag};
+};
+
+
+inline Value::Value(long value)
+{
+    if (VALUE_LIKELY(value >= kMinSmallInt && value <= kMaxSmallInt))
+    {
+        _bits = kIntTag | ((uint64_t)value & kPayloadMask);
+    }
+    else
+    {
+        setLargeInt(value); /* Rare */
+    }
+}
+
+
+inline Value::Value(double value)
+{
+    if (value != value)
+        _bits = kCanonicalNaN;
+    else
+        std::memcpy(&_bits, &value, sizeof(double));
+}
+
+
+inline Value::Value(AnyObject &object)
+{
+    switch (object.getType())
+    {
+        case AnyObject::Int:
+            *this = Value(object.getValue<long>());
+            break;
+        case AnyObject::Float:
+            *this = Value(object.getValue<double>());
+            break;
+        case AnyObject::Bool:
+            *this = Value(object.getValue<bool>());
+            break;
+        default:
+            setHeap(object);
+            break;
+    }
+}
+
+
+inline Value::Value(const AnyObject::Ptr &object)
+{
+    if (object)
+    {
+        *this = Value(*object);
+    }
+}
+
+
+inline AnyObject::Type Value::type() const
+{
+    if (isFloat())
+        return AnyObject::Float;
+
+    switch (_bits & kTagMask)
+    {
+        case kBoolTag:
+            return AnyObject::Bool;
+        case kIntTag:
+            return AnyObject::Int;
+        case kHeapTag:
+            return heap()->getType();
+        default:
+            return AnyObject::NotSet;
+    }
+}
+
+
+inline void AnyObject::assign(const Value &value)
+{
+    if (value.isHeap())
+    {
+        *this = value.object(); /* Copy assignment */
+        return;
+    }
+
+    if (_type != value.type())
+    {
+        throwAssignTypeMismatch(value.type());
+    }
+
+    switch (_type)
+    {
+        case Int:
+            std::get<long>(_value) = value.asInt();
+            break;
+        case Float:
+            std::get<double>(_value) = value.asFloat();
+            break;
+        case Bool:
+            std::get<bool>(_value) = value.asBool();
+            break;
+        default:
+            break;
+    }
+}
+
+
+inline Value AnyObject::arrayElement(size_t index) const
+{
+    switch (elementType())
+    {
+        case Int:
+            return Value(getValue<IntVector>()[index]);
+        case Float:
+            return Value(getValue<FloatVector>()[index]);
+        case Bool:
+            return Value((bool)getValue<BoolVector>()[index]);
+        default:
+            return Value(getValue<Vector>()[index]); /* Borrowed */
+    }
+}
+
+
+inline void AnyObject::setArrayElement(size_t index, const Value &value)
+{
+    const Type type = elementType();
+
+    if (type == NotSet)
+    {
+        getValue<Vector>()[index]->assign(value); /* Detaches a shared array */
+        return;
+    }
+    else if (value.type() != type)
+    {
+        throwAssignTypeMismatch(type, value.type());
+    }
+
+    switch (type)
+    {
+        case Int:
+            getValue<IntVector>()[index] = value.asInt();
+            break;
+        case Float:
+            getValue<FloatVector>()[index] = value.asFloat();
+            break;
+        default:
+            getValue<BoolVector>()[index] = value.asBool();
+            break;
+    }
+}
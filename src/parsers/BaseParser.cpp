@@ -11,30 +11,31 @@
 #include "Exceptions.hpp"
 
 
-bool BaseParser::equals(const std::string &value)
+bool BaseParser::equals(Token::Type type)
 {
-    return (tokens().empty() ? false : (tokens().front() == value));
+    return (tokens().empty() ? false : (tokens().front().type() == type));
 }
 
 
-bool BaseParser::equals(Token::Type type)
+bool BaseParser::equals(TokenKind kind)
 {
-    return (tokens().empty() ? false : (tokens().front().type() == type));
+    return (frontKind() == kind);
 }
 
 
-bool BaseParser::equals(Token::Type type, const std::string &value)
+TokenKind BaseParser::frontKind()
 {
-    return (equals(type) && equals(value));
+    return (tokens().empty() ? TokenKind::EndOfFile : tokens().front().kind());
 }
 
 
-void BaseParser::skip(const std::string &expected)
+void BaseParser::skip(TokenKind expected)
 {
     if (!equals(expected))
     {
-        /* TODO: - add method wrapper so we never have exception if calling front() on empty queue */
-        ThrowException("unexpected token: '" + tokens().front() + "' != '" + expected + "'");
+        std::string found = tokens().empty() ? "end of file" : tokens().front().str();
+
+        ThrowException("unexpected token: '" + found + "' != '" + Grammar::instance().kindName(expected) + "'");
     }
 
     tokens().pop();
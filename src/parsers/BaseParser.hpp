@@ -9,6 +9,7 @@
 
 #pragma once
 #include "BaseNode.hpp"
+#include "Grammar.hpp"
 #include "Tokenizer.hpp"
 #include <functional>
 #include <string>
@@ -25,15 +26,15 @@ protected:
     /* Returns a reference to the tokens */
     [[nodiscard]] virtual Tokens &tokens() = 0;
 
-    /* Returns true if front token matches expected value */
-    bool equals(const std::string &value);
-
     /* Returns true if front token matches expected type */
     bool equals(Token::Type type);
 
-    /* Returns true if front token matches exepcted value and type */
-    bool equals(Token::Type type, const std::string &value);
+    /* Returns true if front token is of the expected kind */
+    bool equals(TokenKind kind);
+
+    /* Returns the kind of the front token (EndOfFile if there are no more tokens) */
+    TokenKind frontKind();
 
-    /* Skips token and throws exception if token to be skipped does not match expected */
-    void skip(const std::string &expected);
+    /* Skips token and throws exception if token to be skipped is not of the expected kind */
+    void skip(TokenKind expected);
 };
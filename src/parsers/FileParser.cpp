@@ -6,11 +6,16 @@
 //
 
 #include "FileParser.hpp"
+#include "AstArena.hpp"
+#include "ConstantFolder.hpp"
 #include "Exceptions.hpp"
 #include "Grammar.hpp"
+#include "ImportGraph.hpp"
 #include "Logger.hpp"
 #include "NodeFactory.hpp"
-#include "ParserData.hpp"
+#include "NodeFuser.hpp"
+#include "ProgramCache.hpp"
+#include "VariableResolver.hpp"
 #include <assert.h>
 #include <cassert>
 #include <cstring>
@@ -18,21 +23,60 @@
 #include <stdlib.h>
 
 
-AnyNode::Ptr FileParser::parseMainFile(const std::string entryPointPath_)
+AnyNode::Ptr FileParser::parseMainFile(const std::string entryPointPath_, bool useCache, Statistics *statistics)
 {
-    /* Clear data for all imports */
-    ParserData::instance().clearImports();
+    /* Nodes loaded from the cache or rebuilt by the passes below are allocated in this arena. Imported files are
+     * parsed into arenas owned by the AST returned by the ImportGraph */
+    auto arena = std::make_shared<AstArena>();
 
-    /* Create parser for entry-point file. If required, it will create additional parsers for other imported files */
-    return FileParser(entryPointPath_).buildAST();
+    AstArena::CurrentArena currentArena(arena);
+
+    AnyNode::Ptr ast = useCache ? ProgramCache::load(entryPointPath_) : nullptr;
+
+    if (!ast)
+    {
+        /* Parse entry-point file and imported files (concurrently if there are file imports) */
+        ImportGraph graph(entryPointPath_);
+        ast = graph.parse();
+
+        if (useCache)
+            ProgramCache::store(entryPointPath_, *ast, graph.sources());
+    }
+
+    ast = AstArena::adopt(std::move(ast), std::move(arena));
+
+    /* Evaluate constant expressions once. Folded nodes are rebuilt so this must be done before resolving variables */
+    size_t numFolded = ConstantFolder::fold(ast);
+
+    if (statistics)
+        statistics->numFolded = numFolded;
+
+    /* Resolve variables to scope slots now that all imports have been parsed */
+    VariableResolver::resolve(ast);
+
+    /* Specialize common statements now that variables are resolved */
+    (void)NodeFuser::fuse(ast);
+    return ast;
 }
 
 
-FileParser::FileParser(const std::string &fpath)
+FileParser::FileParser(const std::string &fpath, Tokens tokens, const Imports &imports)
     : _parentDirPath(buildParentDirPath(fpath)),
-      _tokens(Tokenizer::build(fpath)),
-      _subParsers(*this)
+      _tokens(std::move(tokens)),
+      _subParsers(*this),
+      _imports(imports)
+{
+}
+
+
+const FileParser::Import &FileParser::nextImport()
 {
+    if (_nextImport >= _imports.size())
+    {
+        ThrowException("import statement not found in import graph");
+    }
+
+    return _imports[_nextImport++];
 }
 
 
@@ -65,33 +109,28 @@ BaseNode::Ptr FileParser::maybeBinary(BaseNode::Ptr leftExpression, int leftPrec
 
     // Take a peek look at the next token. Is it an operator token. If it is then
     // we need to create a binary node.
-    Token next = tokens().front(); /* TODO: - should wrap so alerts if no more tokens */
+    const TokenKind nextKind = tokens().front().kind(); /* TODO: - should wrap so alerts if no more tokens */
 
-    if (next.type() == Token::Operator)
+    // Does it have a higher precedence than the left-hand expression? Precedence
+    // is zero for anything which isn't a binary operator.
+    const int nextPrecedence = getPrecedence();
+    if (nextPrecedence > leftPrecedence)
     {
-        // Yes it is an operator. Does it have a higher precedence than the
-        // left-hand expression?
-        const int nextPrecedence = getPrecedence();
-        if (nextPrecedence > leftPrecedence)
-        {
-            tokens().pop(); // Move along one.
+        tokens().pop(); // Move along one.
 
-            auto rightExpression = maybeBinary(parseAtomically(), nextPrecedence);
+        auto rightExpression = maybeBinary(parseAtomically(), nextPrecedence);
 
-            // Create binary or assign node.
-            BaseNode::Ptr node{nullptr};
+        // Create binary or assign node.
+        BaseNode::Ptr node{nullptr};
 
-            bool isAssignNode = (next == std::string("="));
+        if (nextKind == TokenKind::Assign)
+            node = NodeFactory::createAssignNode(leftExpression, rightExpression);
+        else
+            node = AstArena::makeNode<BinaryNode>(leftExpression, rightExpression, BinaryNode::toBinaryOperator(nextKind));
 
-            if (isAssignNode)
-                node = NodeFactory::createAssignNode(leftExpression, rightExpression);
-            else
-                node = std::make_shared<BinaryNode>(leftExpression, rightExpression, next);
-
-            // Wrap binary node by calling ourselves should the next operator
-            // be of a greater precedence.
-            return maybeBinary(std::move(node), leftPrecedence);
-        }
+        // Wrap binary node by calling ourselves should the next operator
+        // be of a greater precedence.
+        return maybeBinary(std::move(node), leftPrecedence);
     }
 
     // Default.
@@ -103,7 +142,7 @@ BaseNode::Ptr FileParser::maybeFunctionCall(ParseMethod expression) /* TODO: - r
 {
     auto expr = expression(); // Possible function name.
 
-    return equals(Token::Punctuation, "(") ? _subParsers.function.parseFunctionCall(expr) : expr;
+    return equals(TokenKind::LeftParen) ? _subParsers.function.parseFunctionCall(expr) : expr;
 }
 
 
@@ -111,7 +150,7 @@ BaseNode::Ptr FileParser::maybeArrayAccess(ParseMethod expression)
 {
     auto expr = expression(); // Possible array variable name.
 
-    return equals(Token::Punctuation, "[") ? _subParsers.dataType.parseArrayAccessor(expr) : expr;
+    return equals(TokenKind::LeftBracket) ? _subParsers.dataType.parseArrayAccessor(expr) : expr;
 }
 
 
@@ -122,11 +161,11 @@ BaseNode::Ptr FileParser::maybeFunctionCallOrArrayAccess(ParseMethod expression)
 
     if (!tokens().empty())
     {
-        if (equals(Token::Punctuation, "("))
+        if (equals(TokenKind::LeftParen))
             return _subParsers.function.parseFunctionCall(expr); /* TODO: - remove */
-        else if (equals(Token::Punctuation, "["))
+        else if (equals(TokenKind::LeftBracket))
             return _subParsers.dataType.parseArrayAccessor(expr);
-        else if (equals(Token::Punctuation, "."))
+        else if (equals(TokenKind::Dot))
             return _subParsers.classParser.parseStructAccessor(expr);
     }
 
@@ -156,62 +195,67 @@ BaseNode::Ptr FileParser::parseAtomically()
 
 BaseNode::Ptr FileParser::parseAtomicallyExpression()
 {
-    // TODO: - breakup
-    if (equals(Token::Punctuation, "("))
-        return parseBrackets();
-    else if (equals(Token::Punctuation, "["))
-        return _subParsers.dataType.parseArray();
-    else if (equals(Token::Punctuation, "{"))
-        return _subParsers.block.parseBlock();
-    else if (equals(Token::Keyword, "true") || equals(Token::Keyword, "false"))
-        return _subParsers.dataType.parseBool();
-    else if (equals(Token::Keyword, "while"))
-        return _subParsers.loop.parseWhile();
-    else if (equals(Token::Keyword, "do"))
-        return _subParsers.loop.parseDoWhile();
-    else if (equals(Token::Keyword, "for"))
-        return _subParsers.loop.parseFor();
-    else if (equals(Token::Keyword, "if"))
-        return _subParsers.controlFlow.parseIf();
-    else if (equals(Token::Keyword, "import"))
-        return _subParsers.import.parseImport();
-    else if (equals(Token::Keyword, "func")) // Functions should be defined as in C --> will need void type
-        return _subParsers.function.parseFunctionDefinition();
-    else if (equals(Token::Keyword, "class"))
-        return _subParsers.classParser.parseClass();
-    else if (Grammar::instance().isDataType(tokens().front()))
-        return _subParsers.variable.parseVariableDefinition();
-    else if (equals(Token::Keyword, "break"))
-        return _subParsers.controlFlow.parseBreak();
-    else if (equals(Token::Keyword, "return"))
-        return _subParsers.controlFlow.parseReturn();
-
-    // TODO: - split-up into separate method for unary operators.
-    // Parse unary operators.
-    else if (equals(Token::Operator, "!"))
-        return _subParsers.unary.parseNot();
-    // Parse prefix increment operator i.e.
-    else if (equals(Token::Operator, "++"))
-        return _subParsers.unary.parsePrefixIncrement();
-    else if (equals(Token::Operator, "--"))
-        return _subParsers.unary.parsePrefixDecrement();
-    else if (equals(Token::Operator, "-"))
-        return _subParsers.unary.parseNegation();
-
-    const Token &token = tokens().front();
-
-    switch (token.type())
+    switch (frontKind())
     {
-        case Token::Variable:
+        case TokenKind::LeftParen:
+            return parseBrackets();
+        case TokenKind::LeftBracket:
+            return _subParsers.dataType.parseArray();
+        case TokenKind::LeftBrace:
+            return _subParsers.block.parseBlock();
+        case TokenKind::True:
+        case TokenKind::False:
+            return _subParsers.dataType.parseBool();
+        case TokenKind::While:
+            return _subParsers.loop.parseWhile();
+        case TokenKind::Do:
+            return _subParsers.loop.parseDoWhile();
+        case TokenKind::For:
+            return _subParsers.loop.parseFor();
+        case TokenKind::If:
+            return _subParsers.controlFlow.parseIf();
+        case TokenKind::Import:
+            return _subParsers.import.parseImport();
+        case TokenKind::Func: // Functions should be defined as in C --> will need void type
+        case TokenKind::Pure:
+            return _subParsers.function.parseFunctionDefinition();
+        case TokenKind::Class:
+            return _subParsers.classParser.parseClass();
+        case TokenKind::Int:
+        case TokenKind::Float:
+        case TokenKind::Bool:
+        case TokenKind::Array:
+        case TokenKind::String:
+            return _subParsers.variable.parseVariableDefinition();
+        case TokenKind::Break:
+            return _subParsers.controlFlow.parseBreak();
+        case TokenKind::Continue:
+            return _subParsers.controlFlow.parseContinue();
+        case TokenKind::Return:
+            return _subParsers.controlFlow.parseReturn();
+
+        // Parse unary operators.
+        case TokenKind::Not:
+            return _subParsers.unary.parseNot();
+        case TokenKind::Increment: // Parse prefix increment operator i.e.
+            return _subParsers.unary.parsePrefixIncrement();
+        case TokenKind::Decrement:
+            return _subParsers.unary.parsePrefixDecrement();
+        case TokenKind::Minus:
+            return _subParsers.unary.parseNegation();
+
+        case TokenKind::Identifier:
             return _subParsers.variable.parseVariable();
-        case Token::String:
+        case TokenKind::StringLiteral:
             return _subParsers.dataType.parseString();
-        case Token::Int:
+        case TokenKind::IntLiteral:
             return _subParsers.dataType.parseInt();
-        case Token::Float:
+        case TokenKind::FloatLiteral:
             return _subParsers.dataType.parseFloat();
+        case TokenKind::EndOfFile:
+            ThrowException("unexpected end of file");
         default:
-            ThrowException("unexpected token: " + token);
+            ThrowException("unexpected token: " + tokens().front().str());
     }
 }
 
@@ -231,7 +275,7 @@ void FileParser::skipSemicolonLineEndingIfRequired(const BaseNode &node)
         case NodeType::Function:
             break;
         default:
-            skip(";");
+            skip(TokenKind::Semicolon);
             break;
     };
 }
@@ -239,51 +283,23 @@ void FileParser::skipSemicolonLineEndingIfRequired(const BaseNode &node)
 
 int FileParser::getPrecedence()
 {
-    const Token &token = tokens().front();
-
-    if (token.type() != Token::Operator)
-    {
-        return 0;
-    }
-
-    if (token == "=")
-        return 1;
-    else if (token == "||")
-        return 2;
-    else if (token == "&&")
-        return 3;
-    else if ((token == "<") ||
-             (token == ">") ||
-             (token == "<=") ||
-             (token == ">=") ||
-             (token == "==") ||
-             (token == "!="))
-        return 7;
-    else if ((token == "+") ||
-             (token == "-"))
-        return 10;
-    else if ((token == "*") ||
-             (token == "/") ||
-             (token == "%"))
-        return 20;
-    else
-        return 0;
+    return GrammarImpl::precedence(frontKind());
 }
 
 
 BaseNode::Ptr FileParser::parseBrackets()
 {
-    skip("(");
+    skip(TokenKind::LeftParen);
 
     BaseNode::Ptr expression = parseExpression();
 
-    skip(")");
+    skip(TokenKind::RightParen);
 
     return expression;
 }
 
 
-std::string FileParser::buildParentDirPath(const std::string &filePath_) const
+std::string FileParser::buildParentDirPath(const std::string &filePath_)
 {
     for (long i = (long)filePath_.size() - 1; i != 0; --i)
     {
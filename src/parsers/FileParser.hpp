@@ -25,18 +25,39 @@
 #include "Tokenizer.hpp"
 #include "UnaryOperatorSubParser.hpp"
 #include <unordered_set>
+#include <vector>
 
 
-/* Parser for a single file */
-class FileParser : public BaseParser // TODO: - build a thread-pool for FileParsing
+/* Parser for a single file. Imported files are parsed separately (see ImportGraph) */
+class FileParser : public BaseParser
 {
 public:
+    /* Result of an import statement. Decided by the ImportGraph before the file is parsed */
+    struct Import
+    {
+        bool isDuplicate{false};   /* Already imported elsewhere */
+        AnyNode::Ptr ast{nullptr}; /* File imports only */
+    };
+
+    using Imports = std::vector<Import>;
+
     /* Constructors */
     FileParser() = delete;
-    FileParser(const std::string &fpath);
+    FileParser(const std::string &fpath, Tokens tokens, const Imports &imports);
+
+    /* Results of the passes run by parseMainFile */
+    struct Statistics
+    {
+        size_t numFolded{0}; /* Nodes removed by the ConstantFolder */
+    };
 
-    /* Top-level parse */
-    static AnyNode::Ptr parseMainFile(const std::string entryPointPath_);
+    /* Top-level parse. If useCache is set, the program is loaded from (or saved to) the ProgramCache */
+    static AnyNode::Ptr parseMainFile(const std::string entryPointPath_,
+                                      bool useCache = false,
+                                      Statistics *statistics = nullptr);
+
+    /* Convert a path 'a/b/c/fileName.ek' --> 'a/b/c/' */
+    static std::string buildParentDirPath(const std::string &filePath_);
 
     /* Returns reference to subparsers for file */
     [[nodiscard]] SubParsers &subparsers() { return _subParsers; }
@@ -47,6 +68,9 @@ public:
     /* Returns parent directory path for file */
     [[nodiscard]] const std::string &parentDirPath() const { return _parentDirPath; }
 
+    /* Returns the result for the next import statement in the file */
+    const Import &nextImport();
+
     /* Construct AST for file */
     AnyNode::Ptr buildAST();
 
@@ -76,11 +100,11 @@ protected:
 
     BaseNode::Ptr maybeBinary(BaseNode::Ptr leftExpression, int leftPrecedence);
 
-    /* Convert a path 'a/b/c/fileName.ek' --> 'a/b/c/' */
-    std::string buildParentDirPath(const std::string &filePath_) const;
-
 private:
     const std::string _parentDirPath;
     Tokens _tokens;
     SubParsers _subParsers;
+
+    const Imports &_imports;
+    size_t _nextImport{0};
 };
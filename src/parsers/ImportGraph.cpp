@@ -0,0 +1,285 @@
+/**
+ * @file ImportGraph.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ImportGraph.hpp"
+#include "AstArena.hpp"
+#include "Logger.hpp"
+#include "Stringify.hpp"
+#include "ThreadPool.hpp"
+#include <iterator>
+
+
+ImportGraph::ImportGraph(std::string entryPointPath)
+    : _entryPointPath(std::move(entryPointPath))
+{
+}
+
+
+AnyNode::Ptr ImportGraph::parse()
+{
+    /* 1. Discover. The ThreadPool is only used if the entry-point imports other files */
+    SourceFile &entryPoint = _files.emplace_back();
+    entryPoint.path = _entryPointPath;
+    _fileForPath.emplace(entryPoint.path, &entryPoint);
+
+    tokenize(entryPoint);
+
+    for (const auto &statement : entryPoint.imports)
+    {
+        _isParallel |= (statement.type == ParserData::File);
+    }
+
+    for (const auto &statement : entryPoint.imports)
+    {
+        if (statement.type == ParserData::File)
+            (void)sourceFile(FileParser::buildParentDirPath(entryPoint.path) + statement.name);
+    }
+
+    wait();
+
+    /* 2. Plan */
+    (void)plan(entryPoint, nullptr, 0);
+
+    log().debug(eucleia::stringify("import graph for %s: %zu files, %zu parses",
+                                   _entryPointPath.c_str(), _files.size(), _jobs.size()));
+
+    /* 3. Parse from the leaves up */
+    for (ParseJob &job : _jobs)
+    {
+        if (job.children.empty())
+            submit([this, &job]()
+            { run(job); });
+    }
+
+    wait();
+
+    ParseJob &root = _jobs.front();
+
+    if (root.error)
+    {
+        std::rethrow_exception(root.error);
+    }
+
+    AnyNode::Ptr ast = std::move(root.ast);
+
+    /* The returned AST owns the arenas so the jobs must not keep any nodes */
+    auto arenas = std::make_shared<std::vector<AstArena::Ptr>>();
+    arenas->reserve(_jobs.size());
+
+    for (ParseJob &job : _jobs)
+    {
+        job.ast = nullptr;
+        job.imports.clear();
+        arenas->push_back(std::move(job.arena));
+    }
+
+    return AstArena::adopt(std::move(ast), std::move(arenas));
+}
+
+
+void ImportGraph::tokenize(SourceFile &file)
+{
+    try
+    {
+        file.tokens = Tokenizer::build(file.path);
+        file.source = file.tokens.source();
+        file.imports = findImports(file.tokens);
+    }
+    catch (...)
+    {
+        file.error = std::current_exception(); /* Thrown if the file is parsed */
+    }
+}
+
+
+std::vector<eucleia::MappedFile::Ptr> ImportGraph::sources() const
+{
+    std::vector<eucleia::MappedFile::Ptr> sources;
+
+    for (const SourceFile &file : _files)
+    {
+        if (file.numParses > 0)
+            sources.push_back(file.source);
+    }
+
+    return sources;
+}
+
+
+ImportGraph::SourceFile &ImportGraph::sourceFile(const std::string &path)
+{
+    SourceFile *file{nullptr};
+    {
+        Lock lock(_mutex);
+
+        auto iter = _fileForPath.find(path);
+        if (iter != _fileForPath.end())
+        {
+            return *iter->second;
+        }
+
+        file = &_files.emplace_back();
+        file->path = path;
+        _fileForPath.emplace(path, file);
+    }
+
+    submit([this, file]()
+    {
+        tokenize(*file);
+
+        for (const auto &statement : file->imports)
+        {
+            if (statement.type == ParserData::File)
+                (void)sourceFile(FileParser::buildParentDirPath(file->path) + statement.name);
+        }
+    });
+
+    return *file;
+}
+
+
+ImportGraph::ParseJob *ImportGraph::plan(SourceFile &file, ParseJob *parent, size_t parentImportIndex)
+{
+    ParseJob &job = _jobs.emplace_back();
+    job.file = &file;
+    job.parent = parent;
+    job.parentImportIndex = parentImportIndex;
+    job.imports.resize(file.imports.size());
+
+    ++file.numParses;
+
+    for (size_t i = 0; i < file.imports.size(); ++i)
+    {
+        const ImportStatement &statement = file.imports[i];
+
+        /* Check: has file already been imported somewhere? If it has then we don't want to import it a second time!
+         * (i.e. A imports B, C and B imports C. In this case, PARSE A set[A]--> PARSE B set[A,B]--> PARSE C set[A,B,C] */
+        if (_parserData.isImported(statement.name, statement.type))
+        {
+            job.imports[i].isDuplicate = true;
+            continue;
+        }
+
+        _parserData.addImport(statement.name, statement.type);
+
+        if (statement.type == ParserData::File)
+        {
+            SourceFile &imported = *_fileForPath.at(FileParser::buildParentDirPath(file.path) + statement.name);
+
+            job.children.push_back(plan(imported, &job, i));
+        }
+    }
+
+    job.pendingChildren = job.children.size();
+    return &job;
+}
+
+
+void ImportGraph::run(ParseJob &job)
+{
+    try
+    {
+        if (job.file->error)
+        {
+            std::rethrow_exception(job.file->error);
+        }
+
+        for (ParseJob *child : job.children) /* First failed import */
+        {
+            if (child->error)
+                std::rethrow_exception(child->error);
+        }
+
+        log().debug("parsing file: " + job.file->path);
+
+        /* Each file has its own arena since arenas are not thread-safe */
+        job.arena = std::make_shared<AstArena>();
+
+        AstArena::CurrentArena arena(job.arena);
+
+        Tokens tokens = (job.file->numParses > 1) ? job.file->tokens : std::move(job.file->tokens);
+
+        job.ast = FileParser(job.file->path, std::move(tokens), job.imports).buildAST();
+    }
+    catch (...)
+    {
+        job.error = std::current_exception();
+    }
+
+    ParseJob *parent = job.parent;
+
+    if (!parent)
+    {
+        return;
+    }
+
+    parent->imports[job.parentImportIndex].ast = job.ast;
+
+    if (parent->pendingChildren.fetch_sub(1, std::memory_order_acq_rel) == 1) /* Last child */
+    {
+        submit([this, parent]()
+        { run(*parent); });
+    }
+}
+
+
+void ImportGraph::submit(std::function<void()> task)
+{
+    if (!_isParallel)
+    {
+        task();
+        return;
+    }
+
+    {
+        Lock lock(_mutex);
+        ++_pendingTasks;
+    }
+
+    ThreadPool::instance().submit([this, task = std::move(task)]()
+    {
+        task();
+
+        Lock lock(_mutex);
+        if (--_pendingTasks == 0)
+            _cv.notify_all();
+    });
+}
+
+
+void ImportGraph::wait()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    _cv.wait(lock, [this]()
+    { return (_pendingTasks == 0); });
+}
+
+
+std::vector<ImportGraph::ImportStatement> ImportGraph::findImports(const Tokens &tokens)
+{
+    std::vector<ImportStatement> imports;
+
+    for (auto iter = tokens.begin(); iter != tokens.end(); ++iter)
+    {
+        if (!iter->is(TokenKind::Import))
+            continue;
+
+        auto next = std::next(iter);
+
+        if (next == tokens.end())
+            break;
+        else if (next->is(TokenKind::StringLiteral)) /* import "file" */
+            imports.push_back({ParserData::File, next->str()});
+        else if (next->is(TokenKind::Less) && std::next(next) != tokens.end()) /* import <module> */
+            imports.push_back({ParserData::Module, std::next(next)->str()});
+    }
+
+    return imports;
+}
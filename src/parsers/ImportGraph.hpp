@@ -0,0 +1,129 @@
+/**
+ * @file ImportGraph.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "AstArena.hpp"
+#include "FileUtils.hpp"
+#include "FileParser.hpp"
+#include "ParserData.hpp"
+#include "Tokenizer.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Parses a program and its imported files concurrently.
+ *
+ * 1. Discover: files are tokenized on the ThreadPool. Each file's tokens are scanned for import statements and the
+ *    imported files are queued for tokenizing.
+ * 2. Plan: the graph is walked in the order that the files would be parsed serially. The first import of a name
+ *    inlines the file and later imports are empty (as before). This decides the result of every import statement.
+ * 3. Parse: each file is parsed once all of the files that it inlines have been parsed. Independent files are parsed
+ *    concurrently, each with its own AstArena. The results are stitched into the importing file in statement order so
+ *    the AST does not depend on the thread timings.
+ *
+ * Programs without file imports are parsed on the calling thread.
+ */
+class ImportGraph
+{
+public:
+    explicit ImportGraph(std::string entryPointPath);
+
+    ImportGraph(const ImportGraph &) = delete;
+    ImportGraph &operator=(const ImportGraph &) = delete;
+
+    /* Returns the AST for the entry-point with the imported files inlined. It owns the arenas of the parsed files */
+    AnyNode::Ptr parse();
+
+    /* Number of times a file is parsed (once per inline) */
+    [[nodiscard]] size_t numParses() const { return _jobs.size(); }
+
+    /* Contents of the files which were parsed (entry-point first). Call after parse() */
+    [[nodiscard]] std::vector<eucleia::MappedFile::Ptr> sources() const;
+
+protected:
+    struct ImportStatement
+    {
+        ParserData::Type type;
+        std::string name;
+    };
+
+    /* A tokenized file. Shared by all imports of the same path */
+    struct SourceFile
+    {
+        std::string path;
+        Tokens tokens;
+        eucleia::MappedFile::Ptr source{nullptr};
+        std::vector<ImportStatement> imports; /* In statement order */
+        std::exception_ptr error{nullptr};    /* Failed to tokenize */
+        size_t numParses{0};
+    };
+
+    /* One parse of a file */
+    struct ParseJob
+    {
+        SourceFile *file{nullptr};
+        ParseJob *parent{nullptr};
+        size_t parentImportIndex{0}; /* Index of the import statement in the parent */
+
+        FileParser::Imports imports;
+        std::vector<ParseJob *> children; /* Inlined files */
+        std::atomic<size_t> pendingChildren{0};
+
+        AnyNode::Ptr ast{nullptr};
+        AstArena::Ptr arena{nullptr}; /* Nodes of ast. Owned by the root returned by parse() */
+        std::exception_ptr error{nullptr};
+    };
+
+    /* Tokenizes the file and queues its imports (called on the ThreadPool) */
+    void tokenize(SourceFile &file);
+
+    /* Returns the file for the path, queuing it for tokenizing on first use */
+    SourceFile &sourceFile(const std::string &path);
+
+    /* Builds the job for a file and its inlined imports. Mirrors the serial parse order */
+    ParseJob *plan(SourceFile &file, ParseJob *parent, size_t parentImportIndex);
+
+    /* Parses the file once its children have finished then schedules the parent */
+    void run(ParseJob &job);
+
+    /* Submits a task to the ThreadPool (or runs it if the program has no file imports) */
+    void submit(std::function<void()> task);
+
+    /* Blocks until all submitted tasks have finished */
+    void wait();
+
+    static std::vector<ImportStatement> findImports(const Tokens &tokens);
+
+private:
+    const std::string _entryPointPath;
+
+    /* Deques so that pointers remain valid */
+    std::deque<SourceFile> _files;
+    std::unordered_map<std::string, SourceFile *> _fileForPath;
+
+    std::deque<ParseJob> _jobs;
+
+    ParserData _parserData; /* Classes and functions declared by each file */
+
+    bool _isParallel{false};
+
+    size_t _pendingTasks{0};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+
+    using Lock = std::lock_guard<std::mutex>;
+};
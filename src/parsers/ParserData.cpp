@@ -9,18 +9,14 @@
 
 #include "ParserData.hpp"
 
-void ParserDataImpl::clearImports()
+void ParserData::clearImports()
 {
-    LockGuard lock(_mutex);
-
     _importedModuleNames.clear();
     _importedFileNames.clear();
 }
 
-void ParserDataImpl::addImport(std::string importName, Type importType)
+void ParserData::addImport(std::string importName, Type importType)
 {
-    LockGuard lock(_mutex);
-
     if (importType == Module)
         _importedModuleNames.insert(importName);
     else
@@ -28,10 +24,8 @@ void ParserDataImpl::addImport(std::string importName, Type importType)
 }
 
 
-bool ParserDataImpl::isImported(std::string importName, Type importType) const
+bool ParserData::isImported(std::string importName, Type importType) const
 {
-    LockGuard lock(_mutex);
-
     bool result{false};
 
     if (importType == Module)
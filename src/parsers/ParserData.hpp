@@ -8,14 +8,12 @@
  */
 
 #pragma once
-#include "SingletonT.hpp"
 #include "Token.hpp"
-#include <mutex>
 #include <string>
 #include <unordered_set>
 
-/* Stores info required by all program-parsers such as imported files */
-class ParserDataImpl
+/* Stores info required by all of the parsers for a program such as imported files. Owned by the ImportGraph */
+class ParserData
 {
 public:
     using StringSet = std::unordered_set<std::string>;
@@ -29,25 +27,13 @@ public:
     /* Clear all imports */
     void clearImports();
 
-    /* Records file as being imported (thread-safe) */
+    /* Records file as being imported */
     void addImport(std::string importName, Type importType);
 
-    /* Returns true if file is already imported (thread-safe) */
+    /* Returns true if file is already imported */
     bool isImported(std::string importName, Type importType) const;
 
 protected:
-    friend class SingletonT<ParserDataImpl>;
-
-    /* Prevent direct initialization */
-    ParserDataImpl() = default;
-
     StringSet _importedModuleNames;
     StringSet _importedFileNames;
-
-    using LockGuard = std::lock_guard<std::mutex>;
-
-    mutable std::mutex _mutex;
-};
-
-
-using ParserData = SingletonT<ParserDataImpl>;
\ No newline at end of file
+};
\ No newline at end of file
@@ -0,0 +1,750 @@
+/**
+ * @file ProgramCache.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ProgramCache.hpp"
+#include "AddVariableNode.hpp"
+#include "BinaryNode.hpp"
+#include "ClassDefinitionNode.hpp"
+#include "ClassNode.hpp"
+#include "Exceptions.hpp"
+#include "FileParser.hpp"
+#include "FunctionNode.hpp"
+#include "Logger.hpp"
+#include "LookupVariableNode.hpp"
+#include "ModuleNodeFactory.hpp"
+#include "NodeFactory.hpp"
+#include "Stringify.hpp"
+#include "SymbolTable.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+static_assert(sizeof(double) == sizeof(int64_t));
+
+
+AnyNode::Ptr ProgramCache::load(const std::string &entryPointPath)
+{
+    const std::string path = cachePath(entryPointPath);
+
+    if (!std::filesystem::exists(path))
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        auto cache = eucleia::MappedFile::open(path);
+
+        Reader reader(cache->contents());
+
+        if (!reader.sourcesMatch(FileParser::buildParentDirPath(entryPointPath)))
+        {
+            log().debug("program cache is out of date: " + path);
+            return nullptr;
+        }
+
+        return reader.buildAST();
+    }
+    catch (const std::exception &exception)
+    {
+        log().warning(eucleia::stringify("ignoring program cache %s: %s", path.c_str(), exception.what()));
+        return nullptr;
+    }
+}
+
+
+void ProgramCache::store(const std::string &entryPointPath, const BaseNode &ast, const std::vector<eucleia::MappedFile::Ptr> &sources)
+{
+    const std::string path = cachePath(entryPointPath);
+    const std::string parentDirPath = FileParser::buildParentDirPath(entryPointPath);
+
+    try
+    {
+        Writer writer;
+
+        for (const auto &source : sources)
+        {
+            std::string_view sourcePath = source->path();
+
+            if (sourcePath.compare(0, parentDirPath.size(), parentDirPath) == 0)
+            {
+                sourcePath.remove_prefix(parentDirPath.size());
+            }
+
+            writer.addSource(sourcePath, source->contents());
+        }
+
+        writer.addNode(&ast);
+
+        const std::string contents = writer.contents();
+
+        /* Write to a temporary file and rename so that other processes never see a partial cache */
+        const std::string temporaryPath = path + ".tmp" + std::to_string(getpid());
+        {
+            std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+            file.write(contents.data(), (std::streamsize)contents.size());
+
+            if (!file)
+            {
+                ThrowException("failed to write " + temporaryPath);
+            }
+        }
+
+        std::filesystem::rename(temporaryPath, path);
+    }
+    catch (const std::exception &exception)
+    {
+        log().warning(eucleia::stringify("failed to write program cache %s: %s", path.c_str(), exception.what()));
+    }
+}
+
+
+std::string ProgramCache::cachePath(const std::string &entryPointPath)
+{
+    std::filesystem::path path(entryPointPath);
+
+    const char *cacheDir = std::getenv("EUCLEIA_CACHE_DIR");
+    if (!cacheDir || !*cacheDir)
+    {
+        return path.replace_extension(".ekc").string();
+    }
+
+    /* Named by the absolute path of the entry-point to avoid clashes between programs */
+    const std::string absolutePath = std::filesystem::absolute(path).lexically_normal().string();
+
+    auto cacheName = eucleia::stringify("%s-%016llx.ekc", path.stem().c_str(), (unsigned long long)hashContents(absolutePath));
+
+    return (std::filesystem::path(cacheDir) / cacheName).string();
+}
+
+
+uint64_t ProgramCache::hashContents(std::string_view contents)
+{
+    constexpr uint64_t kMultiplier{0x9E3779B97F4A7C15};
+
+    auto mix = [](uint64_t hash, uint64_t word)
+    {
+        hash ^= word;
+        hash = (hash << 29) | (hash >> 35);
+        return hash * kMultiplier;
+    };
+
+    uint64_t hash = contents.size() * kMultiplier;
+
+    const char *iter = contents.data();
+    const char *end = iter + contents.size();
+
+    for (; (end - iter) >= 8; iter += 8) /* Word at a time */
+    {
+        uint64_t word;
+        memcpy(&word, iter, 8);
+        hash = mix(hash, word);
+    }
+
+    if (iter != end)
+    {
+        uint64_t word{0};
+        memcpy(&word, iter, end - iter);
+        hash = mix(hash, word);
+    }
+
+    /* Finalize so that all bits depend on the last word */
+    hash ^= (hash >> 32);
+    hash *= 0xBF58476D1CE4E5B9;
+    hash ^= (hash >> 29);
+
+    return hash;
+}
+
+
+void ProgramCache::Writer::addSource(std::string_view relativePath, std::string_view contents)
+{
+    _sources.push_back(SourceRecord{hashContents(contents), contents.size(), addString(relativePath), 0});
+}
+
+
+ProgramCache::StringRef ProgramCache::Writer::addString(std::string_view str)
+{
+    auto [iter, inserted] = _stringRefs.try_emplace(std::string(str));
+
+    if (inserted)
+    {
+        const auto length = (uint32_t)str.size();
+
+        iter->second = (StringRef)_strings.size();
+        _strings.append(reinterpret_cast<const char *>(&length), sizeof(length));
+        _strings.append(str);
+    }
+
+    return iter->second;
+}
+
+
+void ProgramCache::Writer::addChildren(const BaseNodePtrVector &children)
+{
+    for (const auto &child : children)
+    {
+        addNode(child.get());
+    }
+}
+
+
+void ProgramCache::Writer::addNode(const BaseNode *node)
+{
+    if (!node)
+    {
+        addRecord(NodeRecord());
+        return;
+    }
+
+    NodeRecord record;
+
+    auto literal = [node]()
+    {
+        Scope emptyScope;
+        return const_cast<BaseNode *>(node)->evaluateValue(emptyScope);
+    };
+
+    auto addAnyNode = [this, &record](Kind kind, const BaseNode &node)
+    {
+        const auto &children = node.castNode<AnyNode>().children();
+
+        addChildren(children);
+
+        record.kind = kind;
+        record.numChildren = (uint32_t)children.size();
+    };
+
+    auto symbolName = [](const BaseNode &node, size_t index) -> std::string_view
+    {
+        SymbolID symbol = node.castNode<AnyNode>().symbol(index);
+
+        return (symbol == SymbolTableImpl::kNoSymbol) ? std::string_view() : SymbolTable::instance().name(symbol);
+    };
+
+    switch (node->type())
+    {
+        case NodeType::Bool:
+            record.kind = Kind::Bool;
+            record.value = literal().asBool();
+            break;
+        case NodeType::Int:
+            record.kind = Kind::Int;
+            record.value = literal().asInt();
+            break;
+        case NodeType::Float:
+        {
+            double value = literal().asFloat();
+
+            record.kind = Kind::Float;
+            memcpy(&record.value, &value, sizeof(double));
+            break;
+        }
+        case NodeType::String:
+        {
+            Scope emptyScope;
+
+            record.kind = Kind::String;
+            record.names[0] = addString(const_cast<BaseNode *>(node)->evaluate(emptyScope)->getValue<std::string>());
+            break;
+        }
+        case NodeType::If:
+            addAnyNode(Kind::If, *node);
+            break;
+        case NodeType::ForLoop:
+            addAnyNode(Kind::ForLoop, *node);
+            break;
+        case NodeType::While:
+            addAnyNode(Kind::While, *node);
+            break;
+        case NodeType::DoWhile:
+            addAnyNode(Kind::DoWhile, *node);
+            break;
+        case NodeType::Break:
+            record.kind = Kind::Break;
+            break;
+        case NodeType::Continue:
+            record.kind = Kind::Continue;
+            break;
+        case NodeType::Return:
+            addAnyNode(Kind::Return, *node);
+            break;
+        case NodeType::Not:
+            addAnyNode(Kind::Not, *node);
+            break;
+        case NodeType::Negation:
+            addAnyNode(Kind::Negation, *node);
+            break;
+        case NodeType::PrefixIncrement:
+            addAnyNode(Kind::PrefixIncrement, *node);
+            break;
+        case NodeType::PrefixDecrement:
+            addAnyNode(Kind::PrefixDecrement, *node);
+            break;
+        case NodeType::Block:
+            addAnyNode(Kind::Block, *node);
+            break;
+        case NodeType::Assign:
+            addAnyNode(Kind::Assign, *node);
+            break;
+        case NodeType::Array:
+            addAnyNode(Kind::Array, *node);
+            break;
+        case NodeType::File:
+            addAnyNode(Kind::File, *node);
+            break;
+        case NodeType::Cast:
+            addAnyNode(Kind::Cast, *node);
+            record.subtype = (uint8_t)node->castNode<AnyNode>().valueType();
+            break;
+        case NodeType::ArrayAccess:
+            addAnyNode(Kind::ArrayAccess, *node);
+            break;
+        case NodeType::ClassMethodCall: /* The instance lookup is created by the factory */
+            addNode(node->castNode<AnyNode>().child(0).get());
+            record.kind = Kind::ClassMethodCall;
+            record.numChildren = 1;
+            record.names[0] = addString(symbolName(*node, 0));
+            break;
+        case NodeType::StructAccess:
+            record.kind = Kind::StructAccess;
+            record.names[0] = addString(symbolName(*node, 0));
+            record.names[1] = addString(symbolName(*node, 1));
+            break;
+        case NodeType::Module:
+            record.kind = Kind::Module;
+            record.names[0] = addString(symbolName(*node, 0)); /* Empty for duplicate imports */
+            break;
+        case NodeType::Binary:
+        {
+            const auto &binaryNode = node->castNode<BinaryNode>();
+
+            addNode(binaryNode.left().get());
+            addNode(binaryNode.right().get());
+
+            record.kind = Kind::Binary;
+            record.subtype = (uint8_t)binaryNode.binaryOperator();
+            record.numChildren = 2;
+            break;
+        }
+        case NodeType::LookupVariable:
+            record.kind = Kind::LookupVariable;
+            record.names[0] = addString(node->castNode<LookupVariableNode>().name());
+            break;
+        case NodeType::AddVariable:
+        {
+            const auto &variableNode = node->castNode<AddVariableNode>();
+
+            record.kind = Kind::AddVariable;
+            record.subtype = (uint8_t)variableNode.variableType();
+            record.elementType = (uint8_t)(variableNode.elementType() + 1);
+            record.names[0] = addString(variableNode.name());
+
+            if (dynamic_cast<const AddReferenceVariableNode *>(node))
+            {
+                record.kind = Kind::AddReferenceVariable;
+                record.names[1] = addString(variableNode.declaredName());
+            }
+            break;
+        }
+        case NodeType::FunctionCall:
+        {
+            const auto &callNode = node->castNode<FunctionCallNode>();
+
+            addChildren(callNode._funcArgs);
+
+            record.kind = Kind::FunctionCall;
+            record.numChildren = (uint32_t)callNode._funcArgs.size();
+            record.names[0] = addString(callNode._funcName);
+            break;
+        }
+        case NodeType::Function:
+        {
+            const auto &functionNode = node->castNode<FunctionNode>();
+
+            addChildren(functionNode._funcArgs);
+            addNode(functionNode.funcBody.get());
+
+            record.kind = Kind::Function;
+            record.subtype = functionNode.isPure() ? 1 : 0;
+            record.numChildren = (uint32_t)functionNode._funcArgs.size() + 1;
+            record.names[0] = addString(functionNode._funcName);
+            break;
+        }
+        case NodeType::ClassDefinition:
+        {
+            const auto &classNode = node->castNode<ClassDefinitionNode>();
+
+            for (const auto &variable : classNode.variables())
+                addNode(variable.get());
+
+            for (const auto &method : classNode.methods())
+                addNode(method.get());
+
+            record.kind = Kind::ClassDefinition;
+            record.numChildren = (uint32_t)(classNode.variables().size() + classNode.methods().size());
+            record.names[0] = addString(classNode.className());
+            record.names[1] = addString(classNode.parentClassName());
+            break;
+        }
+        default:
+        {
+            /* Class instances are the only nodes created by the parser without a type */
+            const auto *instanceNode = dynamic_cast<const ClassNode *>(node);
+            if (!instanceNode)
+            {
+                ThrowException("cannot store node of type " + std::to_string((int)node->type()));
+            }
+
+            record.kind = Kind::ClassInstance;
+            record.names[0] = addString(instanceNode->className());
+            record.names[1] = addString(instanceNode->instanceName());
+            break;
+        }
+    }
+
+    addRecord(record);
+}
+
+
+std::string ProgramCache::Writer::contents() const
+{
+    const size_t sourcesSize = _sources.size() * sizeof(SourceRecord);
+    const size_t nodesSize = _nodes.size() * sizeof(NodeRecord);
+
+    std::string contents(sizeof(Header) + sourcesSize + nodesSize + _strings.size(), '\0');
+
+    char *body = contents.data() + sizeof(Header);
+
+    memcpy(body, _sources.data(), sourcesSize);
+    memcpy(body + sourcesSize, _nodes.data(), nodesSize);
+    memcpy(body + sourcesSize + nodesSize, _strings.data(), _strings.size());
+
+    Header header;
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byteOrder = kByteOrder;
+    header.numSources = (uint32_t)_sources.size();
+    header.numNodes = (uint32_t)_nodes.size();
+    header.stringsSize = (uint32_t)_strings.size();
+    header.checksum = hashContents(std::string_view(body, contents.size() - sizeof(Header)));
+
+    memcpy(contents.data(), &header, sizeof(Header));
+    return contents;
+}
+
+
+ProgramCache::Reader::Reader(std::string_view contents)
+    : _contents(contents)
+{
+    if (_contents.size() < sizeof(Header))
+    {
+        ThrowException("cache is truncated");
+    }
+
+    memcpy(&_header, _contents.data(), sizeof(Header));
+
+    if (memcmp(_header.magic, kMagic, sizeof(kMagic)) != 0 || _header.byteOrder != kByteOrder)
+    {
+        ThrowException("not a program cache");
+    }
+    else if (_header.version != kVersion)
+    {
+        ThrowException(eucleia::stringify("unsupported version %u", _header.version));
+    }
+
+    _nodesOffset = sizeof(Header) + (size_t)_header.numSources * sizeof(SourceRecord);
+    _stringsOffset = _nodesOffset + (size_t)_header.numNodes * sizeof(NodeRecord);
+
+    if (_stringsOffset + _header.stringsSize != _contents.size())
+    {
+        ThrowException("cache is truncated");
+    }
+
+    if (hashContents(_contents.substr(sizeof(Header))) != _header.checksum)
+    {
+        ThrowException("cache is corrupted");
+    }
+}
+
+
+template <class TRecord>
+TRecord ProgramCache::Reader::record(size_t index, size_t offset) const
+{
+    TRecord record;
+    memcpy(&record, _contents.data() + offset + index * sizeof(TRecord), sizeof(TRecord));
+    return record;
+}
+
+
+std::string_view ProgramCache::Reader::string(StringRef ref) const
+{
+    uint32_t length{0};
+
+    if ((size_t)ref + sizeof(length) <= _header.stringsSize)
+    {
+        memcpy(&length, _contents.data() + _stringsOffset + ref, sizeof(length));
+    }
+
+    if ((size_t)ref + sizeof(length) + length > _header.stringsSize)
+    {
+        ThrowException("string is out of range");
+    }
+
+    return _contents.substr(_stringsOffset + ref + sizeof(length), length);
+}
+
+
+bool ProgramCache::Reader::sourcesMatch(const std::string &parentDirPath) const
+{
+    for (size_t i = 0; i < _header.numSources; ++i)
+    {
+        const auto source = record<SourceRecord>(i, sizeof(Header));
+
+        const std::string path = parentDirPath + std::string(string(source.path));
+
+        if (!std::filesystem::exists(path))
+        {
+            return false;
+        }
+
+        auto file = eucleia::MappedFile::open(path);
+
+        if (file->size() != source.size || hashContents(file->contents()) != source.hash)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+AnyNode::Ptr ProgramCache::Reader::buildAST() const
+{
+    BaseNodePtrVector stack;
+
+    for (size_t i = 0; i < _header.numNodes; ++i)
+    {
+        const auto node = record<NodeRecord>(i, _nodesOffset);
+
+        if (node.numChildren > stack.size())
+        {
+            ThrowException("node has missing children");
+        }
+
+        BaseNodePtrVector children(std::make_move_iterator(stack.end() - node.numChildren),
+                                   std::make_move_iterator(stack.end()));
+
+        stack.resize(stack.size() - node.numChildren);
+        stack.push_back(buildNode(node, std::move(children)));
+    }
+
+    if (stack.size() != 1 || !stack.front() || !stack.front()->isNodeType(NodeType::File))
+    {
+        ThrowException("cache does not contain a program");
+    }
+
+    return std::static_pointer_cast<AnyNode>(stack.front());
+}
+
+
+BaseNode::Ptr ProgramCache::Reader::buildNode(const NodeRecord &record, BaseNodePtrVector children) const
+{
+    auto expectChildren = [&](size_t numChildren)
+    {
+        if (children.size() != numChildren)
+            ThrowException("unexpected number of children");
+    };
+
+    auto expectType = [](const BaseNode::Ptr &node, NodeType type)
+    {
+        if (!node || !node->isNodeType(type))
+            ThrowException("unexpected child node");
+    };
+
+    auto expectNotNull = [&children]()
+    {
+        for (const auto &child : children)
+        {
+            if (!child)
+                ThrowException("unexpected child node");
+        }
+    };
+
+    auto name = [this, &record](size_t index)
+    {
+        return std::string(string(record.names[index]));
+    };
+
+    switch (record.kind)
+    {
+        case Kind::Null:
+            expectChildren(0);
+            return nullptr;
+        case Kind::Bool:
+            expectChildren(0);
+            return NodeFactory::createBoolNode(record.value != 0);
+        case Kind::Int:
+            expectChildren(0);
+            return NodeFactory::createIntNode((long)record.value);
+        case Kind::Float:
+        {
+            expectChildren(0);
+
+            double value;
+            memcpy(&value, &record.value, sizeof(double));
+            return NodeFactory::createFloatNode(value);
+        }
+        case Kind::String:
+            expectChildren(0);
+            return NodeFactory::createStringNode(name(0));
+        case Kind::If:
+            expectChildren(3);
+            if (!children[0] || !children[1])
+                ThrowException("unexpected child node");
+            return NodeFactory::createIfNode(children[0], children[1], children[2]);
+        case Kind::ForLoop:
+            expectChildren(4);
+            expectNotNull();
+            return NodeFactory::createForLoopNode(children[0], children[1], children[2], children[3]);
+        case Kind::While:
+            expectChildren(2);
+            expectNotNull();
+            return NodeFactory::createWhileLoopNode(children[0], children[1]);
+        case Kind::DoWhile:
+            expectChildren(2);
+            expectNotNull();
+            return NodeFactory::createDoWhileLoopNode(children[0], children[1]);
+        case Kind::Break:
+            expectChildren(0);
+            return NodeFactory::createBreakNode();
+        case Kind::Continue:
+            expectChildren(0);
+            return NodeFactory::createContinueNode();
+        case Kind::Return:
+            expectChildren(1);
+            return NodeFactory::createReturnNode(children[0]);
+        case Kind::Not:
+            expectChildren(1);
+            expectNotNull();
+            return NodeFactory::createNotNode(children[0]);
+        case Kind::Negation:
+            expectChildren(1);
+            expectNotNull();
+            return NodeFactory::createNegationNode(children[0]);
+        case Kind::PrefixIncrement:
+            expectChildren(1);
+            expectNotNull();
+            return NodeFactory::createPrefixIncrementNode(children[0]);
+        case Kind::PrefixDecrement:
+            expectChildren(1);
+            expectNotNull();
+            return NodeFactory::createPrefixDecrementNode(children[0]);
+        case Kind::Block:
+            expectNotNull();
+            return NodeFactory::createBlockNode(std::move(children));
+        case Kind::Assign:
+            expectChildren(2);
+            expectNotNull();
+            return NodeFactory::createAssignNode(children[0], children[1]);
+        case Kind::Array:
+            expectNotNull();
+            return NodeFactory::createArrayNode(std::move(children));
+        case Kind::File:
+            expectNotNull();
+            return NodeFactory::createFileNode(std::move(children));
+        case Kind::Binary:
+        {
+            expectChildren(2);
+            expectNotNull();
+
+            const auto binaryOperator = (BinaryOperatorType)record.subtype;
+            if (binaryOperator > BinaryOperatorType::Or)
+                ThrowException("unknown binary operator");
+
+            return AstArena::makeNode<BinaryNode>(children[0], children[1], binaryOperator);
+        }
+        case Kind::Cast:
+            expectChildren(1);
+            expectNotNull();
+            return NodeFactory::createCastNode(children[0], (AnyObject::Type)record.subtype);
+        case Kind::LookupVariable:
+            expectChildren(0);
+            return AstArena::makeNode<LookupVariableNode>(name(0));
+        case Kind::AddVariable:
+            expectChildren(0);
+            return AstArena::makeNode<AddVariableNode>(name(0), (AnyObject::Type)record.subtype, (AnyObject::Type)(record.elementType - 1));
+        case Kind::AddReferenceVariable:
+            expectChildren(0);
+            return AstArena::makeNode<AddReferenceVariableNode>(name(1), name(0), (AnyObject::Type)record.subtype);
+        case Kind::FunctionCall:
+            expectNotNull();
+            return AstArena::makeNode<FunctionCallNode>(name(0), std::move(children));
+        case Kind::Function:
+        {
+            if (children.empty())
+                ThrowException("function has no body");
+
+            expectNotNull();
+
+            BaseNode::Ptr body = std::move(children.back());
+            children.pop_back();
+
+            return AstArena::makeNode<FunctionNode>(name(0), std::move(children), std::move(body), record.subtype != 0);
+        }
+        case Kind::ClassDefinition:
+        {
+            /* Variables followed by methods */
+            std::vector<AddVariableNode::Ptr> variables;
+            std::vector<FunctionNode::Ptr> methods;
+
+            for (const auto &child : children)
+            {
+                if (child && child->isNodeType(NodeType::AddVariable) && methods.empty())
+                {
+                    variables.push_back(std::static_pointer_cast<AddVariableNode>(child));
+                }
+                else
+                {
+                    expectType(child, NodeType::Function);
+                    methods.push_back(std::static_pointer_cast<FunctionNode>(child));
+                }
+            }
+
+            return AstArena::makeNode<ClassDefinitionNode>(name(0), name(1), std::move(variables), std::move(methods));
+        }
+        case Kind::ClassInstance:
+            expectChildren(0);
+            return AstArena::makeNode<ClassNode>(name(0), name(1));
+        case Kind::ClassMethodCall:
+            expectChildren(1);
+            expectType(children[0], NodeType::FunctionCall);
+            return NodeFactory::createClassMethodCallNode(name(0), std::static_pointer_cast<FunctionCallNode>(children[0]));
+        case Kind::StructAccess:
+            expectChildren(0);
+            return NodeFactory::createStructAccessNode(name(0), name(1));
+        case Kind::ArrayAccess:
+            expectChildren(2);
+            expectType(children[0], NodeType::LookupVariable);
+            expectNotNull();
+            return NodeFactory::createArrayAccessNode(children[0], children[1]);
+        case Kind::Module:
+            expectChildren(0);
+        {
+            std::string moduleName = name(0);
+
+            return moduleName.empty() ? NodeFactory::createModuleNode() : NodeFactory::createDefinedModuleNode(std::move(moduleName));
+        }
+        default:
+            ThrowException("unknown node kind " + std::to_string((int)record.kind));
+    }
+}
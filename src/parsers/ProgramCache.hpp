@@ -0,0 +1,185 @@
+/**
+ * @file ProgramCache.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "AnyNode.hpp"
+#include "BaseNode.hpp"
+#include "FileUtils.hpp"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * On-disk cache of parsed programs (.ekc files).
+ *
+ * The AST for the entry-point and its imports is stored as a flat array of fixed-size node records in post-order
+ * followed by a string table. All references are offsets so the file can be mapped at any address and the pages shared
+ * by all of the processes running the program.
+ *
+ * The cache records the size and content hash of each file that was parsed with paths relative to the entry-point's
+ * directory (so the program can be moved). It is only used if none of these files have changed. The import graph is
+ * decided by the contents of these files so it does not need to be checked separately.
+ *
+ * Loading rebuilds the nodes with the NodeFactory. The files are not tokenized or parsed.
+ *
+ * The cache is written next to the entry-point (main.ek -> main.ekc) or to EUCLEIA_CACHE_DIR if set.
+ */
+class ProgramCache
+{
+public:
+    /* Returns the AST if there is a valid cache for the program, otherwise nullptr */
+    static AnyNode::Ptr load(const std::string &entryPointPath);
+
+    /* Writes the cache for a program parsed from the sources (entry-point first). Failures are logged and ignored */
+    static void store(const std::string &entryPointPath, const BaseNode &ast, const std::vector<eucleia::MappedFile::Ptr> &sources);
+
+    /* Returns the path of the cache for the entry-point */
+    static std::string cachePath(const std::string &entryPointPath);
+
+    /* 64-bit hash used to detect changes to sources (not cryptographic) */
+    static uint64_t hashContents(std::string_view contents);
+
+    /* Incremented whenever the format or the nodes change */
+    static constexpr uint32_t kVersion{2};
+
+protected:
+    /* Prevent direct initialization */
+    ProgramCache() = default;
+
+    /* Offset of a string in the string table. Strings are stored as a uint32_t length followed by the characters */
+    using StringRef = uint32_t;
+
+    struct Header
+    {
+        char magic[4];
+        uint32_t version;
+        uint32_t byteOrder; /* Written as kByteOrder */
+        uint32_t numSources;
+        uint32_t numNodes;
+        uint32_t stringsSize;
+        uint64_t checksum; /* Hash of everything after the header */
+    };
+
+    struct SourceRecord
+    {
+        uint64_t hash;
+        uint64_t size;
+        StringRef path; /* Relative to the entry-point's directory */
+        uint32_t reserved;
+    };
+
+    enum class Kind : uint8_t
+    {
+        Null, /* Optional child which is not set */
+        Bool,
+        Int,
+        Float,
+        String,
+        If,
+        ForLoop,
+        While,
+        DoWhile,
+        Break,
+        Continue,
+        Return,
+        Not,
+        Negation,
+        PrefixIncrement,
+        PrefixDecrement,
+        Block,
+        Assign,
+        Array,
+        File,
+        Binary,
+        Cast,
+        LookupVariable,
+        AddVariable,
+        AddReferenceVariable,
+        FunctionCall,
+        Function,
+        ClassDefinition,
+        ClassInstance,
+        ClassMethodCall,
+        StructAccess,
+        ArrayAccess,
+        Module
+    };
+
+    /* Children are the numChildren records built before this one */
+    struct NodeRecord
+    {
+        Kind kind{Kind::Null};
+        uint8_t subtype{0}; /* Operator, object type or pure function */
+        uint8_t elementType{0}; /* Packed array declarations (element type + 1 so that 0 is not set) */
+        uint8_t reserved{0};
+        uint32_t numChildren{0};
+        union
+        {
+            StringRef names[2];
+            int64_t value{0}; /* Literals */
+        };
+    };
+
+    static_assert(sizeof(NodeRecord) == 16);
+
+    static constexpr char kMagic[4]{'E', 'K', 'C', '\0'};
+    static constexpr uint32_t kByteOrder{0x01020304};
+
+    /* Builds the contents of a cache */
+    class Writer
+    {
+    public:
+        void addSource(std::string_view relativePath, std::string_view contents);
+
+        void addNode(const BaseNode *node);
+
+        [[nodiscard]] std::string contents() const;
+
+    protected:
+        StringRef addString(std::string_view str);
+
+        void addChildren(const BaseNodePtrVector &children);
+
+        void addRecord(NodeRecord record) { _nodes.push_back(record); }
+
+    private:
+        std::vector<SourceRecord> _sources;
+        std::vector<NodeRecord> _nodes;
+        std::string _strings;
+        std::unordered_map<std::string, StringRef> _stringRefs;
+    };
+
+    /* Rebuilds the AST from a cache. Throws if the cache is invalid */
+    class Reader
+    {
+    public:
+        explicit Reader(std::string_view contents);
+
+        /* Returns false if any of the sources have changed */
+        [[nodiscard]] bool sourcesMatch(const std::string &parentDirPath) const;
+
+        [[nodiscard]] AnyNode::Ptr buildAST() const;
+
+    protected:
+        BaseNode::Ptr buildNode(const NodeRecord &record, BaseNodePtrVector children) const;
+
+        [[nodiscard]] std::string_view string(StringRef ref) const;
+
+        template <class TRecord>
+        [[nodiscard]] TRecord record(size_t index, size_t offset) const;
+
+    private:
+        std::string_view _contents;
+        Header _header;
+        size_t _nodesOffset{0};
+        size_t _stringsOffset{0};
+    };
+};
@@ -30,11 +30,11 @@ AnyNode::Ptr BlockSubParser::parseBlock()
 
 BaseNodePtrVector BlockSubParser::parseBraces()
 {
-    skip("{");
+    skip(TokenKind::LeftBrace);
 
     BaseNodePtrVector capturedNodes; /* Nodes inside the block */
 
-    while (!tokens().empty() && !equals(Token::Punctuation, "}"))
+    while (!tokens().empty() && !equals(TokenKind::RightBrace))
     {
         auto expression = parent().parseExpression();
 
@@ -43,15 +43,15 @@ BaseNodePtrVector BlockSubParser::parseBraces()
         parent().skipSemicolonLineEndingIfRequired(*expression);
     }
 
-    skip("}");
+    skip(TokenKind::RightBrace);
 
     return capturedNodes;
 }
 
 
-BaseNodePtrVector BlockSubParser::parseDelimited(std::string start,
-                                                 std::string stop,
-                                                 std::string separator,
+BaseNodePtrVector BlockSubParser::parseDelimited(TokenKind start,
+                                                 TokenKind stop,
+                                                 TokenKind separator,
                                                  ParseMethod parseMethod)
 {
     skip(start);
@@ -39,8 +39,8 @@ public:
     BaseNodePtrVector parseBraces();
 
     /* Parse a delimited expression, e.g. (a, b, c) where start='(', stop=')', separator=',' */
-    BaseNodePtrVector parseDelimited(std::string start,
-                                     std::string stop,
-                                     std::string separator,
+    BaseNodePtrVector parseDelimited(TokenKind start,
+                                     TokenKind stop,
+                                     TokenKind separator,
                                      ParseMethod parseMethod);
 };
\ No newline at end of file
@@ -8,6 +8,7 @@
  */
 
 #include "ClassSubParser.hpp"
+#include "AstArena.hpp"
 #include "BaseNode.hpp"
 #include "Exceptions.hpp"
 #include "FileParser.hpp"
@@ -16,24 +17,25 @@
 
 BaseNode::Ptr ClassSubParser::parseClass()
 {
-    skip("class");
+    skip(TokenKind::Class);
 
-    auto classTypeName = tokens().dequeue();
+    auto classTypeToken = tokens().dequeue();
+    std::string classTypeName = classTypeToken.str();
 
     /* Insert to keep track of class definitions */
-    _parsedClassDefinitions.insert(classTypeName);
+    _parsedClassDefinitions.insert(classTypeToken.symbol());
 
     // Do we have a '{' token next? If we do then it is definition of new struct.
-    if (equals(Token::Punctuation, "{") || equals(Token::Punctuation, ":"))
+    if (equals(TokenKind::LeftBrace) || equals(TokenKind::Colon))
     {
         // *** Inheritance: class SomeClass(ParentClass) ***
         std::string classParentTypeName = "";
 
-        if (equals(Token::Punctuation, ":"))
+        if (equals(TokenKind::Colon))
         {
-            skip(":");
+            skip(TokenKind::Colon);
 
-            classParentTypeName = tokens().dequeue();
+            classParentTypeName = tokens().dequeue().str();
         }
 
         std::vector<BaseNode::Ptr> classBody = parent().subparsers().block.parseBraces();
@@ -52,7 +54,7 @@ BaseNode::Ptr ClassSubParser::parseClass()
                 ThrowException("unexpected node type for class definition " + classTypeName);
         }
 
-        return std::make_shared<ClassDefinitionNode>(classTypeName, classParentTypeName, classVariables, classMethods);
+        return AstArena::makeNode<ClassDefinitionNode>(classTypeName, classParentTypeName, classVariables, classMethods);
     }
 
     ThrowException("Failed to parse class definition");
@@ -63,7 +65,7 @@ BaseNode::Ptr ClassSubParser::parseStructAccessor(BaseNode::Ptr lastExpression)
 {
     auto instanceName = lastExpression->castNode<LookupVariableNode>().name();
 
-    skip(".");
+    skip(TokenKind::Dot);
 
     BaseNode::Ptr expression = parent().maybeFunctionCall(std::bind(&VariableSubParser::parseVariable, &parent().subparsers().variable));
 
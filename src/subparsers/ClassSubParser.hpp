@@ -9,7 +9,7 @@
 
 #pragma once
 #include "SubParser.hpp"
-#include <string>
+#include "SymbolTable.hpp"
 #include <unordered_set>
 
 class FileParser;
@@ -45,16 +45,17 @@ public:
      */
     BaseNode::Ptr parseStructAccessor(BaseNode::Ptr lastExpression);
 
-    inline bool isParsedClassDefinition(const std::string &name) const;
+    /* Class names are stored as interned symbols */
+    inline bool isParsedClassDefinition(SymbolID name) const;
 
 private:
-    using ClassDefinitionSet = std::unordered_set<std::string>;
+    using ClassDefinitionSet = std::unordered_set<SymbolID>;
 
     ClassDefinitionSet _parsedClassDefinitions;
 };
 
 
-bool ClassSubParser::isParsedClassDefinition(const std::string &name) const
+bool ClassSubParser::isParsedClassDefinition(SymbolID name) const
 {
     return _parsedClassDefinitions.count(name);
 }
@@ -45,18 +45,18 @@
 AnyNode::Ptr ControlFlowSubParser::parseIf()
 {
     // For now, only permit a single if statement.
-    skip("if");
+    skip(TokenKind::If);
 
     auto condition = parent().parseBrackets();
     auto thenDo = parent().subparsers().block.parseBlock();
 
     BaseNode::Ptr elseDo{nullptr}; // Optional.
-    if (tokens().front() == "else")
+    if (equals(TokenKind::Else))
     {
-        skip("else");
+        skip(TokenKind::Else);
 
         // Option 1: else if (condition) { [statement]; }
-        if (tokens().front() == "if")
+        if (equals(TokenKind::If))
             elseDo = parseIf();
         // Option 2: else { [statement]; }
         else
@@ -69,19 +69,27 @@ AnyNode::Ptr ControlFlowSubParser::parseIf()
 
 AnyNode::Ptr ControlFlowSubParser::parseBreak()
 {
-    skip("break");
+    skip(TokenKind::Break);
 
     return NodeFactory::createBreakNode();
 }
 
 
+AnyNode::Ptr ControlFlowSubParser::parseContinue()
+{
+    skip(TokenKind::Continue);
+
+    return NodeFactory::createContinueNode();
+}
+
+
 AnyNode::Ptr ControlFlowSubParser::parseReturn()
 {
-    skip("return");
+    skip(TokenKind::Return);
 
     BaseNode::Ptr returnedExpression{nullptr};
 
-    if (!equals(Token::Punctuation, ";"))
+    if (!equals(TokenKind::Semicolon))
     {
         returnedExpression = parent().parseExpression();
     }
@@ -20,5 +20,7 @@ public:
 
     AnyNode::Ptr parseBreak();
 
+    AnyNode::Ptr parseContinue();
+
     AnyNode::Ptr parseReturn();
 };
\ No newline at end of file
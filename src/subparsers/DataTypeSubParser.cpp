@@ -19,7 +19,7 @@ AnyNode::Ptr DataTypeSubParser::parseInt()
 {
     Token token = tokens().dequeue();
 
-    long intValue = strtold(token.c_str(), NULL);
+    long intValue = token.toInt();
 
     return NodeFactory::createIntNode(intValue);
 }
@@ -29,7 +29,7 @@ AnyNode::Ptr DataTypeSubParser::parseFloat()
 {
     Token token = tokens().dequeue();
 
-    double floatValue = strtof(token.c_str(), NULL);
+    double floatValue = token.toFloat();
 
     return NodeFactory::createFloatNode(floatValue);
 }
@@ -39,7 +39,7 @@ AnyNode::Ptr DataTypeSubParser::parseBool()
 {
     Token token = tokens().dequeue();
 
-    bool state = (token == "true");
+    bool state = token.toBool();
 
     return NodeFactory::createBoolNode(state);
 }
@@ -49,24 +49,24 @@ AnyNode::Ptr DataTypeSubParser::parseString()
 {
     Token token = tokens().dequeue();
 
-    return NodeFactory::createStringNode(std::move(token));
+    return NodeFactory::createStringNode(token.symbol()); /* Interned by the lexer */
 }
 
 
 AnyNode::Ptr DataTypeSubParser::parseArray()
 {
-    BaseNodePtrVector nodes = subparsers().block.parseDelimited("[", "]", ",", std::bind(&FileParser::parseExpression, &parent()));
+    BaseNodePtrVector nodes = subparsers().block.parseDelimited(TokenKind::LeftBracket, TokenKind::RightBracket, TokenKind::Comma, std::bind(&FileParser::parseExpression, &parent()));
     return NodeFactory::createArrayNode(std::move(nodes));
 }
 
 
 AnyPropertyNode::Ptr DataTypeSubParser::parseArrayAccessor(BaseNode::Ptr lastExpression)
 {
-    skip("[");
+    skip(TokenKind::LeftBracket);
 
     auto arrayIndexNode = parent().parseExpression();
 
-    skip("]");
+    skip(TokenKind::RightBracket);
 
     return NodeFactory::createArrayAccessNode(lastExpression, arrayIndexNode);
 }
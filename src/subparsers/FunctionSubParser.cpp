@@ -8,6 +8,7 @@
  */
 
 #include "FunctionSubParser.hpp"
+#include "AstArena.hpp"
 #include "FileParser.hpp"
 #include "FunctionCallNode.hpp"
 #include "FunctionNode.hpp"
@@ -23,21 +24,27 @@ FunctionCallNode::Ptr FunctionSubParser::parseFunctionCall(BaseNode::Ptr lastExp
 
 FunctionCallNode::Ptr FunctionSubParser::parseFunctionCall(std::string functionName)
 {
-    auto functionArgs = subparsers().block.parseDelimited("(", ")", ",", std::bind(&FileParser::parseExpression, &parent()));
+    auto functionArgs = subparsers().block.parseDelimited(TokenKind::LeftParen, TokenKind::RightParen, TokenKind::Comma, std::bind(&FileParser::parseExpression, &parent()));
 
-    return std::make_shared<FunctionCallNode>(functionName, functionArgs);
+    return AstArena::makeNode<FunctionCallNode>(functionName, functionArgs);
 }
 
 
 FunctionNode::Ptr FunctionSubParser::parseFunctionDefinition()
 {
-    skip("func");
+    bool isPure = equals(TokenKind::Pure);
+    if (isPure)
+    {
+        skip(TokenKind::Pure); /* Checked by VariableResolver */
+    }
+
+    skip(TokenKind::Func);
 
     auto funcName = tokens().dequeue();
     assert(funcName.type() == Token::Variable);
 
-    auto funcArgs = subparsers().block.parseDelimited("(", ")", ",", std::bind(&VariableSubParser::parseVariableDefinition, &subparsers().variable)); // Func variables.
+    auto funcArgs = subparsers().block.parseDelimited(TokenKind::LeftParen, TokenKind::RightParen, TokenKind::Comma, std::bind(&VariableSubParser::parseVariableDefinition, &subparsers().variable)); // Func variables.
     auto funcBody = parent().subparsers().block.parseBlock();                                                                                         // TODO: - investigate why this causes a segfault when we switch to parseBlock()
 
-    return std::make_shared<FunctionNode>(funcName, funcArgs, funcBody);
+    return AstArena::makeNode<FunctionNode>(funcName.str(), funcArgs, funcBody, isPure);
 }
\ No newline at end of file
@@ -26,7 +26,7 @@ public:
 
     /* Parse function definition:
      *
-     * func [funcName]([dataType1] [arg1], ...)
+     * [pure] func [funcName]([dataType1] [arg1], ...)
      * {
      *      [code]
      * }
@@ -13,22 +13,21 @@
 #include "Logger.hpp"
 #include "ModuleNodeFactory.hpp"
 #include "NodeFactory.hpp"
-#include "ParserData.hpp"
 #include "Token.hpp"
 
 
 BaseNode::Ptr ImportSubParser::parseImport()
 {
-    skip("import");
+    skip(TokenKind::Import);
 
     auto token = tokens().front();
 
     if (token.type() == Token::String)
         return parseFileImport();
-    else if (equals(Token::Operator, "<"))
+    else if (equals(TokenKind::Less))
         return parseModuleImport();
 
-    ThrowException("unexpected token: " + token);
+    ThrowException("unexpected token: " + token.str());
 }
 
 
@@ -38,47 +37,40 @@ AnyNode::Ptr ImportSubParser::parseFileImport()
     auto token = tokens().dequeue();
     assert(token.type() == Token::String);
 
-    // Check: has file already been imported somewhere? If it has then we don't
-    // want to import it a second time! (i.e. A imports B, C and B imports C. In
-    // this case, PARSE A set[A]--> PARSE B set[A,B]--> PARSE C set[A,B,C].
-    if (ParserData::instance().isImported(token, ParserDataImpl::File))
+    // Files are parsed before the files which import them (see ImportGraph). If a file has already been imported
+    // somewhere then we don't want to import it a second time! (i.e. A imports B, C and B imports C).
+    const FileParser::Import &import = parent().nextImport();
+
+    if (import.isDuplicate)
     {
         return NodeFactory::createFileNode(); // Return "empty file".
     }
 
-    ParserData::instance().addImport(token, ParserDataImpl::File);
-
-    // Build the file path:
-    std::string filePath = parent().parentDirPath() + token;
-    log().debug("importing file: " + filePath);
-
-    auto ast = FileParser(filePath).buildAST(); // NB: don't use static method as this will clear loaded modules/files.
-    if (!ast)
+    if (!import.ast)
     {
-        ThrowException("failed to import file with path " + filePath);
+        ThrowException("failed to import file " + token.str());
     }
 
-    return ast;
+    return import.ast;
 }
 
 
 AnyNode::Ptr ImportSubParser::parseModuleImport()
 {
-    skip("<");
+    skip(TokenKind::Less);
 
     auto token = tokens().dequeue();
     assert(token.type() == Token::Variable);
 
-    skip(">");
+    skip(TokenKind::Greater);
 
-    if (ParserData::instance().isImported(token, ParserDataImpl::Module))
+    if (parent().nextImport().isDuplicate)
     {
         return NodeFactory::createModuleNode(); /* Empty module node */
     }
 
-    ParserData::instance().addImport(token, ParserDataImpl::Module);
-
-    log().debug("importing library: " + token);
+    std::string moduleName = token.str();
+    log().debug("importing library: " + moduleName);
 
-    return NodeFactory::createDefinedModuleNode(std::move(token));
+    return NodeFactory::createDefinedModuleNode(std::move(moduleName));
 }
@@ -22,9 +22,9 @@
  */
 AnyNode::Ptr LoopSubParser::parseDoWhile()
 {
-    skip("do");
+    skip(TokenKind::Do);
     BaseNode::Ptr body = parent().subparsers().block.parseBlock();
-    skip("while");
+    skip(TokenKind::While);
     BaseNode::Ptr condition = parent().parseBrackets();
 
     return NodeFactory::createDoWhileLoopNode(condition, body);
@@ -40,7 +40,7 @@ AnyNode::Ptr LoopSubParser::parseDoWhile()
  */
 AnyNode::Ptr LoopSubParser::parseWhile()
 {
-    skip("while");
+    skip(TokenKind::While);
 
     BaseNode::Ptr condition = parent().parseBrackets();
     BaseNode::Ptr body = parent().subparsers().block.parseBlock();
@@ -58,9 +58,9 @@ AnyNode::Ptr LoopSubParser::parseWhile()
  */
 AnyNode::Ptr LoopSubParser::parseFor()
 {
-    skip("for");
+    skip(TokenKind::For);
 
-    auto forLoopArgs = subparsers().block.parseDelimited("(", ")", ";", std::bind(&FileParser::parseExpression, &parent()));
+    auto forLoopArgs = subparsers().block.parseDelimited(TokenKind::LeftParen, TokenKind::RightParen, TokenKind::Semicolon, std::bind(&FileParser::parseExpression, &parent()));
 
     if (forLoopArgs.size() != 3)
     {
@@ -14,7 +14,7 @@
 
 AnyNode::Ptr UnaryOperatorSubParser::parseNot()
 {
-    skip("!");
+    skip(TokenKind::Not);
 
     return NodeFactory::createNotNode(parent().parseAtomically());
 }
@@ -22,7 +22,7 @@ AnyNode::Ptr UnaryOperatorSubParser::parseNot()
 
 AnyNode::Ptr UnaryOperatorSubParser::parseNegation()
 {
-    skip("-");
+    skip(TokenKind::Minus);
 
     return NodeFactory::createNegationNode(parent().parseAtomically());
 }
@@ -30,7 +30,7 @@ AnyNode::Ptr UnaryOperatorSubParser::parseNegation()
 
 AnyNode::Ptr UnaryOperatorSubParser::parsePrefixIncrement()
 {
-    skip("++");
+    skip(TokenKind::Increment);
 
     return NodeFactory::createPrefixIncrementNode(parent().parseAtomically());
 }
@@ -38,7 +38,7 @@ AnyNode::Ptr UnaryOperatorSubParser::parsePrefixIncrement()
 
 AnyNode::Ptr UnaryOperatorSubParser::parsePrefixDecrement()
 {
-    skip("--");
+    skip(TokenKind::Decrement);
 
     return NodeFactory::createPrefixDecrementNode(parent().parseAtomically());
 }
\ No newline at end of file
@@ -10,7 +10,9 @@
 #include "VariableSubParser.hpp"
 #include "AddVariableNode.hpp"
 #include "AnyNode.hpp"
+#include "AstArena.hpp"
 #include "ClassNode.hpp"
+#include "Exceptions.hpp"
 #include "FileParser.hpp"
 #include "LookupVariableNode.hpp"
 #include "NodeFactory.hpp"
@@ -23,21 +25,37 @@ BaseNode::Ptr VariableSubParser::parseVariableDefinition()
     Token typeToken = tokens().dequeue();
     assert(typeToken.type() == Token::Keyword);
 
-    AnyObject::Type typeOfObject = AnyObject::stringToType(typeToken);
+    AnyObject::Type typeOfObject = AnyObject::stringToType(typeToken.str());
 
-    if (tokens().front() == "&") // Is reference: [type] & [name] = [another object]
+    if (equals(TokenKind::Ampersand)) // Is reference: [type] & [name] = [another object]
     {
         return parseReference(typeOfObject);
     }
-    else if (tokens().front() == "(") // Is cast: i.e., float(1), float(intVar), bool(1), int(1.2)
+    else if (equals(TokenKind::LeftParen)) // Is cast: i.e., float(1), float(intVar), bool(1), int(1.2)
     {
         return parseCast(typeOfObject);
     }
 
+    AnyObject::Type elementType = AnyObject::NotSet;
+
+    if (equals(TokenKind::LeftBracket)) // Is packed array: int[], float[] or bool[]
+    {
+        skip(TokenKind::LeftBracket);
+        skip(TokenKind::RightBracket);
+
+        if (typeOfObject != AnyObject::Int && typeOfObject != AnyObject::Float && typeOfObject != AnyObject::Bool)
+        {
+            ThrowException("Invalid array element type [" + typeToken.str() + "]. Expected int, float or bool");
+        }
+
+        elementType = typeOfObject;
+        typeOfObject = AnyObject::Array;
+    }
+
     Token nameToken = tokens().dequeue();
     assert(nameToken.type() == Token::Variable);
 
-    return std::make_shared<AddVariableNode>(nameToken, typeOfObject);
+    return AstArena::makeNode<AddVariableNode>(nameToken.str(), typeOfObject, elementType);
 }
 
 
@@ -46,17 +64,17 @@ BaseNode::Ptr VariableSubParser::parseVariableDefinition()
 
 BaseNode::Ptr VariableSubParser::parseReference(AnyObject::Type boundVariableType)
 {
-    skip("&"); // TODO: - add type-checking
+    skip(TokenKind::Ampersand); // TODO: - add type-checking
 
     Token referenceNameToken = tokens().dequeue();
     assert(referenceNameToken.type() == Token::Variable);
 
-    skip("=");
+    skip(TokenKind::Assign);
 
     Token boundVariableNameToken = tokens().dequeue();
     assert(boundVariableNameToken.type() == Token::Variable);
 
-    return std::make_shared<AddReferenceVariableNode>(referenceNameToken, boundVariableNameToken, boundVariableType);
+    return AstArena::makeNode<AddReferenceVariableNode>(referenceNameToken.str(), boundVariableNameToken.str(), boundVariableType);
 }
 
 
@@ -66,13 +84,13 @@ BaseNode::Ptr VariableSubParser::parseVariable()
     assert(token.type() == Token::Variable);
 
     /* Note: we may have a class instance defined here: [classType] [classInstance] */
-    if (subparsers().classParser.isParsedClassDefinition(token))
+    if (subparsers().classParser.isParsedClassDefinition(token.symbol()))
     {
         /* ClassTypeName, ClassInstanceName */
-        return std::make_shared<ClassNode>(token, tokens().dequeue());
+        return AstArena::makeNode<ClassNode>(token.str(), tokens().dequeue().str());
     }
 
-    return std::make_shared<LookupVariableNode>(token);
+    return AstArena::makeNode<LookupVariableNode>(token.str());
 }
 
 
@@ -0,0 +1,686 @@
+/**
+ * @file ArrayKernels.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ArrayKernels.hpp"
+#include "Exceptions.hpp"
+#include "ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+/* Vectorize using GCC vector extensions on x86-64. AVX2 kernels are compiled with the target attribute */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define KERNELS_X86 1
+#define KERNELS_AVX2 __attribute__((target("avx2")))
+#define KERNELS_INLINE inline __attribute__((always_inline))
+#else
+#define KERNELS_X86 0
+#endif
+
+namespace ArrayKernels
+{
+
+namespace
+{
+
+/* Reference implementation. Also handles the remaining elements for the vectorized kernels */
+struct ScalarKernels
+{
+    template <class T>
+    static T sum(const T *values, size_t size)
+    {
+        return std::accumulate(values, values + size, T{0});
+    }
+
+    template <class T>
+    static T dot(const T *left, const T *right, size_t size)
+    {
+        return std::inner_product(left, left + size, right, T{0});
+    }
+
+    template <class T>
+    static T min(const T *values, size_t size)
+    {
+        return *std::min_element(values, values + size);
+    }
+
+    template <class T>
+    static T max(const T *values, size_t size)
+    {
+        return *std::max_element(values, values + size);
+    }
+
+    template <class T>
+    static void scale(const T *values, T factor, T *result, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            result[i] = values[i] * factor;
+    }
+
+    template <class T>
+    static void add(const T *left, const T *right, T *result, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            result[i] = left[i] + right[i];
+    }
+
+    template <class T>
+    static void mul(const T *left, const T *right, T *result, size_t size)
+    {
+        for (size_t i = 0; i < size; ++i)
+            result[i] = left[i] * right[i];
+    }
+
+    template <class T>
+    static void fill(T *values, T value, size_t size)
+    {
+        std::fill_n(values, size, value);
+    }
+
+    static void range(long *values, long start, size_t size)
+    {
+        std::iota(values, values + size, start);
+    }
+};
+
+
+#if KERNELS_X86
+
+/*
+ * Vector types for SSE2 (16 bytes) and AVX2 (32 bytes). The kernels below are always inlined so the same code compiles
+ * to AVX2 instructions when inlined into a function with the AVX2 target. Vectors are never passed by value since the
+ * ABI depends on the target.
+ */
+typedef double Double2 __attribute__((vector_size(16)));
+typedef double Double4 __attribute__((vector_size(32)));
+typedef long Long2 __attribute__((vector_size(16)));
+typedef long Long4 __attribute__((vector_size(32)));
+
+
+template <class TVector, class T>
+KERNELS_INLINE void load(TVector &vector, const T *values)
+{
+    std::memcpy(&vector, values, sizeof(TVector)); /* Unaligned */
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE void store(const TVector &vector, T *values)
+{
+    std::memcpy(values, &vector, sizeof(TVector));
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE T horizontalSum(const TVector &vector)
+{
+    T total{0};
+
+    for (size_t lane = 0; lane < sizeof(TVector) / sizeof(T); ++lane)
+        total += vector[lane];
+
+    return total;
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE T sumVector(const T *values, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    /* Two accumulators to hide the latency of the adds */
+    TVector total0{}, total1{}, next0, next1;
+
+    size_t i = 0;
+    for (; i + 2 * kLanes <= size; i += 2 * kLanes)
+    {
+        load(next0, values + i);
+        load(next1, values + i + kLanes);
+
+        total0 += next0;
+        total1 += next1;
+    }
+
+    total0 += total1;
+
+    return horizontalSum<TVector, T>(total0) + ScalarKernels::sum(values + i, size - i);
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE T dotVector(const T *left, const T *right, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    TVector total0{}, total1{}, left0, left1, right0, right1;
+
+    size_t i = 0;
+    for (; i + 2 * kLanes <= size; i += 2 * kLanes)
+    {
+        load(left0, left + i);
+        load(left1, left + i + kLanes);
+        load(right0, right + i);
+        load(right1, right + i + kLanes);
+
+        total0 += left0 * right0;
+        total1 += left1 * right1;
+    }
+
+    total0 += total1;
+
+    return horizontalSum<TVector, T>(total0) + ScalarKernels::dot(left + i, right + i, size - i);
+}
+
+
+/* Minimum (or maximum) element. Size must be > 0 */
+template <class TVector, bool kIsMin, class T>
+KERNELS_INLINE T extremumVector(const T *values, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    const auto better = [](T left, T right)
+    { return kIsMin ? (left < right) : (left > right); };
+
+    if (size < kLanes)
+    {
+        return *std::min_element(values, values + size, better);
+    }
+
+    TVector best, next;
+    load(best, values);
+
+    size_t i = kLanes;
+    for (; i + kLanes <= size; i += kLanes)
+    {
+        load(next, values + i);
+
+        if constexpr (kIsMin)
+            best = (next < best) ? next : best; /* Lane-wise select */
+        else
+            best = (next > best) ? next : best;
+    }
+
+    T result = best[0];
+
+    for (size_t lane = 1; lane < kLanes; ++lane)
+        result = std::min<T>(result, best[lane], better);
+
+    for (; i < size; ++i)
+        result = std::min(result, values[i], better);
+
+    return result;
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE void scaleVector(const T *values, T factor, T *result, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    TVector next;
+
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes)
+    {
+        load(next, values + i);
+        next *= factor;
+        store(next, result + i);
+    }
+
+    ScalarKernels::scale(values + i, factor, result + i, size - i);
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE void addVector(const T *left, const T *right, T *result, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    TVector nextLeft, nextRight;
+
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes)
+    {
+        load(nextLeft, left + i);
+        load(nextRight, right + i);
+        nextLeft += nextRight;
+        store(nextLeft, result + i);
+    }
+
+    ScalarKernels::add(left + i, right + i, result + i, size - i);
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE void mulVector(const T *left, const T *right, T *result, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    TVector nextLeft, nextRight;
+
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes)
+    {
+        load(nextLeft, left + i);
+        load(nextRight, right + i);
+        nextLeft *= nextRight;
+        store(nextLeft, result + i);
+    }
+
+    ScalarKernels::mul(left + i, right + i, result + i, size - i);
+}
+
+
+template <class TVector, class T>
+KERNELS_INLINE void fillVector(T *values, T value, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(T);
+
+    TVector splat = TVector{} + value;
+
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes)
+        store(splat, values + i);
+
+    ScalarKernels::fill(values + i, value, size - i);
+}
+
+
+template <class TVector>
+KERNELS_INLINE void rangeVector(long *values, long start, size_t size)
+{
+    constexpr size_t kLanes = sizeof(TVector) / sizeof(long);
+
+    TVector next = TVector{} + start;
+
+    for (size_t lane = 0; lane < kLanes; ++lane)
+        next[lane] += (long)lane;
+
+    size_t i = 0;
+    for (; i + kLanes <= size; i += kLanes)
+    {
+        store(next, values + i);
+        next += (long)kLanes;
+    }
+
+    ScalarKernels::range(values + i, start + (long)i, size - i);
+}
+
+
+/* Instantiates the vectorized kernels in functions compiled for TARGET */
+#define DEFINE_VECTOR_KERNELS(NAME, TARGET, DoubleVector, LongVector)                                                \
+    struct NAME                                                                                                      \
+    {                                                                                                                \
+        TARGET static long sum(const long *values, size_t size) { return sumVector<LongVector>(values, size); }      \
+        TARGET static double sum(const double *values, size_t size) { return sumVector<DoubleVector>(values, size); } \
+                                                                                                                     \
+        TARGET static long dot(const long *left, const long *right, size_t size)                                     \
+        {                                                                                                            \
+            return dotVector<LongVector>(left, right, size);                                                         \
+        }                                                                                                            \
+        TARGET static double dot(const double *left, const double *right, size_t size)                               \
+        {                                                                                                            \
+            return dotVector<DoubleVector>(left, right, size);                                                       \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static long min(const long *values, size_t size)                                                      \
+        {                                                                                                            \
+            return extremumVector<LongVector, true>(values, size);                                                   \
+        }                                                                                                            \
+        TARGET static double min(const double *values, size_t size)                                                  \
+        {                                                                                                            \
+            return extremumVector<DoubleVector, true>(values, size);                                                 \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static long max(const long *values, size_t size)                                                      \
+        {                                                                                                            \
+            return extremumVector<LongVector, false>(values, size);                                                 \
+        }                                                                                                            \
+        TARGET static double max(const double *values, size_t size)                                                  \
+        {                                                                                                            \
+            return extremumVector<DoubleVector, false>(values, size);                                             \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static void scale(const long *values, long factor, long *result, size_t size)                         \
+        {                                                                                                            \
+            scaleVector<LongVector>(values, factor, result, size);                                                   \
+        }                                                                                                            \
+        TARGET static void scale(const double *values, double factor, double *result, size_t size)                   \
+        {                                                                                                            \
+            scaleVector<DoubleVector>(values, factor, result, size);                                                 \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static void add(const long *left, const long *right, long *result, size_t size)                       \
+        {                                                                                                            \
+            addVector<LongVector>(left, right, result, size);                                                        \
+        }                                                                                                            \
+        TARGET static void add(const double *left, const double *right, double *result, size_t size)                 \
+        {                                                                                                            \
+            addVector<DoubleVector>(left, right, result, size);                                                      \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static void mul(const long *left, const long *right, long *result, size_t size)                       \
+        {                                                                                                            \
+            mulVector<LongVector>(left, right, result, size);                                                        \
+        }                                                                                                            \
+        TARGET static void mul(const double *left, const double *right, double *result, size_t size)                 \
+        {                                                                                                            \
+            mulVector<DoubleVector>(left, right, result, size);                                                      \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static void fill(long *values, long value, size_t size) { fillVector<LongVector>(values, value, size); } \
+        TARGET static void fill(double *values, double value, size_t size)                                           \
+        {                                                                                                            \
+            fillVector<DoubleVector>(values, value, size);                                                           \
+        }                                                                                                            \
+                                                                                                                     \
+        TARGET static void range(long *values, long start, size_t size) { rangeVector<LongVector>(values, start, size); } \
+    };
+
+DEFINE_VECTOR_KERNELS(SSE2Kernels, /* Baseline for x86-64 */, Double2, Long2)
+DEFINE_VECTOR_KERNELS(AVX2Kernels, KERNELS_AVX2, Double4, Long4)
+
+#undef DEFINE_VECTOR_KERNELS
+
+#endif
+
+
+std::atomic<InstructionSet> &selectedInstructionSet()
+{
+    static std::atomic<InstructionSet> selected{detectInstructionSet()};
+    return selected;
+}
+
+
+/* Calls function with the kernels for the selected instruction set */
+template <class TFunction>
+decltype(auto) dispatch(TFunction &&function)
+{
+    switch (selectedInstructionSet().load(std::memory_order_relaxed))
+    {
+#if KERNELS_X86
+        case InstructionSet::AVX2:
+            return function(AVX2Kernels{});
+        case InstructionSet::SSE2:
+            return function(SSE2Kernels{});
+#endif
+        default:
+            return function(ScalarKernels{});
+    }
+}
+
+
+/* Blocks until all chunks submitted to the ThreadPool have run */
+class Latch
+{
+public:
+    explicit Latch(size_t count) : _count(count) {}
+
+    void countDown()
+    {
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        if (--_count == 0)
+        {
+            _cv.notify_all(); /* NB: under the lock so the waiting thread cannot destroy the latch first */
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _cv.wait(lock, [this]()
+        { return (_count == 0); });
+    }
+
+private:
+    size_t _count;
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+};
+
+
+/* Calls function(chunk, begin, end) for each chunk. The first chunk runs on the calling thread */
+template <class TFunction>
+void forEachChunk(size_t size, size_t chunks, TFunction &&function)
+{
+    if (chunks <= 1)
+    {
+        function(0, 0, size);
+        return;
+    }
+
+    const size_t chunkSize = (size + chunks - 1) / chunks;
+
+    Latch latch(chunks - 1);
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+    {
+        ThreadPool::instance().submit([&function, &latch, chunk, chunkSize, size]()
+        {
+            function(chunk, chunk * chunkSize, std::min(size, (chunk + 1) * chunkSize));
+            latch.countDown();
+        });
+    }
+
+    function(0, 0, chunkSize);
+    latch.wait();
+}
+
+
+/* Combines the result of kernel(kernels, begin, end) for each chunk */
+template <class T, class TCombine, class TKernel>
+T reduce(size_t size, TCombine combine, TKernel kernel)
+{
+    const size_t chunks = numChunks(size);
+
+    std::vector<T> partials(chunks);
+
+    forEachChunk(size, chunks, [&](size_t chunk, size_t begin, size_t end)
+    {
+        partials[chunk] = dispatch([&](auto kernels)
+        { return kernel(kernels, begin, end); });
+    });
+
+    return std::accumulate(std::next(partials.begin()), partials.end(), partials.front(), combine);
+}
+
+
+/* Calls kernel(kernels, begin, end) for each chunk */
+template <class TKernel>
+void transform(size_t size, TKernel kernel)
+{
+    forEachChunk(size, numChunks(size), [&](size_t, size_t begin, size_t end)
+    {
+        dispatch([&](auto kernels)
+        { kernel(kernels, begin, end); });
+    });
+}
+
+
+const auto kMin = [](auto left, auto right)
+{ return std::min(left, right); };
+
+const auto kMax = [](auto left, auto right)
+{ return std::max(left, right); };
+
+} // namespace
+
+
+InstructionSet detectInstructionSet()
+{
+#if KERNELS_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return InstructionSet::AVX2;
+    }
+
+    return InstructionSet::SSE2;
+#else
+    return InstructionSet::Scalar;
+#endif
+}
+
+
+InstructionSet instructionSet()
+{
+    return selectedInstructionSet().load();
+}
+
+
+void setInstructionSet(InstructionSet instructionSet)
+{
+    if (instructionSet > detectInstructionSet())
+    {
+        ThrowException("instruction set is not supported by the CPU");
+    }
+
+    selectedInstructionSet().store(instructionSet);
+}
+
+
+size_t numChunks(size_t size)
+{
+    /* Serial if too small or already running on the pool (waiting for other tasks could deadlock) */
+    if (size < 2 * kParallelThreshold || ThreadPoolImpl::isWorkerThread())
+    {
+        return 1;
+    }
+
+    return std::min(ThreadPool::instance().size() + 1, size / kParallelThreshold);
+}
+
+
+long sum(const long *values, size_t size)
+{
+    return reduce<long>(size, std::plus<>(), [values](auto kernels, size_t begin, size_t end)
+    { return kernels.sum(values + begin, end - begin); });
+}
+
+
+double sum(const double *values, size_t size)
+{
+    return reduce<double>(size, std::plus<>(), [values](auto kernels, size_t begin, size_t end)
+    { return kernels.sum(values + begin, end - begin); });
+}
+
+
+long dot(const long *left, const long *right, size_t size)
+{
+    return reduce<long>(size, std::plus<>(), [left, right](auto kernels, size_t begin, size_t end)
+    { return kernels.dot(left + begin, right + begin, end - begin); });
+}
+
+
+double dot(const double *left, const double *right, size_t size)
+{
+    return reduce<double>(size, std::plus<>(), [left, right](auto kernels, size_t begin, size_t end)
+    { return kernels.dot(left + begin, right + begin, end - begin); });
+}
+
+
+long min(const long *values, size_t size)
+{
+    return reduce<long>(size, kMin, [values](auto kernels, size_t begin, size_t end)
+    { return kernels.min(values + begin, end - begin); });
+}
+
+
+double min(const double *values, size_t size)
+{
+    return reduce<double>(size, kMin, [values](auto kernels, size_t begin, size_t end)
+    { return kernels.min(values + begin, end - begin); });
+}
+
+
+long max(const long *values, size_t size)
+{
+    return reduce<long>(size, kMax, [values](auto kernels, size_t begin, size_t end)
+    { return kernels.max(values + begin, end - begin); });
+}
+
+
+double max(const double *values, size_t size)
+{
+    return reduce<double>(size, kMax, [values](auto kernels, size_t begin, size_t end)
+    { return kernels.max(values + begin, end - begin); });
+}
+
+
+void scale(const long *values, long factor, long *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.scale(values + begin, factor, result + begin, end - begin); });
+}
+
+
+void scale(const double *values, double factor, double *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.scale(values + begin, factor, result + begin, end - begin); });
+}
+
+
+void add(const long *left, const long *right, long *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.add(left + begin, right + begin, result + begin, end - begin); });
+}
+
+
+void add(const double *left, const double *right, double *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.add(left + begin, right + begin, result + begin, end - begin); });
+}
+
+
+void mul(const long *left, const long *right, long *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.mul(left + begin, right + begin, result + begin, end - begin); });
+}
+
+
+void mul(const double *left, const double *right, double *result, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.mul(left + begin, right + begin, result + begin, end - begin); });
+}
+
+
+void fill(long *values, long value, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.fill(values + begin, value, end - begin); });
+}
+
+
+void fill(double *values, double value, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.fill(values + begin, value, end - begin); });
+}
+
+
+void range(long *values, long start, size_t size)
+{
+    transform(size, [=](auto kernels, size_t begin, size_t end)
+    { kernels.range(values + begin, start + (long)begin, end - begin); });
+}
+
+} // namespace ArrayKernels
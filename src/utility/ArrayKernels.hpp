@@ -0,0 +1,78 @@
+/**
+ * @file ArrayKernels.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include <cstddef>
+
+/**
+ * Numeric kernels for packed arrays (see stdarray module).
+ *
+ * - Kernels are vectorized for AVX2 or SSE2 with a scalar fallback. The instruction set is chosen on first use by
+ *   detecting the CPU.
+ * - Arrays with at least 2 * kParallelThreshold elements are split into chunks which are run on the ThreadPool. The
+ *   calling thread runs the first chunk.
+ * - Reductions of floats are not associative so the result may differ slightly between instruction sets.
+ */
+namespace ArrayKernels
+{
+
+enum class InstructionSet
+{
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+/* Best instruction set supported by the CPU */
+InstructionSet detectInstructionSet();
+
+/* Instruction set used by the kernels */
+InstructionSet instructionSet();
+
+/* Overrides the detected instruction set (i.e. for testing). Must be supported by the CPU */
+void setInstructionSet(InstructionSet instructionSet);
+
+/* Minimum number of elements in each chunk run on the ThreadPool */
+constexpr size_t kParallelThreshold{1 << 16};
+
+/* Number of chunks an array is split into */
+size_t numChunks(size_t size);
+
+long sum(const long *values, size_t size);
+double sum(const double *values, size_t size);
+
+long dot(const long *left, const long *right, size_t size);
+double dot(const double *left, const double *right, size_t size);
+
+/* Size must be > 0 */
+long min(const long *values, size_t size);
+double min(const double *values, size_t size);
+
+long max(const long *values, size_t size);
+double max(const double *values, size_t size);
+
+/* result[i] = values[i] * factor. Result may be the same as values */
+void scale(const long *values, long factor, long *result, size_t size);
+void scale(const double *values, double factor, double *result, size_t size);
+
+/* result[i] = left[i] + right[i] */
+void add(const long *left, const long *right, long *result, size_t size);
+void add(const double *left, const double *right, double *result, size_t size);
+
+/* result[i] = left[i] * right[i] */
+void mul(const long *left, const long *right, long *result, size_t size);
+void mul(const double *left, const double *right, double *result, size_t size);
+
+void fill(long *values, long value, size_t size);
+void fill(double *values, double value, size_t size);
+
+/* values[i] = start + i */
+void range(long *values, long start, size_t size);
+
+} // namespace ArrayKernels
@@ -11,66 +11,99 @@
 #include "FileUtils.hpp"
 #include "Exceptions.hpp"
 #include "Stringify.hpp"
-#include <cstdio>
-#include <cstdlib>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace eucleia
 {
 
-static long numBytesInFile(FILE *fp);
-
-
-char *loadFileContents(const char *path)
+MappedFile::Ptr MappedFile::open(const std::string &path)
 {
-    if (!path)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
     {
-        ThrowException("path cannot be NULL");
+        ThrowException(eucleia::stringify("failed to open file %s", path.c_str()));
     }
 
-    FILE *fp = fopen(path, "r");
-    if (!fp)
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0)
     {
-        ThrowException(eucleia::stringify("failed to open file %s", path));
+        close(fd);
+        ThrowException("file is empty");
     }
 
-    const long kBufferSize = numBytesInFile(fp);
-    if (kBufferSize <= 0)
+    const size_t size = fileInfo.st_size;
+
+    Ptr file = (size < kMinMappedSize) ? read(path, fd, size) : map(path, fd, size);
+    close(fd);
+
+    if (!file)
     {
-        fclose(fp);
-        ThrowException("file is empty");
+        ThrowException(eucleia::stringify("failed to read file %s", path.c_str()));
     }
 
-    // NB: +1 for '\0' character.
-    char *buffer = (char *)malloc(sizeof(char) * (kBufferSize + 1));
-    if (!buffer)
+    return file;
+}
+
+
+MappedFile::Ptr MappedFile::read(const std::string &path, int fd, size_t size)
+{
+    std::unique_ptr<char[]> buffer(new char[size + kPadding]);
+
+    size_t bytesRead = 0;
+    while (bytesRead < size)
     {
-        fclose(fp);
-        ThrowException("failed to malloc file buffer");
-    }
+        ssize_t count = pread(fd, buffer.get() + bytesRead, size - bytesRead, bytesRead);
+        if (count <= 0)
+        {
+            return nullptr;
+        }
 
-    // Read from file.
-    buffer[kBufferSize] = '\0';
-    (void)fread((void *)buffer, sizeof(char), kBufferSize, fp);
+        bytesRead += count;
+    }
 
-    // Close file pointer.
-    fclose(fp);
+    std::fill_n(buffer.get() + size, kPadding, '\0');
 
-    return buffer;
+    return Ptr(new MappedFile(path, std::move(buffer), size));
 }
 
 
-static long numBytesInFile(FILE *fp)
+MappedFile::Ptr MappedFile::map(const std::string &path, int fd, size_t size)
 {
-    if (!fp)
-        return 0;
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
 
-    fseek(fp, 0, SEEK_END); // Jump to end.
+    /*
+     * Reserve zero-filled pages for the file plus the padding and then map the file over the start. The bytes after
+     * the end of the file are always zero so the contents are '\0' terminated.
+     */
+    const size_t mappedSize = ((size + kPadding + pageSize - 1) / pageSize) * pageSize;
 
-    const long nBytes = ftell(fp);
+    void *reserved = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (reserved == MAP_FAILED)
+    {
+        return nullptr;
+    }
 
-    rewind(fp); // Jump to start.
+    void *mapped = mmap(reserved, size, PROT_READ, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        munmap(reserved, mappedSize);
+        return nullptr;
+    }
 
-    return nBytes;
+    return Ptr(new MappedFile(path, static_cast<const char *>(mapped), size, mappedSize));
+}
+
+
+MappedFile::~MappedFile()
+{
+    if (_mappedSize > 0)
+    {
+        munmap(const_cast<char *>(_data), _mappedSize);
+    }
 }
 
-} // namespace eucleia
\ No newline at end of file
+} // namespace eucleia
@@ -8,11 +8,62 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
 
 namespace eucleia
 {
 
-// Returns a C-string containing the file contents.
-char *loadFileContents(const char *fpath);
+/*
+ * Read-only memory mapping of a file. The contents are always followed by kPadding '\0' characters so they can be
+ * scanned like a C-string (or a vector at a time) without copying the file. Small files are read into a buffer instead
+ * since mapping them costs more than the copy.
+ */
+class MappedFile
+{
+public:
+    using Ptr = std::shared_ptr<const MappedFile>;
+
+    /* Files smaller than this are read rather than mapped */
+    static constexpr size_t kMinMappedSize{16 * 1024};
+
+    /* Number of readable '\0' characters after the contents */
+    static constexpr size_t kPadding{16};
+
+    static Ptr open(const std::string &path);
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]] const char *data() const { return _data; }
+
+    [[nodiscard]] size_t size() const { return _size; }
+
+    [[nodiscard]] std::string_view contents() const { return {_data, _size}; }
+
+    [[nodiscard]] const std::string &path() const { return _path; }
+
+protected:
+    MappedFile(std::string path, const char *data, size_t size, size_t mappedSize)
+        : _path(std::move(path)), _data(data), _size(size), _mappedSize(mappedSize) {}
+
+    MappedFile(std::string path, std::unique_ptr<char[]> buffer, size_t size)
+        : _path(std::move(path)), _buffer(std::move(buffer)), _data(_buffer.get()), _size(size) {}
+
+    static Ptr read(const std::string &path, int fd, size_t size);
+
+    static Ptr map(const std::string &path, int fd, size_t size);
+
+private:
+    const std::string _path;
+    const std::unique_ptr<char[]> _buffer; /* Small files only */
+    const char *_data{nullptr};
+    const size_t _size{0};
+    const size_t _mappedSize{0}; /* Zero if not mapped */
+};
 
 } // namespace eucleia
@@ -0,0 +1,88 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace
+{
+/* Set for the worker threads */
+thread_local bool tIsWorkerThread{false};
+} // namespace
+
+
+ThreadPoolImpl::ThreadPoolImpl()
+{
+    const size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+
+    _threads.reserve(numThreads);
+
+    for (size_t i = 0; i < numThreads; ++i)
+    {
+        _threads.emplace_back(&ThreadPoolImpl::loop, this);
+    }
+}
+
+
+ThreadPoolImpl::~ThreadPoolImpl()
+{
+    {
+        Lock guard(_mutex);
+        _shutdown = true;
+    }
+
+    _cv.notify_all(); /* Wakeup threads */
+
+    for (auto &thread : _threads)
+    {
+        thread.join(); /* Remaining tasks are run first */
+    }
+}
+
+
+void ThreadPoolImpl::submit(Task task)
+{
+    {
+        Lock guard(_mutex);
+        _tasks.push(std::move(task));
+    }
+
+    _cv.notify_one();
+}
+
+
+bool ThreadPoolImpl::isWorkerThread()
+{
+    return tIsWorkerThread;
+}
+
+
+void ThreadPoolImpl::loop()
+{
+    tIsWorkerThread = true;
+
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            _cv.wait(lock, [this]()
+            { return (!_tasks.empty() || _shutdown); });
+
+            if (_shutdown && _tasks.empty())
+                return;
+
+            task = std::move(_tasks.front());
+            _tasks.pop();
+        }
+
+        task(); /* Execute */
+    }
+}
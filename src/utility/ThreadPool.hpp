@@ -0,0 +1,58 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#pragma once
+#include "SingletonT.hpp"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/* Fixed-size pool of worker threads. Threads are started on first use and joined on exit */
+class ThreadPoolImpl
+{
+public:
+    using Task = std::function<void()>;
+
+    /* Queues a task. Tasks must not throw */
+    void submit(Task task);
+
+    /* Number of worker threads */
+    [[nodiscard]] size_t size() const { return _threads.size(); }
+
+    /* Returns true if called from one of the worker threads. Tasks waiting on other tasks would deadlock */
+    [[nodiscard]] static bool isWorkerThread();
+
+protected:
+    friend class SingletonT<ThreadPoolImpl>;
+
+    /* Prevent direct initialization. Starts one thread per core */
+    ThreadPoolImpl();
+
+    ~ThreadPoolImpl();
+
+private:
+    /* Thread loop */
+    void loop();
+
+    using Lock = std::lock_guard<std::mutex>;
+
+    std::vector<std::thread> _threads;
+    std::queue<Task> _tasks;
+
+    bool _shutdown{false};
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+};
+
+
+using ThreadPool = SingletonT<ThreadPoolImpl>;
@@ -0,0 +1,67 @@
+/**
+ * @file ClassBenchmarks.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FileParser.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <benchmark/benchmark.h>
+
+namespace Classes
+{
+
+/* Creates 20k instances and reads and writes their fields */
+static void EvaluateParticleInstances(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/ParticleInstances.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+/* Calls 40k methods (including overridden methods from the same call site) which call a global function */
+static void EvaluateMethodCalls(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/MethodCalls.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+/* Creates 20k instances which are each part of a reference cycle */
+static void EvaluateCyclicInstances(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CyclicInstances.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+} // namespace Classes
+
+
+BENCHMARK(Classes::EvaluateParticleInstances)->Unit(benchmark::kMillisecond);
+BENCHMARK(Classes::EvaluateMethodCalls)->Unit(benchmark::kMillisecond);
+BENCHMARK(Classes::EvaluateCyclicInstances)->Unit(benchmark::kMillisecond);
@@ -9,6 +9,7 @@
 
 #include "EucleiaInterpreter.hpp"
 #include "FileParser.hpp"
+#include "ObjectFactory.hpp"
 #include "Scope.hpp"
 #include "test/utility/Utility.hpp"
 #include <benchmark/benchmark.h>
@@ -27,6 +28,26 @@ static void ParseAndEvaluateFibTo25(benchmark::State &state)
     }
 }
 
+static void ParseAndEvaluateFibTo25Bytecode(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/EvaluateFibToTwentyFive.ek");
+
+    for (auto _ : state)
+    {
+        Interpreter::evaluateFile(path, Interpreter::Engine::Bytecode);
+    }
+}
+
+static void ParseAndEvaluatePureFibTo25(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/EvaluatePureFibToTwentyFive.ek");
+
+    for (auto _ : state)
+    {
+        Interpreter::evaluateFile(path);
+    }
+}
+
 static void ParseAndEvaluateSumOfMultiplesOf3Or5To1000Naive(benchmark::State &state)
 {
     auto path = (getTestDirPath() + "benchmark/data/SumMultiplesThreeFiveNaive.ek");
@@ -57,10 +78,94 @@ static void ParseAndEvaluateDifferenceSumOfSquaresAndSquareOfSum(benchmark::Stat
     }
 }
 
+/* Global function called 200k times from 20 nested calls deep */
+static void EvaluateCallFromNestedScope(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CallFromNestedScope.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+/* Tail-recursive sum to 100k */
+static void EvaluateTailRecursion(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/SumTailRecursive.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+/* Rule run for each request with different inputs. Parses the script each time */
+static void ParseAndRunScoreRule(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/ScoreRule.ek");
+
+    auto history = ObjectFactory::allocate(AnyObject::IntVector{120, 80, 400, 95, 60, 310, 75, 200});
+
+    long amount = 0;
+
+    for (auto _ : state)
+    {
+        Interpreter::compile(path).run({{"amount", ObjectFactory::allocate(amount++ % 1500)}, {"history", history}});
+    }
+}
+
+/* As above. The script is parsed once and run for each request */
+static void RunPreparedScoreRule(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/ScoreRule.ek");
+
+    auto history = ObjectFactory::allocate(AnyObject::IntVector{120, 80, 400, 95, 60, 310, 75, 200});
+    auto script = Interpreter::compile(path);
+
+    long amount = 0;
+
+    for (auto _ : state)
+    {
+        script.run({{"amount", ObjectFactory::allocate(amount++ % 1500)}, {"history", history}});
+    }
+}
+
+/* As above. The rule function is called directly for each request */
+static void CallPreparedScoreRule(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/ScoreRule.ek");
+
+    auto history = ObjectFactory::allocate(AnyObject::IntVector{120, 80, 400, 95, 60, 310, 75, 200});
+    auto script = Interpreter::compile(path);
+
+    script.run({{"amount", ObjectFactory::allocate(0L)}, {"history", history}});
+
+    long amount = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(script.call("score", {ObjectFactory::allocate(amount++ % 1500), history}));
+    }
+}
+
 } // namespace Functions
 
 
 BENCHMARK(Functions::ParseAndEvaluateFibTo25)->Unit(benchmark::kMillisecond);
+BENCHMARK(Functions::ParseAndEvaluateFibTo25Bytecode)->Unit(benchmark::kMillisecond);
+BENCHMARK(Functions::ParseAndEvaluatePureFibTo25)->Unit(benchmark::kMillisecond);
 BENCHMARK(Functions::ParseAndEvaluateSumOfMultiplesOf3Or5To1000Naive)->Unit(benchmark::kMillisecond);
 BENCHMARK(Functions::ParseAndEvaluateSumOfMultiplesOf3Or5To1000Opt)->Unit(benchmark::kMillisecond);
-BENCHMARK(Functions::ParseAndEvaluateDifferenceSumOfSquaresAndSquareOfSum)->Unit(benchmark::kMillisecond);
\ No newline at end of file
+BENCHMARK(Functions::ParseAndEvaluateDifferenceSumOfSquaresAndSquareOfSum)->Unit(benchmark::kMillisecond);
+BENCHMARK(Functions::EvaluateCallFromNestedScope)->Unit(benchmark::kMillisecond);
+BENCHMARK(Functions::EvaluateTailRecursion)->Unit(benchmark::kMillisecond);
+BENCHMARK(Functions::ParseAndRunScoreRule)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Functions::RunPreparedScoreRule)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Functions::CallPreparedScoreRule)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,73 @@
+/**
+ * @file FusedNodeBenchmarks.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FileParser.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace Fused
+{
+static void evaluateFile(benchmark::State &state, const std::string &fileName)
+{
+    auto path = (getTestDirPath() + "benchmark/data/" + fileName);
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+/* for (...; i < n; ++i) */
+static void EvaluateLoopCondition(benchmark::State &state)
+{
+    evaluateFile(state, "LoopConditionOneMillion.ek");
+}
+
+
+/* x = x + k */
+static void EvaluateAddConstantToVariable(benchmark::State &state)
+{
+    evaluateFile(state, "AddConstantToVariable.ek");
+}
+
+
+/* ++x */
+static void EvaluateIncrementVariable(benchmark::State &state)
+{
+    evaluateFile(state, "IncrementVariable.ek");
+}
+
+
+/* if (a == b) */
+static void EvaluateBranchOnEquality(benchmark::State &state)
+{
+    evaluateFile(state, "BranchOnEquality.ek");
+}
+
+
+/* return fib(n - 1) + fib(n - 2) */
+static void EvaluateRecursiveCalls(benchmark::State &state)
+{
+    evaluateFile(state, "EvaluateFibToTwentyFive.ek");
+}
+
+} // namespace Fused
+
+
+BENCHMARK(Fused::EvaluateLoopCondition)->Unit(benchmark::kMillisecond);
+BENCHMARK(Fused::EvaluateAddConstantToVariable)->Unit(benchmark::kMillisecond);
+BENCHMARK(Fused::EvaluateIncrementVariable)->Unit(benchmark::kMillisecond);
+BENCHMARK(Fused::EvaluateBranchOnEquality)->Unit(benchmark::kMillisecond);
+BENCHMARK(Fused::EvaluateRecursiveCalls)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,82 @@
+/**
+ * @file LexerBenchmarks.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Tokenizer.hpp"
+#include "test/utility/Utility.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+namespace Lexer
+{
+/* Concatenates the functional test files until the file is at least minSize bytes. Returns the path */
+static std::string buildLargeSourceFile(size_t minSize)
+{
+    std::string contents;
+
+    for (const auto &entry : std::filesystem::directory_iterator(getTestDirPath() + "functional/data"))
+    {
+        std::ifstream file(entry.path());
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+
+        contents += buffer.str() + "\n";
+    }
+
+    const size_t sizeOfFiles = contents.size();
+
+    while (contents.size() < minSize)
+    {
+        contents.append(contents, 0, sizeOfFiles);
+    }
+
+    auto path = std::filesystem::temp_directory_path() / ("LexerBenchmarks_" + std::to_string(getpid()) + ".ek");
+
+    std::ofstream(path, std::ios::binary) << contents;
+
+    return path.string();
+}
+
+
+static void TokenizeFile(benchmark::State &state, const std::string &path)
+{
+    const size_t size = std::filesystem::file_size(path);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(Tokenizer::build(path));
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+}
+
+
+static void TokenizeFib(benchmark::State &state)
+{
+    TokenizeFile(state, getTestDirPath() + "benchmark/data/Fib.ek");
+}
+
+
+static void Tokenize4MB(benchmark::State &state)
+{
+    const std::string path = buildLargeSourceFile(4 * 1024 * 1024);
+
+    TokenizeFile(state, path);
+
+    std::filesystem::remove(path);
+}
+
+} // namespace Lexer
+
+
+BENCHMARK(Lexer::TokenizeFib)->Unit(benchmark::kMicrosecond);
+BENCHMARK(Lexer::Tokenize4MB)->Unit(benchmark::kMillisecond);
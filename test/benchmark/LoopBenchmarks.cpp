@@ -7,9 +7,11 @@
  *
  */
 
+#include "BytecodeCompiler.hpp"
 #include "EucleiaInterpreter.hpp"
 #include "FileParser.hpp"
 #include "Scope.hpp"
+#include "VirtualMachine.hpp"
 #include "test/utility/Utility.hpp"
 #include <benchmark/benchmark.h>
 
@@ -39,8 +41,116 @@ static void EvaluateCountTo1M(benchmark::State &state)
     }
 }
 
+
+static void EvaluateCountTo1MBytecode(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CountToOneMillion.ek");
+
+    auto program = BytecodeCompiler::compile(FileParser::parseMainFile(path));
+
+    for (auto _ : state)
+    {
+        VirtualMachine(program).run();
+    }
+}
+
+
+static void EvaluateCountTo1MConstants(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CountToOneMillionConstants.ek");
+
+    FileParser::Statistics statistics;
+
+    auto ast = FileParser::parseMainFile(path, false, &statistics);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+
+    state.counters["nodesFolded"] = (double)statistics.numFolded;
+}
+
+
+static void EvaluateCompareStrings1M(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CompareStringsOneMillion.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+static void EvaluateCopyAndReadArray(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/CopyAndReadArray.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+static void EvaluateSumArray100K(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/SumArrayOneHundredThousand.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+static void EvaluateSumAndDot1M(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/SumAndDotOneMillion.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
+
+static void EvaluateSumAndDot1MNative(benchmark::State &state)
+{
+    auto path = (getTestDirPath() + "benchmark/data/SumAndDotOneMillionNative.ek");
+
+    auto ast = FileParser::parseMainFile(path);
+
+    for (auto _ : state)
+    {
+        Scope globalScope;
+        ast->evaluate(globalScope);
+    }
+}
+
 } // namespace Loops
 
 
 BENCHMARK(Loops::ParseCountTo1M)->Unit(benchmark::kMillisecond);
-BENCHMARK(Loops::EvaluateCountTo1M)->Unit(benchmark::kMillisecond);
\ No newline at end of file
+BENCHMARK(Loops::EvaluateCountTo1M)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateCountTo1MBytecode)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateCountTo1MConstants)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateCompareStrings1M)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateCopyAndReadArray)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateSumArray100K)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateSumAndDot1M)->Unit(benchmark::kMillisecond);
+BENCHMARK(Loops::EvaluateSumAndDot1MNative)->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,117 @@
+/**
+ * @file ParserBenchmarks.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FileParser.hpp"
+#include "ProgramCache.hpp"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace Parser
+{
+/* Writes a file with numFunctions operator-heavy function definitions. Returns the path */
+static std::string buildFunctionsFile(int numFunctions, const std::string &name = "Functions")
+{
+    auto path = std::filesystem::temp_directory_path() / ("ParserBenchmarks_" + std::to_string(getpid()) + name + ".ek");
+
+    std::ofstream file(path, std::ios::binary);
+
+    for (int i = 0; i < numFunctions; ++i)
+    {
+        file << "func " << name << i << "(int a, int b)\n"
+             << "{\n"
+             << "    int c = a * b + (a - b) % 3;\n"
+             << "    if (c >= 10 && a != b || !(a < b))\n"
+             << "    {\n"
+             << "        return c;\n"
+             << "    }\n"
+             << "    while (c > 0) { c = c - 1; }\n"
+             << "    return a + b;\n"
+             << "}\n";
+    }
+
+    return path.string();
+}
+
+
+static void ParseGeneratedFunctions(benchmark::State &state)
+{
+    const std::string path = buildFunctionsFile(10000);
+    const size_t size = std::filesystem::file_size(path);
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FileParser::parseMainFile(path));
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+
+    std::filesystem::remove(path);
+}
+
+
+/* As above but the program is loaded from the ProgramCache */
+static void LoadCachedFunctions(benchmark::State &state)
+{
+    const std::string path = buildFunctionsFile(10000);
+    const size_t size = std::filesystem::file_size(path);
+
+    (void)FileParser::parseMainFile(path, true); /* Write the cache */
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FileParser::parseMainFile(path, true));
+    }
+
+    state.SetBytesProcessed(state.iterations() * size);
+
+    std::filesystem::remove(ProgramCache::cachePath(path));
+    std::filesystem::remove(path);
+}
+
+
+/* Entry-point which imports 32 library files (like a program using many library files) */
+static void ParseManyImports(benchmark::State &state)
+{
+    const int numLibraries = 32;
+
+    std::vector<std::string> paths;
+    std::string entryPoint;
+
+    for (int i = 0; i < numLibraries; ++i)
+    {
+        paths.push_back(buildFunctionsFile(500, "Library" + std::to_string(i)));
+        entryPoint += "import \"" + std::filesystem::path(paths.back()).filename().string() + "\"\n";
+    }
+
+    auto path = std::filesystem::temp_directory_path() / ("ParserBenchmarks_" + std::to_string(getpid()) + "Main.ek");
+    std::ofstream(path, std::ios::binary) << entryPoint;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FileParser::parseMainFile(path.string()));
+    }
+
+    std::filesystem::remove(path);
+
+    for (const auto &libraryPath : paths)
+    {
+        std::filesystem::remove(libraryPath);
+    }
+}
+
+} // namespace Parser
+
+
+BENCHMARK(Parser::ParseGeneratedFunctions)->Unit(benchmark::kMillisecond);
+BENCHMARK(Parser::LoadCachedFunctions)->Unit(benchmark::kMillisecond);
+BENCHMARK(Parser::ParseManyImports)->Unit(benchmark::kMillisecond)->UseRealTime();
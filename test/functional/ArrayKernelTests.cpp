@@ -0,0 +1,219 @@
+/**
+ * @file ArrayKernelTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AnyNode.hpp"
+#include "ArrayKernels.hpp"
+#include "ObjectFactory.hpp"
+#include "Scope.hpp"
+#include "Value.hpp"
+#include "test/utility/Utility.hpp"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+
+class ArrayKernelTestSuite : public ::testing::Test
+{
+protected:
+    void SetUp() override { _instructionSet = ArrayKernels::instructionSet(); }
+
+    void TearDown() override { ArrayKernels::setInstructionSet(_instructionSet); }
+
+    void evaluate(const std::string &program)
+    {
+        _asts.push_back(evaluateScript(program, _scope));
+    }
+
+    const AnyObject &object(const std::string &name) { return *_scope.getNamedObject(name); }
+
+    /* Instruction sets supported by the CPU */
+    static std::vector<ArrayKernels::InstructionSet> supportedInstructionSets()
+    {
+        std::vector<ArrayKernels::InstructionSet> instructionSets{ArrayKernels::InstructionSet::Scalar};
+
+        for (auto instructionSet : {ArrayKernels::InstructionSet::SSE2, ArrayKernels::InstructionSet::AVX2})
+        {
+            if (instructionSet <= ArrayKernels::detectInstructionSet())
+                instructionSets.push_back(instructionSet);
+        }
+
+        return instructionSets;
+    }
+
+    /* Random integers. Floats are integral so that sums are exact in any order */
+    static std::vector<long> randomInts(size_t size)
+    {
+        std::mt19937 generator(size);
+        std::uniform_int_distribution<long> distribution(-1000, 1000);
+
+        std::vector<long> values(size);
+        std::generate(values.begin(), values.end(), [&]()
+        { return distribution(generator); });
+
+        return values;
+    }
+
+    std::vector<AnyNode::Ptr> _asts;
+    Scope _scope;
+
+    ArrayKernels::InstructionSet _instructionSet;
+};
+
+
+TEST_F(ArrayKernelTestSuite, InstructionSetsMatchScalarResults)
+{
+    for (auto instructionSet : supportedInstructionSets())
+    {
+        ArrayKernels::setInstructionSet(instructionSet);
+
+        /* Sizes cover the remainders of each vector width */
+        for (size_t size : {1, 2, 3, 5, 8, 13, 31, 64, 1001})
+        {
+            SCOPED_TRACE("instruction set " + std::to_string((int)instructionSet) + ", size " + std::to_string(size));
+
+            auto ints = randomInts(size);
+            auto other = randomInts(size + 1);
+            std::vector<double> floats(ints.begin(), ints.end());
+
+            EXPECT_EQ(ArrayKernels::sum(ints.data(), size), std::accumulate(ints.begin(), ints.end(), 0L));
+            EXPECT_EQ(ArrayKernels::sum(floats.data(), size), std::accumulate(ints.begin(), ints.end(), 0L));
+            EXPECT_EQ(ArrayKernels::dot(ints.data(), other.data(), size), std::inner_product(ints.begin(), ints.end(), other.begin(), 0L));
+            EXPECT_EQ(ArrayKernels::min(ints.data(), size), *std::min_element(ints.begin(), ints.end()));
+            EXPECT_EQ(ArrayKernels::max(floats.data(), size), *std::max_element(floats.begin(), floats.end()));
+
+            std::vector<long> result(size);
+
+            ArrayKernels::add(ints.data(), other.data(), result.data(), size);
+            EXPECT_EQ(result.back(), ints.back() + other[size - 1]);
+
+            ArrayKernels::mul(ints.data(), other.data(), result.data(), size);
+            EXPECT_EQ(result.front(), ints.front() * other.front());
+
+            ArrayKernels::scale(floats.data(), 0.5, floats.data(), size); /* In place */
+            EXPECT_EQ(floats.back(), ints.back() * 0.5);
+
+            ArrayKernels::range(result.data(), -3, size);
+            EXPECT_EQ(result.back(), (long)size - 4);
+
+            ArrayKernels::fill(result.data(), 7L, size);
+            EXPECT_TRUE(std::all_of(result.begin(), result.end(), [](long value)
+                                    { return (value == 7); }));
+        }
+    }
+}
+
+
+TEST_F(ArrayKernelTestSuite, LargeArraysAreSplitIntoChunks)
+{
+    const size_t size = 4 * ArrayKernels::kParallelThreshold + 3;
+
+    EXPECT_EQ(ArrayKernels::numChunks(ArrayKernels::kParallelThreshold), 1u);
+    EXPECT_GT(ArrayKernels::numChunks(size), 1u);
+
+    std::vector<long> values(size);
+    ArrayKernels::range(values.data(), 0, size);
+
+    EXPECT_EQ(values[size / 2], (long)size / 2);
+    EXPECT_EQ(values.back(), (long)size - 1);
+
+    EXPECT_EQ(ArrayKernels::sum(values.data(), size), (long)(size * (size - 1) / 2));
+    EXPECT_EQ(ArrayKernels::max(values.data(), size), (long)size - 1);
+
+    /* Minimum in the last chunk */
+    values.back() = -1;
+    EXPECT_EQ(ArrayKernels::min(values.data(), size), -1);
+
+    std::vector<long> doubled(size);
+    ArrayKernels::add(values.data(), values.data(), doubled.data(), size);
+
+    EXPECT_EQ(doubled[size - 2], 2 * (long)(size - 2));
+}
+
+
+TEST_F(ArrayKernelTestSuite, ModuleFunctionsPromoteIntsToFloats)
+{
+    /* The range bound is folded */
+    evaluate("import <stdarray>\n"
+             "int[] values = range(1, 2 + 3);\n"
+             "float[] halves = scale(values, 0.5);\n"
+             "array tripled = scale(values, 3);\n"
+             "array sums = add(values, halves);\n"
+             "int total = sum(values);\n"
+             "float product = dot(values, halves);\n"
+             "float largest = max(halves);\n"
+             "fill(values, 2);\n");
+
+    EXPECT_EQ(object("tripled").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("tripled").arrayElement(3).asInt(), 12);
+
+    EXPECT_EQ(object("sums").elementType(), AnyObject::Float);
+    EXPECT_EQ(object("sums").arrayElement(1).asFloat(), 3.0);
+
+    EXPECT_EQ(object("total").getValue<long>(), 10);
+    EXPECT_EQ(object("product").getValue<double>(), 15.0);
+    EXPECT_EQ(object("largest").getValue<double>(), 2.0);
+
+    EXPECT_EQ(object("values").arrayElement(0).asInt(), 2);
+    EXPECT_EQ(object("halves").arrayElement(0).asFloat(), 0.5); /* Unchanged */
+}
+
+
+TEST_F(ArrayKernelTestSuite, ModuleFunctionsAcceptGenericNumericArrays)
+{
+    /* A generic array of ints (i.e. built by a module) */
+    AnyObject::Vector ints{ObjectFactory::allocate(3L), ObjectFactory::allocate(4L)};
+    _scope.linkObject("ints", ObjectFactory::allocate(std::move(ints)));
+
+    evaluate("import <stdarray>\n"
+             "array mixed = [1, 2.5];\n"
+             "array appended = [1, 2];\n"
+             "append(appended, 2.5);\n"
+             "float mixedSum = sum(mixed);\n"
+             "float largest = max([1.5, 2]);\n"
+             "float appendedSum = sum(appended);\n"
+             "int intSum = sum(ints);\n"
+             "float product = dot(mixed, [2, 2]);\n"
+             "array scaled = scale(ints, 2);\n");
+
+    EXPECT_EQ(object("mixed").elementType(), AnyObject::NotSet);
+    EXPECT_EQ(object("appended").elementType(), AnyObject::NotSet);
+    EXPECT_EQ(object("ints").elementType(), AnyObject::NotSet);
+
+    EXPECT_EQ(object("mixedSum").getValue<double>(), 3.5);
+    EXPECT_EQ(object("largest").getValue<double>(), 2.0);
+    EXPECT_EQ(object("appendedSum").getValue<double>(), 5.5);
+    EXPECT_EQ(object("product").getValue<double>(), 7.0);
+
+    /* A generic array of ints gives ints */
+    EXPECT_EQ(object("intSum").getValue<long>(), 7);
+    EXPECT_EQ(object("scaled").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("scaled").arrayElement(1).asInt(), 8);
+
+    EXPECT_ANY_THROW(evaluate("sum([1, \"a\"]);\n"));
+    EXPECT_ANY_THROW(evaluate("max([2.5, true]);\n"));
+}
+
+
+TEST_F(ArrayKernelTestSuite, ModuleFunctionsRejectInvalidArrays)
+{
+    evaluate("import <stdarray>\n"
+             "int[] values = range(3);\n"
+             "int[] empty;\n");
+
+    EXPECT_EQ(object("values").arraySize(), 3u);
+
+    EXPECT_ANY_THROW(evaluate("min(empty);\n"));
+    EXPECT_ANY_THROW(evaluate("add(values, range(4));\n"));
+    EXPECT_ANY_THROW(evaluate("fill(values, 1.5);\n"));
+    EXPECT_ANY_THROW(evaluate("sum([\"a\", \"b\"]);\n"));
+    EXPECT_ANY_THROW(evaluate("sum([true, false]);\n"));
+}
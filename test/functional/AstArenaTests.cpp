@@ -0,0 +1,78 @@
+/**
+ * @file AstArenaTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AstArena.hpp"
+#include "NodeFactory.hpp"
+#include "Scope.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+
+
+TEST(AstArenaTestSuite, AllocationsAreAligned)
+{
+    AstArena arena;
+
+    (void)arena.allocate(1, 1);
+    void *ptr = arena.allocate(sizeof(double), alignof(double));
+
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(ptr) % alignof(double), 0u);
+    EXPECT_TRUE(arena.contains(ptr));
+    EXPECT_GE(arena.bytesAllocated(), 1 + sizeof(double));
+}
+
+
+TEST(AstArenaTestSuite, LargeAllocationsGetOwnChunk)
+{
+    AstArena arena;
+
+    void *small = arena.allocate(8);
+    void *large = arena.allocate(4 * AstArena::kMaxChunkSize);
+
+    EXPECT_TRUE(arena.contains(small));
+    EXPECT_TRUE(arena.contains(large));
+    EXPECT_GE(arena.bytesReserved(), 4 * AstArena::kMaxChunkSize);
+}
+
+
+TEST(AstArenaTestSuite, NodesAreAllocatedInCurrentArena)
+{
+    auto arena = std::make_shared<AstArena>();
+    std::weak_ptr<AstArena> weakArena = arena;
+
+    AnyNode::Ptr node{nullptr};
+    {
+        AstArena::CurrentArena current(arena);
+
+        node = NodeFactory::createNotNode(NodeFactory::createBoolNode(false));
+
+        EXPECT_TRUE(AstArena::current()->contains(node.get()));
+    }
+
+    EXPECT_EQ(AstArena::current(), nullptr);
+
+    /* Nodes do not refer to their arena. The root owns it */
+    node = AstArena::adopt(std::move(node), std::move(arena));
+
+    Scope scope;
+    EXPECT_TRUE(node->evaluateValue(scope).asBool());
+
+    /* Arena is freed with the root */
+    EXPECT_FALSE(weakArena.expired());
+    node = nullptr;
+    EXPECT_TRUE(weakArena.expired());
+}
+
+
+TEST(AstArenaTestSuite, NodesAreAllocatedOnHeapWithoutArena)
+{
+    auto node = NodeFactory::createIntNode(3);
+
+    Scope scope;
+    EXPECT_EQ(node->evaluateValue(scope).asInt(), 3);
+}
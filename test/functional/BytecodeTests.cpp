@@ -0,0 +1,153 @@
+/**
+ * @file BytecodeTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "BytecodeCompiler.hpp"
+#include "EucleiaInterpreter.hpp"
+#include "FileParser.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <iostream>
+#include <sstream>
+
+
+std::string testDataPath(std::string fileName);
+
+
+static void compileAndRun(const std::string &fileName)
+{
+    auto path = testDataPath(fileName);
+
+    EXPECT_NE(BytecodeCompiler::compile(FileParser::parseMainFile(path)), nullptr);
+
+    Interpreter::evaluateFile(path, Interpreter::Engine::Bytecode);
+}
+
+
+/* Returns the output printed when evaluating the file */
+static std::string captureOutput(const std::string &fileName, Interpreter::Engine engine)
+{
+    std::ostringstream output;
+
+    auto *original = std::cout.rdbuf(output.rdbuf());
+
+    try
+    {
+        Interpreter::evaluateFile(testDataPath(fileName), engine);
+    }
+    catch (...)
+    {
+        std::cout.rdbuf(original);
+        throw;
+    }
+
+    std::cout.rdbuf(original);
+    return output.str();
+}
+
+
+/* Returns the message thrown when evaluating the file without the source location */
+static std::string captureError(const std::string &fileName, Interpreter::Engine engine)
+{
+    try
+    {
+        (void)captureOutput(fileName, engine);
+    }
+    catch (const std::exception &exception)
+    {
+        std::string message = exception.what();
+        return message.substr(message.find("(): ") + 4);
+    }
+
+    return "";
+}
+
+
+static void compareEngines(const std::string &fileName)
+{
+    EXPECT_EQ(captureOutput(fileName, Interpreter::Engine::TreeWalker),
+              captureOutput(fileName, Interpreter::Engine::Bytecode));
+}
+
+
+TEST(BytecodeTestSuite, BoolTests)
+{
+    compileAndRun("BoolTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, FunctionTests)
+{
+    compileAndRun("FunctionTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, IntTests)
+{
+    compileAndRun("IntTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, LoopTests)
+{
+    compileAndRun("LoopTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, MiscTests)
+{
+    compileAndRun("MiscTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, StringTests)
+{
+    compileAndRun("StringTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, UnsupportedFallsBack)
+{
+    auto path = testDataPath("ClassTests.ek");
+
+    EXPECT_EQ(BytecodeCompiler::compile(FileParser::parseMainFile(path)), nullptr);
+
+    Interpreter::evaluateFile(path, Interpreter::Engine::Bytecode);
+}
+
+
+TEST(BytecodeTestSuite, EnginesMatch)
+{
+    for (const char *fileName :
+         {"BoolTests.ek", "FunctionTests.ek", "IntTests.ek", "LoopTests.ek", "MiscTests.ek", "PureFunctionTests.ek", "StringTests.ek"})
+    {
+        SCOPED_TRACE(fileName);
+        compareEngines(fileName);
+    }
+}
+
+
+TEST(BytecodeTestSuite, ReferenceArgumentsAndCallerScopes)
+{
+    /* Functions assign their parameters and read names declared by their callers so the program is not compiled */
+    EXPECT_EQ(BytecodeCompiler::compile(FileParser::parseMainFile(testDataPath("EngineTests.ek"))), nullptr);
+
+    EXPECT_EQ(captureOutput("EngineTests.ek", Interpreter::Engine::Bytecode), "5\n6\n6\nab\n3\n6\n5\n10\n10\n285\n");
+    compareEngines("EngineTests.ek");
+}
+
+
+TEST(BytecodeTestSuite, ArgumentTypeError)
+{
+    EXPECT_NE(BytecodeCompiler::compile(FileParser::parseMainFile(testDataPath("ArgumentTypeError.ek"))), nullptr);
+
+    auto error = captureError("ArgumentTypeError.ek", Interpreter::Engine::TreeWalker);
+
+    EXPECT_EQ(error, "incorrect type for argument 'a' of function 'bad'. Expected type 'Int'.");
+    EXPECT_EQ(captureError("ArgumentTypeError.ek", Interpreter::Engine::Bytecode), error);
+}
@@ -0,0 +1,53 @@
+/**
+ * @file CallSiteCacheTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "InterpreterContext.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+TEST(CallSiteCacheTestSuite, GlobalFunctionsAreReused)
+{
+    auto ast = parseScript("func fib(int n) { if (n < 2) { return n; } return fib(n - 1) + fib(n - 2); }\n"
+                           "int a = fib(15);\n"
+                           "fib(10);\n");
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    EXPECT_EQ(scope.getNamedObject("a")->getValue<long>(), 610);
+
+    /* Calling the function again does not change any bindings */
+    auto generation = InterpreterContext::current().bindingGeneration();
+    auto result = ast->children().back()->evaluate(scope);
+
+    EXPECT_EQ(result->getValue<long>(), 55);
+    EXPECT_EQ(InterpreterContext::current().bindingGeneration(), generation);
+}
+
+
+TEST(CallSiteCacheTestSuite, ParametersShadowGlobalFunctions)
+{
+    auto ast = parseScript("func value() { return 1; }\n"
+                           "func read() { return value(); }\n"
+                           "func shadow(int value) { return read(); }\n"
+                           "int a = read();\n");
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    EXPECT_EQ(scope.getNamedObject("a")->getValue<long>(), 1);
+
+    /* read() now finds the parameter instead of the cached function */
+    auto call = parseScript("shadow(2);\n");
+    EXPECT_ANY_THROW(call->evaluate(scope));
+}
+
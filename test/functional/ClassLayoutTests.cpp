@@ -0,0 +1,109 @@
+/**
+ * @file ClassLayoutTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ClassNode.hpp"
+#include "Scope.hpp"
+#include "SymbolTable.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class ClassLayoutTestSuite : public ::testing::Test
+{
+protected:
+    void evaluate(const std::string &program) { _ast = evaluateScript(program, _scope); }
+
+    /* Evaluates in a new scope */
+    void expectThrows(const std::string &program)
+    {
+        auto ast = parseScript(program);
+
+        Scope scope;
+        EXPECT_ANY_THROW(ast->evaluate(scope)) << program;
+    }
+
+    const ClassNode &instance(const std::string &name) const
+    {
+        return static_cast<const ClassNode &>(*_scope.getNamedObject(name)->getValue<BaseNode::Ptr>());
+    }
+
+    static const AnyObject &member(const ClassNode &instance, const std::string &name)
+    {
+        return *instance.member(SymbolTable::instance().intern(name));
+    }
+
+    const ClassDefinitionNode &definition(const std::string &name) const
+    {
+        return static_cast<const ClassDefinitionNode &>(*_scope.getNamedObject(name)->getValue<BaseNode::Ptr>());
+    }
+
+    AnyNode::Ptr _ast;
+    Scope _scope;
+};
+
+
+TEST_F(ClassLayoutTestSuite, InheritedMembersAreFlattened)
+{
+    evaluate("class Base { int a; func get() { return a; } func name() { return 1; } };\n"
+             "class Derived : Base { float b; func name() { return 2; } };\n");
+
+    const auto &layout = definition("Derived").instanceLayout();
+
+    /* Fields (parent first) followed by methods. Overridden methods keep the parent's slot */
+    ASSERT_EQ(layout.size(), 4u);
+    EXPECT_EQ(layout.slotName(0), "a");
+    EXPECT_EQ(layout.slotName(1), "b");
+    EXPECT_EQ(layout.slotName(2), "get");
+    EXPECT_EQ(layout.slotName(3), "name");
+
+    EXPECT_EQ(definition("Derived").findSlot(SymbolTable::instance().intern("name")), 3);
+    EXPECT_EQ(definition("Derived").findSlot(SymbolTable::instance().intern("missing")), ScopeLayout::kNotFound);
+}
+
+
+TEST_F(ClassLayoutTestSuite, MethodsAreSharedByInstances)
+{
+    evaluate("class Base { int a; func get() { return a; } func name() { return 1; } };\n"
+             "class Derived : Base { float b; func name() { return 2; } };\n"
+             "Base first;\n"
+             "Base second;\n"
+             "Derived third;\n"
+             "first.a = 1;\n"
+             "second.a = 2;\n"
+             "third.a = 3;\n"
+             "third.b = 0.5;\n"
+             "int sum = first.get() + second.get() + third.get() + third.name();\n");
+
+    EXPECT_EQ(_scope.getNamedObject("sum")->getValue<long>(), 8);
+
+    /* Fields are separate objects. Methods are a single object per class */
+    EXPECT_NE(&member(instance("first"), "a"), &member(instance("second"), "a"));
+    EXPECT_EQ(&member(instance("first"), "get"), &member(instance("second"), "get"));
+
+    /* Inherited methods are shared with the parent unless overridden */
+    EXPECT_EQ(&member(instance("first"), "get"), &member(instance("third"), "get"));
+    EXPECT_NE(&member(instance("first"), "name"), &member(instance("third"), "name"));
+
+    EXPECT_EQ(member(instance("third"), "b").getValue<double>(), 0.5);
+    EXPECT_ANY_THROW((void)member(instance("third"), "c"));
+}
+
+
+TEST_F(ClassLayoutTestSuite, RejectsDuplicateMembers)
+{
+    expectThrows("class Base { int a; };\n"
+                 "class Derived : Base { int a; };\n");
+
+    expectThrows("class Clash { int a; func a() { return 1; } };\n");
+
+    expectThrows("class Point { int x; };\n"
+                 "Point p;\n"
+                 "p.z = 1;\n");
+}
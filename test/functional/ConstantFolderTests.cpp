@@ -0,0 +1,131 @@
+/**
+ * @file ConstantFolderTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ConstantFolder.hpp"
+#include "FileParser.hpp"
+#include "ImportGraph.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class ConstantFolderTestSuite : public ::testing::Test
+{
+protected:
+    /* Parses the program without folding */
+    AnyNode::Ptr parse(const std::string &program)
+    {
+        return ImportGraph(_scripts.write(program)).parse();
+    }
+
+    static Scope evaluate(const AnyNode::Ptr &ast)
+    {
+        Scope scope;
+        ast->evaluate(scope);
+        return scope;
+    }
+
+    /* Right-hand side of the statement (i.e. int a = 1 + 2) */
+    static const BaseNode &rhs(const AnyNode::Ptr &ast, size_t statement)
+    {
+        return *ast->child(statement)->castNode<AnyNode>().child(1);
+    }
+
+    TemporaryScripts _scripts{"ConstantFolderTests"};
+};
+
+
+TEST_F(ConstantFolderTestSuite, FoldsLiteralExpressions)
+{
+    auto ast = parse("int a = 3 * 5 + 2;\n"
+                     "float b = -(1.5 * 2.0);\n"
+                     "bool c = !(1 < 2);\n"
+                     "int d = int(2.5) + 1;\n"
+                     "string e = \"ab\" + \"cd\";\n");
+
+    EXPECT_EQ(ConstantFolder::fold(ast), 15u);
+
+    /* Reported when parsing the program */
+    FileParser::Statistics statistics;
+    (void)FileParser::parseMainFile(_scripts.path(), false, &statistics);
+    EXPECT_EQ(statistics.numFolded, 15u);
+
+    for (size_t i = 0; i < 5; ++i)
+    {
+        EXPECT_NE(rhs(ast, i).castNode<AnyNode>().valueType(), AnyObject::NotSet);
+    }
+
+    Scope scope = evaluate(ast);
+    EXPECT_EQ(scope.getNamedObject("a")->getValue<long>(), 17);
+    EXPECT_EQ(scope.getNamedObject("b")->getValue<double>(), -3.0);
+    EXPECT_EQ(scope.getNamedObject("c")->getValue<bool>(), false);
+    EXPECT_EQ(scope.getNamedObject("d")->getValue<long>(), 3);
+    EXPECT_EQ(scope.getNamedObject("e")->getValue<std::string>(), "abcd");
+}
+
+
+TEST_F(ConstantFolderTestSuite, PropagatesUnmodifiedVariables)
+{
+    auto ast = parse("int n = 10;\n"
+                     "int m = n * 2 - 1;\n"
+                     "func f(int x) { return x + m; }\n"
+                     "int r = f(m);\n");
+
+    EXPECT_EQ(ConstantFolder::fold(ast), 4u);
+    EXPECT_TRUE(rhs(ast, 1).isNodeType(NodeType::Int));
+
+    /* m is passed to a function so it is not propagated */
+    Scope scope = evaluate(ast);
+    EXPECT_EQ(scope.getNamedObject("m")->getValue<long>(), 19);
+    EXPECT_EQ(scope.getNamedObject("r")->getValue<long>(), 38);
+}
+
+
+TEST_F(ConstantFolderTestSuite, ModifiedVariablesAreNotPropagated)
+{
+    auto ast = parse("int a = 1;\n"
+                     "int b = 2;\n"
+                     "int c = 3;\n"
+                     "a = 4;\n"
+                     "++b;\n"
+                     "{ int &d = c; d = 5; }\n"
+                     "int e = a + b + c;\n");
+
+    EXPECT_EQ(ConstantFolder::fold(ast), 0u);
+
+    Scope scope = evaluate(ast);
+    EXPECT_EQ(scope.getNamedObject("e")->getValue<long>(), 12);
+}
+
+
+TEST_F(ConstantFolderTestSuite, FoldsIfWithLiteralCondition)
+{
+    auto ast = parse("int a = 0;\n"
+                     "if (1 < 2) { a = 1; } else { a = 2; }\n"
+                     "if (false) { a = 3; }\n"
+                     "while (false) { a = 4; }\n"
+                     "int b = a;\n");
+
+    EXPECT_GT(ConstantFolder::fold(ast), 0u);
+    EXPECT_EQ(ast->children().size(), 3u);
+    EXPECT_TRUE(ast->child(1)->isNodeType(NodeType::Block));
+
+    Scope scope = evaluate(ast);
+    EXPECT_EQ(scope.getNamedObject("b")->getValue<long>(), 1);
+}
+
+
+TEST_F(ConstantFolderTestSuite, DivisionByZeroIsNotFolded)
+{
+    auto ast = parse("int a = 1 / 0;\n");
+
+    EXPECT_EQ(ConstantFolder::fold(ast), 0u);
+    EXPECT_TRUE(rhs(ast, 0).isNodeType(NodeType::Binary));
+}
@@ -0,0 +1,77 @@
+/**
+ * @file CopyOnWriteTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AnyNode.hpp"
+#include "ObjectFactory.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+
+
+class CopyOnWriteTestSuite : public ::testing::Test
+{
+protected:
+    void evaluate(const std::string &program) { _ast = evaluateScript(program, _scope); }
+
+    const AnyObject &object(const std::string &name) { return *_scope.getNamedObject(name); }
+
+    AnyNode::Ptr _ast;
+    Scope _scope;
+};
+
+
+TEST_F(CopyOnWriteTestSuite, StringsShareBufferUntilModified)
+{
+    auto original = ObjectFactory::allocate(std::string("hello"));
+    auto copy = original->clone();
+
+    EXPECT_TRUE(copy->sharesBuffer(*original));
+
+    /* Read-only access does not detach */
+    EXPECT_EQ(std::as_const(*copy).getValue<std::string>(), "hello");
+    EXPECT_TRUE(copy->sharesBuffer(*original));
+
+    copy->getValue<std::string>() += " world";
+
+    EXPECT_FALSE(copy->sharesBuffer(*original));
+    EXPECT_EQ(original->getValue<std::string>(), "hello");
+    EXPECT_EQ(copy->getValue<std::string>(), "hello world");
+}
+
+
+TEST_F(CopyOnWriteTestSuite, ArrayElementsAreCopiedWhenDetached)
+{
+    auto original = ObjectFactory::allocate(AnyObject::Vector{ObjectFactory::allocate(1L), ObjectFactory::allocate(2L)});
+    auto copy = original->clone();
+
+    EXPECT_TRUE(copy->sharesBuffer(*original));
+
+    copy->getValue<AnyObject::Vector>()[0]->getValue<long>() = 100;
+
+    EXPECT_FALSE(copy->sharesBuffer(*original));
+    EXPECT_EQ(original->getValue<AnyObject::Vector>()[0]->getValue<long>(), 1);
+    EXPECT_EQ(copy->getValue<AnyObject::Vector>()[0]->getValue<long>(), 100);
+}
+
+
+TEST_F(CopyOnWriteTestSuite, ReadsBorrowArrayElements)
+{
+    evaluate("array a = [1, 2, 3];\n"
+             "array b = a;\n"
+             "int x = b[1] + a[2];\n"
+             "string s = \"hello\";\n"
+             "string t = s;\n");
+
+    EXPECT_EQ(object("x").getValue<long>(), 5);
+    EXPECT_TRUE(object("b").sharesBuffer(object("a")));
+    EXPECT_TRUE(object("t").sharesBuffer(object("s")));
+}
+
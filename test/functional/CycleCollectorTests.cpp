@@ -0,0 +1,174 @@
+/**
+ * @file CycleCollectorTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ClassNode.hpp"
+#include "InterpreterContext.hpp"
+#include "Scope.hpp"
+#include "SymbolTable.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+
+class CycleCollectorTestSuite : public ::testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        InterpreterContext::CurrentContext currentContext(_context);
+        _scope.reset();
+    }
+
+    static CycleCollector::Options makeOptions(size_t minThreshold, double growthFactor, bool isAutomatic = true)
+    {
+        CycleCollector::Options options;
+        options.minThreshold = minThreshold;
+        options.growthFactor = growthFactor;
+        options.isAutomatic = isAutomatic;
+        return options;
+    }
+
+    /* Evaluates in the test's context. Automatic collections are disabled unless options are given */
+    void evaluate(const std::string &program, const CycleCollector::Options &options = makeOptions(0, 1.0, false))
+    {
+        _ast = parseScript(program);
+
+        InterpreterContext::CurrentContext currentContext(_context);
+        _context.collector().setOptions(options);
+
+        _scope = std::make_unique<Scope>();
+        _ast->evaluate(*_scope);
+    }
+
+    /* Destroys the global scope */
+    void resetScope()
+    {
+        InterpreterContext::CurrentContext currentContext(_context);
+        _scope.reset();
+    }
+
+    /* NB: read-only access so that a shared array is not detached */
+    template <typename TValue>
+    const TValue &value(const std::string &name) const
+    {
+        const AnyObject &object = *_scope->getNamedObject(name);
+        return object.getValue<TValue>();
+    }
+
+    CycleCollector &collector() { return _context.collector(); }
+
+    AnyNode::Ptr _ast;
+    InterpreterContext _context;
+    std::unique_ptr<Scope> _scope;
+};
+
+
+/* Each iteration creates an instance whose field shares the buffer of an array containing the instance */
+static const std::string kCycles = "import <stdarray>\n"
+                                   "class Node { array items; int value; };\n"
+                                   "for (int i = 0; i < 1000; ++i) {\n"
+                                   "    array a;\n"
+                                   "    Node n;\n"
+                                   "    append(a, n);\n"
+                                   "    n.items = a;\n"
+                                   "}\n";
+
+
+TEST_F(CycleCollectorTestSuite, FreesUnreachableCycles)
+{
+    evaluate(kCycles);
+
+    /* The instance and its array field for each iteration. The local array is not part of the cycle */
+    ASSERT_EQ(collector().numTracked(), 2000u);
+
+    EXPECT_EQ(collector().collect(), 2000u);
+    EXPECT_EQ(collector().numTracked(), 0u);
+
+    EXPECT_EQ(collector().statistics().collections, 1u);
+    EXPECT_EQ(collector().statistics().objectsFreed, 2000u);
+    EXPECT_GT(collector().statistics().totalPause.count(), 0);
+
+    EXPECT_EQ(collector().collect(), 0u);
+}
+
+
+TEST_F(CycleCollectorTestSuite, KeepsReachableObjects)
+{
+    evaluate("import <stdarray>\n"
+             "class Node { array items; int value; func add(int k) { value = value + k; return value; } };\n"
+             "array nodes;\n"
+             "array values = [1, 2, 3];\n"
+             "Node last;\n"
+             "int total = 0;\n"
+             "for (int i = 0; i < 50; ++i) {\n"
+             "    Node n;\n"
+             "    n.value = i;\n"
+             "    array a;\n"
+             "    append(a, n);\n"
+             "    n.items = a;\n"
+             "    append(nodes, n);\n"
+             "    total = total + n.add(1);\n"
+             "}\n"
+             "last.items = nodes;\n");
+
+    /* Every cycle is reachable from the global scope */
+    EXPECT_EQ(collector().collect(), 0u);
+
+    EXPECT_EQ(value<long>("total"), 1275);
+    EXPECT_EQ(value<AnyObject::Vector>("nodes").size(), 50u);
+    EXPECT_EQ(value<AnyObject::IntVector>("values").size(), 3u);
+
+    const auto &last = static_cast<const ClassNode &>(*value<BaseNode::Ptr>("last"));
+    EXPECT_EQ(last.member(SymbolTable::instance().intern("items"))->arraySize(), 50u);
+
+    resetScope();
+
+    /* The global arrays and instance are freed normally. The cycles created by the loop are not */
+    EXPECT_EQ(collector().numTracked(), 50u * 2);
+    EXPECT_EQ(collector().collect(), 50u * 2);
+}
+
+
+TEST_F(CycleCollectorTestSuite, CollectsWhenThresholdIsReached)
+{
+    evaluate(kCycles, makeOptions(100, 2.0));
+
+    EXPECT_GE(collector().statistics().collections, 20u); /* At least one for every 100 objects in cycles */
+    EXPECT_LE(collector().numTracked(), 100u);
+    EXPECT_EQ(collector().threshold(), 100u);
+
+    EXPECT_GE(collector().statistics().maxPause, collector().statistics().lastPause);
+    EXPECT_GE(collector().statistics().totalPause, collector().statistics().maxPause);
+
+    EXPECT_ANY_THROW(collector().setOptions(makeOptions(100, 0.5)));
+}
+
+
+TEST_F(CycleCollectorTestSuite, CollectsOnEveryAllocation)
+{
+    /* Objects which are only referred to from the C++ stack or a function's scope are roots */
+    evaluate("import <stdarray>\n"
+             "class Counter { int n; array history; func add(int k) { n = n + k; append(history, n); return n; } };\n"
+             "func makeCycle(int k) { Counter c; int n = c.add(k); array a; append(a, c); c.history = a; return n; }\n"
+             "Counter counter;\n"
+             "int total = 0;\n"
+             "for (int i = 0; i < 20; ++i) { total = total + makeCycle(i) + counter.add(i); }\n"
+             "array copy = counter.history;\n",
+             makeOptions(1, 1.0));
+
+    EXPECT_EQ(value<long>("total"), 190 + 1330);
+    EXPECT_EQ(value<AnyObject::IntVector>("copy").back(), 190);
+    EXPECT_GE(collector().statistics().objectsFreed, 19u * 2); /* The last cycle is freed by the next collection */
+
+    resetScope();
+    (void)collector().collect();
+
+    EXPECT_EQ(collector().numTracked(), 0u);
+}
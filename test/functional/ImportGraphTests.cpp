@@ -0,0 +1,83 @@
+/**
+ * @file ImportGraphTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Exceptions.hpp"
+#include "FileParser.hpp"
+#include "ImportGraph.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class ImportGraphTestSuite : public ::testing::Test
+{
+protected:
+    long evaluate(const std::string &path, const std::string &variable)
+    {
+        auto ast = FileParser::parseMainFile(path);
+
+        Scope scope;
+        ast->evaluate(scope);
+
+        return scope.getNamedObject(variable)->getValue<long>();
+    }
+
+    TemporaryScripts _scripts{"ImportGraphTests"};
+};
+
+
+TEST_F(ImportGraphTestSuite, FilesAreImportedOnce)
+{
+    _scripts.write("int c = 2;\n", "c.ek");
+    _scripts.write("import \"c.ek\"\nfunc fa() { return c + 1; }\n", "a.ek");
+    _scripts.write("import \"c.ek\"\nfunc fb() { return c * 10; }\n", "b.ek");
+
+    auto main = _scripts.write("import \"a.ek\"\nimport \"b.ek\"\nimport \"a.ek\"\nint total = fa() + fb();\n",
+                               "main.ek");
+
+    EXPECT_EQ(evaluate(main, "total"), 23);
+
+    ImportGraph graph(main);
+    (void)graph.parse();
+    EXPECT_EQ(graph.numParses(), 4u); /* main, a, c, b */
+}
+
+
+TEST_F(ImportGraphTestSuite, ManyFilesAreStitchedInOrder)
+{
+    const int numFiles = 32;
+
+    std::string main = "int total = 0;\n";
+
+    for (int i = 0; i < numFiles; ++i)
+    {
+        /* Each file depends on the previous file's update to total */
+        const std::string name = "lib" + std::to_string(i) + ".ek";
+        _scripts.write("total = total * 2 + " + std::to_string(i % 2) + ";\n", name);
+
+        main += "import \"" + name + "\"\n";
+    }
+
+    long expected = 0;
+    for (int i = 0; i < numFiles; ++i)
+    {
+        expected = expected * 2 + (i % 2);
+    }
+
+    EXPECT_EQ(evaluate(_scripts.write(main, "main.ek"), "total"), expected);
+}
+
+
+TEST_F(ImportGraphTestSuite, MissingImportThrows)
+{
+    auto main = _scripts.write("import \"missing.ek\"\nint a = 1;\n", "main.ek");
+
+    EXPECT_THROW((void)FileParser::parseMainFile(main), GeneralException);
+}
@@ -0,0 +1,123 @@
+/**
+ * @file InterpreterContextTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FunctionNode.hpp"
+#include "InterpreterContext.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class InterpreterContextTestSuite : public ::testing::Test
+{
+protected:
+    /* Evaluates the AST in a new context and scope. Returns the value of the variable */
+    static long evaluate(const AnyNode::Ptr &ast, const std::string &name)
+    {
+        InterpreterContext context;
+        InterpreterContext::CurrentContext currentContext(context);
+
+        Scope scope;
+        ast->evaluate(scope);
+
+        return scope.getNamedObject(name)->getValue<long>();
+    }
+
+    static constexpr const char *kProgram =
+        "class Counter { func reset() { count = 0; } func increment(int n) { count = count + n; } int count; };\n"
+        "pure func fib(int n) { if (n < 2) { return n; } return fib(n - 1) + fib(n - 2); }\n"
+        "func loop(int n) { int total = 0; for (int i = 0; i < n; ++i) { if (i == 5 * 10) { break; } total = total + i; } return total; }\n"
+        "Counter counter;\n"
+        "counter.reset();\n"
+        "for (int i = 0; i < 10; ++i) { counter.increment(fib(i)); }\n"
+        "int result = counter.count + loop(100) + fib(20);\n";
+
+    static constexpr long kExpected = 88 + 1225 + 6765;
+};
+
+
+TEST_F(InterpreterContextTestSuite, ReevaluatesTheSameAst)
+{
+    auto ast = parseScript(kProgram);
+
+    /* Class definitions and instances are created for each evaluation so the AST is unchanged */
+    EXPECT_EQ(evaluate(ast, "result"), kExpected);
+    EXPECT_EQ(evaluate(ast, "result"), kExpected);
+}
+
+
+TEST_F(InterpreterContextTestSuite, EvaluatesTheSameAstConcurrently)
+{
+    auto ast = parseScript(kProgram);
+
+    const int numThreads = 4;
+    const int numRepeats = 20;
+
+    std::vector<long> results(numThreads * numRepeats, 0);
+    std::vector<std::thread> threads;
+
+    for (int iThread = 0; iThread < numThreads; ++iThread)
+    {
+        threads.emplace_back([&, iThread]()
+        {
+            for (int iRepeat = 0; iRepeat < numRepeats; ++iRepeat)
+            {
+                results[iThread * numRepeats + iRepeat] = evaluate(ast, "result");
+            }
+        });
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    for (long result : results)
+    {
+        EXPECT_EQ(result, kExpected);
+    }
+}
+
+
+TEST_F(InterpreterContextTestSuite, ContextsDoNotShareState)
+{
+    auto ast = parseScript("pure func square(int n) { return n * n; }\n"
+                           "int result = square(3) + square(3);\n");
+
+    InterpreterContext first, second;
+
+    Scope firstScope;
+    {
+        InterpreterContext::CurrentContext currentContext(first);
+        ast->evaluate(firstScope);
+    }
+
+    const auto &square = firstScope.getNamedObject("square")->getValue<BaseNode::Ptr>()->castNode<FunctionNode>();
+
+    EXPECT_EQ(first.memo(square.cacheSlot()).size(), 1u);
+    EXPECT_EQ(first.memo(square.cacheSlot()).statistics().hits, 1u);
+    EXPECT_EQ(second.memo(square.cacheSlot()).size(), 0u);
+
+    /* Each context has its own completion */
+    {
+        InterpreterContext::CurrentContext currentContext(second);
+        EXPECT_EQ(&InterpreterContext::current(), &second);
+
+        second.completion = Completion::Break;
+        EXPECT_TRUE(second.isInterrupted());
+        EXPECT_FALSE(first.isInterrupted());
+
+        second.completion = Completion::Normal;
+    }
+
+    EXPECT_NE(&InterpreterContext::current(), &second); /* Previous context restored */
+}
@@ -12,84 +12,140 @@
 #include "test/utility/Utility.hpp"
 #include <cstdlib>
 #include <gtest/gtest.h>
+#include <iostream>
+#include <string>
 
 
 std::string testDataPath(std::string fileName);
 
+/* Evaluates a data file. Fails if any of its TEST cases fail */
+static void evaluateTestFile(const std::string &fileName);
+
 
 TEST(InterpreterTestSuite, ArrayTests)
 {
-    Interpreter::evaluateFile(testDataPath("ArrayTests.ek"));
+    evaluateTestFile("ArrayTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, BoolTests)
 {
-    Interpreter::evaluateFile(testDataPath("BoolTests.ek"));
+    evaluateTestFile("BoolTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, ClassTests)
 {
-    Interpreter::evaluateFile(testDataPath("ClassTests.ek"));
+    evaluateTestFile("ClassTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, InheritanceTests)
 {
-    Interpreter::evaluateFile(testDataPath("InheritanceTests.ek"));
+    evaluateTestFile("InheritanceTests.ek");
+}
+
+
+TEST(InterpreterTestSuite, FunctionTests)
+{
+    evaluateTestFile("FunctionTests.ek");
+}
+
+
+TEST(InterpreterTestSuite, PureFunctionTests)
+{
+    evaluateTestFile("PureFunctionTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, IntTests)
 {
-    Interpreter::evaluateFile(testDataPath("IntTests.ek"));
+    evaluateTestFile("IntTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, LoopTests)
 {
-    Interpreter::evaluateFile(testDataPath("LoopTests.ek"));
+    evaluateTestFile("LoopTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, MiscTests)
 {
-    Interpreter::evaluateFile(testDataPath("MiscTests.ek"));
+    evaluateTestFile("MiscTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, ReferenceTests)
 {
-    Interpreter::evaluateFile(testDataPath("ReferenceTests.ek"));
+    evaluateTestFile("ReferenceTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, ScopeTests)
 {
-    Interpreter::evaluateFile(testDataPath("ScopeTests.ek"));
+    evaluateTestFile("ScopeTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, StringTests)
 {
-    Interpreter::evaluateFile(testDataPath("StringTests.ek"));
+    evaluateTestFile("StringTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, StructTests)
 {
-    Interpreter::evaluateFile(testDataPath("StructTests.ek"));
+    evaluateTestFile("StructTests.ek");
 }
 
 
 TEST(InterpreterTestSuite, CastTests)
 {
-    Interpreter::evaluateFile(testDataPath("CastTests.ek"));
+    evaluateTestFile("CastTests.ek");
+}
+
+
+TEST(InterpreterTestSuite, CallSiteCacheTests)
+{
+    evaluateTestFile("CallSiteCacheTests.ek");
+}
+
+
+TEST(InterpreterTestSuite, MethodCallTests)
+{
+    evaluateTestFile("MethodCallTests.ek");
+}
+
+
+TEST(InterpreterTestSuite, TailCallTests)
+{
+    evaluateTestFile("TailCallTests.ek");
 }
 
 
 std::string testDataPath(std::string fileName)
 {
     return getTestDirPath() + "functional/data/" + fileName;
+}
+
+
+static void evaluateTestFile(const std::string &fileName)
+{
+    testing::internal::CaptureStdout();
+
+    try
+    {
+        Interpreter::evaluateFile(testDataPath(fileName));
+    }
+    catch (...)
+    {
+        std::cout << testing::internal::GetCapturedStdout();
+        throw;
+    }
+
+    std::string output = testing::internal::GetCapturedStdout();
+    std::cout << output;
+
+    EXPECT_EQ(output.find("FAILED"), std::string::npos) << fileName;
 }
\ No newline at end of file
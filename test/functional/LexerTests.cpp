@@ -0,0 +1,185 @@
+/**
+ * @file LexerTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FileUtils.hpp"
+#include "Grammar.hpp"
+#include "SymbolTable.hpp"
+#include "Tokenizer.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class LexerTestSuite : public ::testing::Test
+{
+protected:
+    TemporaryScripts _scripts{"LexerTests"};
+};
+
+
+TEST_F(LexerTestSuite, KeywordsAndIdentifiersAreInterned)
+{
+    _scripts.write("int count = 1; while (count < 10) { count = count + 1; }");
+
+    Tokens tokens = Tokenizer::build(_scripts.path());
+
+    Token typeToken = tokens.dequeue();
+    EXPECT_EQ(typeToken.type(), Token::Keyword);
+    EXPECT_TRUE(typeToken.is(TokenKind::Int));
+    EXPECT_TRUE(Grammar::instance().isDataType(typeToken.symbol()));
+
+    Token nameToken = tokens.dequeue();
+    EXPECT_EQ(nameToken.type(), Token::Variable);
+    EXPECT_EQ(nameToken.kind(), TokenKind::Identifier);
+    EXPECT_EQ(nameToken, "count");
+    EXPECT_EQ(nameToken.symbol(), SymbolTable::instance().intern("count"));
+    EXPECT_EQ(SymbolTable::instance().name(nameToken.symbol()), "count");
+
+    while (!tokens.empty() && !tokens.front().is(TokenKind::While))
+    {
+        tokens.pop();
+    }
+
+    ASSERT_FALSE(tokens.empty());
+    EXPECT_EQ(tokens.front().type(), Token::Keyword);
+}
+
+
+TEST_F(LexerTestSuite, OperatorsAndPunctuationHaveKinds)
+{
+    _scripts.write("a <= b != -c && !d || e++; f[0] = {1, 2};");
+
+    const TokenKind expected[] = {TokenKind::Identifier, TokenKind::LessEqual, TokenKind::Identifier,
+                                  TokenKind::NotEqual, TokenKind::Minus, TokenKind::Identifier, TokenKind::And,
+                                  TokenKind::Not, TokenKind::Identifier, TokenKind::Or, TokenKind::Identifier,
+                                  TokenKind::Increment, TokenKind::Semicolon, TokenKind::Identifier,
+                                  TokenKind::LeftBracket, TokenKind::IntLiteral, TokenKind::RightBracket,
+                                  TokenKind::Assign, TokenKind::LeftBrace, TokenKind::IntLiteral, TokenKind::Comma,
+                                  TokenKind::IntLiteral, TokenKind::RightBrace, TokenKind::Semicolon};
+
+    Tokens tokens = Tokenizer::build(_scripts.path());
+
+    for (TokenKind kind : expected)
+    {
+        ASSERT_FALSE(tokens.empty());
+        EXPECT_EQ(tokens.dequeue().kind(), kind);
+    }
+
+    EXPECT_TRUE(tokens.empty());
+
+    EXPECT_GT(GrammarImpl::precedence(TokenKind::Star), GrammarImpl::precedence(TokenKind::Plus));
+    EXPECT_GT(GrammarImpl::precedence(TokenKind::And), GrammarImpl::precedence(TokenKind::Or));
+    EXPECT_EQ(GrammarImpl::precedence(TokenKind::Not), 0);
+}
+
+
+TEST_F(LexerTestSuite, UnknownOperatorsAreRejected)
+{
+    _scripts.write("a =* b;");
+
+    EXPECT_THROW((void)Tokenizer::build(_scripts.path()), GeneralException);
+}
+
+
+TEST_F(LexerTestSuite, LiteralsAreViewsOfSource)
+{
+    _scripts.write("\"hello world\" 12 3.5 true");
+
+    Tokens tokens = Tokenizer::build(_scripts.path());
+
+    Token stringToken = tokens.dequeue();
+    EXPECT_EQ(stringToken.type(), Token::String);
+    EXPECT_EQ(stringToken.view(), "hello world");
+
+    EXPECT_EQ(tokens.dequeue().toInt(), 12);
+    EXPECT_DOUBLE_EQ(tokens.dequeue().toFloat(), 3.5);
+    EXPECT_TRUE(tokens.dequeue().toBool());
+}
+
+
+TEST_F(LexerTestSuite, NumbersOutOfRangeAreRejected)
+{
+    _scripts.write("9223372036854775807 2.");
+
+    Tokens tokens = Tokenizer::build(_scripts.path());
+
+    EXPECT_EQ(tokens.dequeue().toInt(), 9223372036854775807L);
+    EXPECT_DOUBLE_EQ(tokens.dequeue().toFloat(), 2.0);
+
+    _scripts.write("print(99999999999999999999);");
+
+    try
+    {
+        (void)Tokenizer::build(_scripts.path());
+        FAIL() << "expected exception";
+    }
+    catch (const std::exception &error)
+    {
+        EXPECT_NE(std::string(error.what()).find("number out of range: 99999999999999999999"), std::string::npos)
+            << error.what();
+    }
+
+    _scripts.write("float f = 1" + std::string(400, '0') + ".5;");
+
+    EXPECT_THROW((void)Tokenizer::build(_scripts.path()), GeneralException);
+
+    /* Tokens which are not made by the Tokenizer are checked when converted */
+    EXPECT_THROW((void)Token("99999999999999999999", Token::Int, TokenKind::IntLiteral).toInt(), GeneralException);
+    EXPECT_THROW((void)Token("12ab", Token::Int, TokenKind::IntLiteral).toInt(), GeneralException);
+}
+
+
+TEST_F(LexerTestSuite, MappedFileIsNullTerminated)
+{
+    /* Worst case: mapped file ends on a page boundary */
+    const size_t pageSize = sysconf(_SC_PAGESIZE);
+    const size_t size = ((eucleia::MappedFile::kMinMappedSize + pageSize - 1) / pageSize) * pageSize;
+
+    for (size_t fileSize : {(size_t)1, size})
+    {
+        _scripts.write(std::string(fileSize, 'a'));
+
+        auto file = eucleia::MappedFile::open(_scripts.path());
+
+        ASSERT_EQ(file->size(), fileSize);
+
+        for (size_t i = 0; i < eucleia::MappedFile::kPadding; ++i)
+        {
+            EXPECT_EQ(file->data()[fileSize + i], '\0');
+        }
+    }
+}
+
+
+TEST_F(LexerTestSuite, CommentsAndWhiteSpaceAreSkipped)
+{
+    _scripts.write("#!/usr/bin/env eucleia\n// comment\n\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t  x // trailing\r\n\n\n y");
+
+    Tokens tokens = Tokenizer::build(_scripts.path());
+
+    EXPECT_EQ(tokens.dequeue(), "x");
+    EXPECT_EQ(tokens.dequeue(), "y");
+    EXPECT_TRUE(tokens.empty());
+}
+
+
+TEST_F(LexerTestSuite, LocationIsCalculatedForErrors)
+{
+    _scripts.write("int a;\n  a = @;");
+
+    try
+    {
+        (void)Tokenizer::build(_scripts.path());
+        FAIL() << "expected exception";
+    }
+    catch (const std::exception &error)
+    {
+        EXPECT_NE(std::string(error.what()).find(":2:7)"), std::string::npos) << error.what();
+    }
+}
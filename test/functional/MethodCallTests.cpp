@@ -0,0 +1,44 @@
+/**
+ * @file MethodCallTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class MethodCallTestSuite : public ::testing::Test
+{
+protected:
+    /* Evaluates in a new scope */
+    static void expectThrows(const std::string &program)
+    {
+        auto ast = parseScript(program);
+
+        Scope scope;
+        EXPECT_ANY_THROW(ast->evaluate(scope)) << program;
+    }
+};
+
+
+TEST_F(MethodCallTestSuite, RejectsInvalidCalls)
+{
+    expectThrows("class Point { int x; func get() { return x; } };\n"
+                 "Point p;\n"
+                 "p.missing();\n");
+
+    expectThrows("class Point { int x; };\n"
+                 "Point p;\n"
+                 "p.x();\n");
+
+    expectThrows("int p = 1;\n"
+                 "p.get();\n");
+
+    expectThrows("class Point { int this; };\n");
+}
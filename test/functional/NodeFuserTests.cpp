@@ -0,0 +1,93 @@
+/**
+ * @file NodeFuserTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Exceptions.hpp"
+#include "ImportGraph.hpp"
+#include "NodeFuser.hpp"
+#include "Scope.hpp"
+#include "VariableResolver.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class NodeFuserTestSuite : public ::testing::Test
+{
+protected:
+    /* Parses and resolves the program without fusing */
+    AnyNode::Ptr parse(const std::string &program)
+    {
+        auto ast = ImportGraph(_scripts.write(program)).parse();
+        VariableResolver::resolve(ast);
+        return ast;
+    }
+
+    TemporaryScripts _scripts{"NodeFuserTests"};
+};
+
+
+TEST_F(NodeFuserTestSuite, FusesCommonShapes)
+{
+    auto ast = parse("int total = 0;\n"
+                     "int matches = 0;\n"
+                     "for (int i = 0; i < 10; ++i)\n"         /* Condition, increment */
+                     "{\n"
+                     "    total = total + 3;\n"               /* In-place add */
+                     "    if (i == 4) { ++matches; }\n"       /* Condition, increment */
+                     "}\n"
+                     "int n = 5;\n"
+                     "while (n > 0) { n = n - 1; --total; }\n" /* Condition, in-place minus, decrement */
+                     "int m = n + 2;\n");                     /* Variable with constant */
+
+    /* The 6 binary nodes are also fused (variable with constant) */
+    EXPECT_EQ(NodeFuser::fuse(ast), 14u);
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    EXPECT_EQ(scope.getNamedObject("total")->getValue<long>(), 25);
+    EXPECT_EQ(scope.getNamedObject("matches")->getValue<long>(), 1);
+    EXPECT_EQ(scope.getNamedObject("n")->getValue<long>(), 0);
+    EXPECT_EQ(scope.getNamedObject("m")->getValue<long>(), 2);
+}
+
+
+TEST_F(NodeFuserTestSuite, OtherTypesAreNotFused)
+{
+    auto ast = parse("float x = 0.5;\n"
+                     "int count = 0;\n"
+                     "while (x < 3) { x = x + 1; ++count; }\n"  /* Float compared with Int and incremented by Int */
+                     "float y = 1.0;\n"
+                     "y = y * 2.5;\n"
+                     "++y;\n"
+                     "string s = \"a\";\n"
+                     "bool same = (s == \"a\");\n");
+
+    EXPECT_GT(NodeFuser::fuse(ast), 0u);
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    EXPECT_EQ(scope.getNamedObject("x")->getValue<double>(), 3.5);
+    EXPECT_EQ(scope.getNamedObject("count")->getValue<long>(), 3);
+    EXPECT_EQ(scope.getNamedObject("y")->getValue<double>(), 3.5);
+    EXPECT_EQ(scope.getNamedObject("same")->getValue<bool>(), true);
+}
+
+
+TEST_F(NodeFuserTestSuite, FusedIncrementThrowsForStrings)
+{
+    auto ast = parse("string s = \"a\";\n"
+                     "++s;\n");
+
+    EXPECT_EQ(NodeFuser::fuse(ast), 1u);
+
+    Scope scope;
+    EXPECT_THROW(ast->evaluate(scope), std::exception);
+}
@@ -0,0 +1,139 @@
+/**
+ * @file PackedArrayTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "AnyNode.hpp"
+#include "PoolAllocator.hpp"
+#include "Scope.hpp"
+#include "Value.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+
+class PackedArrayTestSuite : public ::testing::Test
+{
+protected:
+    void evaluate(const std::string &program)
+    {
+        /* Functions refer to nodes of earlier programs */
+        _asts.push_back(evaluateScript(program, _scope));
+    }
+
+    const AnyObject &object(const std::string &name) { return *_scope.getNamedObject(name); }
+
+    std::vector<AnyNode::Ptr> _asts;
+    Scope _scope;
+};
+
+
+TEST_F(PackedArrayTestSuite, LiteralsWithOneTypeArePacked)
+{
+    evaluate("array a = [1, 2, 3];\n"
+             "array b = [1.5, 2.5];\n"
+             "array c = [true, false, true];\n"
+             "array d = [1, 2.5];\n"
+             "array e = [\"x\", \"y\"];\n");
+
+    EXPECT_EQ(object("a").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("b").elementType(), AnyObject::Float);
+    EXPECT_EQ(object("c").elementType(), AnyObject::Bool);
+    EXPECT_EQ(object("d").elementType(), AnyObject::NotSet);
+    EXPECT_EQ(object("e").elementType(), AnyObject::NotSet);
+
+    EXPECT_EQ(object("a").arrayElement(2).asInt(), 3);
+    EXPECT_EQ(object("b").arrayElement(1).asFloat(), 2.5);
+    EXPECT_EQ(object("c").arrayElement(1).asBool(), false);
+    EXPECT_EQ(object("d").arrayElement(1).asFloat(), 2.5);
+}
+
+
+TEST_F(PackedArrayTestSuite, HeterogeneousInsertUnpacks)
+{
+    evaluate("import <stdarray>\n"
+             "array a = [1, 2];\n"
+             "array b = a;\n"
+             "append(a, 3);\n"
+             "int packed = 0;\n"
+             "if (length(a) == 3.0) { packed = 1; }\n"
+             "append(a, \"four\");\n"
+             "array c = a + b;\n");
+
+    EXPECT_EQ(object("packed").getValue<long>(), 1);
+
+    EXPECT_EQ(object("a").elementType(), AnyObject::NotSet);
+    EXPECT_EQ(object("a").arraySize(), 4u);
+    EXPECT_EQ(object("a").arrayElement(2).asInt(), 3);
+    EXPECT_EQ(object("a").arrayElement(3).object().getValue<std::string>(), "four");
+
+    EXPECT_EQ(object("b").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("b").arraySize(), 2u);
+
+    EXPECT_EQ(object("c").elementType(), AnyObject::NotSet);
+    EXPECT_EQ(object("c").arraySize(), 6u);
+}
+
+
+TEST_F(PackedArrayTestSuite, WritesAreTypeChecked)
+{
+    evaluate("array a = [1, 2, 3];\n"
+             "a[1] = 5;\n");
+
+    EXPECT_EQ(object("a").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("a").arrayElement(1).asInt(), 5);
+
+    EXPECT_ANY_THROW(evaluate("a[0] = 1.5;\n"));
+    EXPECT_ANY_THROW(evaluate("a[3] = 1;\n"));
+}
+
+
+TEST_F(PackedArrayTestSuite, DeclaredArraysKeepTheirType)
+{
+    evaluate("import <stdarray>\n"
+             "float[] samples;\n"
+             "for (int i = 0; i < 100; ++i) { append(samples, float(i) * 0.5); }\n"
+             "int[] values = [1, 2, 3];\n"
+             "bool[] flags;\n"
+             "func sumFirstThree(int[] xs) { int total = 0; for (int i = 0; i < 3; ++i) { total = total + xs[i]; } return total; }\n"
+             "int total = sumFirstThree(values);\n");
+
+    EXPECT_EQ(object("samples").elementType(), AnyObject::Float);
+    EXPECT_EQ(object("samples").arraySize(), 100u);
+    EXPECT_EQ(object("samples").arrayElement(99).asFloat(), 49.5);
+
+    EXPECT_EQ(object("flags").elementType(), AnyObject::Bool);
+    EXPECT_EQ(object("total").getValue<long>(), 6);
+
+    /* Inserting or assigning other types is an error rather than unpacking the array */
+    EXPECT_ANY_THROW(evaluate("append(values, 1.5);\n"));
+    EXPECT_ANY_THROW(evaluate("values = [1, 2.5];\n"));
+    EXPECT_ANY_THROW(evaluate("sumFirstThree([\"a\", \"b\", \"c\"]);\n"));
+    EXPECT_ANY_THROW(evaluate("string[] names;\n"));
+
+    evaluate("clear(values);\n"
+             "values = [4, 5];\n");
+
+    EXPECT_EQ(object("values").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("values").arraySize(), 2u);
+}
+
+
+TEST_F(PackedArrayTestSuite, ElementsAreNotAllocated)
+{
+    evaluate("import <stdarray>\n"
+             "array values = [0];\n");
+
+    auto allocations = PoolAllocator::statistics().allocations;
+
+    evaluate("for (int i = 1; i < 10000; ++i) { append(values, i); }\n");
+
+    EXPECT_EQ(object("values").elementType(), AnyObject::Int);
+    EXPECT_EQ(object("values").arraySize(), 10000u);
+    EXPECT_LT(PoolAllocator::statistics().allocations - allocations, 1000u);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file PoolAllocatorTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ObjectFactory.hpp"
+#include "PoolAllocator.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+
+TEST(PoolAllocatorTestSuite, ChunksAreAlignedAndReused)
+{
+    void *first = PoolAllocator::allocate(24);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(first) % alignof(std::max_align_t), 0u);
+
+    PoolAllocator::deallocate(first, 24);
+
+    void *second = PoolAllocator::allocate(32); /* Same size class */
+    EXPECT_EQ(first, second);
+
+    PoolAllocator::deallocate(second, 32);
+}
+
+
+TEST(PoolAllocatorTestSuite, LargeAllocationsBypassPool)
+{
+    auto before = PoolAllocator::statistics();
+
+    void *ptr = PoolAllocator::allocate(PoolAllocator::kMaxChunkSize + 1);
+    PoolAllocator::deallocate(ptr, PoolAllocator::kMaxChunkSize + 1);
+
+    auto after = PoolAllocator::statistics();
+    EXPECT_EQ(after.largeAllocations, before.largeAllocations + 1);
+    EXPECT_EQ(after.allocations, before.allocations);
+}
+
+
+TEST(PoolAllocatorTestSuite, EmptyBlocksAreReleased)
+{
+    PoolAllocator::flushThreadCache();
+
+    const size_t size = PoolAllocator::kMaxChunkSize;
+    const size_t numChunks = 4 * (PoolAllocator::kBlockSize / size);
+
+    auto before = PoolAllocator::statistics();
+
+    std::vector<void *> chunks;
+    for (size_t i = 0; i < numChunks; ++i)
+    {
+        chunks.push_back(PoolAllocator::allocate(size));
+    }
+
+    auto peak = PoolAllocator::statistics();
+    EXPECT_GE(peak.blocksInUse, before.blocksInUse + 4);
+    EXPECT_EQ(peak.allocations, before.allocations + numChunks);
+
+    for (void *chunk : chunks)
+    {
+        PoolAllocator::deallocate(chunk, size);
+    }
+
+    PoolAllocator::flushThreadCache();
+
+    auto after = PoolAllocator::statistics();
+    EXPECT_EQ(after.deallocations, before.deallocations + numChunks);
+    EXPECT_GE(after.blocksReleased, before.blocksReleased + 3);
+    EXPECT_LE(after.blocksInUse, before.blocksInUse + 1);
+}
+
+
+TEST(PoolAllocatorTestSuite, ObjectsFreedOnOtherThreads)
+{
+    std::vector<AnyObject::Ptr> objects;
+
+    std::thread([&objects]()
+    {
+        for (long i = 0; i < 1000; ++i)
+        {
+            objects.push_back(ObjectFactory::allocate(i));
+        }
+    }).join();
+
+    for (long i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(objects[i]->getValue<long>(), i);
+    }
+
+    objects.clear();
+}
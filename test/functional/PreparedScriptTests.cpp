@@ -0,0 +1,146 @@
+/**
+ * @file PreparedScriptTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "EucleiaInterpreter.hpp"
+#include "ObjectFactory.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+class PreparedScriptTestSuite : public ::testing::Test
+{
+protected:
+    static long intValue(const PreparedScript &script, const std::string &name)
+    {
+        return script.globals().getNamedObject(name)->getValue<long>();
+    }
+
+    TemporaryScripts _scripts{"PreparedScriptTests"};
+};
+
+
+TEST_F(PreparedScriptTestSuite, RunsWithDifferentBindings)
+{
+    auto path = _scripts.write("int doubled = 2 * input;\n"
+                               "int total = doubled + offset;\n",
+                               "Rule.ek");
+
+    auto script = Interpreter::compile(path);
+
+    script.run({{"input", ObjectFactory::allocate(3L)}, {"offset", ObjectFactory::allocate(1L)}});
+    EXPECT_EQ(intValue(script, "total"), 7);
+
+    /* Each run has a new global scope so variables can be declared again */
+    script.run({{"input", ObjectFactory::allocate(10L)}, {"offset", ObjectFactory::allocate(-5L)}});
+    EXPECT_EQ(intValue(script, "total"), 15);
+
+    EXPECT_ANY_THROW(script.run()); /* Unbound input */
+    EXPECT_ANY_THROW((void)script.globals());
+
+    EXPECT_ANY_THROW(script.run({{"input", ObjectFactory::allocate(1L)},
+                                 {"offset", ObjectFactory::allocate(1L)},
+                                 {"total", ObjectFactory::allocate(1L)}})); /* Declared by the script */
+}
+
+
+TEST_F(PreparedScriptTestSuite, CallsScriptFunctions)
+{
+    auto path = _scripts.write("func clamp(int value, int limit) { if (value > limit) { return limit; } return value; }\n"
+                               "pure func square(int n) { return n * n; }\n"
+                               "func sumTo(int n, int total) { if (n == 0) { return total; } return sumTo(n - 1, total + n); }\n",
+                               "Functions.ek");
+
+    auto script = Interpreter::compile(path);
+
+    /* The script is run on the first call */
+    EXPECT_EQ(script.call("clamp", {ObjectFactory::allocate(12L), ObjectFactory::allocate(10L)})->getValue<long>(), 10);
+    EXPECT_EQ(script.call("clamp", {ObjectFactory::allocate(7L), ObjectFactory::allocate(10L)})->getValue<long>(), 7);
+
+    EXPECT_EQ(script.call("square", {ObjectFactory::allocate(9L)})->getValue<long>(), 81);
+    EXPECT_EQ(script.call("square", {ObjectFactory::allocate(9L)})->getValue<long>(), 81); /* Memoized */
+
+    EXPECT_EQ(script.call("sumTo", {ObjectFactory::allocate(1000L), ObjectFactory::allocate(0L)})->getValue<long>(), 500500);
+
+    EXPECT_ANY_THROW(script.call("clamp", {ObjectFactory::allocate(1L)}));
+    EXPECT_ANY_THROW(script.call("square", {ObjectFactory::allocate(1.5)}));
+    EXPECT_ANY_THROW(script.call("missing"));
+}
+
+
+TEST_F(PreparedScriptTestSuite, ImportsAreEvaluatedOnce)
+{
+    _scripts.write("int numImports = 0;\n"
+                   "numImports = numImports + 1;\n"
+                   "func triple(int n) { return 3 * n; }\n",
+                   "Library.ek");
+
+    auto path = _scripts.write("import \"Library.ek\"\n"
+                               "import <stdarray>\n"
+                               "int result = triple(sum(values));\n",
+                               "Main.ek");
+
+    auto script = Interpreter::compile(path);
+
+    for (long iRun = 1; iRun <= 3; ++iRun)
+    {
+        script.run({{"values", ObjectFactory::allocate(AnyObject::IntVector{iRun, iRun})}});
+
+        EXPECT_EQ(intValue(script, "result"), 6 * iRun);
+        EXPECT_EQ(intValue(script, "numImports"), 1);
+    }
+
+    EXPECT_EQ(script.call("triple", {ObjectFactory::allocate(5L)})->getValue<long>(), 15);
+}
+
+
+TEST_F(PreparedScriptTestSuite, BoundObjectsAreSharedByThreads)
+{
+    auto path = _scripts.write("string greeting = name + \"!\";\n"
+                               "int total = 0;\n"
+                               "for (int i = 0; i < 100; ++i) { if (name == \"world\") { total = total + 1; } }\n",
+                               "Greeting.ek");
+
+    auto name = ObjectFactory::allocate(std::string("world"));
+    {
+        std::vector<PreparedScript> scripts;
+        scripts.push_back(Interpreter::compile(path));
+        scripts.push_back(Interpreter::compile(path));
+
+        /* Both threads pin and unpin the bound string */
+        std::vector<std::thread> threads;
+
+        for (auto &script : scripts)
+        {
+            threads.emplace_back([&script, &name]()
+            {
+                for (int iRun = 0; iRun < 200; ++iRun)
+                {
+                    script.run({{"name", name}});
+                }
+            });
+        }
+
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        for (const auto &script : scripts)
+        {
+            EXPECT_EQ(script.globals().getNamedObject("greeting")->getValue<std::string>(), "world!");
+            EXPECT_EQ(intValue(script, "total"), 100);
+        }
+    }
+
+    EXPECT_EQ(name.use_count(), 1); /* No pins left */
+}
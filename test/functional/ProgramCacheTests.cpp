@@ -0,0 +1,122 @@
+/**
+ * @file ProgramCacheTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "EucleiaInterpreter.hpp"
+#include "FileParser.hpp"
+#include "ProgramCache.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <string>
+
+
+std::string testDataPath(std::string fileName);
+
+
+class ProgramCacheTestSuite : public ::testing::Test
+{
+protected:
+    /* Returns the output of the program */
+    std::string run(const std::string &path, bool useCache)
+    {
+        testing::internal::CaptureStdout();
+        Interpreter::evaluateFile(path, Interpreter::Engine::TreeWalker, useCache);
+        return testing::internal::GetCapturedStdout();
+    }
+
+    long evaluate(const std::string &path, const std::string &variable)
+    {
+        auto ast = FileParser::parseMainFile(path, true);
+
+        Scope scope;
+        ast->evaluate(scope);
+
+        return scope.getNamedObject(variable)->getValue<long>();
+    }
+
+    TemporaryScripts _scripts{"ProgramCacheTests"};
+};
+
+
+TEST_F(ProgramCacheTestSuite, CachedProgramsMatch)
+{
+    for (const char *fileName : {"ArrayTests.ek", "ClassTests.ek", "FunctionTests.ek", "InheritanceTests.ek",
+                                 "LoopTests.ek", "MiscTests.ek", "ReferenceTests.ek", "StringTests.ek", "StructTests.ek"})
+    {
+        auto path = _scripts.path(fileName);
+        std::filesystem::copy_file(testDataPath(fileName), path);
+
+        const std::string expected = run(path, false);
+
+        EXPECT_EQ(run(path, true), expected) << fileName; /* Parsed and stored */
+        ASSERT_TRUE(std::filesystem::exists(ProgramCache::cachePath(path))) << fileName;
+
+        EXPECT_NE(ProgramCache::load(path), nullptr) << fileName;
+        EXPECT_EQ(run(path, true), expected) << fileName; /* Loaded */
+    }
+}
+
+
+TEST_F(ProgramCacheTestSuite, ChangedImportInvalidatesCache)
+{
+    _scripts.write("int b = 2;\n", "lib.ek");
+    auto main = _scripts.write("import \"lib.ek\"\nint a = b * 10;\n", "main.ek");
+
+    EXPECT_EQ(evaluate(main, "a"), 20);
+    EXPECT_NE(ProgramCache::load(main), nullptr);
+
+    _scripts.write("int b = 3;\n", "lib.ek");
+    EXPECT_EQ(ProgramCache::load(main), nullptr);
+
+    EXPECT_EQ(evaluate(main, "a"), 30);
+    EXPECT_NE(ProgramCache::load(main), nullptr);
+}
+
+
+TEST_F(ProgramCacheTestSuite, RelocatedProgramUsesCache)
+{
+    _scripts.write("int b = 2;\n", "lib.ek");
+    auto main = _scripts.write("import \"lib.ek\"\nint a = b + 1;\n", "main.ek");
+
+    EXPECT_EQ(evaluate(main, "a"), 3);
+
+    auto movedDir = _scripts.directory() / "moved";
+    std::filesystem::create_directories(movedDir);
+
+    for (const char *fileName : {"lib.ek", "main.ek", "main.ekc"})
+    {
+        std::filesystem::rename(_scripts.directory() / fileName, movedDir / fileName);
+    }
+
+    auto movedMain = (movedDir / "main.ek").string();
+
+    EXPECT_NE(ProgramCache::load(movedMain), nullptr);
+    EXPECT_EQ(evaluate(movedMain, "a"), 3);
+}
+
+
+TEST_F(ProgramCacheTestSuite, CorruptedCacheIsIgnored)
+{
+    auto main = _scripts.write("int a = 1;\nfloat b = 2.5;\nstring c = \"hello\";\n", "main.ek");
+
+    EXPECT_EQ(evaluate(main, "a"), 1);
+
+    const std::string cachePath = ProgramCache::cachePath(main);
+    {
+        std::fstream cache(cachePath, std::ios::binary | std::ios::in | std::ios::out);
+        cache.seekp(-1, std::ios::end);
+        cache.put('!');
+    }
+
+    EXPECT_EQ(ProgramCache::load(main), nullptr);
+    EXPECT_EQ(evaluate(main, "a"), 1); /* Parsed and replaced */
+    EXPECT_NE(ProgramCache::load(main), nullptr);
+}
@@ -0,0 +1,147 @@
+/**
+ * @file PureFunctionTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "FunctionMemo.hpp"
+#include "FunctionNode.hpp"
+#include "InterpreterContext.hpp"
+#include "ObjectFactory.hpp"
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+class PureFunctionTestSuite : public ::testing::Test
+{
+protected:
+    void evaluate(const std::string &program) { _ast = evaluateScript(program, _scope); }
+
+    static FunctionNode &function(const Scope &scope, const std::string &name)
+    {
+        return scope.getNamedObject(name)->getValue<BaseNode::Ptr>()->castNode<FunctionNode>();
+    }
+
+    /* Results stored for a pure function by the current context */
+    static const FunctionMemo &memo(const Scope &scope, const std::string &name)
+    {
+        return InterpreterContext::current().memo(function(scope, name).cacheSlot());
+    }
+
+    AnyNode::Ptr _ast;
+    Scope _scope;
+};
+
+
+TEST_F(PureFunctionTestSuite, MemoizesPureFunctions)
+{
+    evaluate("pure func fib(int n) { if (n < 2) { return n; } return fib(n - 1) + fib(n - 2); }\n"
+             "int a = fib(30);\n"
+             "int b = fib(30);\n");
+
+    EXPECT_EQ(_scope.getNamedObject("a")->getValue<long>(), 832040);
+    EXPECT_EQ(_scope.getNamedObject("b")->getValue<long>(), 832040);
+
+    /* fib(0) to fib(30) are each evaluated once. fib(n - 2) is reused for n > 2 and by the second call */
+    const auto &fibMemo = memo(_scope, "fib");
+    EXPECT_EQ(fibMemo.size(), 31u);
+    EXPECT_EQ(fibMemo.statistics().misses, 31u);
+    EXPECT_EQ(fibMemo.statistics().hits, 29u);
+}
+
+
+TEST_F(PureFunctionTestSuite, ResultsAreCopied)
+{
+    evaluate("pure func one() { return 1; }\n"
+             "int a = one();\n"
+             "++a;\n"
+             "int b = one();\n");
+
+    EXPECT_EQ(_scope.getNamedObject("a")->getValue<long>(), 2);
+    EXPECT_EQ(_scope.getNamedObject("b")->getValue<long>(), 1);
+}
+
+
+TEST_F(PureFunctionTestSuite, ArraysAreNotCached)
+{
+    evaluate("pure func first(array values) { return values[0]; }\n"
+             "int a = first([1, 2]);\n"
+             "int b = first([3, 4]);\n");
+
+    EXPECT_EQ(_scope.getNamedObject("a")->getValue<long>(), 1);
+    EXPECT_EQ(_scope.getNamedObject("b")->getValue<long>(), 3);
+    EXPECT_EQ(memo(_scope, "first").size(), 0u);
+}
+
+
+TEST_F(PureFunctionTestSuite, RejectsImpureFunctions)
+{
+    EXPECT_ANY_THROW(parseScript("int total = 0;\n"
+                                 "total = 5;\n"
+                                 "pure func add(int n) { return total + n; }\n"));
+
+    EXPECT_ANY_THROW(parseScript("import <io>\n"
+                                 "pure func show(int n) { print(n); return n; }\n"));
+
+    EXPECT_ANY_THROW(parseScript("func helper(int n) { return n; }\n"
+                                 "pure func twice(int n) { return helper(n) * 2; }\n"));
+
+    EXPECT_NO_THROW(parseScript("import <math>\n"
+                                "pure func helper(int n) { return n; }\n"
+                                "pure func root(float x) { float y = sqrt(x); return y + helper(1); }\n"));
+}
+
+
+TEST_F(PureFunctionTestSuite, RejectsModifiedArguments)
+{
+    /* Arguments refer to the caller's variables. A memoized call would not modify them */
+    EXPECT_ANY_THROW(parseScript("pure func p(int x) { x = x + 1; return x; }\n"
+                                 "int v = 1;\n"
+                                 "int w = 1;\n"
+                                 "p(v);\n"
+                                 "p(w);\n"));
+
+    EXPECT_ANY_THROW(parseScript("pure func next(int x) { ++x; return x; }\n"));
+    EXPECT_ANY_THROW(parseScript("pure func previous(float x) { if (x > 0.0) { --x; } return x; }\n"));
+    EXPECT_ANY_THROW(parseScript("pure func bind(int x) { int &y = x; y = 2; return y; }\n"));
+
+    /* Locals may be modified, including those which shadow an argument */
+    EXPECT_NO_THROW(parseScript("pure func count(int n) { int total = 0; for (int i = 0; i < n; ++i) { total = total + i; } "
+                                "return total; }\n"
+                                "pure func shadow(int x) { { int x = 1; x = 2; } return x; }\n"));
+}
+
+
+TEST(FunctionMemoTests, IsBounded)
+{
+    auto makeKey = [](long i)
+    {
+        std::string key;
+        EXPECT_TRUE(FunctionMemo::appendKey(key, *ObjectFactory::allocate(i)));
+        return key;
+    };
+
+    FunctionMemo memo(2);
+
+    memo.insert(makeKey(0), ObjectFactory::allocate(0L));
+    memo.insert(makeKey(1), ObjectFactory::allocate(1L));
+
+    /* The least recently used entry is evicted */
+    AnyObject::Ptr result;
+    EXPECT_TRUE(memo.find(makeKey(0), result));
+
+    memo.insert(makeKey(2), ObjectFactory::allocate(4L));
+
+    EXPECT_EQ(memo.size(), 2u);
+    EXPECT_EQ(memo.statistics().evictions, 1u);
+
+    EXPECT_TRUE(memo.find(makeKey(0), result));
+    EXPECT_EQ(result->getValue<long>(), 0);
+    EXPECT_TRUE(memo.find(makeKey(2), result));
+    EXPECT_FALSE(memo.find(makeKey(1), result));
+}
@@ -0,0 +1,80 @@
+/**
+ * @file StringPoolTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "NodeFactory.hpp"
+#include "PoolAllocator.hpp"
+#include "Scope.hpp"
+#include "StringPool.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+
+TEST(StringPoolTestSuite, EqualLiteralsShareObject)
+{
+    Scope scope;
+
+    auto first = NodeFactory::createStringNode("shared");
+    auto second = NodeFactory::createStringNode("shared");
+
+    Value firstValue = first->evaluateValue(scope);
+    Value secondValue = second->evaluateValue(scope);
+
+    EXPECT_EQ(&firstValue.object(), &secondValue.object());
+    EXPECT_EQ(&firstValue.object(), StringPool::instance().intern("shared").get());
+    EXPECT_EQ(firstValue.object().getValue<std::string>(), "shared");
+
+    /* Returns a copy which can be modified */
+    auto copy = first->evaluate(scope);
+    EXPECT_NE(copy.get(), &firstValue.object());
+    EXPECT_EQ(copy->getValue<std::string>(), "shared");
+}
+
+
+TEST(StringPoolTestSuite, LiteralsAreNotModified)
+{
+    auto ast = parseScript("string a = \"literal\";\n"
+                           "a = \"changed\";\n"
+                           "func f(string s) { s = \"changed\"; }\n"
+                           "f(\"literal\");\n"
+                           "array b = [\"literal\"];\n"
+                           "b[0] = \"changed\";\n"
+                           "bool c = (\"literal\" == \"literal\");\n"
+                           "string d = \"literal\";\n");
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    EXPECT_EQ(scope.getNamedObject("a")->getValue<std::string>(), "changed");
+    EXPECT_EQ(scope.getNamedObject("c")->getValue<bool>(), true);
+    EXPECT_EQ(scope.getNamedObject("d")->getValue<std::string>(), "literal");
+    EXPECT_EQ(StringPool::instance().intern("literal")->getValue<std::string>(), "literal");
+}
+
+
+TEST(StringPoolTestSuite, PrintDoesNotAllocate)
+{
+    auto ast = parseScript("import <io>\n"
+                           "for (int i = 0; i < 1000; ++i) { print(\"iteration\", i); }\n");
+
+    testing::internal::CaptureStdout();
+
+    auto before = PoolAllocator::statistics();
+
+    Scope scope;
+    ast->evaluate(scope);
+
+    auto after = PoolAllocator::statistics();
+
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_NE(output.find("iteration 999\n"), std::string::npos);
+
+    /* Previously at least one string was allocated for each iteration */
+    EXPECT_LT(after.allocations - before.allocations, 100u);
+}
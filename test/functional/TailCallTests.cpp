@@ -0,0 +1,22 @@
+/**
+ * @file TailCallTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "Scope.hpp"
+#include "test/utility/Utility.hpp"
+#include <gtest/gtest.h>
+
+
+TEST(TailCallTestSuite, ArgumentTypesAreChecked)
+{
+    auto ast = parseScript("func g(int n) { if (n == 0) { return 0; } return g(1.5); }\n"
+                           "g(2);\n");
+
+    Scope scope;
+    EXPECT_ANY_THROW(ast->evaluate(scope));
+}
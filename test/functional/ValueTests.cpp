@@ -0,0 +1,88 @@
+/**
+ * @file ValueTests.cpp
+ * @author Edward Palmer
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include "ObjectFactory.hpp"
+#include "Value.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+
+TEST(ValueTestSuite, Immediates)
+{
+    EXPECT_TRUE(Value().isNone());
+    EXPECT_EQ(Value().type(), AnyObject::NotSet);
+
+    EXPECT_TRUE(Value(true).isBool());
+    EXPECT_TRUE(Value(true).asBool());
+    EXPECT_FALSE(Value(false).asBool());
+
+    EXPECT_TRUE(Value(-42L).isSmallInt());
+    EXPECT_EQ(Value(-42L).asInt(), -42);
+
+    EXPECT_TRUE(Value(2.5).isFloat());
+    EXPECT_EQ(Value(2.5).asFloat(), 2.5);
+    EXPECT_EQ(Value(-std::numeric_limits<double>::infinity()).type(), AnyObject::Float);
+}
+
+
+TEST(ValueTestSuite, NaNIsCanonicalized)
+{
+    Value value(-std::numeric_limits<double>::quiet_NaN());
+
+    EXPECT_TRUE(value.isFloat());
+    EXPECT_TRUE(std::isnan(value.asFloat()));
+}
+
+
+TEST(ValueTestSuite, LargeIntsAreBoxed)
+{
+    const long large = std::numeric_limits<long>::max();
+
+    Value value(large);
+
+    EXPECT_FALSE(value.isSmallInt());
+    EXPECT_TRUE(value.isInt());
+    EXPECT_EQ(value.asInt(), large);
+    EXPECT_EQ(ObjectFactory::box(value)->getValue<long>(), large);
+}
+
+
+TEST(ValueTestSuite, HeapObjectsArePinned)
+{
+    Value value;
+
+    std::weak_ptr<AnyObject> weak;
+    {
+        auto object = ObjectFactory::allocate(std::string("hello"));
+        weak = object;
+        value = Value(object);
+    }
+
+    ASSERT_FALSE(weak.expired());
+    EXPECT_EQ(value.object().getValue<std::string>(), "hello");
+
+    Value copy = value;
+    value = Value();
+    EXPECT_FALSE(weak.expired());
+
+    copy = Value();
+    EXPECT_TRUE(weak.expired());
+}
+
+
+TEST(ValueTestSuite, AssignToObject)
+{
+    auto object = ObjectFactory::allocate(1L);
+
+    object->assign(Value(5L));
+    EXPECT_EQ(object->getValue<long>(), 5);
+
+    EXPECT_ANY_THROW(object->assign(Value(1.0)));
+}
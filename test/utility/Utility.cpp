@@ -8,7 +8,11 @@
  */
 
 #include "Utility.hpp"
+#include "FileParser.hpp"
+#include "Scope.hpp"
 #include <cstdlib>
+#include <fstream>
+#include <unistd.h>
 
 std::string getTestDirPath()
 {
@@ -16,3 +20,50 @@ std::string getTestDirPath()
 
     return kTestSrcDir + "/_main/test/";
 }
+
+
+AnyNode::Ptr parseScript(const std::string &program)
+{
+    static const TemporaryScripts scripts("Scripts");
+
+    return FileParser::parseMainFile(scripts.write(program));
+}
+
+
+AnyNode::Ptr evaluateScript(const std::string &program, Scope &scope)
+{
+    auto ast = parseScript(program);
+    ast->evaluate(scope);
+    return ast;
+}
+
+
+TemporaryScripts::TemporaryScripts(const std::string &name)
+    : _directory(std::filesystem::temp_directory_path() / (name + "_" + std::to_string(getpid())))
+{
+    std::filesystem::create_directories(_directory);
+}
+
+
+TemporaryScripts::~TemporaryScripts()
+{
+    std::error_code error;
+    std::filesystem::remove_all(_directory, error); /* Never throws */
+}
+
+
+std::string TemporaryScripts::write(const std::string &contents, const std::string &fileName) const
+{
+    auto filePath = path(fileName);
+
+    std::filesystem::create_directories(std::filesystem::path(filePath).parent_path());
+    std::ofstream(filePath, std::ios::binary | std::ios::trunc) << contents;
+
+    return filePath;
+}
+
+
+std::string TemporaryScripts::path(const std::string &fileName) const
+{
+    return (_directory / fileName).string();
+}
@@ -8,6 +8,42 @@
  */
 
 #pragma once
+#include "AnyNode.hpp"
+#include <filesystem>
 #include <string>
 
+class Scope;
+
 std::string getTestDirPath();
+
+
+/* Parses a program with the interpreter's pipeline (imports, resolution and folding). Nodes are owned by the root */
+AnyNode::Ptr parseScript(const std::string &program);
+
+/*
+ * Parses and evaluates a program. Keep the root alive while the scope refers to its functions or classes. Parse
+ * separately if evaluation is expected to throw.
+ */
+AnyNode::Ptr evaluateScript(const std::string &program, Scope &scope);
+
+
+/* A directory of scripts written by a test. The directory is unique to the process and removed when destroyed */
+class TemporaryScripts
+{
+public:
+    explicit TemporaryScripts(const std::string &name);
+    ~TemporaryScripts();
+
+    TemporaryScripts(const TemporaryScripts &) = delete;
+    TemporaryScripts &operator=(const TemporaryScripts &) = delete;
+
+    /* Writes (or overwrites) a script and returns its path */
+    std::string write(const std::string &contents, const std::string &fileName = "main.ek") const;
+
+    [[nodiscard]] std::string path(const std::string &fileName = "main.ek") const;
+
+    [[nodiscard]] const std::filesystem::path &directory() const { return _directory; }
+
+private:
+    std::filesystem::path _directory;
+};